@@ -7,7 +7,8 @@
 
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-void RunAssembler (const IOfile* file);
+void RunAssembler (const IOfile*  file);
+void WriteCodeArr (const CodeArr* code, const char* codeFile);
 
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
@@ -0,0 +1,80 @@
+#ifndef CODE_CACHE_HPP
+#define CODE_CACHE_HPP
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdint.h>
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// Persistent cache of SPU code of functions for GenerateCachedCode() (codegen/codegen.hpp).
+// Key is the function tree in normalized form, made by the code generator: variables are numbered in order
+// of their first names, so their NameIds and their names do not matter, called functions are kept by name
+// with their arguments quantity. Entry is the code of the function from its start with relocations:
+// jump arguments are places in the function, call arguments are names of callees, so the code goes
+// to any address and is linked again to callees wherever they are.
+// Entries are found by hash of the key and the whole key is compared, a collision only costs a compare.
+// Cache file: code_cache_signature bytes, code_cache_version byte, size_t entries quant, then every entry:
+// size_t key size, code size, relocations quant, names size, key bytes, code, relocations, names.
+// Numbers are in the byte order of this machine. File of another version is taken as an empty cache,
+// code_cache_version goes up with every change of the generated code.
+// Only entries used by the last compilation are written back, so code of deleted functions goes away.
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+const char* const code_cache_signature = "spu_code_cache";
+const uint8_t     code_cache_version   = 1;
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct CodeCacheReloc
+{
+    size_t place;       // jump or call argument, from the function start
+    size_t target;      // jump - label place from the function start, call - callee name offset in CodeCacheEntry::names
+    size_t name_size;   // callee name length, 0 - jump
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct CodeCacheEntry
+{
+    uint64_t        hash;
+    uint8_t*        key;
+    size_t          key_size;
+    int*            code;
+    size_t          code_size;
+    CodeCacheReloc* relocs;
+    size_t          relocs_quant;
+    char*           names;
+    size_t          names_size;
+    bool            is_used;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct CodeCache
+{
+    CodeCacheEntry* entries;
+    size_t          entries_quant;
+    size_t          entries_capacity;
+    size_t*         table;              // index + 1 of entry by hash, linear probing, 0 - empty
+    size_t          table_capacity;     // power of 2
+
+    size_t          hits;
+    size_t          misses;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void                  CodeCacheCtor      (CodeCache* cache);
+void                  CodeCacheDtor      (CodeCache* cache);
+void                  ReadCodeCache      (CodeCache* cache, const char* path);
+void                  WriteCodeCache     (const CodeCache* cache, const char* path);
+
+const CodeCacheEntry* FindCodeCacheEntry (CodeCache* cache, const uint8_t* key, size_t key_size);
+void                  AddCodeCacheEntry  (CodeCache* cache, const CodeCacheEntry* entry);
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#endif // CODE_CACHE_HPP
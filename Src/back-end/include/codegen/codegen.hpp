@@ -0,0 +1,36 @@
+#ifndef CODEGEN_HPP
+#define CODEGEN_HPP
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#include "common/globalInclude.hpp"
+#include "tree/tree.hpp"
+#include "ir/ir.hpp"
+#include "codegen/code-cache/code-cache.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// AST -> SPU code, commands are written straight into CodeArr, without assembler text between them.
+// Every variable gets a RAM slot of its function frame in Name::ram_id, frame begins at register 'ex'.
+// Hot variables live in 'bx', 'cx', 'dx', 'fx' instead (see register-alloc/register-alloc.hpp),
+// the caller saves them to their slots around a call, when they are live across it.
+// Calling convention (SPU has one stack for values and return addresses):
+//   caller - pushes arguments, moves 'ex' over its own frame, 'call', moves 'ex' back, result is on the stack;
+//   callee - pops return address to [ex+0] and arguments to [ex+1] ... [ex+n],
+//            'return' leaves the result under the return address: push [ex+0], ret.
+// 'return f(..)' in f is a tail call: arguments go to the parameters and the body starts again in the same frame.
+// Programm starts with 'call main', 'hlt'. SPU words are int: doubles are truncated.
+// GenerateIrCode() gives the same frames and calling convention from IR (see midle-end ir/ir.hpp), without registers.
+// GenerateCachedCode() gives the same code as GenerateCode(), but takes code of unchanged functions
+// from the cache (see code-cache/code-cache.hpp) and adds there code of the others.
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void GenerateCode       (Tree_t*         tree,   CodeArr* code);
+void GenerateCachedCode (Tree_t*         tree,   CodeArr* code, CodeCache* cache);
+void GenerateIrCode     (const IrModule* module, CodeArr* code);
+void CodeArrDtor        (CodeArr*        code);
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#endif // CODEGEN_HPP
@@ -0,0 +1,77 @@
+#ifndef REGISTER_ALLOC_HPP
+#define REGISTER_ALLOC_HPP
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#include "common/globalInclude.hpp"
+#include "tree/tree.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// Linear scan over one function: live interval of every variable is [first, last] position of its names
+// in code order, interval of a variable met in a loop covers the whole loop (its value goes around the back edge).
+// Weight of a variable is its uses, every loop level multiplies them by RegisterLoopWeight.
+// Registers are caller saved: a variable live across a call costs push / pop of its frame slot around the call,
+// so variables whose uses do not pay for these saves stay in RAM.
+// Intervals are taken by start, when all registers are busy the lightest interval is spilled.
+// Tail self calls ('return f(..)' in f) are jumps to the body start (see codegen.cpp), not calls:
+// the body of such function is one more loop.
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static const size_t RegisterLoopWeight = 8;
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct RegisterInterval
+{
+    size_t first;
+    size_t last;
+    size_t weight;
+    size_t calls_cost;
+    bool   is_met;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct RegisterCall
+{
+    size_t position;
+    size_t weight;
+    NameId saved[REGISTERS_QUANT];  // by register, variable in this register live across the call, NameNoId - none
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct RegisterAlloc
+{
+    size_t            names_quant;
+    Registers*        registers;    // by NameId, REGISTERS_QUANT - variable lives in its frame slot
+    RegisterInterval* intervals;    // by NameId
+
+    NameId*           vars;         // variables of the current function in order of their first names
+    size_t            vars_quant;
+    NameId*           candidates;   // variables worth a register, by interval start
+    size_t            candidates_quant;
+
+    RegisterCall*     calls;        // calls of the current function in code order
+    size_t            calls_quant;
+    size_t            calls_capacity;
+
+    NameId            function;
+    const Node_t*     args;
+    size_t            position;
+    size_t            loop_depth;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void RegisterAllocCtor (RegisterAlloc* alloc, size_t names_quant);
+void RegisterAllocDtor (RegisterAlloc* alloc);
+void AllocateRegisters (RegisterAlloc* alloc, const Node_t* name);
+
+const Node_t* GetTailCall (const Node_t* ret, NameId function);
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#endif // REGISTER_ALLOC_HPP
@@ -151,4 +151,14 @@ struct IOfile
 
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
+// SPU code array: assembler and code generator write it, processor runs it
+struct CodeArr
+{
+    size_t size;
+    size_t pointer;
+    int*   code;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
 #endif //GLOBAL_INCLUDE_HPP
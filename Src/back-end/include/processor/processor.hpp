@@ -45,8 +45,9 @@ struct ProcessorErr
 
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-void RunProcessor         (const IOfile* file);
-void ProcessorAssertPrint (ProcessorErr* Err, const char* File, int Line, const char* Func);
+void   RunProcessor         (const IOfile*  file);
+size_t RunCode              (const CodeArr* code);      // number of executed commands (with hlt)
+void   ProcessorAssertPrint (ProcessorErr* Err, const char* File, int Line, const char* Func);
 
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
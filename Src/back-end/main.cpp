@@ -1,51 +1,102 @@
 #define WORD_SAVE_INPUT_STREAM // for 'read-file/read-file.hpp'
 
 #include <stdlib.h>
+#include <string.h>
 #include "read-file/read-file.hpp"
+#include "lib/lib.hpp"
 #include "tree/tree.hpp"
 #include "assembler/assembler.hpp"
 #include "processor/processor.hpp"
+#include "codegen/codegen.hpp"
+#include "ir/ir-lower/ir-lower.hpp"
+#include "ir/ir-opt/ir-opt.hpp"
 #include "tree/read-write-tree/read-tree/read-tree.hpp"
+#include "name-table/interner/interner.hpp"
 
 #ifdef _DEBUG
 #include "tree/tree-dump/tree-dump.hpp"
 #include "log/log.hpp"
 #endif // _DEBUG
 
-int main()
+// backend [ast] [code] [-run] [-ir | -cache <file>] - default paths are used for missing arguments, AST of any format is read,
+// options may go before the paths, '-run' executes the code on the processor right from memory,
+// '-ir' generates the code through optimized IR instead of straight from the tree,
+// '-cache' takes code of unchanged functions from the file and writes the code of this program there
+
+int main(int argc, const char* argv[])
 {
     ON_DEBUG(
     COLOR_PRINT(GREEN, "\n\nBACKEND START\n\n");
     LOG_OPEN();
     )
 
-    const char* tree_ast = "tree/tree.ast";
-
-    WordArray wordArr = ReadBufferFromFile(tree_ast);
-
-    ON_DEBUG(
-
-    LOG_PRINT(Red, "size = %lu\n", wordArr.size);
+    const char* paths[2]    = {"tree/tree.ast", "tree/code.spu"};
+    size_t      paths_quant = 0;
+    bool        run_code    = false;
+    bool        use_ir      = false;
+    const char* cache       = nullptr;
 
-    for (size_t i = 0; i < wordArr.size; i++)
+    for (int argv_i = 1; argv_i < argc; argv_i++)
     {
-        Word word = wordArr.words[i];
-        LOG_PRINT(Yellow, "word[%lu] = \n{", i);
-        LOG_PRINT(Green, "\tint word = '%s'\n\tlen = %lu\n\t%s:%lu:%lu\n", word.word, word.len, ON_WORD_SAVE_INPUT_STREAM(wordArr.input_stream,) word.line, word.inLine);
-        LOG_PRINT(Yellow, "}\n\n");
+        if      (strcmp(argv[argv_i], "-run")   == 0)                      run_code = true;
+        else if (strcmp(argv[argv_i], "-ir")    == 0)                      use_ir   = true;
+        else if (strcmp(argv[argv_i], "-cache") == 0 && argv_i + 1 < argc) cache    = argv[++argv_i];
+        else if (argv[argv_i][0] != '-' && paths_quant < 2)                paths[paths_quant++] = argv[argv_i];
+        else
+            EXIT(EXIT_FAILURE, "unknown option '%s'.\nusage: %s [ast] [code] [-run] [-ir | -cache <file>]", argv[argv_i], argv[0]);
     }
 
-    )
+    const char* tree_ast = paths[0];
+    const char* code_spu = paths[1];
 
+    if (use_ir && cache)
+        EXIT(EXIT_FAILURE, "'-ir' and '-cache' can't be used together: the cache keeps code generated from the tree.");
 
-    Tree_t tree = ReadTree(&wordArr);
+    Tree_t tree = {};
+    TreeCtor(&tree);
+
+    ReadTree(&tree, tree_ast, GetAstFileFormat(tree_ast));
 
     ON_DEBUG(
     TREE_GRAPHIC_DUMP(&tree);
     )
 
+    CodeArr code = {};
+
+    if (use_ir)
+    {
+        IrModule module = {};
+        IrStats  stats  = {};
+
+        IrModuleCtor  (&module);
+        LowerTree     (&tree, &module);
+        OptimizeIr    (&module, &stats);
+        GenerateIrCode(&module, &code);
+        IrModuleDtor  (&module);
+    }
+    else if (cache)
+    {
+        CodeCache code_cache = {};
+
+        CodeCacheCtor     (&code_cache);
+        ReadCodeCache     (&code_cache, cache);
+        GenerateCachedCode(&tree, &code, &code_cache);
+        WriteCodeCache    (&code_cache, cache);
+        CodeCacheDtor     (&code_cache);
+    }
+    else
+    {
+        GenerateCode(&tree, &code);
+    }
+
+    WriteCodeArr(&code, code_spu);
 
+    if (run_code)
+        RunCode(&code);
 
+    CodeArrDtor(&code);
+    TreeDtor(&tree);
+    InternerDtor();
 
     ON_DEBUG(
     COLOR_PRINT(GREEN, "\n\nBACKEND END\n\n");
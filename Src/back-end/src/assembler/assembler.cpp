@@ -10,6 +10,7 @@
 
 #include "common/globalInclude.hpp"
 #include "lib/lib.hpp"
+#include "profile/profile.hpp"
 #include "stack/stack.hpp"
 #include "log/log.hpp"
 
@@ -47,15 +48,6 @@ struct AssemblerErr
 
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-struct CodeArr
-{
-    size_t size;
-    size_t pointer;
-    int*   code;
-};
-
-//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-
 struct Label
 {
     const char* name;
@@ -246,6 +238,8 @@ void RunAssembler(const IOfile* file)
     assert(file->ProgrammFile);
     assert(file->CodeFile);
 
+    PROFILE_SCOPE("RunAssembler");
+
     AsmData AsmDataInfo = {};
 
     ASSEMBLER_ASSERT(AsmDataCtor         (&AsmDataInfo, file));
@@ -259,6 +253,25 @@ void RunAssembler(const IOfile* file)
 
 //--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
+// code made without assembler text (see codegen/codegen.hpp) is written in the same code file format
+void WriteCodeArr(const CodeArr* code, const char* codeFile)
+{
+    assert(code);
+    assert(code->code);
+    assert(codeFile);
+
+    AsmData AsmDataInfo = {};
+
+    AsmDataInfo.code          = *code;
+    AsmDataInfo.file.CodeFile = codeFile;
+
+    ASSEMBLER_ASSERT(WriteCodeArrInFile(&AsmDataInfo));
+
+    return;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
 static AssemblerErr AsmDataCtor(AsmData* AsmDataInfo, const IOfile* file)
 {
     assert(AsmDataInfo);
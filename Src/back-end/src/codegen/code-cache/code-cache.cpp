@@ -0,0 +1,430 @@
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <sys/stat.h>
+#include "codegen/code-cache/code-cache.hpp"
+#include "tree/read-write-tree/write-buffer/write-buffer.hpp"
+#include "lib/lib.hpp"
+#include "profile/profile.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static const size_t CodeCacheDefaultCapacity = 64;
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct CodeCacheReader
+{
+    uint8_t*       data;
+    size_t         size;
+    size_t         pointer;
+    const char*    path;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void           PushEntry   (CodeCache* cache, const CodeCacheEntry* entry, bool is_used);
+static void           InsertEntry (CodeCache* cache, size_t index);
+static void           ResizeTable (CodeCache* cache);
+static void*          CopyBytes   (const void* bytes, size_t size);
+static uint64_t       HashKey     (const uint8_t* key, size_t key_size);
+static void           CheckRelocs (const CodeCacheEntry* entry, const char* path);
+
+static bool           IsSigned    (const CodeCacheReader* reader);
+static size_t         GetSize     (CodeCacheReader* reader);
+static uint8_t*       TakeBytes   (CodeCacheReader* reader, size_t quant, size_t elem_size);
+static void           PutSize     (WriteBuffer* buffer, size_t value);
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void CodeCacheCtor(CodeCache* cache)
+{
+    assert(cache);
+
+    *cache = {};
+
+    cache->entries_capacity = CodeCacheDefaultCapacity;
+    cache->entries          = (CodeCacheEntry*) calloc(cache->entries_capacity, sizeof(*cache->entries));
+    cache->table_capacity   = CodeCacheDefaultCapacity * 2;
+    cache->table            = (size_t*)         calloc(cache->table_capacity, sizeof(*cache->table));
+
+    if (!cache->entries || !cache->table)
+        EXIT(EXIT_FAILURE, "failed calloc memory for code cache.");
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void CodeCacheDtor(CodeCache* cache)
+{
+    assert(cache);
+
+    // entries are freed with the array, so their pointers are not reset
+    for (size_t i = 0; i < cache->entries_quant; i++)
+    {
+        free(cache->entries[i].key);
+        free(cache->entries[i].code);
+        free(cache->entries[i].relocs);
+        free(cache->entries[i].names);
+    }
+
+    FREE(cache->entries);
+    FREE(cache->table);
+
+    *cache = {};
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// there is no cache before the first compilation, so a missing file is an empty cache
+void ReadCodeCache(CodeCache* cache, const char* path)
+{
+    assert(cache);
+    assert(path);
+
+    PROFILE_SCOPE("ReadCodeCache");
+
+    struct stat file_stat = {};
+
+    if (stat(path, &file_stat) != 0)
+        return;
+
+    FILE* in = fopen(path, "rb");
+    if (!in)
+        EXIT(EXIT_FAILURE, "failed open '%s'", path);
+
+    size_t   size = (size_t) file_stat.st_size;
+    uint8_t* data = (uint8_t*) calloc(size + 1, sizeof(*data));
+
+    if (!data)
+        EXIT(EXIT_FAILURE, "failed calloc memory for code cache file.");
+
+    if (fread(data, sizeof(*data), size, in) != size)
+        EXIT(EXIT_FAILURE, "failed read '%s'", path);
+
+    fclose(in);
+
+    CodeCacheReader reader = {data, size, 0, path};
+
+    // cache of another compiler version is not an error, it is written again after this compilation
+    if (!IsSigned(&reader))
+    {
+        FREE(data);
+        return;
+    }
+
+    reader.pointer = strlen(code_cache_signature) + sizeof(code_cache_version);
+
+    size_t entries_quant = GetSize(&reader);
+
+    for (size_t i = 0; i < entries_quant; i++)
+    {
+        CodeCacheEntry entry = {};
+
+        entry.key_size     = GetSize(&reader);
+        entry.code_size    = GetSize(&reader);
+        entry.relocs_quant = GetSize(&reader);
+        entry.names_size   = GetSize(&reader);
+
+        // file bytes are not aligned for int and size_t, they are only copied by PushEntry()
+        entry.key    =                   TakeBytes(&reader, entry.key_size,     sizeof(*entry.key));
+        entry.code   = (int*)            TakeBytes(&reader, entry.code_size,    sizeof(*entry.code));
+        entry.relocs = (CodeCacheReloc*) TakeBytes(&reader, entry.relocs_quant, sizeof(*entry.relocs));
+        entry.names  = (char*)           TakeBytes(&reader, entry.names_size,   sizeof(*entry.names));
+
+        PushEntry  (cache, &entry, false);
+        CheckRelocs(&cache->entries[cache->entries_quant - 1], path);
+    }
+
+    FREE(data);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void WriteCodeCache(const CodeCache* cache, const char* path)
+{
+    assert(cache);
+    assert(path);
+
+    PROFILE_SCOPE("WriteCodeCache");
+
+    size_t used_quant = 0;
+
+    for (size_t i = 0; i < cache->entries_quant; i++)
+        if (cache->entries[i].is_used) used_quant++;
+
+    WriteBuffer buffer = {};
+    WriteBufferCtor(&buffer, WriteBufferDefaultCapacity);
+
+    BufferPutBytes(&buffer, code_cache_signature, strlen(code_cache_signature));
+    BufferPutBytes(&buffer, &code_cache_version, sizeof(code_cache_version));
+    PutSize       (&buffer, used_quant);
+
+    for (size_t i = 0; i < cache->entries_quant; i++)
+    {
+        const CodeCacheEntry* entry = &cache->entries[i];
+
+        if (!entry->is_used) continue;
+
+        PutSize(&buffer, entry->key_size);
+        PutSize(&buffer, entry->code_size);
+        PutSize(&buffer, entry->relocs_quant);
+        PutSize(&buffer, entry->names_size);
+
+        if (entry->key_size)     BufferPutBytes(&buffer, entry->key,    entry->key_size     * sizeof(*entry->key));
+        if (entry->code_size)    BufferPutBytes(&buffer, entry->code,   entry->code_size    * sizeof(*entry->code));
+        if (entry->relocs_quant) BufferPutBytes(&buffer, entry->relocs, entry->relocs_quant * sizeof(*entry->relocs));
+        if (entry->names_size)   BufferPutBytes(&buffer, entry->names,  entry->names_size   * sizeof(*entry->names));
+    }
+
+    WriteBufferFlush(&buffer, path);
+    WriteBufferDtor (&buffer);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+const CodeCacheEntry* FindCodeCacheEntry(CodeCache* cache, const uint8_t* key, size_t key_size)
+{
+    assert(cache);
+    assert(key);
+
+    uint64_t hash = HashKey(key, key_size);
+    size_t   mask = cache->table_capacity - 1;
+
+    for (size_t i = hash & mask; cache->table[i] != 0; i = (i + 1) & mask)
+    {
+        CodeCacheEntry* entry = &cache->entries[cache->table[i] - 1];
+
+        if (entry->hash != hash || entry->key_size != key_size || memcmp(entry->key, key, key_size) != 0)
+            continue;
+
+        entry->is_used = true;
+        cache->hits++;
+
+        PROFILE_COUNT("code cache hits", 1);
+
+        return entry;
+    }
+
+    cache->misses++;
+
+    PROFILE_COUNT("code cache misses", 1);
+
+    return nullptr;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void AddCodeCacheEntry(CodeCache* cache, const CodeCacheEntry* entry)
+{
+    assert(cache);
+    assert(entry);
+
+    PushEntry(cache, entry, true);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// arrays of the entry are copied, hash is computed here
+static void PushEntry(CodeCache* cache, const CodeCacheEntry* entry, bool is_used)
+{
+    assert(cache);
+    assert(entry);
+    assert(entry->key);
+
+    if (cache->entries_quant == cache->entries_capacity)
+    {
+        cache->entries_capacity *= 2;
+        cache->entries           = (CodeCacheEntry*) realloc(cache->entries, cache->entries_capacity * sizeof(*cache->entries));
+        if (!cache->entries)
+            EXIT(EXIT_FAILURE, "failed realloc memory for code cache entries.");
+    }
+
+    CodeCacheEntry* copy = &cache->entries[cache->entries_quant];
+
+    copy->hash         = HashKey(entry->key, entry->key_size);
+    copy->key          = (uint8_t*)        CopyBytes(entry->key,    entry->key_size     * sizeof(*entry->key));
+    copy->key_size     = entry->key_size;
+    copy->code         = (int*)            CopyBytes(entry->code,   entry->code_size    * sizeof(*entry->code));
+    copy->code_size    = entry->code_size;
+    copy->relocs       = (CodeCacheReloc*) CopyBytes(entry->relocs, entry->relocs_quant * sizeof(*entry->relocs));
+    copy->relocs_quant = entry->relocs_quant;
+    copy->names        = (char*)           CopyBytes(entry->names,  entry->names_size   * sizeof(*entry->names));
+    copy->names_size   = entry->names_size;
+    copy->is_used      = is_used;
+
+    cache->entries_quant++;
+
+    // table is kept at most half full
+    if (cache->entries_quant * 2 > cache->table_capacity)
+        ResizeTable(cache);
+    else
+        InsertEntry(cache, cache->entries_quant - 1);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void InsertEntry(CodeCache* cache, size_t index)
+{
+    assert(cache);
+    assert(index < cache->entries_quant);
+
+    size_t mask = cache->table_capacity - 1;
+    size_t i    = cache->entries[index].hash & mask;
+
+    while (cache->table[i] != 0)
+        i = (i + 1) & mask;
+
+    cache->table[i] = index + 1;
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void ResizeTable(CodeCache* cache)
+{
+    assert(cache);
+
+    FREE(cache->table);
+
+    cache->table_capacity *= 2;
+    cache->table           = (size_t*) calloc(cache->table_capacity, sizeof(*cache->table));
+    if (!cache->table)
+        EXIT(EXIT_FAILURE, "failed calloc memory for code cache table.");
+
+    for (size_t i = 0; i < cache->entries_quant; i++)
+        InsertEntry(cache, i);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void* CopyBytes(const void* bytes, size_t size)
+{
+    void* copy = calloc(size + 1, sizeof(char));
+    if (!copy)
+        EXIT(EXIT_FAILURE, "failed calloc memory for code cache entry.");
+
+    if (size)
+        memcpy(copy, bytes, size);
+
+    return copy;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// keys are as big as function trees, so they are hashed by 8 bytes, not by one like Hash() of name-table
+static uint64_t HashKey(const uint8_t* key, size_t key_size)
+{
+    assert(key);
+
+    const uint64_t multiplier = 0x9E3779B97F4A7C15;
+
+    uint64_t hash = key_size;
+    size_t   i    = 0;
+
+    for (; i + sizeof(uint64_t) <= key_size; i += sizeof(uint64_t))
+    {
+        uint64_t word = 0;
+        memcpy(&word, key + i, sizeof(word));
+
+        hash = (hash ^ word) * multiplier;
+        hash ^= hash >> 29;
+    }
+
+    for (; i < key_size; i++)
+        hash = (hash ^ key[i]) * multiplier;
+
+    return hash ^ (hash >> 32);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// cached code is patched by relocations, so they have to stay in the code and names of their entry
+static void CheckRelocs(const CodeCacheEntry* entry, const char* path)
+{
+    assert(entry);
+    assert(path);
+
+    for (size_t i = 0; i < entry->relocs_quant; i++)
+    {
+        CodeCacheReloc reloc = entry->relocs[i];
+
+        bool is_valid = (reloc.place < entry->code_size) &&
+                        (reloc.name_size == 0 ? reloc.target <= entry->code_size
+                                              : reloc.target <= entry->names_size &&
+                                                reloc.name_size <= entry->names_size - reloc.target);
+        if (!is_valid)
+            EXIT(EXIT_FAILURE, "corrupted code cache '%s', remove it", path);
+    }
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static bool IsSigned(const CodeCacheReader* reader)
+{
+    assert(reader);
+
+    size_t signature_len = strlen(code_cache_signature);
+
+    return reader->size > signature_len                                    &&
+           memcmp(reader->data, code_cache_signature, signature_len) == 0 &&
+           reader->data[signature_len] == code_cache_version;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static size_t GetSize(CodeCacheReader* reader)
+{
+    assert(reader);
+
+    size_t value = 0;
+    memcpy(&value, TakeBytes(reader, 1, sizeof(value)), sizeof(value));
+
+    return value;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static uint8_t* TakeBytes(CodeCacheReader* reader, size_t quant, size_t elem_size)
+{
+    assert(reader);
+    assert(elem_size > 0);
+
+    if (quant > (reader->size - reader->pointer) / elem_size)
+        EXIT(EXIT_FAILURE, "corrupted code cache '%s', remove it", reader->path);
+
+    uint8_t* bytes = reader->data + reader->pointer;
+    reader->pointer += quant * elem_size;
+
+    return bytes;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void PutSize(WriteBuffer* buffer, size_t value)
+{
+    assert(buffer);
+
+    BufferPutBytes(buffer, &value, sizeof(value));
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,2611 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <assert.h>
+#include "codegen/codegen.hpp"
+#include "codegen/register-alloc/register-alloc.hpp"
+#include "common/globalInclude.hpp"
+#include "lib/lib.hpp"
+#include "profile/profile.hpp"
+#include "tree/tree.hpp"
+#include "name-table/interner/interner.hpp"
+#include "tree/read-write-tree/write-buffer/write-buffer.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static const Registers FrameRegister          = Registers::ex;
+static const Registers DiscardRegister        = Registers::ax;
+
+static const size_t    ReturnAddressSlot      = 0;
+static const size_t    NoLabelPlace           = SIZE_MAX;
+static const size_t    NoFunctionLabel        = SIZE_MAX;
+
+static const size_t    CodegenDefaultCodeSize = 1024;
+static const size_t    CodegenDefaultCapacity = 64;
+
+static const char      KeyNoNode              = (char) NodeArgType::undefined;   // there are no undefined nodes in the tree
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct CodegenLabels
+{
+    size_t  size;
+    size_t  capacity;
+    size_t* places;     // code place of every label, NoLabelPlace - label is not set yet
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct CodegenFixup
+{
+    size_t code_place;  // jump or call argument
+    size_t label;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct CodegenFixups
+{
+    size_t        size;
+    size_t        capacity;
+    CodegenFixup* fixups;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct CodegenFunction
+{
+    size_t label;
+    size_t args_quant;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct CodegenFrame
+{
+    size_t* slots;      // slots[NameId] = ram_id + 1 of the variable in the current function, 0 - not met yet
+    size_t  size;
+    size_t  power_slot; // two slots for '^' loop, 0 - not allocated
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// 'if' and its 'else if', 'else' are neighbours in the body connect list, not children of one node
+struct IfChain
+{
+    bool   is_open;
+    size_t end_label;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// state of GenerateCachedCode()
+struct CodegenCache
+{
+    CodeCache*  cache;
+    NameId*     label_functions;        // by label of function, function labels are made first
+    size_t      function_labels_quant;
+    NameId*     locals;                 // by NameId, number + 1 of the variable in the key of the current function
+    NameId*     vars;                   // variables met in the key of the current function
+    size_t      vars_quant;
+    WriteBuffer key;
+    WriteBuffer relocs;
+    WriteBuffer names;                  // callee names of the relocations
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct Codegen
+{
+    CodeArr*         code;
+    CodegenLabels    labels;
+    CodegenFixups    fixups;
+    size_t           names_quant;
+    CodegenFunction* functions;  // by NameId
+    CodegenFrame     frame;
+    RegisterAlloc    alloc;
+    size_t           call_index; // calls of the current function are met in the same order as in AllocateRegisters()
+    const Node_t*    function;   // name node of the current function
+    size_t           body_label; // after the prologue of the current function, tail self calls jump here
+    CodegenCache*    cached;     // nullptr - every function is generated
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// state of GenerateIrCode() for the current function
+struct CodegenIr
+{
+    const IrFunction* function;
+    size_t*           slots;        // by value, frame slot, 0 - value has no slot
+    size_t*           uses;         // by value
+    bool*             is_forwarded; // by value, value is left on the stack for the next instruction
+    size_t*           labels;       // by block
+    IrList            edges;        // label, from, to of every edge with phi copies
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void   CodegenCtor        (Codegen* gen, CodeArr* code);
+static void   CodegenDtor        (Codegen* gen);
+
+static void   DeclareFunctions   (Codegen* gen, const Node_t* node);
+static size_t CountArgs          (const Node_t* node);
+static void   GenEntry           (Codegen* gen);
+static void   GenFunctions       (Codegen* gen, Node_t* node);
+static void   GenFunction        (Codegen* gen, Node_t* node);
+
+static void   CodegenCacheCtor   (Codegen* gen, CodegenCache* cached, CodeCache* cache);
+static void   CodegenCacheDtor   (CodegenCache* cached);
+static void   GenCachedFunction  (Codegen* gen, Node_t* node);
+static void   EmitCachedFunction (Codegen* gen, const Node_t* name_node, const CodeCacheEntry* entry);
+static void   AddCachedFunction  (Codegen* gen, size_t start, size_t fixups_start);
+static void   PutFunctionKey     (Codegen* gen, const Node_t* name_node);
+static void   PutNodeKey         (Codegen* gen, const Node_t* node);
+static void   PutNumberKey       (WriteBuffer* key, Number number);
+static void   PutVariableKey     (Codegen* gen, const Node_t* node);
+static void   PutCalleeKey       (Codegen* gen, const Node_t* name_node);
+
+static void   GenPopArgs         (Codegen* gen, Node_t* node);
+static void   FrameCtor          (Codegen* gen);
+static void   AllocateFrame      (Codegen* gen, Node_t* node);
+static void   AllocateName       (Codegen* gen, Node_t* node);
+
+static void   GenBody            (Codegen* gen, Node_t* node);
+static void   GenStatements      (Codegen* gen, Node_t* node, IfChain* chain);
+static void   GenCondition       (Codegen* gen, Node_t* node, IfChain* chain);
+static void   GenIfBranch        (Codegen* gen, Node_t* node, IfChain* chain);
+static void   CloseIfChain       (Codegen* gen, IfChain* chain);
+static void   GenStatement       (Codegen* gen, Node_t* node);
+static void   GenWhile           (Codegen* gen, Node_t* node);
+static void   GenFor             (Codegen* gen, Node_t* node);
+static void   GenReturn          (Codegen* gen, Node_t* node);
+static void   GenTailCall        (Codegen* gen, Node_t* node);
+
+static void   GenExpression      (Codegen* gen, Node_t* node);
+static void   GenNumber          (Codegen* gen, const Node_t* node);
+static void   GenOperation       (Codegen* gen, Node_t* node);
+static void   GenPower           (Codegen* gen, Node_t* node);
+static void   EmitPower          (Codegen* gen);
+static void   GenBoolValue       (Codegen* gen, Node_t* node);
+static void   GenBranch          (Codegen* gen, Node_t* node, size_t label, bool jump_if);
+static void   GenCall            (Codegen* gen, Node_t* node);
+static void   GenCallArgs        (Codegen* gen, Node_t* node, size_t* args_quant);
+
+static void      DeclareIrFunctions (Codegen* gen, const IrModule* module);
+static void      GenIrFunction      (Codegen* gen, const IrFunction* function);
+static void      CountIrUses        (CodegenIr* ir);
+static void      AllocateIrFrame    (Codegen* gen, CodegenIr* ir);
+static size_t    GetIrArgSlot       (const CodegenIr* ir, IrValue phi);
+static void      CoalesceIrPhis     (CodegenIr* ir);
+static bool      IsIrReadAfter      (const CodegenIr* ir, IrBlockId block, IrValue value, IrValue phi);
+static bool      IsIrEdgeOperand    (const IrFunction* function, IrBlockId block, size_t pred_i, IrValue phi);
+static void      GenIrBlock         (Codegen* gen, CodegenIr* ir, IrBlockId block, IrBlockId next);
+static void      GenIrInstr         (Codegen* gen, CodegenIr* ir, IrValue value);
+static void      GenIrBranch        (Codegen* gen, CodegenIr* ir, IrBlockId block, const IrInstr* br, IrBlockId next, bool is_fused);
+static void      GenIrEdge          (Codegen* gen, CodegenIr* ir, IrBlockId from, IrBlockId to);
+static void      GenIrCall          (Codegen* gen, CodegenIr* ir, const IrInstr* call);
+static bool      HasIrPhis          (const IrFunction* function, IrBlockId block);
+static bool      IsIrEdgeCopy       (const CodegenIr* ir, IrValue phi, size_t pred_i);
+static bool      IsIrFused          (const CodegenIr* ir, const IrList* instrs, size_t i);
+static bool      IsIrForwarded      (const CodegenIr* ir, const IrList* instrs, size_t i);
+static void      EmitPushIrValue    (Codegen* gen, const CodegenIr* ir, IrValue value);
+static Operation GetIrOperation     (IrOp op);
+
+static bool   IsComparison       (Operation operation);
+static Cmd    GetComparisonJump  (Operation operation, bool jump_if);
+static size_t GetVariableSlot    (const Node_t* node);
+
+static size_t NewLabel           (Codegen* gen);
+static void   SetLabel           (Codegen* gen, size_t label);
+static void   ResolveFixups      (Codegen* gen);
+static void   AddFixup           (Codegen* gen, size_t code_place, size_t label);
+
+static void   Emit               (Codegen* gen, int elem);
+static void   EmitCode           (Codegen* gen, const int* code_part, size_t size);
+static void   EmitCmd            (Codegen* gen, Cmd cmd);
+static void   EmitJump           (Codegen* gen, Cmd jump, size_t label);
+static void   EmitPushNumber     (Codegen* gen, int number);
+static void   EmitPushRegister   (Codegen* gen, Registers reg);
+static void   EmitPopRegister    (Codegen* gen, Registers reg);
+static void   EmitPushFrame      (Codegen* gen, size_t slot);
+static void   EmitPopFrame       (Codegen* gen, size_t slot);
+static void   EmitPushVariable   (Codegen* gen, const Node_t* node);
+static void   EmitPopVariable    (Codegen* gen, const Node_t* node);
+static void   EmitSaveRegisters  (Codegen* gen, const RegisterCall* call);
+static void   EmitLoadRegisters  (Codegen* gen, const RegisterCall* call);
+static void   EmitFrameShift     (Codegen* gen, Cmd cmd);
+
+static int    GetPushArg         (uint8_t stk, uint8_t reg, uint8_t mem, uint8_t sum);
+static int    GetPopArg          (uint8_t reg, uint8_t mem, uint8_t sum);
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void GenerateCode(Tree_t* tree, CodeArr* code)
+{
+    assert(tree);
+    assert(code);
+
+    PROFILE_SCOPE("GenerateCode");
+
+    Codegen gen = {};
+    CodegenCtor(&gen, code);
+
+    DeclareFunctions(&gen, tree->root);
+    GenEntry        (&gen);
+    GenFunctions    (&gen, tree->root);
+    ResolveFixups   (&gen);
+
+    code->size = code->pointer;
+
+    CodegenDtor(&gen);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// functions are generated as by GenerateCode(), but a function with its key in the cache gets the cached code,
+// its labels are set again from the function start and its calls become fixups to labels of its callees
+void GenerateCachedCode(Tree_t* tree, CodeArr* code, CodeCache* cache)
+{
+    assert(tree);
+    assert(code);
+    assert(cache);
+
+    PROFILE_SCOPE("GenerateCachedCode");
+
+    Codegen gen = {};
+    CodegenCtor(&gen, code);
+
+    CodegenCache cached = {};
+
+    DeclareFunctions(&gen, tree->root);
+    CodegenCacheCtor(&gen, &cached, cache);
+    GenEntry        (&gen);
+    GenFunctions    (&gen, tree->root);
+    ResolveFixups   (&gen);
+
+    code->size = code->pointer;
+
+    CodegenCacheDtor(&cached);
+    CodegenDtor     (&gen);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void CodeArrDtor(CodeArr* code)
+{
+    assert(code);
+
+    FREE(code->code);
+    *code = {};
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void CodegenCtor(Codegen* gen, CodeArr* code)
+{
+    assert(gen);
+    assert(code);
+
+    *code = {};
+    code->size = CodegenDefaultCodeSize;
+    code->code = (int*) calloc(code->size, sizeof(int));
+
+    gen->code        = code;
+    gen->names_quant = GetInternedNamesQuant();
+
+    gen->labels.capacity = CodegenDefaultCapacity;
+    gen->labels.places   = (size_t*)           calloc(gen->labels.capacity, sizeof(*gen->labels.places));
+    gen->fixups.capacity = CodegenDefaultCapacity;
+    gen->fixups.fixups   = (CodegenFixup*)     calloc(gen->fixups.capacity, sizeof(*gen->fixups.fixups));
+    gen->functions       = (CodegenFunction*)  calloc(gen->names_quant + 1, sizeof(*gen->functions));
+    gen->frame.slots     = (size_t*)           calloc(gen->names_quant + 1, sizeof(*gen->frame.slots));
+
+    if (!code->code || !gen->labels.places || !gen->fixups.fixups || !gen->functions || !gen->frame.slots)
+        EXIT(EXIT_FAILURE, "failed calloc memory for code generator.");
+
+    RegisterAllocCtor(&gen->alloc, gen->names_quant);
+
+    for (size_t i = 0; i <= gen->names_quant; i++)
+        gen->functions[i].label = NoFunctionLabel;
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void CodegenDtor(Codegen* gen)
+{
+    assert(gen);
+
+    FREE(gen->labels.places);
+    FREE(gen->fixups.fixups);
+    FREE(gen->functions);
+    FREE(gen->frame.slots);
+
+    RegisterAllocDtor(&gen->alloc);
+
+    *gen = {};
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// labels of all functions are made before any code, so calls can go forward
+static void DeclareFunctions(Codegen* gen, const Node_t* node)
+{
+    assert(gen);
+
+    if (!node) return;
+
+    if (node->type == NodeArgType::connect)
+    {
+        DeclareFunctions(gen, node->left);
+        DeclareFunctions(gen, node->right);
+        return;
+    }
+
+    if (node->type != NodeArgType::initialisation || node->data.init != Initialisation::def_function)
+        EXIT(EXIT_FAILURE, "here must be def func node");
+
+    const Node_t* name_node = node->left->left;
+    NameId        id        = name_node->data.name.id;
+
+    assert(id != NameNoId);
+    assert(id <= gen->names_quant);
+
+    if (gen->functions[id].label != NoFunctionLabel)
+    {
+        NameInfo name = GetInternedName(id);
+        EXIT(EXIT_FAILURE, "function '%.*s' is defined twice", (int) name.len, name.name);
+    }
+
+    gen->functions[id].label      = NewLabel(gen);
+    gen->functions[id].args_quant = CountArgs(name_node->left);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static size_t CountArgs(const Node_t* node)
+{
+    if (!node) return 0;
+
+    if (node->type == NodeArgType::connect)
+        return CountArgs(node->left) + CountArgs(node->right);
+
+    return 1;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void GenEntry(Codegen* gen)
+{
+    assert(gen);
+
+    const char* const main_name = "main";
+    NameInfo          main_info = {main_name, strlen(main_name)};
+    NameId            main_id   = GetNameId(&main_info);
+
+    if (main_id == NameNoId || gen->functions[main_id].label == NoFunctionLabel)
+        EXIT(EXIT_FAILURE, "programm has no 'main' function");
+
+    // 'ex' is 0 at start, so frame of 'main' begins at RAM[0]
+    EmitJump(gen, Cmd::call, gen->functions[main_id].label);
+    EmitCmd (gen, Cmd::hlt);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void GenFunctions(Codegen* gen, Node_t* node)
+{
+    assert(gen);
+
+    if (!node) return;
+
+    if (node->type == NodeArgType::connect)
+    {
+        GenFunctions(gen, node->left);
+        GenFunctions(gen, node->right);
+        return;
+    }
+
+    if (gen->cached)
+        GenCachedFunction(gen, node);
+    else
+        GenFunction(gen, node);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void GenFunction(Codegen* gen, Node_t* node)
+{
+    assert(gen);
+    assert(node);
+
+    Node_t* name_node = node->left->left;
+    Node_t* args_node = name_node->left;
+    Node_t* body_node = name_node->right;
+
+    SetLabel(gen, gen->functions[name_node->data.name.id].label);
+
+    // arguments are allocated first, so they get slots 1 ... n,
+    // every variable keeps its slot even in a register: the register is saved there around calls
+    FrameCtor        (gen);
+    AllocateFrame    (gen, args_node);
+    AllocateFrame    (gen, body_node);
+    AllocateRegisters(&gen->alloc, name_node);
+
+    gen->call_index = 0;
+    gen->function   = name_node;
+    gen->body_label = NewLabel(gen);
+
+    EmitPopFrame(gen, ReturnAddressSlot);
+    GenPopArgs  (gen, args_node);
+    SetLabel    (gen, gen->body_label);
+
+    GenBody(gen, body_node);
+
+    assert(gen->call_index == gen->alloc.calls_quant);
+
+    // function without 'return' at the end returns 0
+    EmitPushNumber(gen, 0);
+    EmitPushFrame (gen, ReturnAddressSlot);
+    EmitCmd       (gen, Cmd::ret);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// arguments are on the stack in their order, so they are popped from the last one
+static void GenPopArgs(Codegen* gen, Node_t* node)
+{
+    assert(gen);
+
+    if (!node) return;
+
+    if (node->type == NodeArgType::connect)
+    {
+        GenPopArgs(gen, node->right);
+        GenPopArgs(gen, node->left);
+        return;
+    }
+
+    EmitPopVariable(gen, node->left);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void FrameCtor(Codegen* gen)
+{
+    assert(gen);
+    assert(gen->frame.slots);
+
+    memset(gen->frame.slots, 0, (gen->names_quant + 1) * sizeof(*gen->frame.slots));
+
+    gen->frame.size       = ReturnAddressSlot + 1;
+    gen->frame.power_slot = 0;
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// gives RAM slots to all variables of the function before its code, so the frame size is known at every call
+static void AllocateFrame(Codegen* gen, Node_t* node)
+{
+    assert(gen);
+
+    if (!node) return;
+
+    if (node->type == NodeArgType::name)
+        return AllocateName(gen, node);
+
+    if (node->type == NodeArgType::initialisation && node->data.init == Initialisation::call_function)
+        return AllocateFrame(gen, node->left->left); // function name is not a variable
+
+    if (node->type == NodeArgType::operation && node->data.oper == Operation::power && gen->frame.power_slot == 0)
+    {
+        gen->frame.power_slot  = gen->frame.size;
+        gen->frame.size       += 2;
+    }
+
+    AllocateFrame(gen, node->left);
+    AllocateFrame(gen, node->right);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void AllocateName(Codegen* gen, Node_t* node)
+{
+    assert(gen);
+    assert(node);
+    assert(node->type == NodeArgType::name);
+
+    NameId id = node->data.name.id;
+
+    assert(id != NameNoId);
+    assert(id <= gen->names_quant);
+
+    if (gen->frame.slots[id] == 0)
+    {
+        gen->frame.slots[id] = gen->frame.size + 1;
+        gen->frame.size++;
+    }
+
+    node->data.name.ram_id = gen->frame.slots[id] - 1;
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void GenBody(Codegen* gen, Node_t* node)
+{
+    assert(gen);
+
+    IfChain chain = {};
+
+    GenStatements(gen, node, &chain);
+    CloseIfChain (gen, &chain);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void GenStatements(Codegen* gen, Node_t* node, IfChain* chain)
+{
+    assert(gen);
+    assert(chain);
+
+    if (!node) return;
+
+    if (node->type == NodeArgType::connect)
+    {
+        GenStatements(gen, node->left,  chain);
+        GenStatements(gen, node->right, chain);
+        return;
+    }
+
+    if (node->type == NodeArgType::condition)
+        return GenCondition(gen, node, chain);
+
+    CloseIfChain(gen, chain);
+    GenStatement(gen, node);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void GenCondition(Codegen* gen, Node_t* node, IfChain* chain)
+{
+    assert(gen);
+    assert(node);
+    assert(chain);
+
+    switch (node->data.condition)
+    {
+        case Condition::if_t:
+        {
+            CloseIfChain(gen, chain);
+
+            chain->is_open   = true;
+            chain->end_label = NewLabel(gen);
+
+            GenIfBranch(gen, node, chain);
+            return;
+        }
+
+        case Condition::else_if_t:
+        {
+            if (!chain->is_open)
+                EXIT(EXIT_FAILURE, "'else if' without 'if'");
+
+            GenIfBranch(gen, node, chain);
+            return;
+        }
+
+        case Condition::else_t:
+        {
+            if (!chain->is_open)
+                EXIT(EXIT_FAILURE, "'else' without 'if'");
+
+            GenBody     (gen, node->right);
+            CloseIfChain(gen, chain);
+            return;
+        }
+
+        case Condition::undefined_condition:
+        default: EXIT(EXIT_FAILURE, "undefined condition type.");
+    }
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void GenIfBranch(Codegen* gen, Node_t* node, IfChain* chain)
+{
+    assert(gen);
+    assert(node);
+    assert(chain);
+
+    size_t next_label = NewLabel(gen);
+
+    GenBranch(gen, node->left, next_label, false);
+    GenBody  (gen, node->right);
+    EmitJump (gen, Cmd::jmp, chain->end_label);
+    SetLabel (gen, next_label);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void CloseIfChain(Codegen* gen, IfChain* chain)
+{
+    assert(gen);
+    assert(chain);
+
+    if (!chain->is_open) return;
+
+    SetLabel(gen, chain->end_label);
+    *chain = {};
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void GenStatement(Codegen* gen, Node_t* node)
+{
+    assert(gen);
+    assert(node);
+
+    NodeArgType type = node->type;
+
+    if (type == NodeArgType::cycle && node->data.cycle == Cycle::while_t)
+        return GenWhile(gen, node);
+
+    if (type == NodeArgType::cycle && node->data.cycle == Cycle::for_t)
+        return GenFor(gen, node);
+
+    if (type == NodeArgType::attribute && node->data.attribute == FunctionAttribute::ret)
+        return GenReturn(gen, node);
+
+    if (type == NodeArgType::dfunction && node->data.function == DFunction::print)
+    {
+        EmitPushVariable(gen, node->left);
+        EmitCmd         (gen, Cmd::outr);
+        return;
+    }
+
+    if (type == NodeArgType::initialisation && node->data.init == Initialisation::def_variable)
+    {
+        GenExpression  (gen, node->right);
+        EmitPopVariable(gen, node->left->left);
+        return;
+    }
+
+    if (type == NodeArgType::initialisation && node->data.init == Initialisation::assign_variable)
+    {
+        GenExpression  (gen, node->right);
+        EmitPopVariable(gen, node->left);
+        return;
+    }
+
+    // expression as statement (function call): its value is dropped
+    GenExpression  (gen, node);
+    EmitPopRegister(gen, DiscardRegister);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void GenWhile(Codegen* gen, Node_t* node)
+{
+    assert(gen);
+    assert(node);
+
+    size_t condition_label = NewLabel(gen);
+    size_t end_label       = NewLabel(gen);
+
+    SetLabel (gen, condition_label);
+    GenBranch(gen, node->left, end_label, false);
+    GenBody  (gen, node->right);
+    EmitJump (gen, Cmd::jmp, condition_label);
+    SetLabel (gen, end_label);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// for node: left = connect(connect(init, condition), step), right = body
+static void GenFor(Codegen* gen, Node_t* node)
+{
+    assert(gen);
+    assert(node);
+    assert(node->left);
+    assert(node->left->left);
+
+    Node_t* init_node      = node->left->left->left;
+    Node_t* condition_node = node->left->left->right;
+    Node_t* step_node      = node->left->right;
+
+    size_t condition_label = NewLabel(gen);
+    size_t end_label       = NewLabel(gen);
+
+    GenBody (gen, init_node);
+    SetLabel(gen, condition_label);
+
+    if (condition_node)
+        GenBranch(gen, condition_node, end_label, false);
+
+    GenBody (gen, node->right);
+    GenBody (gen, step_node);
+    EmitJump(gen, Cmd::jmp, condition_label);
+    SetLabel(gen, end_label);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void GenReturn(Codegen* gen, Node_t* node)
+{
+    assert(gen);
+    assert(node);
+
+    if (GetTailCall(node, gen->function->data.name.id))
+        return GenTailCall(gen, node->left);
+
+    if (node->left)
+        GenExpression(gen, node->left);
+    else
+        EmitPushNumber(gen, 0);
+
+    EmitPushFrame(gen, ReturnAddressSlot);
+    EmitCmd      (gen, Cmd::ret);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// 'return f(..)' in f: the frame is not needed anymore, so new arguments take place of the old ones
+// and the body starts again - no 'call', no return address, the stack does not grow
+static void GenTailCall(Codegen* gen, Node_t* node)
+{
+    assert(gen);
+    assert(node);
+
+    const CodegenFunction* function   = &gen->functions[gen->function->data.name.id];
+    size_t                 args_quant = 0;
+
+    GenCallArgs(gen, node->left->left, &args_quant);
+
+    if (args_quant != function->args_quant)
+    {
+        NameInfo name = GetInternedName(gen->function->data.name.id);
+        EXIT(EXIT_FAILURE, "function '%.*s' takes %lu arguments, but %lu given", (int) name.len, name.name, function->args_quant, args_quant);
+    }
+
+    GenPopArgs(gen, gen->function->left);
+    EmitJump  (gen, Cmd::jmp, gen->body_label);
+
+    PROFILE_COUNT("tail calls", 1);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// every expression leaves exactly one value on the stack
+static void GenExpression(Codegen* gen, Node_t* node)
+{
+    assert(gen);
+
+    if (!node)
+        EXIT(EXIT_FAILURE, "here must be expression node");
+
+    switch (node->type)
+    {
+        case NodeArgType::number:    return GenNumber   (gen, node);
+        case NodeArgType::operation: return GenOperation(gen, node);
+        case NodeArgType::name:
+        {
+            EmitPushVariable(gen, node);
+            return;
+        }
+
+        case NodeArgType::initialisation:
+        {
+            if (node->data.init == Initialisation::call_function)
+                return GenCall(gen, node);
+
+            if (node->data.init == Initialisation::assign_variable)
+            {
+                GenExpression   (gen, node->right);
+                EmitPopVariable (gen, node->left);
+                EmitPushVariable(gen, node->left);
+                return;
+            }
+
+            EXIT(EXIT_FAILURE, "here must be expression node");
+        }
+
+        case NodeArgType::connect:
+        case NodeArgType::type:
+        case NodeArgType::condition:
+        case NodeArgType::cycle:
+        case NodeArgType::dfunction:
+        case NodeArgType::attribute:
+        case NodeArgType::undefined:
+        default: EXIT(EXIT_FAILURE, "here must be expression node");
+    }
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void GenNumber(Codegen* gen, const Node_t* node)
+{
+    assert(gen);
+    assert(node);
+
+    Number number = node->data.num;
+
+    switch (number.type)
+    {
+        case Type::int_type:    EmitPushNumber(gen,       number.value.int_val   ); break;
+        case Type::char_type:   EmitPushNumber(gen,       number.value.char_val  ); break;
+        case Type::double_type: EmitPushNumber(gen, (int) number.value.double_val); break;
+        case Type::void_type:
+        case Type::undefined_type:
+        default: EXIT(EXIT_FAILURE, "undef num type.");
+    }
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void GenOperation(Codegen* gen, Node_t* node)
+{
+    assert(gen);
+    assert(node);
+
+    Operation operation = node->data.oper;
+
+    if (IsComparison(operation) || operation == Operation::bool_and || operation == Operation::bool_or || operation == Operation::bool_not)
+        return GenBoolValue(gen, node);
+
+    if (operation == Operation::power)
+        return GenPower(gen, node);
+
+    // unary minus is 'minus' node without right child
+    if (operation == Operation::minus && !node->right)
+    {
+        EmitPushNumber(gen, 0);
+        GenExpression (gen, node->left);
+        EmitCmd       (gen, Cmd::sub);
+        return;
+    }
+
+    Cmd cmd = Cmd::hlt;
+
+    switch (operation)
+    {
+        case Operation::plus:  cmd = Cmd::add;  break;
+        case Operation::minus: cmd = Cmd::sub;  break;
+        case Operation::mul:   cmd = Cmd::mul;  break;
+        case Operation::dive:  cmd = Cmd::dive; break;
+        case Operation::power:
+        case Operation::assign:
+        case Operation::greater:
+        case Operation::greater_or_equal:
+        case Operation::less:
+        case Operation::less_or_equal:
+        case Operation::equal:
+        case Operation::not_equal:
+        case Operation::bool_and:
+        case Operation::bool_or:
+        case Operation::bool_not:
+        case Operation::plus_equal:
+        case Operation::minus_equal:
+        case Operation::mul_equal:
+        case Operation::div_equal:
+        case Operation::plus_plus:
+        case Operation::minus_minus:
+        case Operation::undefined_operation:
+        default: EXIT(EXIT_FAILURE, "operation '%d' has no SPU code", (int) operation);
+    }
+
+    GenExpression(gen, node->left);
+    GenExpression(gen, node->right);
+    EmitCmd      (gen, cmd);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// SPU has no power command: result *= base while exponent > 0,
+// base and exponent are kept in two frame slots, the result is on the stack
+static void GenPower(Codegen* gen, Node_t* node)
+{
+    assert(gen);
+    assert(node);
+    assert(gen->frame.power_slot != 0);
+
+    GenExpression(gen, node->left);
+    GenExpression(gen, node->right);
+    EmitPower    (gen);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// base and exponent are on the stack
+static void EmitPower(Codegen* gen)
+{
+    assert(gen);
+    assert(gen->frame.power_slot != 0);
+
+    size_t base_slot     = gen->frame.power_slot;
+    size_t exponent_slot = gen->frame.power_slot + 1;
+
+    size_t loop_label    = NewLabel(gen);
+    size_t end_label     = NewLabel(gen);
+
+    EmitPopFrame  (gen, exponent_slot);
+    EmitPopFrame  (gen, base_slot);
+    EmitPushNumber(gen, 1);
+
+    SetLabel      (gen, loop_label);
+    EmitPushFrame (gen, exponent_slot);
+    EmitPushNumber(gen, 0);
+    EmitJump      (gen, Cmd::jbe, end_label);
+
+    EmitPushFrame (gen, base_slot);
+    EmitCmd       (gen, Cmd::mul);
+    EmitPushFrame (gen, exponent_slot);
+    EmitPushNumber(gen, 1);
+    EmitCmd       (gen, Cmd::sub);
+    EmitPopFrame  (gen, exponent_slot);
+    EmitJump      (gen, Cmd::jmp, loop_label);
+
+    SetLabel      (gen, end_label);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void GenBoolValue(Codegen* gen, Node_t* node)
+{
+    assert(gen);
+    assert(node);
+
+    size_t false_label = NewLabel(gen);
+    size_t end_label   = NewLabel(gen);
+
+    GenBranch     (gen, node, false_label, false);
+    EmitPushNumber(gen, 1);
+    EmitJump      (gen, Cmd::jmp, end_label);
+    SetLabel      (gen, false_label);
+    EmitPushNumber(gen, 0);
+    SetLabel      (gen, end_label);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// jumps to label if node value is jump_if, comparisons become one 'j*', 'and' / 'or' are lazy
+static void GenBranch(Codegen* gen, Node_t* node, size_t label, bool jump_if)
+{
+    assert(gen);
+    assert(node);
+
+    Operation operation = (node->type == NodeArgType::operation) ? node->data.oper : Operation::undefined_operation;
+
+    if (IsComparison(operation))
+    {
+        GenExpression(gen, node->left);
+        GenExpression(gen, node->right);
+        EmitJump     (gen, GetComparisonJump(operation, jump_if), label);
+        return;
+    }
+
+    if (operation == Operation::bool_not)
+        return GenBranch(gen, node->left, label, !jump_if);
+
+    if (operation == Operation::bool_and || operation == Operation::bool_or)
+    {
+        // 'and' jumps on true and 'or' on false only when both operands agree
+        bool both_needed = (operation == Operation::bool_and) == jump_if;
+
+        if (!both_needed)
+        {
+            GenBranch(gen, node->left,  label, jump_if);
+            GenBranch(gen, node->right, label, jump_if);
+            return;
+        }
+
+        size_t skip_label = NewLabel(gen);
+
+        GenBranch(gen, node->left,  skip_label, !jump_if);
+        GenBranch(gen, node->right, label,       jump_if);
+        SetLabel (gen, skip_label);
+        return;
+    }
+
+    GenExpression (gen, node);
+    EmitPushNumber(gen, 0);
+    EmitJump      (gen, jump_if ? Cmd::jne : Cmd::je, label);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void GenCall(Codegen* gen, Node_t* node)
+{
+    assert(gen);
+    assert(node);
+    assert(node->left);
+
+    const Node_t* name_node = node->left;
+    NameId        id        = name_node->data.name.id;
+
+    assert(id != NameNoId);
+    assert(id <= gen->names_quant);
+
+    const CodegenFunction* function = &gen->functions[id];
+    NameInfo               name     = GetInternedName(id);
+
+    if (function->label == NoFunctionLabel)
+        EXIT(EXIT_FAILURE, "call of undefined function '%.*s'", (int) name.len, name.name);
+
+    size_t args_quant = 0;
+    GenCallArgs(gen, node->left->left, &args_quant);
+
+    if (args_quant != function->args_quant)
+        EXIT(EXIT_FAILURE, "function '%.*s' takes %lu arguments, but %lu given", (int) name.len, name.name, function->args_quant, args_quant);
+
+    assert(gen->call_index < gen->alloc.calls_quant);
+
+    const RegisterCall* call = &gen->alloc.calls[gen->call_index];
+    gen->call_index++;
+
+    EmitSaveRegisters(gen, call);
+    EmitFrameShift   (gen, Cmd::add);
+    EmitJump         (gen, Cmd::call, function->label);
+    EmitFrameShift   (gen, Cmd::sub);
+    EmitLoadRegisters(gen, call);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void GenCallArgs(Codegen* gen, Node_t* node, size_t* args_quant)
+{
+    assert(gen);
+    assert(args_quant);
+
+    if (!node) return;
+
+    if (node->type == NodeArgType::connect)
+    {
+        GenCallArgs(gen, node->left,  args_quant);
+        GenCallArgs(gen, node->right, args_quant);
+        return;
+    }
+
+    GenExpression(gen, node);
+    (*args_quant)++;
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void CodegenCacheCtor(Codegen* gen, CodegenCache* cached, CodeCache* cache)
+{
+    assert(gen);
+    assert(cached);
+    assert(cache);
+
+    cached->cache                 = cache;
+    cached->function_labels_quant = gen->labels.size;
+    cached->label_functions       = (NameId*) calloc(gen->labels.size + 1, sizeof(*cached->label_functions));
+    cached->locals                = (NameId*) calloc(gen->names_quant + 1, sizeof(*cached->locals));
+    cached->vars                  = (NameId*) calloc(gen->names_quant + 1, sizeof(*cached->vars));
+
+    if (!cached->label_functions || !cached->locals || !cached->vars)
+        EXIT(EXIT_FAILURE, "failed calloc memory for code generator cache.");
+
+    for (size_t id = 0; id <= gen->names_quant; id++)
+        if (gen->functions[id].label != NoFunctionLabel)
+            cached->label_functions[gen->functions[id].label] = (NameId) id;
+
+    WriteBufferCtor(&cached->key,    WriteBufferDefaultCapacity);
+    WriteBufferCtor(&cached->relocs, WriteBufferDefaultCapacity);
+    WriteBufferCtor(&cached->names,  WriteBufferDefaultCapacity);
+
+    gen->cached = cached;
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void CodegenCacheDtor(CodegenCache* cached)
+{
+    assert(cached);
+
+    FREE(cached->label_functions);
+    FREE(cached->locals);
+    FREE(cached->vars);
+
+    WriteBufferDtor(&cached->key);
+    WriteBufferDtor(&cached->relocs);
+    WriteBufferDtor(&cached->names);
+
+    *cached = {};
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void GenCachedFunction(Codegen* gen, Node_t* node)
+{
+    assert(gen);
+    assert(gen->cached);
+    assert(node);
+
+    CodegenCache* cached    = gen->cached;
+    const Node_t* name_node = node->left->left;
+
+    PutFunctionKey(gen, name_node);
+
+    const CodeCacheEntry* entry = FindCodeCacheEntry(cached->cache, (const uint8_t*) cached->key.data, cached->key.size);
+
+    if (entry)
+        return EmitCachedFunction(gen, name_node, entry);
+
+    size_t start        = gen->code->pointer;
+    size_t fixups_start = gen->fixups.size;
+
+    GenFunction      (gen, node);
+    AddCachedFunction(gen, start, fixups_start);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void EmitCachedFunction(Codegen* gen, const Node_t* name_node, const CodeCacheEntry* entry)
+{
+    assert(gen);
+    assert(name_node);
+    assert(entry);
+
+    SetLabel(gen, gen->functions[name_node->data.name.id].label);
+
+    size_t start = gen->code->pointer;
+
+    EmitCode(gen, entry->code, entry->code_size);
+
+    for (size_t i = 0; i < entry->relocs_quant; i++)
+    {
+        CodeCacheReloc reloc = entry->relocs[i];
+
+        if (reloc.name_size == 0)
+        {
+            gen->code->code[start + reloc.place] = (int) (start + reloc.target);
+            continue;
+        }
+
+        // callee has the same name and arguments quant as in the key, but it may be not defined any more
+        NameInfo name   = {entry->names + reloc.target, reloc.name_size};
+        NameId   callee = GetNameId(&name);
+
+        if (callee == NameNoId || gen->functions[callee].label == NoFunctionLabel)
+            EXIT(EXIT_FAILURE, "call of undefined function '%.*s'", (int) name.len, name.name);
+
+        AddFixup(gen, start + reloc.place, gen->functions[callee].label);
+    }
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// fixups of the function are its relocations: labels of functions become callee names, other labels are in the function
+static void AddCachedFunction(Codegen* gen, size_t start, size_t fixups_start)
+{
+    assert(gen);
+    assert(gen->cached);
+
+    CodegenCache* cached = gen->cached;
+
+    cached->relocs.size = 0;
+    cached->names.size  = 0;
+
+    for (size_t i = fixups_start; i < gen->fixups.size; i++)
+    {
+        CodegenFixup   fixup = gen->fixups.fixups[i];
+        CodeCacheReloc reloc = {fixup.code_place - start, 0, 0};
+
+        if (fixup.label < cached->function_labels_quant)
+        {
+            NameInfo name = GetInternedName(cached->label_functions[fixup.label]);
+
+            reloc.target    = cached->names.size;
+            reloc.name_size = name.len;
+
+            BufferPutBytes(&cached->names, name.name, name.len);
+        }
+        else
+        {
+            size_t place = gen->labels.places[fixup.label];
+
+            assert(place != NoLabelPlace);
+            assert(start <= place && place <= gen->code->pointer);
+
+            reloc.target = place - start;
+        }
+
+        BufferPutBytes(&cached->relocs, &reloc, sizeof(reloc));
+    }
+
+    CodeCacheEntry entry = {};
+
+    entry.key          = (uint8_t*) cached->key.data;
+    entry.key_size     = cached->key.size;
+    entry.code         = gen->code->code + start;
+    entry.code_size    = gen->code->pointer - start;
+    entry.relocs       = (CodeCacheReloc*) cached->relocs.data;
+    entry.relocs_quant = cached->relocs.size / sizeof(*entry.relocs);
+    entry.names        = cached->names.data;
+    entry.names_size   = cached->names.size;
+
+    AddCodeCacheEntry(cached->cache, &entry);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// everything the code of a function depends on: its name (tail self calls), arguments and body
+// with variables numbered by their first names, names and arguments quants of callees
+static void PutFunctionKey(Codegen* gen, const Node_t* name_node)
+{
+    assert(gen);
+    assert(gen->cached);
+    assert(name_node);
+
+    CodegenCache* cached = gen->cached;
+    NameInfo      name   = GetInternedName(name_node->data.name.id);
+
+    cached->key.size = 0;
+
+    BufferPutBytes(&cached->key, &name.len, sizeof(name.len));
+    BufferPutBytes(&cached->key, name.name, name.len);
+
+    PutNodeKey(gen, name_node->left);
+    PutNodeKey(gen, name_node->right);
+
+    for (size_t i = 0; i < cached->vars_quant; i++)
+        cached->locals[cached->vars[i]] = 0;
+
+    cached->vars_quant = 0;
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// nodes in pre-order, empty children too, so different trees have different keys,
+// a node is its type byte and its data, enums are one byte, right children go in the loop
+static void PutNodeKey(Codegen* gen, const Node_t* node)
+{
+    assert(gen);
+    assert(gen->cached);
+
+    WriteBuffer* key = &gen->cached->key;
+
+    for (; node; node = node->right)
+    {
+        BufferPutChar(key, (char) node->type);
+
+        switch (node->type)
+        {
+            case NodeArgType::name:           PutVariableKey(gen, node);                      break;
+            case NodeArgType::number:         PutNumberKey  (key, node->data.num);            break;
+            case NodeArgType::operation:      BufferPutChar (key, (char) node->data.oper);      break;
+            case NodeArgType::type:           BufferPutChar (key, (char) node->data.type);      break;
+            case NodeArgType::condition:      BufferPutChar (key, (char) node->data.condition); break;
+            case NodeArgType::cycle:          BufferPutChar (key, (char) node->data.cycle);     break;
+            case NodeArgType::dfunction:      BufferPutChar (key, (char) node->data.function);  break;
+            case NodeArgType::attribute:      BufferPutChar (key, (char) node->data.attribute); break;
+            case NodeArgType::initialisation: BufferPutChar (key, (char) node->data.init);      break;
+            case NodeArgType::connect:                                                        break;
+            case NodeArgType::undefined:
+            default: EXIT(EXIT_FAILURE, "undefined node type.");
+        }
+
+        if (node->type == NodeArgType::initialisation && node->data.init == Initialisation::call_function)
+        {
+            PutCalleeKey(gen, node->left);
+            PutNodeKey  (gen, node->left->left);
+        }
+        else
+        {
+            PutNodeKey(gen, node->left);
+        }
+    }
+
+    BufferPutChar(key, KeyNoNode);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void PutNumberKey(WriteBuffer* key, Number number)
+{
+    assert(key);
+
+    BufferPutChar(key, (char) number.type);
+
+    switch (number.type)
+    {
+        case Type::int_type:    BufferPutBytes(key, &number.value.int_val,    sizeof(number.value.int_val));    return;
+        case Type::char_type:   BufferPutBytes(key, &number.value.char_val,   sizeof(number.value.char_val));   return;
+        case Type::double_type: BufferPutBytes(key, &number.value.double_val, sizeof(number.value.double_val)); return;
+        case Type::void_type:
+        case Type::undefined_type:
+        default: EXIT(EXIT_FAILURE, "undef num type.");
+    }
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void PutVariableKey(Codegen* gen, const Node_t* node)
+{
+    assert(gen);
+    assert(gen->cached);
+    assert(node);
+
+    CodegenCache* cached = gen->cached;
+    NameId        id     = node->data.name.id;
+
+    assert(id != NameNoId);
+    assert(id <= gen->names_quant);
+
+    if (cached->locals[id] == 0)
+    {
+        cached->vars[cached->vars_quant] = id;
+        cached->vars_quant++;
+        cached->locals[id] = (NameId) cached->vars_quant;
+    }
+
+    BufferPutBytes(&cached->key, &cached->locals[id], sizeof(cached->locals[id]));
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void PutCalleeKey(Codegen* gen, const Node_t* name_node)
+{
+    assert(gen);
+    assert(gen->cached);
+    assert(name_node);
+
+    WriteBuffer* key  = &gen->cached->key;
+    NameId       id   = name_node->data.name.id;
+    NameInfo     name = GetInternedName(id);
+
+    assert(id <= gen->names_quant);
+
+    BufferPutBytes(key, &name.len, sizeof(name.len));
+    BufferPutBytes(key, name.name, name.len);
+    BufferPutBytes(key, &gen->functions[id].args_quant, sizeof(gen->functions[id].args_quant));
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// IR -> SPU code: every value, that is not a number, gets its frame slot, arguments keep slots 1 ... n.
+// Value used once by the next instruction as its first operand is not stored: it is left on the stack.
+// Comparison used only by the branch after it becomes one 'j*'. Phis get their values on the edges:
+// all operands are pushed, then popped to the phi slots, so phis of one block are assigned at once.
+void GenerateIrCode(const IrModule* module, CodeArr* code)
+{
+    assert(module);
+    assert(code);
+
+    PROFILE_SCOPE("GenerateIrCode");
+
+    Codegen gen = {};
+    CodegenCtor(&gen, code);
+
+    DeclareIrFunctions(&gen, module);
+    GenEntry          (&gen);
+
+    for (size_t i = 0; i < module->functions_quant; i++)
+        GenIrFunction(&gen, &module->functions[i]);
+
+    ResolveFixups(&gen);
+
+    code->size = code->pointer;
+
+    CodegenDtor(&gen);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void DeclareIrFunctions(Codegen* gen, const IrModule* module)
+{
+    assert(gen);
+    assert(module);
+
+    for (size_t i = 0; i < module->functions_quant; i++)
+    {
+        NameId id = module->functions[i].name;
+
+        assert(id != NameNoId);
+        assert(id <= gen->names_quant);
+
+        if (gen->functions[id].label != NoFunctionLabel)
+        {
+            NameInfo name = GetInternedName(id);
+            EXIT(EXIT_FAILURE, "function '%.*s' is defined twice", (int) name.len, name.name);
+        }
+
+        gen->functions[id].label      = NewLabel(gen);
+        gen->functions[id].args_quant = module->functions[i].args_quant;
+    }
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void GenIrFunction(Codegen* gen, const IrFunction* function)
+{
+    assert(gen);
+    assert(function);
+
+    CodegenIr ir    = {};
+    ir.function     = function;
+    ir.slots        = (size_t*) calloc(function->instrs_quant + 1, sizeof(*ir.slots));
+    ir.uses         = (size_t*) calloc(function->instrs_quant + 1, sizeof(*ir.uses));
+    ir.is_forwarded = (bool*)   calloc(function->instrs_quant + 1, sizeof(*ir.is_forwarded));
+    ir.labels       = (size_t*) calloc(function->blocks_quant + 1, sizeof(*ir.labels));
+
+    if (!ir.slots || !ir.uses || !ir.is_forwarded || !ir.labels)
+        EXIT(EXIT_FAILURE, "failed calloc memory for ir code generator.");
+
+    for (IrBlockId block = 0; block < function->blocks_quant; block++)
+        ir.labels[block] = NewLabel(gen);
+
+    CountIrUses    (&ir);
+    AllocateIrFrame(gen, &ir);
+
+    SetLabel(gen, gen->functions[function->name].label);
+
+    // arguments are on the stack in their order, so they are popped from the last one
+    EmitPopFrame(gen, ReturnAddressSlot);
+
+    for (size_t arg_i = function->args_quant; arg_i > 0; arg_i--)
+        EmitPopFrame(gen, arg_i);
+
+    IrBlockId block = 0;
+
+    while (block < function->blocks_quant)
+    {
+        IrBlockId next = block + 1;
+
+        while (next < function->blocks_quant && function->blocks[next].is_removed)
+            next++;
+
+        if (!function->blocks[block].is_removed)
+            GenIrBlock(gen, &ir, block, next);
+
+        block = next;
+    }
+
+    // edges with phi copies are placed after all blocks: label, from, to
+    for (size_t i = 0; i < ir.edges.size; i += 3)
+    {
+        SetLabel (gen, ir.edges.items[i]);
+        GenIrEdge(gen, &ir, ir.edges.items[i + 1], ir.edges.items[i + 2]);
+        EmitJump (gen, Cmd::jmp, ir.labels[ir.edges.items[i + 2]]);
+    }
+
+    FREE(ir.slots);
+    FREE(ir.uses);
+    FREE(ir.is_forwarded);
+    FREE(ir.labels);
+    IrListDtor(&ir.edges);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void CountIrUses(CodegenIr* ir)
+{
+    assert(ir);
+
+    const IrFunction* function = ir->function;
+
+    for (IrValue value = 0; value < function->instrs_quant; value++)
+    {
+        const IrInstr* instr = &function->instrs[value];
+
+        if (instr->op == IrOp::nop || function->blocks[instr->block].is_removed)
+            continue;
+
+        const IrValue* operands = GetIrOperands(function, instr);
+
+        if (instr->a != IrNoValue) ir->uses[instr->a]++;
+        if (instr->b != IrNoValue) ir->uses[instr->b]++;
+
+        for (size_t i = 0; i < instr->operands_quant; i++)
+            ir->uses[operands[i]]++;
+    }
+
+    for (IrBlockId block = 0; block < function->blocks_quant; block++)
+    {
+        const IrList* instrs = &function->blocks[block].instrs;
+
+        for (size_t i = 0; i < instrs->size; i++)
+            ir->is_forwarded[instrs->items[i]] = IsIrForwarded(ir, instrs, i);
+    }
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// numbers and undefs are pushed again at every use, forwarded values are never stored,
+// phis get their slots first: value may be computed right into the slot of its phi (see CoalesceIrPhis())
+static void AllocateIrFrame(Codegen* gen, CodegenIr* ir)
+{
+    assert(gen);
+    assert(ir);
+
+    const IrFunction* function = ir->function;
+
+    gen->frame.size       = ReturnAddressSlot + 1 + function->args_quant;
+    gen->frame.power_slot = 0;
+
+    for (IrValue value = 0; value < function->instrs_quant; value++)
+    {
+        const IrInstr* instr = &function->instrs[value];
+
+        if (instr->op == IrOp::nop || function->blocks[instr->block].is_removed)
+            continue;
+
+        if (instr->op == IrOp::arg)
+            ir->slots[value] = ReturnAddressSlot + 1 + (size_t) instr->number;
+
+        if (instr->op == IrOp::phi && ir->uses[value] > 0)
+        {
+            ir->slots[value] = GetIrArgSlot(ir, value);
+
+            if (ir->slots[value] == 0)
+            {
+                ir->slots[value] = gen->frame.size;
+                gen->frame.size++;
+            }
+        }
+    }
+
+    CoalesceIrPhis(ir);
+
+    for (IrValue value = 0; value < function->instrs_quant; value++)
+    {
+        const IrInstr* instr = &function->instrs[value];
+
+        if (instr->op == IrOp::nop || function->blocks[instr->block].is_removed)
+            continue;
+
+        if (instr->op == IrOp::pow && gen->frame.power_slot == 0)
+        {
+            gen->frame.power_slot  = gen->frame.size;
+            gen->frame.size       += 2;
+        }
+
+        bool has_value = (instr->op == IrOp::call || IsIrBinary(instr->op));
+
+        if (has_value && ir->slots[value] == 0 && !ir->is_forwarded[value] && ir->uses[value] > 0)
+        {
+            ir->slots[value] = gen->frame.size;
+            gen->frame.size++;
+        }
+    }
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// phi of the body gets the argument from the entry, the argument is not needed after it: they share the slot, 0 - no such argument
+static size_t GetIrArgSlot(const CodegenIr* ir, IrValue phi)
+{
+    assert(ir);
+
+    const IrFunction* function = ir->function;
+    const IrInstr*    instr    = &function->instrs[phi];
+    const IrList*     preds    = &function->blocks[instr->block].preds;
+    const IrValue*    operands = GetIrOperands(function, instr);
+
+    for (size_t i = 0; i < preds->size; i++)
+    {
+        const IrInstr* operand = &function->instrs[operands[i]];
+
+        if (preds->items[i] == 0 && operand->op == IrOp::arg && ir->uses[operands[i]] == 1)
+            return ReturnAddressSlot + 1 + (size_t) operand->number;
+    }
+
+    return 0;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// value, which is only the operand of a phi on the edge from its block, takes the slot of the phi,
+// when the phi is not read after the value in the block: 'i = i + 1' is stored once, without copy on the edge
+static void CoalesceIrPhis(CodegenIr* ir)
+{
+    assert(ir);
+
+    const IrFunction* function = ir->function;
+
+    for (IrBlockId block = 0; block < function->blocks_quant; block++)
+    {
+        const IrBlock* ir_block = &function->blocks[block];
+
+        if (ir_block->is_removed)
+            continue;
+
+        for (size_t pred_i = 0; pred_i < ir_block->preds.size; pred_i++)
+        {
+            IrBlockId      pred       = ir_block->preds.items[pred_i];
+            const IrInstr* terminator = GetIrTerminator(function, pred);
+
+            if (!terminator || terminator->op != IrOp::jmp)
+                continue;
+
+            for (size_t phi_i = 0; phi_i < ir_block->phis.size; phi_i++)
+            {
+                IrValue        phi   = ir_block->phis.items[phi_i];
+                const IrInstr* instr = &function->instrs[phi];
+
+                if (instr->op != IrOp::phi || ir->slots[phi] == 0)
+                    continue;
+
+                IrValue        value   = GetIrOperands(function, instr)[pred_i];
+                const IrInstr* operand = &function->instrs[value];
+
+                if (operand->block != pred || ir->uses[value] != 1 || ir->slots[value] != 0 || ir->is_forwarded[value])
+                    continue;
+
+                if (operand->op != IrOp::call && !IsIrBinary(operand->op))
+                    continue;
+
+                if (!IsIrReadAfter(ir, pred, value, phi) && !IsIrEdgeOperand(function, block, pred_i, phi))
+                    ir->slots[value] = ir->slots[phi];
+            }
+        }
+    }
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// phi is read in the block after the value is defined
+static bool IsIrReadAfter(const CodegenIr* ir, IrBlockId block, IrValue value, IrValue phi)
+{
+    assert(ir);
+
+    const IrFunction* function = ir->function;
+    const IrList*     instrs   = &function->blocks[block].instrs;
+    bool              is_after = false;
+
+    for (size_t i = 0; i < instrs->size; i++)
+    {
+        const IrInstr* instr    = &function->instrs[instrs->items[i]];
+        const IrValue* operands = GetIrOperands(function, instr);
+
+        if (is_after && (instr->a == phi || instr->b == phi))
+            return true;
+
+        for (size_t operand_i = 0; is_after && operand_i < instr->operands_quant; operand_i++)
+        {
+            if (operands[operand_i] == phi)
+                return true;
+        }
+
+        if (instrs->items[i] == value)
+            is_after = true;
+    }
+
+    return false;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// phi is the value of another phi of the block on the edge
+static bool IsIrEdgeOperand(const IrFunction* function, IrBlockId block, size_t pred_i, IrValue phi)
+{
+    assert(function);
+
+    const IrList* phis = &function->blocks[block].phis;
+
+    for (size_t i = 0; i < phis->size; i++)
+    {
+        const IrInstr* instr = &function->instrs[phis->items[i]];
+
+        if (instr->op == IrOp::phi && GetIrOperands(function, instr)[pred_i] == phi)
+            return true;
+    }
+
+    return false;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void GenIrBlock(Codegen* gen, CodegenIr* ir, IrBlockId block, IrBlockId next)
+{
+    assert(gen);
+    assert(ir);
+
+    const IrFunction* function = ir->function;
+    const IrList*     instrs   = &function->blocks[block].instrs;
+
+    SetLabel(gen, ir->labels[block]);
+
+    for (size_t i = 0; i < instrs->size; i++)
+    {
+        IrValue        value = instrs->items[i];
+        const IrInstr* instr = &function->instrs[value];
+
+        if (instr->op == IrOp::jmp)
+        {
+            GenIrEdge(gen, ir, block, instr->target);
+
+            if (instr->target != next)
+                EmitJump(gen, Cmd::jmp, ir->labels[instr->target]);
+
+            continue;
+        }
+
+        if (instr->op == IrOp::br)
+        {
+            GenIrBranch(gen, ir, block, instr, next, i > 0 && IsIrFused(ir, instrs, i - 1));
+            continue;
+        }
+
+        if (IsIrFused(ir, instrs, i))
+            continue;
+
+        GenIrInstr(gen, ir, value);
+    }
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void GenIrInstr(Codegen* gen, CodegenIr* ir, IrValue value)
+{
+    assert(gen);
+    assert(ir);
+
+    const IrInstr* instr = &ir->function->instrs[value];
+
+    switch (instr->op)
+    {
+        case IrOp::nop:
+        case IrOp::number:
+        case IrOp::arg:
+        case IrOp::undef:
+        case IrOp::phi:    return;
+
+        case IrOp::add:
+        case IrOp::sub:
+        case IrOp::mul:
+        case IrOp::div:
+        {
+            Cmd cmd = (instr->op == IrOp::add) ? Cmd::add :
+                      (instr->op == IrOp::sub) ? Cmd::sub :
+                      (instr->op == IrOp::mul) ? Cmd::mul : Cmd::dive;
+
+            EmitPushIrValue(gen, ir, instr->a);
+            EmitPushIrValue(gen, ir, instr->b);
+            EmitCmd        (gen, cmd);
+            break;
+        }
+
+        case IrOp::pow:
+        {
+            EmitPushIrValue(gen, ir, instr->a);
+            EmitPushIrValue(gen, ir, instr->b);
+            EmitPower      (gen);
+            break;
+        }
+
+        case IrOp::lt:
+        case IrOp::le:
+        case IrOp::gt:
+        case IrOp::ge:
+        case IrOp::eq:
+        case IrOp::ne:
+        {
+            size_t false_label = NewLabel(gen);
+            size_t end_label   = NewLabel(gen);
+
+            EmitPushIrValue(gen, ir, instr->a);
+            EmitPushIrValue(gen, ir, instr->b);
+            EmitJump       (gen, GetComparisonJump(GetIrOperation(instr->op), false), false_label);
+            EmitPushNumber (gen, 1);
+            EmitJump       (gen, Cmd::jmp, end_label);
+            SetLabel       (gen, false_label);
+            EmitPushNumber (gen, 0);
+            SetLabel       (gen, end_label);
+            break;
+        }
+
+        case IrOp::call:
+        {
+            GenIrCall(gen, ir, instr);
+            break;
+        }
+
+        case IrOp::print:
+        {
+            EmitPushIrValue(gen, ir, instr->a);
+            EmitCmd        (gen, Cmd::outr);
+            return;
+        }
+
+        case IrOp::ret:
+        {
+            EmitPushIrValue(gen, ir, instr->a);
+            EmitPushFrame  (gen, ReturnAddressSlot);
+            EmitCmd        (gen, Cmd::ret);
+            return;
+        }
+
+        case IrOp::jmp:
+        case IrOp::br:
+        default: EXIT(EXIT_FAILURE, "ir instruction '%d' has no SPU code", (int) instr->op);
+    }
+
+    // the value is on the stack now
+    if (ir->is_forwarded[value])
+        return;
+
+    if (ir->slots[value] != 0)
+        EmitPopFrame   (gen, ir->slots[value]);
+    else
+        EmitPopRegister(gen, DiscardRegister);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// jump goes to the target, or to the other block, when the target is the next one and the other edge has no copies;
+// edge with copies jumps to its code after the blocks
+static void GenIrBranch(Codegen* gen, CodegenIr* ir, IrBlockId block, const IrInstr* br, IrBlockId next, bool is_fused)
+{
+    assert(gen);
+    assert(ir);
+    assert(br);
+
+    const IrFunction* function = ir->function;
+
+    bool      jump_if = !(br->target == next && !HasIrPhis(function, br->other));
+    IrBlockId jump_to = jump_if ? br->target : br->other;
+    IrBlockId stay    = jump_if ? br->other  : br->target;
+    size_t    label   = ir->labels[jump_to];
+
+    if (HasIrPhis(function, jump_to))
+    {
+        label = NewLabel(gen);
+
+        IrListPush(&ir->edges, label);
+        IrListPush(&ir->edges, block);
+        IrListPush(&ir->edges, jump_to);
+    }
+
+    const IrInstr* condition = &function->instrs[br->a];
+
+    if (is_fused)
+    {
+        EmitPushIrValue(gen, ir, condition->a);
+        EmitPushIrValue(gen, ir, condition->b);
+        EmitJump       (gen, GetComparisonJump(GetIrOperation(condition->op), jump_if), label);
+    }
+    else
+    {
+        EmitPushIrValue(gen, ir, br->a);
+        EmitPushNumber (gen, 0);
+        EmitJump       (gen, jump_if ? Cmd::jne : Cmd::je, label);
+    }
+
+    GenIrEdge(gen, ir, block, stay);
+
+    if (stay != next)
+        EmitJump(gen, Cmd::jmp, ir->labels[stay]);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// all operands of the edge are pushed before any phi is assigned: phis may be operands of each other
+static void GenIrEdge(Codegen* gen, CodegenIr* ir, IrBlockId from, IrBlockId to)
+{
+    assert(gen);
+    assert(ir);
+
+    const IrFunction* function = ir->function;
+    const IrList*     phis     = &function->blocks[to].phis;
+
+    if (!HasIrPhis(function, to))
+        return;
+
+    size_t index = GetIrPredIndex(function, to, from);
+
+    for (size_t i = 0; i < phis->size; i++)
+    {
+        if (IsIrEdgeCopy(ir, phis->items[i], index))
+            EmitPushIrValue(gen, ir, GetIrOperands(function, &function->instrs[phis->items[i]])[index]);
+    }
+
+    for (size_t i = phis->size; i > 0; i--)
+    {
+        if (IsIrEdgeCopy(ir, phis->items[i - 1], index))
+            EmitPopFrame(gen, ir->slots[phis->items[i - 1]]);
+    }
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void GenIrCall(Codegen* gen, CodegenIr* ir, const IrInstr* call)
+{
+    assert(gen);
+    assert(ir);
+    assert(call);
+
+    const CodegenFunction* function = &gen->functions[call->callee];
+    NameInfo               name     = GetInternedName(call->callee);
+
+    if (function->label == NoFunctionLabel)
+        EXIT(EXIT_FAILURE, "call of undefined function '%.*s'", (int) name.len, name.name);
+
+    if (call->operands_quant != function->args_quant)
+        EXIT(EXIT_FAILURE, "function '%.*s' takes %lu arguments, but %lu given", (int) name.len, name.name, function->args_quant, call->operands_quant);
+
+    const IrValue* args = GetIrOperands(ir->function, call);
+
+    for (size_t i = 0; i < call->operands_quant; i++)
+        EmitPushIrValue(gen, ir, args[i]);
+
+    EmitFrameShift(gen, Cmd::add);
+    EmitJump      (gen, Cmd::call, function->label);
+    EmitFrameShift(gen, Cmd::sub);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static bool HasIrPhis(const IrFunction* function, IrBlockId block)
+{
+    assert(function);
+
+    const IrList* phis = &function->blocks[block].phis;
+
+    for (size_t i = 0; i < phis->size; i++)
+    {
+        if (function->instrs[phis->items[i]].op == IrOp::phi)
+            return true;
+    }
+
+    return false;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// phi is read somewhere and its value on the edge is not in its slot already
+static bool IsIrEdgeCopy(const CodegenIr* ir, IrValue phi, size_t pred_i)
+{
+    assert(ir);
+
+    const IrInstr* instr = &ir->function->instrs[phi];
+
+    if (instr->op != IrOp::phi || ir->slots[phi] == 0)
+        return false;
+
+    return ir->slots[GetIrOperands(ir->function, instr)[pred_i]] != ir->slots[phi];
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// comparison, used only by the branch right after it
+static bool IsIrFused(const CodegenIr* ir, const IrList* instrs, size_t i)
+{
+    assert(ir);
+    assert(instrs);
+
+    IrValue        value = instrs->items[i];
+    const IrInstr* instr = &ir->function->instrs[value];
+
+    if (!IsIrComparison(instr->op) || ir->uses[value] != 1 || i + 1 >= instrs->size)
+        return false;
+
+    const IrInstr* next = &ir->function->instrs[instrs->items[i + 1]];
+
+    return next->op == IrOp::br && next->a == value;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// value, used only by the next instruction, which pushes it first
+static bool IsIrForwarded(const CodegenIr* ir, const IrList* instrs, size_t i)
+{
+    assert(ir);
+    assert(instrs);
+
+    IrValue        value = instrs->items[i];
+    const IrInstr* instr = &ir->function->instrs[value];
+
+    if (instr->op != IrOp::call && !IsIrBinary(instr->op))
+        return false;
+
+    if (ir->uses[value] != 1 || i + 1 >= instrs->size || IsIrFused(ir, instrs, i))
+        return false;
+
+    const IrInstr* next = &ir->function->instrs[instrs->items[i + 1]];
+
+    if (next->op == IrOp::call)
+        return next->operands_quant > 0 && GetIrOperands(ir->function, next)[0] == value;
+
+    if (next->op == IrOp::print || next->op == IrOp::ret || next->op == IrOp::br || IsIrBinary(next->op))
+        return next->a == value;
+
+    return false;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void EmitPushIrValue(Codegen* gen, const CodegenIr* ir, IrValue value)
+{
+    assert(gen);
+    assert(ir);
+    assert(value != IrNoValue);
+
+    const IrInstr* instr = &ir->function->instrs[value];
+
+    if (instr->op == IrOp::number)
+        return EmitPushNumber(gen, instr->number);
+
+    // value of variable read before assignment is not defined, 0 is as good as any
+    if (instr->op == IrOp::undef)
+        return EmitPushNumber(gen, 0);
+
+    if (ir->is_forwarded[value])
+        return;
+
+    assert(ir->slots[value] != 0);
+
+    EmitPushFrame(gen, ir->slots[value]);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static Operation GetIrOperation(IrOp op)
+{
+    switch (op)
+    {
+        case IrOp::lt:     return Operation::less;
+        case IrOp::le:     return Operation::less_or_equal;
+        case IrOp::gt:     return Operation::greater;
+        case IrOp::ge:     return Operation::greater_or_equal;
+        case IrOp::eq:     return Operation::equal;
+        case IrOp::ne:     return Operation::not_equal;
+
+        case IrOp::nop:
+        case IrOp::number:
+        case IrOp::arg:
+        case IrOp::undef:
+        case IrOp::phi:
+        case IrOp::add:
+        case IrOp::sub:
+        case IrOp::mul:
+        case IrOp::div:
+        case IrOp::pow:
+        case IrOp::call:
+        case IrOp::print:
+        case IrOp::ret:
+        case IrOp::jmp:
+        case IrOp::br:
+        default: EXIT(EXIT_FAILURE, "here must be comparison ir instruction");
+    }
+
+    return Operation::undefined_operation;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static bool IsComparison(Operation operation)
+{
+    switch (operation)
+    {
+        case Operation::greater:
+        case Operation::greater_or_equal:
+        case Operation::less:
+        case Operation::less_or_equal:
+        case Operation::equal:
+        case Operation::not_equal:           return true;
+
+        case Operation::undefined_operation:
+        case Operation::plus:
+        case Operation::minus:
+        case Operation::mul:
+        case Operation::dive:
+        case Operation::power:
+        case Operation::assign:
+        case Operation::bool_and:
+        case Operation::bool_or:
+        case Operation::bool_not:
+        case Operation::plus_equal:
+        case Operation::minus_equal:
+        case Operation::mul_equal:
+        case Operation::div_equal:
+        case Operation::plus_plus:
+        case Operation::minus_minus:
+        default:                             return false;
+    }
+
+    return false;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static Cmd GetComparisonJump(Operation operation, bool jump_if)
+{
+    switch (operation)
+    {
+        case Operation::greater:          return jump_if ? Cmd::ja  : Cmd::jbe;
+        case Operation::greater_or_equal: return jump_if ? Cmd::jae : Cmd::jb;
+        case Operation::less:             return jump_if ? Cmd::jb  : Cmd::jae;
+        case Operation::less_or_equal:    return jump_if ? Cmd::jbe : Cmd::ja;
+        case Operation::equal:            return jump_if ? Cmd::je  : Cmd::jne;
+        case Operation::not_equal:        return jump_if ? Cmd::jne : Cmd::je;
+
+        case Operation::undefined_operation:
+        case Operation::plus:
+        case Operation::minus:
+        case Operation::mul:
+        case Operation::dive:
+        case Operation::power:
+        case Operation::assign:
+        case Operation::bool_and:
+        case Operation::bool_or:
+        case Operation::bool_not:
+        case Operation::plus_equal:
+        case Operation::minus_equal:
+        case Operation::mul_equal:
+        case Operation::div_equal:
+        case Operation::plus_plus:
+        case Operation::minus_minus:
+        default: EXIT(EXIT_FAILURE, "here must be comparison operation");
+    }
+
+    return Cmd::jmp;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static size_t GetVariableSlot(const Node_t* node)
+{
+    if (!node || node->type != NodeArgType::name)
+        EXIT(EXIT_FAILURE, "here must be node with type 'name'");
+
+    return node->data.name.ram_id;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static size_t NewLabel(Codegen* gen)
+{
+    assert(gen);
+
+    CodegenLabels* labels = &gen->labels;
+
+    if (labels->size == labels->capacity)
+    {
+        labels->capacity *= 2;
+        labels->places    = (size_t*) realloc(labels->places, labels->capacity * sizeof(*labels->places));
+        if (!labels->places)
+            EXIT(EXIT_FAILURE, "failed realloc memory for code generator labels.");
+    }
+
+    labels->places[labels->size] = NoLabelPlace;
+
+    return labels->size++;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void SetLabel(Codegen* gen, size_t label)
+{
+    assert(gen);
+    assert(label < gen->labels.size);
+    assert(gen->labels.places[label] == NoLabelPlace);
+
+    gen->labels.places[label] = gen->code->pointer;
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void ResolveFixups(Codegen* gen)
+{
+    assert(gen);
+
+    for (size_t i = 0; i < gen->fixups.size; i++)
+    {
+        CodegenFixup fixup = gen->fixups.fixups[i];
+        size_t       place = gen->labels.places[fixup.label];
+
+        assert(place != NoLabelPlace);
+
+        gen->code->code[fixup.code_place] = (int) place;
+    }
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void AddFixup(Codegen* gen, size_t code_place, size_t label)
+{
+    assert(gen);
+
+    CodegenFixups* fixups = &gen->fixups;
+
+    if (fixups->size == fixups->capacity)
+    {
+        fixups->capacity *= 2;
+        fixups->fixups    = (CodegenFixup*) realloc(fixups->fixups, fixups->capacity * sizeof(*fixups->fixups));
+        if (!fixups->fixups)
+            EXIT(EXIT_FAILURE, "failed realloc memory for code generator fixups.");
+    }
+
+    fixups->fixups[fixups->size] = {code_place, label};
+    fixups->size++;
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void Emit(Codegen* gen, int elem)
+{
+    assert(gen);
+
+    CodeArr* code = gen->code;
+
+    if (code->pointer == code->size)
+    {
+        code->size *= 2;
+        code->code  = (int*) realloc(code->code, code->size * sizeof(int));
+        if (!code->code)
+            EXIT(EXIT_FAILURE, "failed realloc memory for code array.");
+    }
+
+    code->code[code->pointer] = elem;
+    code->pointer++;
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void EmitCode(Codegen* gen, const int* code_part, size_t size)
+{
+    assert(gen);
+    assert(code_part);
+
+    CodeArr* code = gen->code;
+
+    if (code->pointer + size > code->size)
+    {
+        while (code->pointer + size > code->size)
+            code->size *= 2;
+
+        code->code = (int*) realloc(code->code, code->size * sizeof(int));
+        if (!code->code)
+            EXIT(EXIT_FAILURE, "failed realloc memory for code array.");
+    }
+
+    memcpy(code->code + code->pointer, code_part, size * sizeof(*code_part));
+    code->pointer += size;
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void EmitCmd(Codegen* gen, Cmd cmd)
+{
+    assert(gen);
+
+    Emit(gen, cmd);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// argument is a label, its place is written by ResolveFixups()
+static void EmitJump(Codegen* gen, Cmd jump, size_t label)
+{
+    assert(gen);
+
+    EmitCmd (gen, jump);
+    AddFixup(gen, gen->code->pointer, label);
+    Emit    (gen, 0);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void EmitPushNumber(Codegen* gen, int number)
+{
+    assert(gen);
+
+    EmitCmd(gen, Cmd::push);
+    Emit   (gen, GetPushArg(1, 0, 0, 0));
+    Emit   (gen, number);
+    Emit   (gen, 0);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void EmitPushRegister(Codegen* gen, Registers reg)
+{
+    assert(gen);
+
+    EmitCmd(gen, Cmd::push);
+    Emit   (gen, GetPushArg(0, 1, 0, 0));
+    Emit   (gen, reg);
+    Emit   (gen, 0);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void EmitPopRegister(Codegen* gen, Registers reg)
+{
+    assert(gen);
+
+    EmitCmd(gen, Cmd::pop);
+    Emit   (gen, GetPopArg(1, 0, 0));
+    Emit   (gen, reg);
+    Emit   (gen, 0);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// push [ex+slot]
+static void EmitPushFrame(Codegen* gen, size_t slot)
+{
+    assert(gen);
+
+    EmitCmd(gen, Cmd::push);
+    Emit   (gen, GetPushArg(0, 0, 1, 1));
+    Emit   (gen, FrameRegister);
+    Emit   (gen, (int) slot);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// pop [ex+slot]
+static void EmitPopFrame(Codegen* gen, size_t slot)
+{
+    assert(gen);
+
+    EmitCmd(gen, Cmd::pop);
+    Emit   (gen, GetPopArg(0, 1, 1));
+    Emit   (gen, FrameRegister);
+    Emit   (gen, (int) slot);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// variable is in its register or in its frame slot
+static void EmitPushVariable(Codegen* gen, const Node_t* node)
+{
+    assert(gen);
+
+    size_t    slot = GetVariableSlot(node);
+    Registers reg  = gen->alloc.registers[node->data.name.id];
+
+    if (reg != Registers::REGISTERS_QUANT)
+        EmitPushRegister(gen, reg);
+    else
+        EmitPushFrame   (gen, slot);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void EmitPopVariable(Codegen* gen, const Node_t* node)
+{
+    assert(gen);
+
+    size_t    slot = GetVariableSlot(node);
+    Registers reg  = gen->alloc.registers[node->data.name.id];
+
+    if (reg != Registers::REGISTERS_QUANT)
+        EmitPopRegister(gen, reg);
+    else
+        EmitPopFrame   (gen, slot);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// registers are caller saved: callee uses all of them, variables live across the call go to their slots
+static void EmitSaveRegisters(Codegen* gen, const RegisterCall* call)
+{
+    assert(gen);
+    assert(call);
+
+    for (size_t reg = 0; reg < Registers::REGISTERS_QUANT; reg++)
+    {
+        NameId id = call->saved[reg];
+
+        if (id == NameNoId) continue;
+
+        EmitPushRegister(gen, (Registers) reg);
+        EmitPopFrame    (gen, gen->frame.slots[id] - 1);
+    }
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void EmitLoadRegisters(Codegen* gen, const RegisterCall* call)
+{
+    assert(gen);
+    assert(call);
+
+    for (size_t reg = 0; reg < Registers::REGISTERS_QUANT; reg++)
+    {
+        NameId id = call->saved[reg];
+
+        if (id == NameNoId) continue;
+
+        EmitPushFrame  (gen, gen->frame.slots[id] - 1);
+        EmitPopRegister(gen, (Registers) reg);
+    }
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// ex = ex + frame size (cmd = add) or ex = ex - frame size (cmd = sub)
+static void EmitFrameShift(Codegen* gen, Cmd cmd)
+{
+    assert(gen);
+    assert(cmd == Cmd::add || cmd == Cmd::sub);
+
+    EmitPushRegister(gen, FrameRegister);
+    EmitPushNumber  (gen, (int) gen->frame.size);
+    EmitCmd         (gen, cmd);
+    EmitPopRegister (gen, FrameRegister);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static int GetPushArg(uint8_t stk, uint8_t reg, uint8_t mem, uint8_t sum)
+{
+    PushType push = {};
+
+    push.stk = stk ? 1 : 0;
+    push.reg = reg ? 1 : 0;
+    push.mem = mem ? 1 : 0;
+    push.sum = sum ? 1 : 0;
+
+    int arg = 0;
+    static_assert(sizeof(push) == sizeof(arg), "push type must be one code elem");
+    memcpy(&arg, &push, sizeof(arg));
+
+    return arg;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static int GetPopArg(uint8_t reg, uint8_t mem, uint8_t sum)
+{
+    PopType pop = {};
+
+    pop.reg = reg ? 1 : 0;
+    pop.mem = mem ? 1 : 0;
+    pop.sum = sum ? 1 : 0;
+
+    int arg = 0;
+    static_assert(sizeof(pop) == sizeof(arg), "pop type must be one code elem");
+    memcpy(&arg, &pop, sizeof(arg));
+
+    return arg;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,561 @@
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "codegen/register-alloc/register-alloc.hpp"
+#include "lib/lib.hpp"
+#include "profile/profile.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// 'ax' takes dropped values and 'ex' is the frame register (see codegen.cpp), others are given to variables
+static const Registers AllocatableRegisters[] = {Registers::bx, Registers::cx, Registers::dx, Registers::fx};
+static const size_t    AllocatableQuant       = sizeof(AllocatableRegisters) / sizeof(*AllocatableRegisters);
+
+static const size_t    RegisterMaxLoopDepth   = 6;
+static const size_t    RegisterDefaultCalls   = 16;
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void   IntervalsReset     (RegisterAlloc* alloc);
+static void   LiveArgs           (RegisterAlloc* alloc, const Node_t* node);
+static void   LiveStatements     (RegisterAlloc* alloc, const Node_t* node);
+static void   LiveStatement      (RegisterAlloc* alloc, const Node_t* node);
+static void   LiveLoop           (RegisterAlloc* alloc, const Node_t* condition, const Node_t* body, const Node_t* step);
+static void   LiveExpression     (RegisterAlloc* alloc, const Node_t* node);
+static void   LiveName           (RegisterAlloc* alloc, const Node_t* node);
+static void   LiveCall           (RegisterAlloc* alloc);
+static void   LiveTailCall       (RegisterAlloc* alloc, const Node_t* call);
+static bool   HasTailCall        (const Node_t* node, NameId function);
+static void   CoverLoop          (RegisterAlloc* alloc, size_t loop_start);
+static size_t GetLoopWeight      (size_t loop_depth);
+
+static void   CountCallsCost     (RegisterAlloc* alloc);
+static void   LinearScan         (RegisterAlloc* alloc);
+static size_t GetBenefit         (const RegisterInterval* interval);
+static void   FillCallsSaved     (RegisterAlloc* alloc);
+static int    CompareIntervals   (const void* first, const void* second);
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// intervals array is seen by qsort comparator, it is set only while one function is sorted
+static const RegisterInterval* SortIntervals = nullptr;
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void RegisterAllocCtor(RegisterAlloc* alloc, size_t names_quant)
+{
+    assert(alloc);
+
+    *alloc = {};
+
+    alloc->names_quant    = names_quant;
+    alloc->registers      = (Registers*)        calloc(names_quant + 1, sizeof(*alloc->registers));
+    alloc->intervals      = (RegisterInterval*) calloc(names_quant + 1, sizeof(*alloc->intervals));
+    alloc->vars           = (NameId*)           calloc(names_quant + 1, sizeof(*alloc->vars));
+    alloc->candidates     = (NameId*)           calloc(names_quant + 1, sizeof(*alloc->candidates));
+    alloc->calls_capacity = RegisterDefaultCalls;
+    alloc->calls          = (RegisterCall*)     calloc(alloc->calls_capacity, sizeof(*alloc->calls));
+
+    if (!alloc->registers || !alloc->intervals || !alloc->vars || !alloc->candidates || !alloc->calls)
+        EXIT(EXIT_FAILURE, "failed calloc memory for register allocator.");
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void RegisterAllocDtor(RegisterAlloc* alloc)
+{
+    assert(alloc);
+
+    FREE(alloc->registers);
+    FREE(alloc->intervals);
+    FREE(alloc->vars);
+    FREE(alloc->candidates);
+    FREE(alloc->calls);
+
+    *alloc = {};
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// positions are given in the same order as codegen.cpp emits code of the function,
+// name - name node of the function: arguments in left, body in right
+void AllocateRegisters(RegisterAlloc* alloc, const Node_t* name)
+{
+    assert(alloc);
+    assert(name);
+
+    IntervalsReset(alloc);
+
+    alloc->function = name->data.name.id;
+    alloc->args     = name->left;
+
+    LiveArgs(alloc, name->left);
+
+    if (HasTailCall(name->right, alloc->function))
+        LiveLoop(alloc, nullptr, name->right, nullptr);
+    else
+        LiveStatements(alloc, name->right);
+
+    CountCallsCost(alloc);
+    LinearScan    (alloc);
+    FillCallsSaved(alloc);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+const Node_t* GetTailCall(const Node_t* ret, NameId function)
+{
+    assert(ret);
+
+    const Node_t* value = ret->left;
+
+    if (!value || value->type != NodeArgType::initialisation || value->data.init != Initialisation::call_function)
+        return nullptr;
+
+    return (value->left->data.name.id == function) ? value : nullptr;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void IntervalsReset(RegisterAlloc* alloc)
+{
+    assert(alloc);
+
+    for (size_t i = 0; i <= alloc->names_quant; i++)
+        alloc->registers[i] = Registers::REGISTERS_QUANT;
+
+    memset(alloc->intervals, 0, (alloc->names_quant + 1) * sizeof(*alloc->intervals));
+
+    alloc->vars_quant       = 0;
+    alloc->candidates_quant = 0;
+    alloc->calls_quant      = 0;
+    alloc->position         = 0;
+    alloc->loop_depth       = 0;
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// arguments are popped from the stack in the function prologue, it is their first name,
+// they are numbered in the pop order of GenPopArgs() (the last one first), else an argument
+// that dies at once may get the register of an argument popped before it
+static void LiveArgs(RegisterAlloc* alloc, const Node_t* node)
+{
+    assert(alloc);
+
+    if (!node) return;
+
+    if (node->type == NodeArgType::connect)
+    {
+        LiveArgs(alloc, node->right);
+        LiveArgs(alloc, node->left);
+        return;
+    }
+
+    LiveName(alloc, node->left);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void LiveStatements(RegisterAlloc* alloc, const Node_t* node)
+{
+    assert(alloc);
+
+    if (!node) return;
+
+    if (node->type == NodeArgType::connect)
+    {
+        LiveStatements(alloc, node->left);
+        LiveStatements(alloc, node->right);
+        return;
+    }
+
+    LiveStatement(alloc, node);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void LiveStatement(RegisterAlloc* alloc, const Node_t* node)
+{
+    assert(alloc);
+    assert(node);
+
+    NodeArgType type = node->type;
+
+    if (type == NodeArgType::condition)
+    {
+        if (node->data.condition != Condition::else_t)
+            LiveExpression(alloc, node->left);
+
+        LiveStatements(alloc, node->right);
+        return;
+    }
+
+    if (type == NodeArgType::cycle && node->data.cycle == Cycle::while_t)
+        return LiveLoop(alloc, node->left, node->right, nullptr);
+
+    // for node: left = connect(connect(init, condition), step), right = body
+    if (type == NodeArgType::cycle && node->data.cycle == Cycle::for_t)
+    {
+        LiveStatements(alloc, node->left->left->left);
+        LiveLoop      (alloc, node->left->left->right, node->right, node->left->right);
+        return;
+    }
+
+    if (type == NodeArgType::attribute && node->data.attribute == FunctionAttribute::ret)
+    {
+        const Node_t* tail_call = GetTailCall(node, alloc->function);
+
+        if (tail_call)
+            return LiveTailCall(alloc, tail_call);
+
+        return LiveExpression(alloc, node->left);
+    }
+
+    if (type == NodeArgType::dfunction && node->data.function == DFunction::print)
+        return LiveName(alloc, node->left);
+
+    if (type == NodeArgType::initialisation && node->data.init == Initialisation::def_variable)
+    {
+        LiveExpression(alloc, node->right);
+        LiveName      (alloc, node->left->left);
+        return;
+    }
+
+    LiveExpression(alloc, node);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void LiveLoop(RegisterAlloc* alloc, const Node_t* condition, const Node_t* body, const Node_t* step)
+{
+    assert(alloc);
+
+    // loop start and end are positions of their own, so a call at the loop head is inside the covered intervals
+    size_t loop_start = alloc->position++;
+
+    alloc->loop_depth++;
+
+    LiveExpression(alloc, condition);
+    LiveStatements(alloc, body);
+    LiveStatements(alloc, step);
+
+    alloc->loop_depth--;
+
+    CoverLoop(alloc, loop_start);
+    alloc->position++;
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void LiveExpression(RegisterAlloc* alloc, const Node_t* node)
+{
+    assert(alloc);
+
+    if (!node) return;
+
+    if (node->type == NodeArgType::name)
+        return LiveName(alloc, node);
+
+    if (node->type == NodeArgType::initialisation && node->data.init == Initialisation::call_function)
+    {
+        LiveExpression(alloc, node->left->left);
+        LiveCall      (alloc);
+        return;
+    }
+
+    if (node->type == NodeArgType::initialisation && node->data.init == Initialisation::assign_variable)
+    {
+        LiveExpression(alloc, node->right);
+        LiveName      (alloc, node->left);
+        return;
+    }
+
+    LiveExpression(alloc, node->left);
+    LiveExpression(alloc, node->right);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void LiveName(RegisterAlloc* alloc, const Node_t* node)
+{
+    assert(alloc);
+
+    if (!node || node->type != NodeArgType::name)
+        EXIT(EXIT_FAILURE, "here must be node with type 'name'");
+
+    NameId id = node->data.name.id;
+
+    assert(id != NameNoId);
+    assert(id <= alloc->names_quant);
+
+    RegisterInterval* interval = &alloc->intervals[id];
+
+    if (!interval->is_met)
+    {
+        interval->is_met = true;
+        interval->first  = alloc->position;
+
+        alloc->vars[alloc->vars_quant] = id;
+        alloc->vars_quant++;
+    }
+
+    interval->last    = alloc->position;
+    interval->weight += GetLoopWeight(alloc->loop_depth);
+
+    alloc->position++;
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void LiveCall(RegisterAlloc* alloc)
+{
+    assert(alloc);
+
+    if (alloc->calls_quant == alloc->calls_capacity)
+    {
+        alloc->calls_capacity *= 2;
+        alloc->calls           = (RegisterCall*) realloc(alloc->calls, alloc->calls_capacity * sizeof(*alloc->calls));
+        if (!alloc->calls)
+            EXIT(EXIT_FAILURE, "failed realloc memory for register allocator calls.");
+    }
+
+    RegisterCall* call = &alloc->calls[alloc->calls_quant];
+
+    call->position = alloc->position;
+    call->weight   = GetLoopWeight(alloc->loop_depth);
+
+    alloc->calls_quant++;
+    alloc->position++;
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// arguments are evaluated and popped to the parameters, as in the function prologue
+static void LiveTailCall(RegisterAlloc* alloc, const Node_t* call)
+{
+    assert(alloc);
+    assert(call);
+
+    LiveExpression(alloc, call->left->left);
+    LiveArgs      (alloc, alloc->args);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static bool HasTailCall(const Node_t* node, NameId function)
+{
+    if (!node) return false;
+
+    if (node->type == NodeArgType::attribute && node->data.attribute == FunctionAttribute::ret)
+        return GetTailCall(node, function) != nullptr;
+
+    return HasTailCall(node->left, function) || HasTailCall(node->right, function);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void CoverLoop(RegisterAlloc* alloc, size_t loop_start)
+{
+    assert(alloc);
+
+    size_t loop_end = alloc->position;
+
+    for (size_t i = 0; i < alloc->vars_quant; i++)
+    {
+        RegisterInterval* interval = &alloc->intervals[alloc->vars[i]];
+
+        if (interval->last < loop_start)
+            continue;
+
+        if (interval->first > loop_start) interval->first = loop_start;
+        if (interval->last  < loop_end)   interval->last  = loop_end;
+    }
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static size_t GetLoopWeight(size_t loop_depth)
+{
+    size_t weight = 1;
+
+    for (size_t i = 0; i < loop_depth && i < RegisterMaxLoopDepth; i++)
+        weight *= RegisterLoopWeight;
+
+    return weight;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// value in a register is needed after the call, when the call is strictly inside the interval:
+// it is saved to the frame slot before the call and loaded back after it
+static void CountCallsCost(RegisterAlloc* alloc)
+{
+    assert(alloc);
+
+    for (size_t i = 0; i < alloc->vars_quant; i++)
+    {
+        RegisterInterval* interval = &alloc->intervals[alloc->vars[i]];
+
+        for (size_t call_i = 0; call_i < alloc->calls_quant; call_i++)
+        {
+            const RegisterCall* call = &alloc->calls[call_i];
+
+            if (interval->first < call->position && call->position < interval->last)
+                interval->calls_cost += 2 * call->weight;
+        }
+    }
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void LinearScan(RegisterAlloc* alloc)
+{
+    assert(alloc);
+
+    // variables that lose on saves are not taken at all, others are sorted by interval start
+    for (size_t i = 0; i < alloc->vars_quant; i++)
+    {
+        if (GetBenefit(&alloc->intervals[alloc->vars[i]]) > 0)
+            alloc->candidates[alloc->candidates_quant++] = alloc->vars[i];
+    }
+
+    SortIntervals = alloc->intervals;
+    qsort(alloc->candidates, alloc->candidates_quant, sizeof(*alloc->candidates), CompareIntervals);
+    SortIntervals = nullptr;
+
+    NameId active[AllocatableQuant] = {}; // by allocatable register index, NameNoId - register is free
+
+    size_t given   = 0;
+    size_t spilled = 0;
+
+    for (size_t i = 0; i < alloc->candidates_quant; i++)
+    {
+        NameId                  id       = alloc->candidates[i];
+        const RegisterInterval* interval = &alloc->intervals[id];
+
+        size_t free_reg  = AllocatableQuant;
+        size_t light_reg = AllocatableQuant;
+
+        for (size_t reg = 0; reg < AllocatableQuant; reg++)
+        {
+            if (active[reg] != NameNoId && alloc->intervals[active[reg]].last < interval->first)
+                active[reg] = NameNoId;
+
+            if (active[reg] == NameNoId)
+            {
+                free_reg = reg;
+                continue;
+            }
+
+            if (light_reg == AllocatableQuant || GetBenefit(&alloc->intervals[active[reg]]) < GetBenefit(&alloc->intervals[active[light_reg]]))
+                light_reg = reg;
+        }
+
+        if (free_reg == AllocatableQuant)
+        {
+            spilled++;
+
+            if (GetBenefit(&alloc->intervals[active[light_reg]]) >= GetBenefit(interval))
+                continue;
+
+            alloc->registers[active[light_reg]] = Registers::REGISTERS_QUANT;
+            free_reg = light_reg;
+            given--;
+        }
+
+        active[free_reg]     = id;
+        alloc->registers[id] = AllocatableRegisters[free_reg];
+        given++;
+    }
+
+    PROFILE_COUNT("register variables", given);
+    PROFILE_COUNT("spilled variables",  spilled + (alloc->vars_quant - alloc->candidates_quant));
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static size_t GetBenefit(const RegisterInterval* interval)
+{
+    assert(interval);
+
+    return (interval->weight > interval->calls_cost) ? interval->weight - interval->calls_cost : 0;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void FillCallsSaved(RegisterAlloc* alloc)
+{
+    assert(alloc);
+
+    for (size_t call_i = 0; call_i < alloc->calls_quant; call_i++)
+    {
+        RegisterCall* call = &alloc->calls[call_i];
+
+        for (size_t reg = 0; reg < Registers::REGISTERS_QUANT; reg++)
+            call->saved[reg] = NameNoId;
+
+        for (size_t i = 0; i < alloc->candidates_quant; i++)
+        {
+            NameId                  id       = alloc->candidates[i];
+            const RegisterInterval* interval = &alloc->intervals[id];
+            Registers               reg      = alloc->registers[id];
+
+            if (reg == Registers::REGISTERS_QUANT)
+                continue;
+
+            if (interval->first < call->position && call->position < interval->last)
+                call->saved[reg] = id;
+        }
+    }
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static int CompareIntervals(const void* first, const void* second)
+{
+    assert(first);
+    assert(second);
+    assert(SortIntervals);
+
+    const RegisterInterval* first_interval  = &SortIntervals[*(const NameId*) first];
+    const RegisterInterval* second_interval = &SortIntervals[*(const NameId*) second];
+
+    if (first_interval->first == second_interval->first)
+        return 0;
+
+    return (first_interval->first < second_interval->first) ? -1 : 1;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -1,12 +1,14 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <limits.h>
+#include <string.h>
 #include <SFML/Graphics.hpp>
 #include <assert.h>
 #include "processor/processor.hpp"
 #include "stack/stack.hpp"
 #include "common/globalInclude.hpp"
 #include "lib/lib.hpp"
+#include "profile/profile.hpp"
 
 #ifdef _DEBUG
 #include "log/log.hpp"
@@ -36,6 +38,7 @@ struct SPU
     Stack_t      stack;
     StackElem_t  registers[REGISTERS_QUANT];
     RAM          ram;
+    size_t       executed;      // commands run by ExecuteCommands
 };
 
 //--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -44,10 +47,15 @@ static ProcessorErr   Verif                      (SPU* spu, ProcessorErr* err,
 static void           PrintError                 (          ProcessorErr* err);
 
 static ProcessorErr   SpuCtor                    (SPU* spu, const IOfile* file);
+static ProcessorErr   SpuStateCtor               (SPU* spu);
 static ProcessorErr   SpuDtor                    (SPU* spu);
 static ProcessorErr   ExecuteCommands            (SPU* spu);
+ON_PROFILE(
+static const char*    GetCmdName                 (size_t cmd);
+)
 
 static ProcessorErr   CodeCtor                   (SPU* spu, const IOfile* file);
+static ProcessorErr   CodeCopyCtor               (SPU* spu, const CodeArr* code);
 static ProcessorErr   ReadCodeFromFile           (SPU* spu, FILE* codeFilePtr);
 
 
@@ -155,6 +163,25 @@ void RunProcessor(const IOfile* file)
 
 //--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
+size_t RunCode(const CodeArr* code)
+{
+    assert(code);
+    assert(code->code);
+
+    SPU spu = {};
+    PROCESSOR_ASSERT(CodeCopyCtor   (&spu, code));
+    PROCESSOR_ASSERT(SpuStateCtor   (&spu));
+    PROCESSOR_ASSERT(ExecuteCommands(&spu));
+
+    size_t executed = spu.executed;
+
+    PROCESSOR_ASSERT(SpuDtor(&spu));
+
+    return executed;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
 static ProcessorErr SpuCtor(SPU* spu, const IOfile* file)
 {
     assert(spu);
@@ -162,7 +189,19 @@ static ProcessorErr SpuCtor(SPU* spu, const IOfile* file)
 
     ProcessorErr  err = {};
 
-    PROCESSOR_ASSERT(CodeCtor(spu, file));
+    PROCESSOR_ASSERT(CodeCtor    (spu, file));
+    PROCESSOR_ASSERT(SpuStateCtor(spu));
+
+    return PROCESSOR_VERIF(spu, err);
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static ProcessorErr SpuStateCtor(SPU* spu)
+{
+    assert(spu);
+
+    ProcessorErr  err = {};
 
     spu->ip = 0;
 
@@ -216,8 +255,13 @@ static ProcessorErr ExecuteCommands(SPU* spu)
     // LOG_PRINT(Green, "We are in processor\n");
     // )
 
+    PROFILE_SCOPE("ExecuteCommands");
+
     while (GetIp(spu) < GetCodeSize(spu))
     {
+        PROFILE_COUNT_AT("spu cmd", (size_t) GetCodeElem(spu), Cmd::CMD_QUANT, GetCmdName);
+        spu->executed++;
+
         switch (GetCodeElem(spu))
         {
             case Cmd::push:  PROCESSOR_ASSERT(HandlePush (spu)); break;
@@ -262,6 +306,17 @@ static ProcessorErr ExecuteCommands(SPU* spu)
 
 //--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
+ON_PROFILE(
+static const char* GetCmdName(size_t cmd)
+{
+    assert(cmd < CmdInfoArrSize);
+
+    return CmdInfoArr[cmd].name;
+}
+)
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
 static ProcessorErr HandlePush(SPU* spu)
 {
     ON_PROCESSOR_DEBUG(WhereProcessorIs("push"));
@@ -273,6 +328,8 @@ static ProcessorErr HandlePush(SPU* spu)
     int      PushTypeInt = GetNextCodeElem(spu);
     PushType Push        = GetPushType(PushTypeInt);
 
+    PROFILE_COUNT("spu push memory", Push.mem);
+
     StackElem_t PushElem = 0;
 
     if      (Push.stk == 1 && Push.reg == 0 && Push.mem == 0 && Push.sum == 0) PushElem = GetPushPopArg           (spu);
@@ -307,6 +364,8 @@ static ProcessorErr HandlePop(SPU* spu)
     PopType Pop = {};
     Pop = GetPopType(PopTypeInt);
 
+    PROFILE_COUNT("spu pop memory", Pop.mem);
+
     StackElem_t PopElem = 0;
     STACK_ASSERT(StackPop(&spu->stack, &PopElem));
 
@@ -1114,6 +1173,30 @@ static ProcessorErr CodeCtor(SPU* spu, const IOfile* file)
 
 //--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
+static ProcessorErr CodeCopyCtor(SPU* spu, const CodeArr* code)
+{
+    assert(spu);
+    assert(code);
+    assert(code->code);
+
+    ProcessorErr err = {};
+
+    spu->code.size = code->size;
+    spu->code.code = (int*) calloc(code->size, sizeof(int));
+
+    if (!spu->code.code)
+    {
+        err.err = ProcessorErrorType::SPU_CODE_CALLOC_NULL;
+        return PROCESSOR_VERIF(spu, err);
+    }
+
+    memcpy(spu->code.code, code->code, code->size * sizeof(int));
+
+    return PROCESSOR_VERIF(spu, err);
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
 static ProcessorErr Verif(SPU* spu, ProcessorErr* err,  const char* file, int line, const char* func)
 {
     assert(spu);
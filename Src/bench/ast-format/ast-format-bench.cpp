@@ -0,0 +1,186 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <sys/stat.h>
+#include "lib/lib.hpp"
+#include "tree/tree.hpp"
+#include "read-tree/file-read/file-read.hpp"
+#include "read-tree/tokens/tokens.hpp"
+#include "read-tree/recursive-descent/recursive-descent.hpp"
+#include "tree/read-write-tree/write-tree/write-tree.hpp"
+#include "tree/read-write-tree/read-tree/read-tree.hpp"
+#include "name-table/interner/interner.hpp"
+#include "bench-lib/bench-lib.hpp"
+
+#ifdef _DEBUG
+#include "log/log.hpp"
+#endif // _DEBUG
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// text vs binary AST: write time, read time and file size of both formats.
+// Trees read back from both files are printed as text again, it must give the same text file.
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static const char* const text_ast_file   = "/tmp/ast-format-bench.ast";
+static const char* const binary_ast_file = "/tmp/ast-format-bench.bin";
+static const char* const round_trip_file = "/tmp/ast-format-bench-round-trip.ast";
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void   CheckRoundTrip (const Tree_t* read, size_t nodes_quant, const char* format_name);
+static size_t GetFileSize    (const char* file);
+static bool   FilesEqual     (const char* first, const char* second);
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+int main(int argc, const char* argv[])
+{
+    size_t functions_quant  = (argc > 1) ? (size_t) atol(argv[1]) : 2000;
+    size_t statements_quant = (argc > 2) ? (size_t) atol(argv[2]) : 50;
+    size_t repeats_quant    = (argc > 3) ? (size_t) atol(argv[3]) : 5;
+
+    ON_DEBUG(
+    LOG_OPEN(); // write-tree logs its steps in debug build
+    )
+
+    InputData input  = GenerateProgramm(functions_quant, statements_quant);
+    TokensArr tokens = ReadInputBuffer(&input);
+
+    Tree_t tree = {};
+    TreeCtor(&tree);
+    tree.root = GetTree(&tokens, &input, tree.arena);
+
+    size_t nodes_quant = tree.arena->nodes_quant;
+
+    double text_write   = 0, text_read   = 0;
+    double binary_write = 0, binary_read = 0;
+
+    for (size_t i = 0; i < repeats_quant; i++)
+    {
+        double start = GetTime();
+        PrintTree(&tree, text_ast_file, AstFormat::text);
+        text_write += GetTime() - start;
+
+        start = GetTime();
+        PrintTree(&tree, binary_ast_file, AstFormat::binary);
+        binary_write += GetTime() - start;
+
+        Tree_t text_tree = {};
+        TreeCtor(&text_tree);
+
+        start = GetTime();
+        ReadTree(&text_tree, text_ast_file, AstFormat::text);
+        text_read += GetTime() - start;
+
+        Tree_t binary_tree = {};
+        TreeCtor(&binary_tree);
+
+        start = GetTime();
+        ReadTree(&binary_tree, binary_ast_file, AstFormat::binary);
+        binary_read += GetTime() - start;
+
+        if (i == 0)
+        {
+            CheckRoundTrip(&text_tree,   nodes_quant, "text"  );
+            CheckRoundTrip(&binary_tree, nodes_quant, "binary");
+        }
+
+        TreeDtor(&text_tree);
+        TreeDtor(&binary_tree);
+    }
+
+    printf("%lu nodes, %lu repeats, round trip ok\n\n", nodes_quant, repeats_quant);
+    printf("%-8s %14s %14s %14s\n", "format", "write, ms", "read, ms", "size, KB");
+    printf("%-8s %14.3lf %14.3lf %14lu\n", "text",   text_write   * 1e3 / (double) repeats_quant,
+                                                     text_read    * 1e3 / (double) repeats_quant,
+                                                     GetFileSize(text_ast_file)   / 1024);
+    printf("%-8s %14.3lf %14.3lf %14lu\n", "binary", binary_write * 1e3 / (double) repeats_quant,
+                                                     binary_read  * 1e3 / (double) repeats_quant,
+                                                     GetFileSize(binary_ast_file) / 1024);
+
+    remove(text_ast_file);
+    remove(binary_ast_file);
+    remove(round_trip_file);
+
+    TreeDtor     (&tree);
+    TokenDtor    (&tokens);
+    InputDataDtor(&input);
+    InternerDtor ();
+
+    ON_DEBUG(
+    LOG_CLOSE();
+    )
+
+    return EXIT_SUCCESS;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void CheckRoundTrip(const Tree_t* read, size_t nodes_quant, const char* format_name)
+{
+    assert(read);
+    assert(format_name);
+
+    if (read->arena->nodes_quant != nodes_quant)
+        EXIT(EXIT_FAILURE, "%s round trip: %lu nodes read, %lu written", format_name, read->arena->nodes_quant, nodes_quant);
+
+    PrintTree(read, round_trip_file, AstFormat::text);
+
+    if (!FilesEqual(text_ast_file, round_trip_file))
+        EXIT(EXIT_FAILURE, "%s round trip changed the tree: '%s' != '%s'", format_name, text_ast_file, round_trip_file);
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static size_t GetFileSize(const char* file)
+{
+    assert(file);
+
+    struct stat file_info = {};
+
+    if (stat(file, &file_info) != 0)
+        EXIT(EXIT_FAILURE, "failed get size of '%s'", file);
+
+    return (size_t) file_info.st_size;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static bool FilesEqual(const char* first, const char* second)
+{
+    assert(first);
+    assert(second);
+
+    size_t size = GetFileSize(first);
+
+    if (size != GetFileSize(second))
+        return false;
+
+    char* first_data  = (char*) calloc(size + 1, sizeof(char));
+    char* second_data = (char*) calloc(size + 1, sizeof(char));
+
+    FILE* first_file  = fopen(first,  "rb");
+    FILE* second_file = fopen(second, "rb");
+
+    if (!first_data || !second_data || !first_file || !second_file)
+        EXIT(EXIT_FAILURE, "failed open '%s' and '%s' for compare", first, second);
+
+    size_t first_read  = fread(first_data,  sizeof(char), size, first_file);
+    size_t second_read = fread(second_data, sizeof(char), size, second_file);
+
+    bool equal = (first_read == size) && (second_read == size) && (memcmp(first_data, second_data, size) == 0);
+
+    fclose(first_file);
+    fclose(second_file);
+    free(first_data);
+    free(second_data);
+
+    return equal;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,176 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <assert.h>
+#include "lib/lib.hpp"
+#include "read-tree/file-read/file-read.hpp"
+#include "bench-lib/bench-lib.hpp"
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+InputData GenerateProgramm(size_t functions_quant, size_t statements_quant)
+{
+    static const size_t MaxStatementLen = 64;
+
+    size_t capacity = (functions_quant * (statements_quant + 4) + 8) * MaxStatementLen;
+    char*  buffer   = (char*) calloc(capacity, sizeof(char));
+
+    if (!buffer)
+        EXIT(EXIT_FAILURE, "failed calloc memory for generated programm.");
+
+    size_t size = 0;
+
+    for (size_t f = 0; f < functions_quant; f++)
+    {
+        size += (size_t) sprintf(buffer + size, "int f%lu(int a, int b)\n{\n", f);
+
+        for (size_t s = 0; s < statements_quant; s++)
+            size += (size_t) sprintf(buffer + size, "    int v%lu = a + %lu * (b - %lu) / 3;\n", s, s + 1, s);
+
+        size += (size_t) sprintf(buffer + size, "    return v0 + a;\n}\n\n");
+    }
+
+    InputData input   = {};
+    input.inputStream = "generated";
+    input.buffer      = buffer;
+    input.size        = size;
+
+    return input;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// every statement is one long expression: names, numbers, brackets and calls
+// joined with all binary operations, the parser spends its time in expressions
+InputData GenerateExpressionsProgramm(size_t functions_quant, size_t statements_quant, size_t operands_quant)
+{
+    static const size_t MaxOperandLen = 32;
+
+    static const char* const Operations[] = {" + ", " * ", " - ", " / ", " < ", " + ", " == ", " * ", " and ", " - ", " or "};
+    static const size_t OperationsQuant   = sizeof(Operations) / sizeof(Operations[0]);
+
+    size_t capacity = (functions_quant * statements_quant * (operands_quant + 1) + functions_quant * 4 + 8) * MaxOperandLen;
+    char*  buffer   = (char*) calloc(capacity, sizeof(char));
+
+    if (!buffer)
+        EXIT(EXIT_FAILURE, "failed calloc memory for generated programm.");
+
+    size_t size = 0;
+
+    for (size_t f = 0; f < functions_quant; f++)
+    {
+        size += (size_t) sprintf(buffer + size, "int f%lu(int a, int b)\n{\n", f);
+
+        for (size_t s = 0; s < statements_quant; s++)
+        {
+            size += (size_t) sprintf(buffer + size, "    int v%lu = ", s);
+
+            for (size_t o = 0; o < operands_quant; o++)
+            {
+                if (o > 0)
+                    size += (size_t) sprintf(buffer + size, "%s", Operations[(s + o) % OperationsQuant]);
+
+                switch ((s + o) % 5)
+                {
+                    case 0:  size += (size_t) sprintf(buffer + size, "a");                    break;
+                    case 1:  size += (size_t) sprintf(buffer + size, "%lu", o + 1);           break;
+                    case 2:  size += (size_t) sprintf(buffer + size, "(b - %lu * a)", o);     break;
+                    case 3:  size += (size_t) sprintf(buffer + size, "f%lu(a, b + %lu)", f, o); break;
+                    default: size += (size_t) sprintf(buffer + size, "b");                    break;
+                }
+            }
+
+            size += (size_t) sprintf(buffer + size, ";\n");
+        }
+
+        size += (size_t) sprintf(buffer + size, "    return v0 + a;\n}\n\n");
+    }
+
+    InputData input   = {};
+    input.inputStream = "generated";
+    input.buffer      = buffer;
+    input.size        = size;
+
+    return input;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// every function has all statement kinds the front-end knows: many variables, nested loops,
+// if / else if / else, expression of 'depth' nested brackets and call of the previous function,
+// 'main' calls the last function, so the programm goes through the code generator too
+InputData GenerateMixedProgramm(size_t functions_quant, size_t variables_quant, size_t depth, size_t loops_quant)
+{
+    static const size_t MaxStatementLen = 256;
+    static const size_t MaxDepthLen     = 24;
+
+    assert(variables_quant > 0);
+
+    size_t capacity = functions_quant * ((variables_quant + 4 * loops_quant + 16) * MaxStatementLen + depth * MaxDepthLen) + MaxStatementLen;
+    char*  buffer   = (char*) calloc(capacity, sizeof(char));
+
+    if (!buffer)
+        EXIT(EXIT_FAILURE, "failed calloc memory for generated programm.");
+
+    size_t size = 0;
+
+    for (size_t f = 0; f < functions_quant; f++)
+    {
+        size += (size_t) sprintf(buffer + size, "int f%lu(int a, int b)\n{\n", f);
+
+        for (size_t v = 0; v < variables_quant; v++)
+            size += (size_t) sprintf(buffer + size, "    int v%lu = a * %lu + b;\n", v, v + 1);
+
+        for (size_t l = 0; l < loops_quant; l++)
+        {
+            size_t v = l % variables_quant;
+
+            size += (size_t) sprintf(buffer + size, "    for (int i = 0; i < %lu; i = i + 1)\n    {\n", 1000 + l);
+            size += (size_t) sprintf(buffer + size, "        v%lu = v%lu + i * a - b / (i + 1);\n", v, v);
+            size += (size_t) sprintf(buffer + size, "        while (v%lu > 100) { v%lu = v%lu - 7; }\n    }\n", v, v, v);
+        }
+
+        size += (size_t) sprintf(buffer + size, "    if (a > b) { a = a - b; }\n"
+                                                "    else if (a < b) { b = b - a; }\n"
+                                                "    else { a = a + 1; }\n");
+
+        size += (size_t) sprintf(buffer + size, "    int deep = ");
+
+        for (size_t d = 0; d < depth; d++)
+            size += (size_t) sprintf(buffer + size, "(v%lu %s ", d % variables_quant, (d % 2) ? "*" : "+");
+
+        size += (size_t) sprintf(buffer + size, "1");
+
+        for (size_t d = 0; d < depth; d++)
+            size += (size_t) sprintf(buffer + size, ")");
+
+        size += (size_t) sprintf(buffer + size, ";\n");
+
+        if (f > 0)
+            size += (size_t) sprintf(buffer + size, "    deep = deep + f%lu(a, b - 1);\n", f - 1);
+
+        size += (size_t) sprintf(buffer + size, "    return deep;\n}\n\n");
+    }
+
+    if (functions_quant > 0)
+        size += (size_t) sprintf(buffer + size, "int main()\n{\n    return f%lu(1, 2);\n}\n", functions_quant - 1);
+
+    InputData input   = {};
+    input.inputStream = "generated";
+    input.buffer      = buffer;
+    input.size        = size;
+
+    return input;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+double GetTime()
+{
+    timespec time = {};
+    clock_gettime(CLOCK_MONOTONIC, &time);
+
+    return (double) time.tv_sec + (double) time.tv_nsec * 1e-9;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
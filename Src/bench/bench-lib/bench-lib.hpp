@@ -0,0 +1,18 @@
+#ifndef BENCH_LIB_HPP
+#define BENCH_LIB_HPP
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#include <stdio.h>
+#include "read-tree/file-read/file-read.hpp"
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+InputData GenerateProgramm            (size_t functions_quant, size_t statements_quant);
+InputData GenerateExpressionsProgramm (size_t functions_quant, size_t statements_quant, size_t operands_quant);
+InputData GenerateMixedProgramm       (size_t functions_quant, size_t variables_quant, size_t depth, size_t loops_quant);
+double    GetTime                     ();
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#endif // BENCH_LIB_HPP
@@ -0,0 +1,42 @@
+int poly(int x)
+{
+    return 3 * x ^ 3 - 2 * x ^ 2 + 7 * x - 5;
+}
+
+double mean(double a, double b, double c, double d)
+{
+    return (a + b + c + d) / 4;
+}
+
+int clamp(int x, int low, int high)
+{
+    if (x < low) { return low; }
+    else if (x > high) { return high; }
+    return x;
+}
+
+int sign(int x)
+{
+    if (x > 0) { return 1; } else if (x < 0) { return -1; } else { return 0; }
+    return 0;
+}
+
+int mix(int a, int b, int c)
+{
+    int x = (a + b) * (b - c) / (c * c + 1) - a * b * c + (a - (b - (c - a)));
+    int y = ((a * 2 + b * 3) * (c * 4 - a * 5) + (b * 6 - c * 7)) / (a * a + 1);
+    int z = not (a == b) and (b != c) or (a >= c) and (b <= a);
+    return x + y * z;
+}
+
+void main()
+{
+    int total = 0;
+    for (int i = -10; i < 10; i = i + 1)
+    {
+        total = total + clamp(poly(i), -100, 100) * sign(i);
+        total = total + mix(i, i + 1, i - 1);
+    }
+    double m = mean(1.5, 2.5, 3.5, 4.5);
+    return 0;
+}
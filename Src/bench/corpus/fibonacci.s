@@ -0,0 +1,37 @@
+int fib(int n)
+{
+    if (n < 2) { return n; }
+    return fib(n - 1) + fib(n - 2);
+}
+
+int fib_loop(int n)
+{
+    int prev = 0;
+    int cur  = 1;
+    for (int i = 0; i < n; i = i + 1)
+    {
+        int next = prev + cur;
+        prev = cur;
+        cur  = next;
+    }
+    return prev;
+}
+
+int fib_check(int n)
+{
+    int errors = 0;
+    for (int i = 0; i < n; i = i + 1)
+    {
+        if (fib(i) != fib_loop(i)) { errors = errors + 1; }
+    }
+    return errors;
+}
+
+void main()
+{
+    int n = 20;
+    int a = fib(n);
+    int b = fib_loop(n);
+    int errors = fib_check(15);
+    return 0;
+}
@@ -0,0 +1,57 @@
+int sum_range(int from, int to)
+{
+    int sum = 0;
+    for (int i = from; i < to; i = i + 1) { sum = sum + i; }
+    return sum;
+}
+
+int sum_squares(int n)
+{
+    int sum = 0;
+    int i = 0;
+    while (i <= n)
+    {
+        sum = sum + i * i;
+        i = i + 1;
+    }
+    return sum;
+}
+
+int dot_table(int n)
+{
+    int dot = 0;
+    for (int i = 0; i < n; i = i + 1)
+    {
+        for (int j = 0; j < 4; j = j + 1) { dot = dot + i * j; }
+    }
+    return dot;
+}
+
+int countdown(int n)
+{
+    int steps = 0;
+    int k = n;
+    while (k > 0)
+    {
+        steps = steps + k / 3;
+        k = k - 2;
+    }
+    return steps;
+}
+
+int polynom(int x)
+{
+    int value = 0;
+    for (int p = 0; p < 6; p = p + 1) { value = value * x + p; }
+    return value;
+}
+
+void main()
+{
+    int range   = sum_range(3, 500);
+    int squares = sum_squares(300);
+    int table   = dot_table(200);
+    int down    = countdown(777);
+    int value   = polynom(3);
+    return 0;
+}
@@ -0,0 +1,68 @@
+int is_prime(int n)
+{
+    if (n < 2) { return 0; }
+    for (int d = 2; d * d <= n; d = d + 1)
+    {
+        int q = n / d;
+        if (q * d == n) { return 0; }
+    }
+    return 1;
+}
+
+int count_primes(int limit)
+{
+    int count = 0;
+    int n = 2;
+    while (n < limit)
+    {
+        if (is_prime(n)) { count = count + 1; }
+        n = n + 1;
+    }
+    return count;
+}
+
+int gcd(int a, int b)
+{
+    while (b != 0)
+    {
+        int q = a / b;
+        int r = a - q * b;
+        a = b;
+        b = r;
+    }
+    return a;
+}
+
+int power(int base, int exp)
+{
+    int result = 1;
+    for (int i = 0; i < exp; i = i + 1) { result = result * base; }
+    return result;
+}
+
+int collatz(int n)
+{
+    int steps = 0;
+    while (n != 1)
+    {
+        int half = n / 2;
+        if (half * 2 == n) { n = half; }
+        else { n = 3 * n + 1; }
+        steps = steps + 1;
+    }
+    return steps;
+}
+
+void main()
+{
+    int count = count_primes(1000);
+    int divisor = gcd(1071, 462);
+    int p = power(3, 10);
+    int longest = 0;
+    for (int i = 1; i < 100; i = i + 1)
+    {
+        int steps = collatz(i);
+        if (steps > longest and i > 1 or longest == 0) { longest = steps; }
+    }
+    return 0;
+}
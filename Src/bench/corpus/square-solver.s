@@ -0,0 +1,64 @@
+double square(double x)
+{
+    return x * x;
+}
+
+double abs(double x)
+{
+    if (x < 0) { return -x; }
+    return x;
+}
+
+double sqrt(double x)
+{
+    if (x == 0) { return 0; }
+    double guess = x;
+    for (int i = 0; i < 30; i = i + 1)
+    {
+        guess = (guess + x / guess) / 2;
+    }
+    return guess;
+}
+
+int solve_linear(double b, double c)
+{
+    if (b == 0)
+    {
+        if (c == 0) { return -1; }
+        return 0;
+    }
+    double x = -c / b;
+    return 1;
+}
+
+int solve(double a, double b, double c)
+{
+    if (a == 0) { return solve_linear(b, c); }
+
+    double d = square(b) - 4 * a * c;
+
+    if (d < 0) { return 0; }
+    else if (d == 0)
+    {
+        double x = -b / (2 * a);
+        return 1;
+    }
+    else
+    {
+        double root = sqrt(d);
+        double x1 = (-b - root) / (2 * a);
+        double x2 = (-b + root) / (2 * a);
+        return 2;
+    }
+    return 0;
+}
+
+void main()
+{
+    int roots = solve(1, -3, 2);
+    roots = solve(1, 2, 1);
+    roots = solve(1, 0, 1);
+    roots = solve(0, 2, -4);
+    roots = solve(0, 0, 0);
+    return 0;
+}
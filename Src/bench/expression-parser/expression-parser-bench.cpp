@@ -0,0 +1,60 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "lib/lib.hpp"
+#include "tree/tree.hpp"
+#include "read-tree/file-read/file-read.hpp"
+#include "read-tree/tokens/tokens.hpp"
+#include "read-tree/recursive-descent/recursive-descent.hpp"
+#include "name-table/interner/interner.hpp"
+#include "bench-lib/bench-lib.hpp"
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// expression parsing benchmark: GetTree on a programm made of long expressions,
+// the time is dominated by the expression parser
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+int main(int argc, const char* argv[])
+{
+    size_t functions_quant  = (argc > 1) ? (size_t) atol(argv[1]) : 500;
+    size_t statements_quant = (argc > 2) ? (size_t) atol(argv[2]) : 20;
+    size_t operands_quant   = (argc > 3) ? (size_t) atol(argv[3]) : 40;
+    size_t repeats_quant    = (argc > 4) ? (size_t) atol(argv[4]) : 5;
+
+    InputData input  = GenerateExpressionsProgramm(functions_quant, statements_quant, operands_quant);
+    TokensArr tokens = ReadInputBuffer(&input);
+
+    double parse_time  = 0;
+    size_t nodes_quant = 0;
+
+    for (size_t i = 0; i < repeats_quant; i++)
+    {
+        Tree_t tree = {};
+        TreeCtor(&tree);
+
+        double start = GetTime();
+        tree.root    = GetTree(&tokens, &input, tree.arena);
+        parse_time  += GetTime() - start;
+
+        nodes_quant = tree.arena->nodes_quant;
+
+        TreeDtor(&tree);
+    }
+
+    printf("programm: %lu functions x %lu statements x %lu operands, %lu tokens, %lu nodes, %lu repeats\n\n",
+            functions_quant, statements_quant, operands_quant, tokens.size, nodes_quant, repeats_quant);
+
+    printf("%-12s %14s %14s\n", "parser", "parse, ms", "ns per token");
+    printf("%-12s %14.3lf %14.3lf\n", "expressions", parse_time * 1e3 / (double) repeats_quant,
+                                                     parse_time * 1e9 / (double) repeats_quant / (double) tokens.size);
+
+    TokenDtor    (&tokens);
+    InputDataDtor(&input);
+    InternerDtor ();
+
+    return EXIT_SUCCESS;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
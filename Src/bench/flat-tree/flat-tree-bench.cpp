@@ -0,0 +1,185 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "lib/lib.hpp"
+#include "tree/tree.hpp"
+#include "tree/flat-tree/flat-tree.hpp"
+#include "tree/read-write-tree/binary-tree/binary-tree.hpp"
+#include "read-tree/file-read/file-read.hpp"
+#include "read-tree/tokens/tokens.hpp"
+#include "read-tree/recursive-descent/recursive-descent.hpp"
+#include "bench-lib/bench-lib.hpp"
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// pointer tree vs flat tree: the same passes (verification, operation count, binary AST writing)
+// done recursively over Node_t and linearly over FlatTree, plus memory usage
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static size_t CountOperations     (const Node_t*   node);
+static size_t CountOperationsFlat (const FlatTree* flat);
+static size_t CountNodes          (const Node_t*   node);
+static bool   SameFiles           (const char*     first, const char* second);
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static const char* const TreeAstFile = "flat-tree-bench-tree.ast";
+static const char* const FlatAstFile = "flat-tree-bench-flat.ast";
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+int main(int argc, const char* argv[])
+{
+    size_t functions_quant  = (argc > 1) ? (size_t) atol(argv[1]) : 2000;
+    size_t statements_quant = (argc > 2) ? (size_t) atol(argv[2]) : 50;
+    size_t repeats_quant    = (argc > 3) ? (size_t) atol(argv[3]) : 5;
+
+    InputData input  = GenerateProgramm(functions_quant, statements_quant);
+    TokensArr tokens = ReadInputBuffer(&input);
+
+    Tree_t tree = {};
+    TreeCtor(&tree);
+    tree.root = GetTree(&tokens, &input, tree.arena);
+
+    double   start      = GetTime();
+    FlatTree flat       = FlatTreeCtor(&tree);
+    double   flat_ctor  = GetTime() - start;
+
+    Tree_t copy = {};
+    start = GetTime();
+    FlatTreeToTree(&flat, &copy);
+    double   flat_back  = GetTime() - start;
+
+    double tree_verif  = 0, flat_verif  = 0;
+    double tree_oper   = 0, flat_oper   = 0;
+    double tree_write  = 0, flat_write  = 0;
+    size_t tree_oper_quant = 0, flat_oper_quant = 0;
+
+    for (size_t i = 0; i < repeats_quant; i++)
+    {
+        TreeErr err = {};
+
+        start = GetTime();
+        TREE_ASSERT(TREE_VERIF(&tree, err));
+        tree_verif += GetTime() - start;
+
+        start = GetTime();
+        TREE_ASSERT(FLAT_TREE_VERIF(&flat, err));
+        flat_verif += GetTime() - start;
+
+        start = GetTime();
+        tree_oper_quant = CountOperations(tree.root);
+        tree_oper += GetTime() - start;
+
+        start = GetTime();
+        flat_oper_quant = CountOperationsFlat(&flat);
+        flat_oper += GetTime() - start;
+
+        start = GetTime();
+        PrintBinaryTree(&tree, TreeAstFile);
+        tree_write += GetTime() - start;
+
+        start = GetTime();
+        PrintBinaryFlatTree(&flat, FlatAstFile);
+        flat_write += GetTime() - start;
+    }
+
+    if (!SameFiles(TreeAstFile, FlatAstFile))
+        EXIT(EXIT_FAILURE, "'%s' and '%s' differ.", TreeAstFile, FlatAstFile);
+
+    remove(TreeAstFile);
+    remove(FlatAstFile);
+
+    assert(tree_oper_quant == flat_oper_quant);
+    assert(CountNodes(copy.root) == flat.size);
+
+    size_t nodes_quant = CountNodes(tree.root);
+
+    printf("%lu nodes, %lu repeats\n\n", nodes_quant, repeats_quant);
+    printf("%-8s %14s %14s %14s %14s\n", "tree", "verif, ms", "opers, ms", "write, ms", "memory, KB");
+    printf("%-8s %14.3lf %14.3lf %14.3lf %14lu\n", "Node_t"  , tree_verif * 1e3 / (double) repeats_quant, tree_oper * 1e3 / (double) repeats_quant, tree_write * 1e3 / (double) repeats_quant, nodes_quant * sizeof(Node_t) / 1024);
+    printf("%-8s %14.3lf %14.3lf %14.3lf %14lu\n", "FlatTree", flat_verif * 1e3 / (double) repeats_quant, flat_oper * 1e3 / (double) repeats_quant, flat_write * 1e3 / (double) repeats_quant, FlatTreeMemory(&flat)        / 1024);
+    printf("\nTree_t -> FlatTree: %.3lf ms, FlatTree -> Tree_t: %.3lf ms\n", flat_ctor * 1e3, flat_back * 1e3);
+
+    FlatTreeDtor (&flat);
+    TreeDtor     (&copy);
+    TreeDtor     (&tree);
+    TokenDtor    (&tokens);
+    InputDataDtor(&input);
+
+    return EXIT_SUCCESS;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static size_t CountOperations(const Node_t* node)
+{
+    if (!node)
+        return 0;
+
+    size_t quant = (node->type == NodeArgType::operation) ? 1 : 0;
+
+    return quant + CountOperations(node->left) + CountOperations(node->right);
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static size_t CountOperationsFlat(const FlatTree* flat)
+{
+    assert(flat);
+
+    size_t quant = 0;
+
+    for (size_t i = 0; i < flat->size; i++)
+        quant += (flat->kinds[i] == (uint8_t) NodeArgType::operation) ? 1 : 0;
+
+    return quant;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static size_t CountNodes(const Node_t* node)
+{
+    if (!node)
+        return 0;
+
+    return 1 + CountNodes(node->left) + CountNodes(node->right);
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static bool SameFiles(const char* first, const char* second)
+{
+    assert(first);
+    assert(second);
+
+    FILE* first_file  = fopen(first,  "rb");
+    FILE* second_file = fopen(second, "rb");
+
+    if (!first_file || !second_file)
+        EXIT(EXIT_FAILURE, "failed open '%s' or '%s'", first, second);
+
+    bool same = true;
+
+    while (same)
+    {
+        char   first_buffer [4096] = {};
+        char   second_buffer[4096] = {};
+        size_t first_size  = fread(first_buffer,  sizeof(char), sizeof(first_buffer ), first_file );
+        size_t second_size = fread(second_buffer, sizeof(char), sizeof(second_buffer), second_file);
+
+        same = (first_size == second_size) && (memcmp(first_buffer, second_buffer, first_size) == 0);
+
+        if (first_size == 0)
+            break;
+    }
+
+    fclose(first_file);
+    fclose(second_file);
+
+    return same;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
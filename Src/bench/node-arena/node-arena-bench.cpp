@@ -0,0 +1,96 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "lib/lib.hpp"
+#include "tree/tree.hpp"
+#include "read-tree/file-read/file-read.hpp"
+#include "read-tree/tokens/tokens.hpp"
+#include "read-tree/recursive-descent/recursive-descent.hpp"
+#include "bench-lib/bench-lib.hpp"
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// parse-and-destroy benchmark: GetTree + TreeDtor on a synthetic program,
+// once with plain calloc/free nodes and once with the tree node arena
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct BenchResult
+{
+    double parse_time;
+    double dtor_time;
+    size_t nodes_quant;
+};
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static BenchResult RunParseAndDtor  (const TokensArr* tokens, const InputData* input, bool use_arena, size_t repeats_quant);
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+int main(int argc, const char* argv[])
+{
+    size_t functions_quant  = (argc > 1) ? (size_t) atol(argv[1]) : 2000;
+    size_t statements_quant = (argc > 2) ? (size_t) atol(argv[2]) : 50;
+    size_t repeats_quant    = (argc > 3) ? (size_t) atol(argv[3]) : 5;
+
+    InputData input  = GenerateProgramm(functions_quant, statements_quant);
+    TokensArr tokens = ReadInputBuffer(&input);
+
+    printf("programm: %lu functions x %lu statements, %lu bytes, %lu tokens, %lu repeats\n\n",
+            functions_quant, statements_quant, input.size, tokens.size, repeats_quant);
+
+    BenchResult malloc_res = RunParseAndDtor(&tokens, &input, false, repeats_quant);
+    BenchResult arena_res  = RunParseAndDtor(&tokens, &input, true , repeats_quant);
+
+    printf("%-8s %14s %14s %14s\n", "nodes", "parse, ms", "dtor, ms", "total, ms");
+    printf("%-8s %14.3lf %14.3lf %14.3lf\n", "malloc", malloc_res.parse_time * 1e3, malloc_res.dtor_time * 1e3, (malloc_res.parse_time + malloc_res.dtor_time) * 1e3);
+    printf("%-8s %14.3lf %14.3lf %14.3lf\n", "arena" , arena_res .parse_time * 1e3, arena_res .dtor_time * 1e3, (arena_res .parse_time + arena_res .dtor_time) * 1e3);
+    printf("\n%lu nodes per tree\n", arena_res.nodes_quant);
+
+    TokenDtor    (&tokens);
+    InputDataDtor(&input);
+
+    return EXIT_SUCCESS;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static BenchResult RunParseAndDtor(const TokensArr* tokens, const InputData* input, bool use_arena, size_t repeats_quant)
+{
+    assert(tokens);
+    assert(input);
+
+    BenchResult res = {};
+
+    for (size_t i = 0; i < repeats_quant; i++)
+    {
+        Tree_t tree = {};
+
+        double start = GetTime();
+
+        if (use_arena)
+            TreeCtor(&tree);
+
+        tree.root = GetTree(tokens, input, tree.arena);
+
+        double middle = GetTime();
+
+        if (tree.arena)
+            res.nodes_quant = tree.arena->nodes_quant;
+
+        TreeDtor(&tree);
+
+        double end = GetTime();
+
+        res.parse_time += middle - start;
+        res.dtor_time  += end    - middle;
+    }
+
+    res.parse_time /= (double) repeats_quant;
+    res.dtor_time  /= (double) repeats_quant;
+
+    return res;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
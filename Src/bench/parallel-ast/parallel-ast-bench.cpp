@@ -0,0 +1,182 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "lib/lib.hpp"
+#include "tree/tree.hpp"
+#include "read-tree/file-read/file-read.hpp"
+#include "read-tree/tokens/tokens.hpp"
+#include "read-tree/recursive-descent/recursive-descent.hpp"
+#include "tree/read-write-tree/write-tree/write-tree.hpp"
+#include "tree/read-write-tree/read-tree/read-tree.hpp"
+#include "tree/read-write-tree/binary-tree/binary-tree.hpp"
+#include "name-table/interner/interner.hpp"
+#include "bench-lib/bench-lib.hpp"
+
+#ifdef _DEBUG
+#include "log/log.hpp"
+#endif // _DEBUG
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// binary AST write and read on 1, 2, 4, ... worker threads, the programm has thousands of functions.
+// File must not depend on workers quant, and the tree read back must be written to the same file.
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static const char* const reference_file  = "/tmp/parallel-ast-bench-reference.bin";
+static const char* const binary_ast_file = "/tmp/parallel-ast-bench.bin";
+static const char* const round_trip_file = "/tmp/parallel-ast-bench-round-trip.bin";
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static size_t GetFileSize (const char* file);
+static bool   FilesEqual  (const char* first, const char* second);
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+int main(int argc, const char* argv[])
+{
+    long   cores            = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t functions_quant  = (argc > 1) ? (size_t) atol(argv[1]) : 5000;
+    size_t statements_quant = (argc > 2) ? (size_t) atol(argv[2]) : 20;
+    size_t max_workers      = (argc > 3) ? (size_t) atol(argv[3]) : ((cores > 1) ? (size_t) cores : 1);
+    size_t repeats_quant    = (argc > 4) ? (size_t) atol(argv[4]) : 5;
+
+    ON_DEBUG(
+    LOG_OPEN(); // write-tree logs its steps in debug build
+    )
+
+    InputData input  = GenerateProgramm(functions_quant, statements_quant);
+    TokensArr tokens = ReadInputBuffer(&input);
+
+    Tree_t tree = {};
+    TreeCtor(&tree);
+    tree.root = GetTree(&tokens, &input, tree.arena);
+
+    size_t nodes_quant = tree.arena->nodes_quant;
+
+    SetBinaryTreeWorkersQuant(1);
+    PrintTree(&tree, reference_file, AstFormat::binary);
+
+    printf("%lu functions, %lu nodes, %lu KB, %ld cores, %lu repeats\n\n",
+           functions_quant, nodes_quant, GetFileSize(reference_file) / 1024, cores, repeats_quant);
+    printf("%-8s %14s %14s %14s %14s\n", "workers", "write, ms", "read, ms", "write speedup", "read speedup");
+
+    double one_worker_write = 0, one_worker_read = 0;
+
+    for (size_t workers_quant = 1; workers_quant <= max_workers; workers_quant *= 2)
+    {
+        SetBinaryTreeWorkersQuant(workers_quant);
+
+        double write_time = 0, read_time = 0;
+
+        for (size_t i = 0; i < repeats_quant; i++)
+        {
+            double start = GetTime();
+            PrintTree(&tree, binary_ast_file, AstFormat::binary);
+            write_time += GetTime() - start;
+
+            Tree_t read = {};
+            TreeCtor(&read);
+
+            start = GetTime();
+            ReadTree(&read, binary_ast_file, AstFormat::binary);
+            read_time += GetTime() - start;
+
+            if (i == 0)
+            {
+                PrintTree(&read, round_trip_file, AstFormat::binary);
+
+                if (read.arena->nodes_quant != nodes_quant)
+                    EXIT(EXIT_FAILURE, "%lu workers: %lu nodes read, %lu written", workers_quant, read.arena->nodes_quant, nodes_quant);
+
+                if (!FilesEqual(reference_file, binary_ast_file) || !FilesEqual(reference_file, round_trip_file))
+                    EXIT(EXIT_FAILURE, "%lu workers: binary AST differs from one worker AST", workers_quant);
+            }
+
+            TreeDtor(&read);
+        }
+
+        write_time /= (double) repeats_quant;
+        read_time  /= (double) repeats_quant;
+
+        if (workers_quant == 1)
+        {
+            one_worker_write = write_time;
+            one_worker_read  = read_time;
+        }
+
+        printf("%-8lu %14.3lf %14.3lf %14.2lf %14.2lf\n", workers_quant, write_time * 1e3, read_time * 1e3,
+                                                         one_worker_write / write_time, one_worker_read / read_time);
+    }
+
+    SetBinaryTreeWorkersQuant(0);
+
+    remove(reference_file);
+    remove(binary_ast_file);
+    remove(round_trip_file);
+
+    TreeDtor     (&tree);
+    TokenDtor    (&tokens);
+    InputDataDtor(&input);
+    InternerDtor ();
+
+    ON_DEBUG(
+    LOG_CLOSE();
+    )
+
+    return EXIT_SUCCESS;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static size_t GetFileSize(const char* file)
+{
+    assert(file);
+
+    struct stat file_info = {};
+
+    if (stat(file, &file_info) != 0)
+        EXIT(EXIT_FAILURE, "failed get size of '%s'", file);
+
+    return (size_t) file_info.st_size;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static bool FilesEqual(const char* first, const char* second)
+{
+    assert(first);
+    assert(second);
+
+    size_t size = GetFileSize(first);
+
+    if (size != GetFileSize(second))
+        return false;
+
+    char* first_data  = (char*) calloc(size + 1, sizeof(char));
+    char* second_data = (char*) calloc(size + 1, sizeof(char));
+
+    FILE* first_file  = fopen(first,  "rb");
+    FILE* second_file = fopen(second, "rb");
+
+    if (!first_data || !second_data || !first_file || !second_file)
+        EXIT(EXIT_FAILURE, "failed open '%s' and '%s' for compare", first, second);
+
+    size_t first_read  = fread(first_data,  sizeof(char), size, first_file);
+    size_t second_read = fread(second_data, sizeof(char), size, second_file);
+
+    bool equal = (first_read == size) && (second_read == size) && (memcmp(first_data, second_data, size) == 0);
+
+    fclose(first_file);
+    fclose(second_file);
+    free(first_data);
+    free(second_data);
+
+    return equal;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,353 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "lib/lib.hpp"
+#include "tree/tree.hpp"
+#include "read-tree/file-read/file-read.hpp"
+#include "read-tree/tokens/tokens.hpp"
+#include "read-tree/recursive-descent/recursive-descent.hpp"
+#include "tree/read-write-tree/write-tree/write-tree.hpp"
+#include "tree/read-write-tree/read-tree/read-tree.hpp"
+#include "name-table/interner/interner.hpp"
+#include "optimize/optimize.hpp"
+#include "codegen/codegen.hpp"
+#include "ir/ir-lower/ir-lower.hpp"
+#include "ir/ir-opt/ir-opt.hpp"
+#include "processor/processor.hpp"
+#include "bench-lib/bench-lib.hpp"
+
+#ifdef _DEBUG
+#include "log/log.hpp"
+#endif // _DEBUG
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// Every compiler stage timed alone on one generated programm, the result is JSON on stdout:
+//   {"programm": {...sizes...}, "repeats": R, "stages": [{"name", "ms", "mb_per_s", "tokens_per_s", "nodes_per_s"}, ...]}
+// Throughputs are in units of the source programm (its bytes, tokens and AST nodes), so stages are comparable.
+// RunCode runs optimized code on the processor and has only "spu_commands_per_s": loops of the generated programm
+// run 1000+ iterations with data dependent inner 'while', so it runs the same programm without loops.
+// Stages that can not run yet are reported with "ms": null and "skipped": reason, so the set of stages is stable.
+//
+// stages-bench [functions] [variables] [depth] [loops] [repeats]
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static const char* const programm_file   = "/tmp/stages-bench.s";
+static const char* const run_file        = "/tmp/stages-bench-run.s";
+static const char* const text_ast_file   = "/tmp/stages-bench.ast";
+static const char* const binary_ast_file = "/tmp/stages-bench.bin";
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+enum StageId
+{
+    ReadFileStage        ,
+    ReadInputBufferStage ,
+    GetTreeStage         ,
+    PrintTextTreeStage   ,
+    PrintBinaryTreeStage ,
+    ReadTextTreeStage    ,
+    ReadBinaryTreeStage  ,
+    OptimizeTreeStage    ,
+    GenerateCodeStage    ,
+    GenerateCachedStage  ,
+    LowerTreeStage       ,
+    OptimizeIrStage      ,
+    GenerateIrCodeStage  ,
+    RunCodeStage         ,
+    StagesQuant          ,
+};
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct Stage
+{
+    const char* name;
+    const char* skipped;    // nullptr - stage is timed
+    double      time;
+};
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct ProgrammSize
+{
+    size_t bytes;
+    size_t tokens;
+    size_t nodes;
+    size_t spu_commands;    // executed by RunCode on the programm from run_file
+};
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void    WriteProgramm (const InputData* input, const char* file);
+static CodeArr CompileRun    (const char* file);
+static void    RunStages     (Stage* stages, ProgrammSize* size);
+static void    PrintJson     (const Stage* stages, const ProgrammSize* size, size_t functions_quant, size_t repeats_quant);
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+int main(int argc, const char* argv[])
+{
+    size_t functions_quant = (argc > 1) ? (size_t) atol(argv[1]) : 500;
+    size_t variables_quant = (argc > 2) ? (size_t) atol(argv[2]) : 40;
+    size_t depth           = (argc > 3) ? (size_t) atol(argv[3]) : 64;
+    size_t loops_quant     = (argc > 4) ? (size_t) atol(argv[4]) : 8;
+    size_t repeats_quant   = (argc > 5) ? (size_t) atol(argv[5]) : 5;
+
+    ON_DEBUG(
+    LOG_OPEN(); // write-tree logs its steps in debug build
+    )
+
+    InputData input = GenerateMixedProgramm(functions_quant, variables_quant, depth, loops_quant);
+    WriteProgramm(&input, programm_file);
+    InputDataDtor(&input);
+
+    InputData run_input = GenerateMixedProgramm(functions_quant, variables_quant, depth, 0);
+    WriteProgramm(&run_input, run_file);
+    InputDataDtor(&run_input);
+
+    Stage stages[StagesQuant] =
+    {
+        {"ReadFile"            , nullptr, 0},
+        {"ReadInputBuffer"     , nullptr, 0},
+        {"GetTree"             , nullptr, 0},
+        {"PrintTree text"      , nullptr, 0},
+        {"PrintTree binary"    , nullptr, 0},
+        {"ReadTree text"       , nullptr, 0},
+        {"ReadTree binary"     , nullptr, 0},
+        {"OptimizeTree"        , nullptr, 0},
+        {"GenerateCode"        , nullptr, 0},
+        {"GenerateCode cached" , nullptr, 0},
+        {"LowerTree"           , nullptr, 0},
+        {"OptimizeIr"          , nullptr, 0},
+        {"GenerateIrCode"      , nullptr, 0},
+        {"RunCode"             , nullptr, 0},
+    };
+
+    ProgrammSize size = {};
+
+    for (size_t i = 0; i < repeats_quant; i++)
+        RunStages(stages, &size);
+
+    PrintJson(stages, &size, functions_quant, repeats_quant);
+
+    remove(programm_file);
+    remove(run_file);
+    remove(text_ast_file);
+    remove(binary_ast_file);
+
+    InternerDtor();
+
+    ON_DEBUG(
+    LOG_CLOSE();
+    )
+
+    return EXIT_SUCCESS;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void WriteProgramm(const InputData* input, const char* file)
+{
+    assert(input);
+    assert(file);
+
+    FILE* stream = fopen(file, "wb");
+    if (!stream)
+        EXIT(EXIT_FAILURE, "failed open '%s'", file);
+
+    if (fwrite(input->buffer, sizeof(char), input->size, stream) != input->size)
+        EXIT(EXIT_FAILURE, "failed write generated programm to '%s'", file);
+
+    fclose(stream);
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// optimized code of the programm in file, is not timed
+static CodeArr CompileRun(const char* file)
+{
+    assert(file);
+
+    InputData input  = ReadFile(file);
+    TokensArr tokens = ReadInputBuffer(&input);
+
+    Tree_t tree = {};
+    TreeCtor(&tree);
+
+    tree.root = GetTree(&tokens, &input, tree.arena);
+    OptimizeTree(&tree, &OptimizeDefaultOptions);
+
+    CodeArr code = {};
+    GenerateCode(&tree, &code);
+
+    TreeDtor     (&tree);
+    TokenDtor    (&tokens);
+    InputDataDtor(&input);
+
+    return code;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// one pass of all stages, every stage gets the output of the previous one
+static void RunStages(Stage* stages, ProgrammSize* size)
+{
+    assert(stages);
+    assert(size);
+
+    double start = GetTime();
+    InputData input = ReadFile(programm_file);
+    stages[ReadFileStage].time += GetTime() - start;
+
+    start = GetTime();
+    TokensArr tokens = ReadInputBuffer(&input);
+    stages[ReadInputBufferStage].time += GetTime() - start;
+
+    Tree_t tree = {};
+    TreeCtor(&tree);
+
+    start = GetTime();
+    tree.root = GetTree(&tokens, &input, tree.arena);
+    stages[GetTreeStage].time += GetTime() - start;
+
+    start = GetTime();
+    PrintTree(&tree, text_ast_file, AstFormat::text);
+    stages[PrintTextTreeStage].time += GetTime() - start;
+
+    start = GetTime();
+    PrintTree(&tree, binary_ast_file, AstFormat::binary);
+    stages[PrintBinaryTreeStage].time += GetTime() - start;
+
+    Tree_t text_tree = {};
+    TreeCtor(&text_tree);
+
+    start = GetTime();
+    ReadTree(&text_tree, text_ast_file, AstFormat::text);
+    stages[ReadTextTreeStage].time += GetTime() - start;
+
+    Tree_t binary_tree = {};
+    TreeCtor(&binary_tree);
+
+    start = GetTime();
+    ReadTree(&binary_tree, binary_ast_file, AstFormat::binary);
+    stages[ReadBinaryTreeStage].time += GetTime() - start;
+
+    start = GetTime();
+    OptimizeTree(&binary_tree, &OptimizeDefaultOptions);
+    stages[OptimizeTreeStage].time += GetTime() - start;
+
+    CodeArr code = {};
+
+    start = GetTime();
+    GenerateCode(&binary_tree, &code);
+    stages[GenerateCodeStage].time += GetTime() - start;
+
+    // the first cached pass fills the cache, the timed one takes every function from it
+    CodeCache code_cache  = {};
+    CodeArr   cold_code   = {};
+    CodeArr   cached_code = {};
+    CodeCacheCtor(&code_cache);
+
+    GenerateCachedCode(&binary_tree, &cold_code, &code_cache);
+
+    start = GetTime();
+    GenerateCachedCode(&binary_tree, &cached_code, &code_cache);
+    stages[GenerateCachedStage].time += GetTime() - start;
+
+    IrModule module   = {};
+    IrStats  ir_stats = {};
+    CodeArr  ir_code  = {};
+    IrModuleCtor(&module);
+
+    start = GetTime();
+    LowerTree(&binary_tree, &module);
+    stages[LowerTreeStage].time += GetTime() - start;
+
+    start = GetTime();
+    OptimizeIr(&module, &ir_stats);
+    stages[OptimizeIrStage].time += GetTime() - start;
+
+    start = GetTime();
+    GenerateIrCode(&module, &ir_code);
+    stages[GenerateIrCodeStage].time += GetTime() - start;
+
+    CodeArr run_code = CompileRun(run_file);
+
+    start = GetTime();
+    size_t spu_commands = RunCode(&run_code);
+    stages[RunCodeStage].time += GetTime() - start;
+
+    *size = {input.size, tokens.size, tree.arena->nodes_quant, spu_commands};
+
+    CodeArrDtor  (&code);
+    CodeArrDtor  (&run_code);
+    CodeArrDtor  (&cold_code);
+    CodeArrDtor  (&cached_code);
+    CodeCacheDtor(&code_cache);
+    CodeArrDtor  (&ir_code);
+    IrModuleDtor (&module);
+    TreeDtor     (&binary_tree);
+    TreeDtor     (&text_tree);
+    TreeDtor     (&tree);
+    TokenDtor    (&tokens);
+    InputDataDtor(&input);
+
+    // interned names point to this pass input
+    InternerDtor ();
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void PrintJson(const Stage* stages, const ProgrammSize* size, size_t functions_quant, size_t repeats_quant)
+{
+    assert(stages);
+    assert(size);
+
+    printf("{\n");
+    printf("    \"programm\": {\"functions\": %lu, \"bytes\": %lu, \"tokens\": %lu, \"nodes\": %lu, \"spu_commands\": %lu},\n",
+           functions_quant, size->bytes, size->tokens, size->nodes, size->spu_commands);
+    printf("    \"repeats\": %lu,\n", repeats_quant);
+    printf("    \"stages\":\n    [\n");
+
+    for (size_t i = 0; i < StagesQuant; i++)
+    {
+        const Stage* stage = &stages[i];
+        const char*  comma = (i + 1 < StagesQuant) ? "," : "";
+
+        if (stage->skipped)
+        {
+            printf("        {\"name\": \"%s\", \"ms\": null, \"skipped\": \"%s\"}%s\n", stage->name, stage->skipped, comma);
+            continue;
+        }
+
+        double time = stage->time / (double) repeats_quant;
+        if (!(time > 0))
+            time = 1e-9;
+
+        // RunCode runs another programm, units of the source one say nothing about it
+        if (i == RunCodeStage)
+        {
+            printf("        {\"name\": \"%s\", \"ms\": %.3lf, \"spu_commands_per_s\": %.0lf}%s\n",
+                   stage->name, time * 1e3, (double) size->spu_commands / time, comma);
+            continue;
+        }
+
+        printf("        {\"name\": \"%s\", \"ms\": %.3lf, \"mb_per_s\": %.2lf, \"tokens_per_s\": %.0lf, \"nodes_per_s\": %.0lf}%s\n",
+               stage->name, time * 1e3,
+               (double) size->bytes  / time / (1024 * 1024),
+               (double) size->tokens / time,
+               (double) size->nodes  / time, comma);
+    }
+
+    printf("    ]\n}\n");
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,192 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "lib/lib.hpp"
+#include "name-table/name-table.hpp"
+#include "name-table/interner/interner.hpp"
+#include "name-table/symbol-table/symbol-table.hpp"
+#include "bench-lib/bench-lib.hpp"
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// name resolution benchmark: every function name is global, every function has its own locals,
+// each local is used several times. Linear NameTable_t + IsNameAlreadyDefined vs SymbolTable.
+// Names are interned when the pool is built, as the lexer does.
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct NamesPool
+{
+    char*  buffer;
+    Name*  functions;
+    Name*  locals;
+};
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static NamesPool NamesPoolCtor       (size_t functions_quant, size_t locals_quant);
+static void      NamesPoolDtor       (NamesPool* pool);
+static size_t    ResolveLinear       (const NamesPool* pool, size_t functions_quant, size_t locals_quant, size_t uses_quant);
+static size_t    ResolveSymbolTable  (const NamesPool* pool, size_t functions_quant, size_t locals_quant, size_t uses_quant);
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+int main(int argc, const char* argv[])
+{
+    size_t functions_quant = (argc > 1) ? (size_t) atol(argv[1]) : 500;
+    size_t locals_quant    = (argc > 2) ? (size_t) atol(argv[2]) : 50;
+    size_t uses_quant      = (argc > 3) ? (size_t) atol(argv[3]) : 4;
+
+    NamesPool pool = NamesPoolCtor(functions_quant, locals_quant);
+
+    double start         = GetTime();
+    size_t linear_found  = ResolveLinear(&pool, functions_quant, locals_quant, uses_quant);
+    double linear_time   = GetTime() - start;
+
+    start                = GetTime();
+    size_t symbols_found = ResolveSymbolTable(&pool, functions_quant, locals_quant, uses_quant);
+    double symbols_time  = GetTime() - start;
+
+    assert(linear_found == symbols_found);
+
+    printf("%lu functions x %lu locals x %lu uses, %lu lookups\n\n", functions_quant, locals_quant, uses_quant, linear_found);
+    printf("%-12s %14s\n", "table", "resolve, ms");
+    printf("%-12s %14.3lf\n", "NameTable_t", linear_time  * 1e3);
+    printf("%-12s %14.3lf\n", "SymbolTable", symbols_time * 1e3);
+
+    NamesPoolDtor(&pool);
+    InternerDtor ();
+
+    return EXIT_SUCCESS;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static NamesPool NamesPoolCtor(size_t functions_quant, size_t locals_quant)
+{
+    static const size_t MaxNameLen = 32;
+
+    NamesPool pool = {};
+
+    pool.buffer    = (char*) calloc((functions_quant + locals_quant) * MaxNameLen, sizeof(char));
+    pool.functions = (Name*) calloc(functions_quant, sizeof(Name));
+    pool.locals    = (Name*) calloc(locals_quant   , sizeof(Name));
+
+    if (!pool.buffer || !pool.functions || !pool.locals)
+        EXIT(EXIT_FAILURE, "failed calloc memory for names pool.");
+
+    char* cur = pool.buffer;
+
+    for (size_t i = 0; i < functions_quant; i++)
+    {
+        int len = snprintf(cur, MaxNameLen, "function_%lu", i);
+        pool.functions[i]    = NameCtor(cur, (size_t) len);
+        pool.functions[i].id = InternName(&pool.functions[i].name);
+        cur += MaxNameLen;
+    }
+
+    for (size_t i = 0; i < locals_quant; i++)
+    {
+        int len = snprintf(cur, MaxNameLen, "local_%lu", i);
+        pool.locals[i]    = NameCtor(cur, (size_t) len);
+        pool.locals[i].id = InternName(&pool.locals[i].name);
+        cur += MaxNameLen;
+    }
+
+    return pool;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void NamesPoolDtor(NamesPool* pool)
+{
+    assert(pool);
+
+    free(pool->buffer);
+    FREE(pool->functions);
+    FREE(pool->locals);
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static size_t ResolveLinear(const NamesPool* pool, size_t functions_quant, size_t locals_quant, size_t uses_quant)
+{
+    assert(pool);
+
+    NameTable_t table = {};
+    NAME_TABLE_ASSERT(NameTableCtor(&table, functions_quant + locals_quant));
+
+    size_t found   = 0;
+    size_t pointer = 0;
+
+    for (size_t i = 0; i < functions_quant; i++)
+    {
+        if (!IsNameAlreadyDefined(&pool->functions[i], &table, &pointer))
+            NAME_TABLE_ASSERT(NameTablePush(&table, pool->functions[i]));
+    }
+
+    for (size_t i = 0; i < functions_quant; i++)
+    {
+        for (size_t j = 0; j < locals_quant; j++)
+        {
+            if (!IsNameAlreadyDefined(&pool->locals[j], &table, &pointer))
+                NAME_TABLE_ASSERT(NameTablePush(&table, pool->locals[j]));
+        }
+
+        for (size_t use = 0; use < uses_quant; use++)
+        {
+            for (size_t j = 0; j < locals_quant; j++)
+                found += IsNameAlreadyDefined(&pool->locals[j], &table, &pointer);
+
+            found += IsNameAlreadyDefined(&pool->functions[(i + use) % functions_quant], &table, &pointer);
+        }
+
+        Name popped = {};
+        for (size_t j = 0; j < locals_quant; j++)
+            NAME_TABLE_ASSERT(NameTablePop(&table, &popped));
+    }
+
+    NAME_TABLE_ASSERT(NameTableDtor(&table));
+
+    return found;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static size_t ResolveSymbolTable(const NamesPool* pool, size_t functions_quant, size_t locals_quant, size_t uses_quant)
+{
+    assert(pool);
+
+    SymbolTable table = SymbolTableCtor(functions_quant + locals_quant);
+
+    size_t found = 0;
+
+    for (size_t i = 0; i < functions_quant; i++)
+        SymbolTableDefine(&table, &pool->functions[i]);
+
+    for (size_t i = 0; i < functions_quant; i++)
+    {
+        SymbolTablePushScope(&table);
+
+        for (size_t j = 0; j < locals_quant; j++)
+            SymbolTableDefine(&table, &pool->locals[j]);
+
+        for (size_t use = 0; use < uses_quant; use++)
+        {
+            for (size_t j = 0; j < locals_quant; j++)
+                found += (SymbolTableFindById(&table, pool->locals[j].id) != nullptr);
+
+            found += (SymbolTableFindById(&table, pool->functions[(i + use) % functions_quant].id) != nullptr);
+        }
+
+        SymbolTablePopScope(&table);
+    }
+
+    SymbolTableDtor(&table);
+
+    return found;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
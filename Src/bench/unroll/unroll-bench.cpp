@@ -0,0 +1,147 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "lib/lib.hpp"
+#include "tree/tree.hpp"
+#include "read-tree/file-read/file-read.hpp"
+#include "read-tree/tokens/tokens.hpp"
+#include "read-tree/recursive-descent/recursive-descent.hpp"
+#include "name-table/interner/interner.hpp"
+#include "optimize/optimize.hpp"
+#include "codegen/codegen.hpp"
+#include "bench-lib/bench-lib.hpp"
+
+#ifdef _DEBUG
+#include "log/log.hpp"
+#endif // _DEBUG
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// Loop-heavy corpus programms compiled with every unrolling factor, the result is JSON on stdout:
+//   {"repeats": R, "runs": [{"programm", "factor", "nodes", "code_size", "optimize_ms", "codegen_ms"}, ...]}
+// nodes - AST after the middle-end, code_size - SPU code words. Factor 0 is the build without unrolling,
+// the other runs are compared with it. Executed commands need the processor (SFML window),
+// they are counted with COMPILER_PROFILE=1 runs of the compiler itself.
+//
+// unroll-bench [repeats] [programm ...]
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static const size_t      Factors[]        = {0, 2, 4, 8};
+static const size_t      FactorsQuant     = sizeof(Factors) / sizeof(Factors[0]);
+
+static const char* const DefaultCorpus[]  = {"bench/corpus/loops.s", "bench/corpus/primes.s", "bench/corpus/fibonacci.s"};
+static const size_t      DefaultQuant     = sizeof(DefaultCorpus) / sizeof(DefaultCorpus[0]);
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct UnrollRun
+{
+    size_t nodes;
+    size_t code_size;
+    double optimize_time;
+    double codegen_time;
+};
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void   RunProgramm  (const char* programm, size_t factor, UnrollRun* run);
+static size_t GetTreeSize  (const Node_t* node);
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+int main(int argc, const char* argv[])
+{
+    size_t             repeats_quant  = (argc > 1) ? (size_t) atol(argv[1]) : 20;
+    const char* const* corpus         = (argc > 2) ? argv + 2 : DefaultCorpus;
+    size_t             corpus_quant   = (argc > 2) ? (size_t) (argc - 2) : DefaultQuant;
+
+    if (repeats_quant == 0)
+        EXIT(EXIT_FAILURE, "repeats must be positive");
+
+    ON_DEBUG(
+    LOG_OPEN();
+    )
+
+    printf("{\n");
+    printf("    \"repeats\": %lu,\n", repeats_quant);
+    printf("    \"runs\":\n    [\n");
+
+    for (size_t programm_i = 0; programm_i < corpus_quant; programm_i++)
+    {
+        for (size_t factor_i = 0; factor_i < FactorsQuant; factor_i++)
+        {
+            UnrollRun run = {};
+
+            for (size_t i = 0; i < repeats_quant; i++)
+                RunProgramm(corpus[programm_i], Factors[factor_i], &run);
+
+            const char* comma = (programm_i + 1 < corpus_quant || factor_i + 1 < FactorsQuant) ? "," : "";
+
+            printf("        {\"programm\": \"%s\", \"factor\": %lu, \"nodes\": %lu, \"code_size\": %lu, \"optimize_ms\": %.3lf, \"codegen_ms\": %.3lf}%s\n",
+                   corpus[programm_i], Factors[factor_i], run.nodes, run.code_size,
+                   run.optimize_time / (double) repeats_quant * 1e3,
+                   run.codegen_time  / (double) repeats_quant * 1e3, comma);
+        }
+    }
+
+    printf("    ]\n}\n");
+
+    ON_DEBUG(
+    LOG_CLOSE();
+    )
+
+    return EXIT_SUCCESS;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void RunProgramm(const char* programm, size_t factor, UnrollRun* run)
+{
+    assert(programm);
+    assert(run);
+
+    InputData input  = ReadFile(programm);
+    TokensArr tokens = ReadInputBuffer(&input);
+
+    Tree_t tree = {};
+    TreeCtor(&tree);
+    tree.root = GetTree(&tokens, &input, tree.arena);
+
+    OptimizeOptions options = OptimizeDefaultOptions;
+    options.unroll.factor   = factor;
+
+    double start = GetTime();
+    OptimizeTree(&tree, &options);
+    run->optimize_time += GetTime() - start;
+
+    CodeArr code = {};
+
+    start = GetTime();
+    GenerateCode(&tree, &code);
+    run->codegen_time += GetTime() - start;
+
+    run->nodes     = GetTreeSize(tree.root);
+    run->code_size = code.size;
+
+    CodeArrDtor  (&code);
+    TreeDtor     (&tree);
+    TokenDtor    (&tokens);
+    InputDataDtor(&input);
+
+    // interned names point to this programm text
+    InternerDtor ();
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static size_t GetTreeSize(const Node_t* node)
+{
+    if (!node) return 0;
+
+    return 1 + GetTreeSize(node->left) + GetTreeSize(node->right);
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
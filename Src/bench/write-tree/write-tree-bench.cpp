@@ -0,0 +1,81 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <sys/stat.h>
+#include "lib/lib.hpp"
+#include "tree/tree.hpp"
+#include "read-tree/file-read/file-read.hpp"
+#include "read-tree/tokens/tokens.hpp"
+#include "read-tree/recursive-descent/recursive-descent.hpp"
+#include "tree/read-write-tree/write-tree/write-tree.hpp"
+#include "name-table/interner/interner.hpp"
+#include "bench-lib/bench-lib.hpp"
+
+#ifdef _DEBUG
+#include "log/log.hpp"
+#endif // _DEBUG
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// text AST writer on a programm of long expressions (> 1M nodes by default):
+// deep indentation and many numbers, so the time is the emitter itself
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static const char* const text_ast_file = "/tmp/write-tree-bench.ast";
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+int main(int argc, const char* argv[])
+{
+    size_t functions_quant  = (argc > 1) ? (size_t) atol(argv[1]) : 500;
+    size_t statements_quant = (argc > 2) ? (size_t) atol(argv[2]) : 20;
+    size_t operands_quant   = (argc > 3) ? (size_t) atol(argv[3]) : 40;
+    size_t repeats_quant    = (argc > 4) ? (size_t) atol(argv[4]) : 5;
+
+    ON_DEBUG(
+    LOG_OPEN(); // write-tree logs its steps in debug build
+    )
+
+    InputData input  = GenerateExpressionsProgramm(functions_quant, statements_quant, operands_quant);
+    TokensArr tokens = ReadInputBuffer(&input);
+
+    Tree_t tree = {};
+    TreeCtor(&tree);
+    tree.root = GetTree(&tokens, &input, tree.arena);
+
+    size_t nodes_quant = tree.arena->nodes_quant;
+    double write_time  = 0;
+
+    for (size_t i = 0; i < repeats_quant; i++)
+    {
+        double start = GetTime();
+        PrintTree(&tree, text_ast_file, AstFormat::text);
+        write_time += GetTime() - start;
+    }
+
+    struct stat file_info = {};
+    stat(text_ast_file, &file_info);
+
+    double file_size  = (double) file_info.st_size;
+    double write_avg  = write_time / (double) repeats_quant;
+
+    printf("%lu nodes, %.1lf MB, %lu repeats\n\n", nodes_quant, file_size / 1e6, repeats_quant);
+    printf("%-8s %14s %14s %14s\n", "writer", "write, ms", "ns per node", "MB/s");
+    printf("%-8s %14.3lf %14.3lf %14.1lf\n", "text", write_avg * 1e3, write_avg * 1e9 / (double) nodes_quant, file_size / 1e6 / write_avg);
+
+    remove(text_ast_file);
+
+    TreeDtor     (&tree);
+    TokenDtor    (&tokens);
+    InputDataDtor(&input);
+    InternerDtor ();
+
+    ON_DEBUG(
+    LOG_CLOSE();
+    )
+
+    return EXIT_SUCCESS;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,38 @@
+#ifndef DUMP_SERVICE_HPP
+#define DUMP_SERVICE_HPP
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#include <stdio.h>
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// Graphic dumps service:
+//   DumpOpen()  makes ../dot/<kind>/dot/ and ../dot/<kind>/img/ once with mkdir(2) and opens
+//               ../dot/<kind>/dot/<kind><number>.dot with a big stdio buffer,
+//   DumpClose() closes the .dot file and queues "dot -Tpng" for it,
+// dot is run by background workers without a shell, so a dump does not wait for rendering.
+// DumpWait() waits for all queued images, it is also called at exit.
+// kind must be a string literal.
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static const size_t DumpPathMaxLen = 128;
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct DumpFiles
+{
+    char dot[DumpPathMaxLen];
+    char img[DumpPathMaxLen];
+};
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+FILE* DumpOpen  (const char* kind, size_t number, DumpFiles* files);
+void  DumpClose (FILE* dot_file, const DumpFiles* files);
+void  DumpWait  ();
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#endif // DUMP_SERVICE_HPP
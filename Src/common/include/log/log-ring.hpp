@@ -0,0 +1,55 @@
+#ifndef LOG_RING_HPP
+#define LOG_RING_HPP
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#include <stdarg.h>
+#include <stdint.h>
+#include "log/log.hpp"
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// Binary log: every thread appends records to its own buffer, a record is
+//   kind byte, LogColor byte, u32 format id, raw arguments (no formatting at log time).
+// Full buffers are written to the file as chunks, at close the formats table is appended.
+// Records are turned into text only when the file is decoded.
+//
+// File: "log_bin_format" signature, then tagged sections:
+//   chunk   - tag, u32 thread, u32 size, records,
+//   formats - tag, u32 quant, then for ids 1, 2, ...: u32 len, chars, u8 args quant, arg types.
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+enum class LogRecordKind : uint8_t
+{
+    print     ,
+    adc_print ,
+    color     ,
+    color_end ,
+    title     ,
+};
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct LogRecord
+{
+    LogRecordKind kind;
+    LogColor      color;
+    const char*   text;    // formatted, valid only in the handler call
+};
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+typedef void (*LogRecordHandler) (const LogRecord* record);
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void LogRingOpen   (const char* bin_file);
+void LogRingClose  ();
+bool LogRingIsOpen ();
+void LogRingPut    (LogRecordKind kind, LogColor color, const char* format, va_list args);
+void LogRingDecode (const char* bin_file, LogRecordHandler handler);
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#endif // LOG_RING_HPP
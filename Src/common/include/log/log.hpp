@@ -51,6 +51,7 @@ enum LogColor : char
 
 void OpenLog();
 void CloseLog();
+void LogDecode(const char* bin_file, const char* html_file);
 void LogAdcPrint(const char* format, ...);
 void LogTextColor(LogColor color);
 void LogTextColorEnd();
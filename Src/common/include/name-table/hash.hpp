@@ -8,7 +8,7 @@
 
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-uint64_t Hash(void* Arr, size_t ArrElemQuant, size_t ArrElemSize);
+uint64_t Hash(const void* Arr, size_t ArrElemQuant, size_t ArrElemSize);
 
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
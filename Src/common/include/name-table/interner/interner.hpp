@@ -0,0 +1,67 @@
+#ifndef INTERNER_HPP
+#define INTERNER_HPP
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdint.h>
+#include "tree/node-and-token-types.hpp"
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// Global identifiers interner: every distinct name gets a dense id 1, 2, 3, ... at lex time,
+// so names are compared as integers. Id 0 (NameNoId) means "not interned", it is what a zeroed Name has.
+// InternName() does NOT copy the string: it must live as long as the interner (source buffer).
+// InternNameCopy() copies new names into interner owned blocks (names read from AST files).
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct InternSlot
+{
+    uint64_t hash;
+    NameId   id;
+};
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct InternCharsBlock
+{
+    InternCharsBlock* prev;
+    size_t            capacity;
+    size_t            size;
+    char*             chars;
+};
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct NameInterner
+{
+    size_t      slots_capacity;
+    InternSlot* slots;
+
+    size_t      names_size;
+    size_t      names_capacity;
+    NameInfo*   names;
+
+    InternCharsBlock* chars;
+};
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static const size_t InternerDefaultCapacity   = 256;
+static const size_t InternerCharsBlockCapacity = 4096;
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void     InternerCtor          (size_t capacity);
+void     InternerDtor          ();
+
+NameId   InternName            (const NameInfo* name);
+NameId   InternNameCopy        (const NameInfo* name);
+NameId   GetNameId             (const NameInfo* name);
+NameInfo GetInternedName       (NameId id);
+size_t   GetInternedNamesQuant ();
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#endif // INTERNER_HPP
@@ -0,0 +1,65 @@
+#ifndef SYMBOL_TABLE_HPP
+#define SYMBOL_TABLE_HPP
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdint.h>
+#include "tree/node-and-token-types.hpp"
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// Scoped symbol table over interned names (name-table/interner/interner.hpp):
+//   definitions are kept in a stack of bindings, heads[id] points to the visible binding of id,
+//   a scope remembers the bindings stack size, so SymbolTablePopScope() just unwinds it.
+// Lookup, define and pop (per binding) are O(1), no allocations except amortized growth.
+// The front-end does no symbol resolution yet, so for now it is used only by bench/symbol-table.
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static const size_t SymbolNoBinding = SIZE_MAX;
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct SymbolBinding
+{
+    Name   name;
+    size_t scope;
+    size_t prev;
+};
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct SymbolTable
+{
+    size_t         heads_capacity;
+    size_t*        heads;
+
+    size_t         bindings_size;
+    size_t         bindings_capacity;
+    SymbolBinding* bindings;
+
+    size_t         scopes_size;
+    size_t         scopes_capacity;
+    size_t*        scopes;
+};
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static const size_t SymbolTableDefaultCapacity = 256;
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+SymbolTable  SymbolTableCtor      (size_t capacity);
+void         SymbolTableDtor      (SymbolTable* table);
+
+void         SymbolTablePushScope (SymbolTable* table);
+void         SymbolTablePopScope  (SymbolTable* table);
+
+bool         SymbolTableDefine    (SymbolTable* table, const Name* name);
+const Name*  SymbolTableFind      (const SymbolTable* table, const NameInfo* name);
+const Name*  SymbolTableFindById  (const SymbolTable* table, NameId id);
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#endif // SYMBOL_TABLE_HPP
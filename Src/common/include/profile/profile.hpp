@@ -0,0 +1,165 @@
+#ifndef PROFILE_HPP
+#define PROFILE_HPP
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stddef.h>
+#include <time.h>
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// Instrumentation of hot paths in any build type:
+//   PROFILE_SCOPE(name)                       - time of the enclosing block (calls, total, max) and a trace event,
+//   PROFILE_COUNT(name, n)                    - named counter,
+//   PROFILE_COUNT_AT(name, index, quant, get) - counters array, get(index) gives the element name (dispatch counts),
+//   PROFILE_HISTOGRAM(name, value)            - power of two buckets of value.
+//
+// Everything is off until the program is run with COMPILER_PROFILE set: "1" - summary table to stderr and
+// Chrome trace (chrome://tracing, ui.perfetto.dev) to profile-trace.json, any other value - trace file path.
+// Off costs one branch per macro. Comment _PROFILE out to compile all macros away.
+
+#define _PROFILE
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef _PROFILE
+    #define ON_PROFILE(...) __VA_ARGS__
+#else
+    #define ON_PROFILE(...)
+#endif
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct ProfileZone
+{
+    const char*  name;
+    uint64_t     calls;
+    uint64_t     total_ns;
+    uint64_t     max_ns;
+    bool         registered;
+    ProfileZone* next;
+};
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct ProfileCounter
+{
+    const char*     name;
+    uint64_t        value;
+    bool            registered;
+    ProfileCounter* next;
+};
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+typedef const char* (*ProfileIndexName) (size_t index);
+
+struct ProfileCounters
+{
+    const char*      name;
+    size_t           quant;
+    ProfileIndexName get_name;
+    uint64_t*        values;
+    bool             registered;
+    ProfileCounters* next;
+};
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static const size_t ProfileHistogramBuckets = 64;
+
+struct ProfileHistogram
+{
+    const char*       name;
+    uint64_t          buckets[ProfileHistogramBuckets];    // bucket i: values in [2^(i-1), 2^i), bucket 0: value 0
+    bool              registered;
+    ProfileHistogram* next;
+};
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+extern const bool ProfileEnabled;
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void ProfileZoneEnd      (ProfileZone*      zone,      uint64_t start_ns);
+void ProfileCount        (ProfileCounter*   counter,   uint64_t value);
+void ProfileCountAt      (ProfileCounters*  counters,  size_t   index);
+void ProfileHistogramAdd (ProfileHistogram* histogram, uint64_t value);
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+inline uint64_t ProfileNow()
+{
+    timespec time = {};
+    clock_gettime(CLOCK_MONOTONIC, &time);
+
+    return (uint64_t) time.tv_sec * 1000000000 + (uint64_t) time.tv_nsec;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct ProfileScope
+{
+    ProfileZone* zone;
+    uint64_t     start_ns;
+
+    explicit ProfileScope(ProfileZone* scope_zone) :
+        zone     (ProfileEnabled ? scope_zone : nullptr),
+        start_ns (ProfileEnabled ? ProfileNow() : 0)
+    {}
+
+    ~ProfileScope()
+    {
+        if (zone)
+            ProfileZoneEnd(zone, start_ns);
+    }
+
+    ProfileScope            (const ProfileScope&) = delete;
+    ProfileScope& operator= (const ProfileScope&) = delete;
+};
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#define PROFILE_CONCAT_(first, second) first##second
+#define PROFILE_CONCAT(first, second)  PROFILE_CONCAT_(first, second)
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef _PROFILE
+
+#define PROFILE_SCOPE(name)                                                                     \
+    static ProfileZone PROFILE_CONCAT(profile_zone_, __LINE__) = {name, 0, 0, 0, false, nullptr}; \
+    ProfileScope PROFILE_CONCAT(profile_scope_, __LINE__) (&PROFILE_CONCAT(profile_zone_, __LINE__))
+
+#define PROFILE_COUNT(name, n) do                                                               \
+{                                                                                                \
+    static ProfileCounter profile_counter = {name, 0, false, nullptr};                            \
+    if (ProfileEnabled) ProfileCount(&profile_counter, n);                                       \
+} while (0)
+
+#define PROFILE_COUNT_AT(name, index, quant, get_name) do                                       \
+{                                                                                                \
+    static ProfileCounters profile_counters = {name, quant, get_name, nullptr, false, nullptr};   \
+    if (ProfileEnabled) ProfileCountAt(&profile_counters, index);                                \
+} while (0)
+
+#define PROFILE_HISTOGRAM(name, value) do                                                       \
+{                                                                                                \
+    static ProfileHistogram profile_histogram = {name, {}, false, nullptr};                       \
+    if (ProfileEnabled) ProfileHistogramAdd(&profile_histogram, value);                          \
+} while (0)
+
+#else
+
+#define PROFILE_SCOPE(name)
+#define PROFILE_COUNT(name, n)                         do {} while (0)
+#define PROFILE_COUNT_AT(name, index, quant, get_name) do {} while (0)
+#define PROFILE_HISTOGRAM(name, value)                 do {} while (0)
+
+#endif // _PROFILE
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#endif // PROFILE_HPP
@@ -0,0 +1,70 @@
+#ifndef FLAT_TREE_HPP
+#define FLAT_TREE_HPP
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdint.h>
+#include "tree/tree.hpp"
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// Tree_t stored in pre-order as struct of arrays:
+//   node i left  child (if any) is i + 1,
+//   node i right child (if any) is i + 1 + sizes[left] (or i + 1 if there is no left child),
+//   the whole subtree of node i is [i, i + sizes[i]).
+// payloads[i] holds the enum value of the node, or an index in 'names' / 'numbers'.
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+enum FlatNodeLinks : uint8_t
+{
+    FLAT_NO_CHILDREN = 0     ,
+    FLAT_HAS_LEFT    = 1 << 0,
+    FLAT_HAS_RIGHT   = 1 << 1,
+};
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct FlatTree
+{
+    size_t    size;
+
+    uint8_t*  kinds;    // NodeArgType
+    uint8_t*  links;    // FlatNodeLinks
+    uint32_t* sizes;
+    uint32_t* payloads;
+
+    size_t    names_size;
+    Name*     names;
+
+    size_t    numbers_size;
+    Number*   numbers;
+};
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static const size_t FlatTreeNoNode = SIZE_MAX;
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+FlatTree    FlatTreeCtor       (const Tree_t*   tree);
+void        FlatTreeDtor       (FlatTree*       flat);
+void        FlatTreeToTree     (const FlatTree* flat, Tree_t* tree);
+
+NodeArgType FlatTreeGetType    (const FlatTree* flat, size_t node);
+NodeData_t  FlatTreeGetData    (const FlatTree* flat, size_t node);
+size_t      FlatTreeGetLeft    (const FlatTree* flat, size_t node);
+size_t      FlatTreeGetRight   (const FlatTree* flat, size_t node);
+size_t      FlatTreeGetNext    (const FlatTree* flat, size_t node);
+size_t      FlatTreeMemory     (const FlatTree* flat);
+
+TreeErr     FlatTreeVerif      (const FlatTree* flat, TreeErr* err, const char* file, const int line, const char* func);
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#define FLAT_TREE_VERIF(FlatPtr, Err) FlatTreeVerif(FlatPtr, &Err, __FILE__, __LINE__, __func__)
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#endif // FLAT_TREE_HPP
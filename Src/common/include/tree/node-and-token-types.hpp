@@ -34,6 +34,12 @@ struct NameInfo
     size_t      len;
 };
 
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+typedef uint32_t NameId; // see name-table/interner/interner.hpp
+
+static const NameId NameNoId = 0;
+
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
 #define STRLEN(str) (sizeof(str) - 1) // '-1' to avoid counting \0
@@ -520,6 +526,7 @@ struct Name
 
     NameInfo name;
     NameType type;
+    NameId   id;
     NameData data;
 };
 
@@ -0,0 +1,44 @@
+#ifndef NODE_ARENA_HPP
+#define NODE_ARENA_HPP
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#include <stdio.h>
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct Node_t;
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct NodeArenaBlock
+{
+    NodeArenaBlock* prev;
+    size_t          capacity;
+    size_t          pointer;
+    Node_t*         nodes;
+};
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct NodeArena
+{
+    NodeArenaBlock* last;
+    size_t          blocks_quant;
+    size_t          nodes_quant;
+};
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static const size_t NodeArenaDefaultBlockCapacity = 1024;
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+NodeArena* NodeArenaCtor  (size_t first_block_capacity);
+void       NodeArenaDtor  (NodeArena* arena);
+Node_t*    NodeArenaAlloc (NodeArena* arena);
+void       NodeArenaMerge (NodeArena* arena, NodeArena* other);
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#endif // NODE_ARENA_HPP
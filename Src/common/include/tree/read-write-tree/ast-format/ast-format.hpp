@@ -0,0 +1,14 @@
+#ifndef AST_FORMAT_HPP
+#define AST_FORMAT_HPP
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+enum class AstFormat
+{
+    text  ,
+    binary,
+};
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#endif // AST_FORMAT_HPP
@@ -0,0 +1,33 @@
+#ifndef BINARY_TREE_HPP
+#define BINARY_TREE_HPP
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#include "tree/tree.hpp"
+#include "tree/flat-tree/flat-tree.hpp"
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// Binary AST file:
+//   ast_binary_signature bytes, ast_binary_version byte,
+//   varint names quant, then for every interned name (ids 1, 2, ...): varint len, chars,
+//   varint functions quant, then functions index: varint nodes quant, varint bytes size for every function,
+//   then functions one after another, every function is its nodes in pre-order: kind byte, FlatNodeLinks byte, payload.
+// Payload: name   - varint name id, NameType byte,
+//          number - Type byte, zigzag varint (int) / 8 bytes (double) / 1 byte (char),
+//          other  - varint enum value.
+// Functions are the nodes of the root connect list, connect nodes of this list are not stored.
+// The index gives every function offset, so functions are written and read on worker threads.
+// PrintBinaryFlatTree() writes the same file from a FlatTree, one linear pass over its arrays.
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void PrintBinaryTree     (const Tree_t*   tree, const char* outstream);
+void PrintBinaryFlatTree (const FlatTree* flat, const char* outstream);
+void ReadBinaryTree      (Tree_t*         tree, const char* instream);
+
+void SetBinaryTreeWorkersQuant (size_t workers_quant);
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#endif // BINARY_TREE_HPP
@@ -1,17 +1,19 @@
 #ifndef READ_TREE_HPP
 #define READ_TREE_HPP
 
-//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
 #include "tree/tree.hpp"
-#include "read-file/read-file.hpp"
+#include "tree/read-write-tree/ast-format/ast-format.hpp"
 
-//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
+// GetAstFileFormat() tells the format by the file signature, so stages read ASTs of both formats,
+// a file without the binary signature is taken as text, its reader checks its own signature
 
-Tree_t ReadTree(WordArray* wordArr);
+void      ReadTree         (Tree_t* tree, const char* instream, AstFormat format);
+AstFormat GetAstFileFormat (const char* instream);
 
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-
-#endif // READ_TREE_HPP
\ No newline at end of file
+#endif // READ_TREE_HPP
@@ -1,61 +1,68 @@
 #ifndef _READ_WRITE_TREE_GLOBAL
 #define _READ_WRITE_TREE_GLOBAL
 
+#include <stdint.h>
+
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
 
-const char* ast_file_signature         = "file_signature:";
-const char* ast_file_signature_name    = "name=ast_txt_format";
-const char* ast_file_signature_autor   = "autor=Sebelev_M._M.";
-const char* ast_file_signature_version = "version=1.0";
-
-const char* def_func                   = "DEF_FUNC";
-const char* arguments                  = "ARGS";
-const char* body                       = "BODY";
-const char* condition                  = "CONDITION";
-const char* condition_if               = "ONDITION: if";
-const char* condition_else             = "ONDITION: else";
-const char* condition_else_if          = "ONDITION: else_if";
-const char* cycle_for                  = "CYCLE: for";
-const char* cycle_while                = "CYCLE: while";
-const char* cycle_condition            = "CYCLE_CONDITION";
-const char* define_variable            = "DEF_VAR";
-const char* assign                     = "ASGN";
-const char* operation                  = "OP";
-
-const char* assign_operation           = "=";
-const char* plus_operation             = "+";
-const char* minus_operation            = "-";
-const char* mul_operation              = "*";
-const char* div_operation              = "/";
-const char* power_operation            = "^";
-const char* equal_operation            = "==";
-const char* not_equal_operation        = "!=";
-const char* greater_operation          = ">";
-const char* greater_or_equal_operation = ">=";
-const char* less_operation             = "<";
-const char* less_or_equal_operation    = "<=";
-const char* bool_and_operation         = "&&";
-const char* bool_or_operation          = "||";
-const char* bool_not_operation         = "!";
-const char* plus_plus_operation        = "++";
-const char* minus_minus_operation      = "--";
-const char* plus_equal_operation       = "+=";
-const char* minus_equal_operation      = "-=";
-const char* mul_equal_operation        = "*";
-const char* div_equal_operation        = "/=";
-
-const char* call_function              = "CALL_FUNC";
-const char* call_function_arguments    = "CALL_FUNC_ARGS";
-const char* ret                        = "RET";
-const char* number                     = "NUM:";
-const char* name                       = "NAME:";
-const char* type                       = "TYPE:";
-
-const char* int_type                   = "int";
-const char* char_type                  = "char";
-const char* double_type                = "double";
-const char* void_type                  = "void";
+const char* const ast_file_signature         = "file_signature:";
+const char* const ast_file_signature_name    = "name=ast_txt_format";
+const char* const ast_file_signature_autor   = "autor=Sebelev_M._M.";
+const char* const ast_file_signature_version = "version=1.1";
+
+const char* const names_table                = "NAMES:";
+
+const char* const ast_binary_signature       = "ast_bin_format";
+const uint8_t     ast_binary_version         = 2;
+
+const char* const def_func                   = "DEF_FUNC";
+const char* const arguments                  = "ARGS";
+const char* const body                       = "BODY";
+const char* const condition                  = "CONDITION";
+const char* const condition_if               = "ONDITION: if";
+const char* const condition_else             = "ONDITION: else";
+const char* const condition_else_if          = "ONDITION: else_if";
+const char* const cycle_for                  = "CYCLE: for";
+const char* const cycle_while                = "CYCLE: while";
+const char* const cycle_condition            = "CYCLE_CONDITION";
+const char* const define_variable            = "DEF_VAR";
+const char* const assign                     = "ASGN";
+const char* const operation                  = "OP";
+
+const char* const assign_operation           = "=";
+const char* const plus_operation             = "+";
+const char* const minus_operation            = "-";
+const char* const mul_operation              = "*";
+const char* const div_operation              = "/";
+const char* const power_operation            = "^";
+const char* const equal_operation            = "==";
+const char* const not_equal_operation        = "!=";
+const char* const greater_operation          = ">";
+const char* const greater_or_equal_operation = ">=";
+const char* const less_operation             = "<";
+const char* const less_or_equal_operation    = "<=";
+const char* const bool_and_operation         = "&&";
+const char* const bool_or_operation          = "||";
+const char* const bool_not_operation         = "!";
+const char* const plus_plus_operation        = "++";
+const char* const minus_minus_operation      = "--";
+const char* const plus_equal_operation       = "+=";
+const char* const minus_equal_operation      = "-=";
+const char* const mul_equal_operation        = "*";
+const char* const div_equal_operation        = "/=";
+
+const char* const call_function              = "CALL_FUNC";
+const char* const call_function_arguments    = "CALL_FUNC_ARGS";
+const char* const ret                        = "RET";
+const char* const number                     = "NUM:";
+const char* const name                       = "NAME:";
+const char* const type                       = "TYPE:";
+
+const char* const int_type                   = "int";
+const char* const char_type                  = "char";
+const char* const double_type                = "double";
+const char* const void_type                  = "void";
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
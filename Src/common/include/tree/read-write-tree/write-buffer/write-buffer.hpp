@@ -0,0 +1,43 @@
+#ifndef WRITE_BUFFER_HPP
+#define WRITE_BUFFER_HPP
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdint.h>
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// Growable output buffer of the tree writers: everything is formatted in memory
+// and goes to the file with one write() in WriteBufferFlush(), that also closes the file.
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct WriteBuffer
+{
+    char*  data;
+    size_t size;
+    size_t capacity;
+};
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static const size_t WriteBufferDefaultCapacity = 1 << 16;
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void WriteBufferCtor  (WriteBuffer* buffer, size_t capacity);
+void WriteBufferDtor  (WriteBuffer* buffer);
+void WriteBufferFlush (WriteBuffer* buffer, const char* outstream);
+
+void BufferPutChar    (WriteBuffer* buffer, char c);
+void BufferPutBytes   (WriteBuffer* buffer, const void* bytes, size_t size);
+void BufferPutStr     (WriteBuffer* buffer, const char* str);
+void BufferPutTabs    (WriteBuffer* buffer, size_t tabs_quant);
+void BufferPutSize    (WriteBuffer* buffer, size_t value);
+void BufferPutInt     (WriteBuffer* buffer, int64_t value);
+void BufferPutDouble  (WriteBuffer* buffer, double value);
+
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#endif // WRITE_BUFFER_HPP
@@ -4,6 +4,7 @@
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
 #include "tree/tree.hpp"
+#include "tree/read-write-tree/ast-format/ast-format.hpp"
 
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
@@ -17,7 +18,10 @@
 
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-void PrintTree(const Tree_t* tree, const char* outstream);
+// GetAstFormat() takes format of the stages command line: 'text' or 'binary'
+
+void      PrintTree    (const Tree_t* tree, const char* outstream, AstFormat format);
+AstFormat GetAstFormat (const char* format_name);
 
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
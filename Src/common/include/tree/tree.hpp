@@ -9,6 +9,7 @@
 #include "lib/lib.hpp"
 #include "tree/node-and-token-types.hpp"
 #include "name-table/name-table.hpp"
+#include "tree/node-arena/node-arena.hpp"
 
 
 //--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -96,17 +97,20 @@ struct Tree_t
 {
     Node_t*      root;
     NameTable_t* main_name_table;
+    NodeArena*   arena;
 };
 
 //--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
 // TreeErr TreeCtor               (Tree_t*  tree, const TokensArr* tokensArr, const InputData* input);
+void    TreeCtor               (Tree_t*  tree);
 void    TreeDtor               (Tree_t*  tree);
-TreeErr NodeCtor               (Node_t** node, NodeArgType type, NodeData_t data, Node_t* left, Node_t* right);
-TreeErr NodeDtor               (Node_t*  node);
-TreeErr NodeAndUnderTreeDtor   (Node_t*  node);
 
-TreeErr NodeCopy               (Node_t** copy, const Node_t* node);
+TreeErr NodeCtor               (Node_t** node, NodeArena* arena, NodeArgType type, NodeData_t data, Node_t* left, Node_t* right);
+TreeErr NodeDtor               (Node_t*  node, const NodeArena* arena);
+TreeErr NodeAndUnderTreeDtor   (Node_t*  node, const NodeArena* arena);
+
+TreeErr NodeCopy               (Node_t** copy, NodeArena* arena, const Node_t* node);
 // TreeErr NodeSetCopy            (Node_t*  copy, const Node_t* node);
 TreeErr SetNode                (Node_t*  node, NodeArgType type, NodeData_t data, Node_t* left, Node_t* right);
 TreeErr SwapNode               (Node_t** node1, Node_t** node2);
@@ -116,19 +120,19 @@ TreeErr NodeVerif              (const Node_t* node, TreeErr* err, const char* fi
 
 //--------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-#define _NUM(      node, val                 ) do { NodeData_t data = {.num      = val};                            TREE_ASSERT(NodeCtor(node, NodeArgType::number        , data,  nullptr,       nullptr)); }         while(0)
-#define _FUNC(     node, val, left           ) do { NodeData_t data = {.func     = val};                            TREE_ASSERT(NodeCtor(node, NodeArgType::function      , data,  left,          nullptr)); }         while(0)
-#define _NAME(     node, val                 ) do { NodeData_t data = {.name     = val};                            TREE_ASSERT(NodeCtor(node, NodeArgType::name          , data,  nullptr,       nullptr)); }         while(0)
-#define _OPER(     node, val, left, right    ) do { NodeData_t data = {.oper     = val};                            TREE_ASSERT(NodeCtor(node, NodeArgType::operation     , data,  left,          right));   }         while(0)
-#define _TYPE(     node, val, left           ) do { NodeData_t data = {.type     = val};                            TREE_ASSERT(NodeCtor(node, NodeArgType::type          , data,  left,          nullptr)); }         while(0)
-#define _CONNECT(  node,      left, right    ) do { NodeData_t data = {.connect  = '\0'};                           TREE_ASSERT(NodeCtor(node, NodeArgType::connect       , data,  left,          right));   }         while(0)
-#define _WHILE(    node,      left, right    ) do { NodeData_t data = {.cycle    = Cycle::while_t};                 TREE_ASSERT(NodeCtor(node, NodeArgType::cycle         , data,  left,          right));   }         while(0)
-#define _FOR(      node,      left, right    ) do { NodeData_t data = {.cycle    = Cycle::for_t};                   TREE_ASSERT(NodeCtor(node, NodeArgType::cycle         , data,  left,          right));   }         while(0)
-#define _DEF_VAR(  node,      left, right    ) do { NodeData_t data = {.init     = Initialisation::def_variable};   TREE_ASSERT(NodeCtor(node, NodeArgType::initialisation, data,  left,          right  )); }         while(0)
-#define _DEF_FUNC( node,      left           ) do { NodeData_t data = {.init     = Initialisation::def_function};   TREE_ASSERT(NodeCtor(node, NodeArgType::initialisation, data,  left,          nullptr)); }         while(0)
-#define _CALL_FUNC(node,      left           ) do { NodeData_t data = {.init    = Initialisation::call_function};   TREE_ASSERT(NodeCtor(node, NodeArgType::initialisation, data,  left,          nullptr)); }         while(0)
-#define _GET_VAR(  node,      left           ) do { NodeData_t data = {.init     = Initialisation::get_variable};   TREE_ASSERT(NodeCtor(node, NodeArgType::initialisation, data,  left,          nullptr)); }         while(0)
-#define _ASG_VAR(  node,      left, right    ) do { NodeData_t data = {.init     = Initialisation::assign_variable};TREE_ASSERT(NodeCtor(node, NodeArgType::initialisation, data,  left,          right  )); }         while(0)
+#define _NUM(      node, arena, val                 ) do { NodeData_t data = {.num      = val};                            TREE_ASSERT(NodeCtor(node, arena, NodeArgType::number        , data,  nullptr,       nullptr)); }         while(0)
+#define _FUNC(     node, arena, val, left           ) do { NodeData_t data = {.func     = val};                            TREE_ASSERT(NodeCtor(node, arena, NodeArgType::function      , data,  left,          nullptr)); }         while(0)
+#define _NAME(     node, arena, val                 ) do { NodeData_t data = {.name     = val};                            TREE_ASSERT(NodeCtor(node, arena, NodeArgType::name          , data,  nullptr,       nullptr)); }         while(0)
+#define _OPER(     node, arena, val, left, right    ) do { NodeData_t data = {.oper     = val};                            TREE_ASSERT(NodeCtor(node, arena, NodeArgType::operation     , data,  left,          right));   }         while(0)
+#define _TYPE(     node, arena, val, left           ) do { NodeData_t data = {.type     = val};                            TREE_ASSERT(NodeCtor(node, arena, NodeArgType::type          , data,  left,          nullptr)); }         while(0)
+#define _CONNECT(  node, arena,      left, right    ) do { NodeData_t data = {.connect  = '\0'};                           TREE_ASSERT(NodeCtor(node, arena, NodeArgType::connect       , data,  left,          right));   }         while(0)
+#define _WHILE(    node, arena,      left, right    ) do { NodeData_t data = {.cycle    = Cycle::while_t};                 TREE_ASSERT(NodeCtor(node, arena, NodeArgType::cycle         , data,  left,          right));   }         while(0)
+#define _FOR(      node, arena,      left, right    ) do { NodeData_t data = {.cycle    = Cycle::for_t};                   TREE_ASSERT(NodeCtor(node, arena, NodeArgType::cycle         , data,  left,          right));   }         while(0)
+#define _DEF_VAR(  node, arena,      left, right    ) do { NodeData_t data = {.init     = Initialisation::def_variable};   TREE_ASSERT(NodeCtor(node, arena, NodeArgType::initialisation, data,  left,          right  )); }         while(0)
+#define _DEF_FUNC( node, arena,      left           ) do { NodeData_t data = {.init     = Initialisation::def_function};   TREE_ASSERT(NodeCtor(node, arena, NodeArgType::initialisation, data,  left,          nullptr)); }         while(0)
+#define _CALL_FUNC(node, arena,      left           ) do { NodeData_t data = {.init    = Initialisation::call_function};   TREE_ASSERT(NodeCtor(node, arena, NodeArgType::initialisation, data,  left,          nullptr)); }         while(0)
+#define _GET_VAR(  node, arena,      left           ) do { NodeData_t data = {.init     = Initialisation::get_variable};   TREE_ASSERT(NodeCtor(node, arena, NodeArgType::initialisation, data,  left,          nullptr)); }         while(0)
+#define _ASG_VAR(  node, arena,      left, right    ) do { NodeData_t data = {.init     = Initialisation::assign_variable};TREE_ASSERT(NodeCtor(node, arena, NodeArgType::initialisation, data,  left,          right  )); }         while(0)
 
 
 #define _SET_NUM(  node, val               ) do { NodeData_t data = {.num  = val};                                  TREE_ASSERT(SetNode (node, NodeArgType::number        , data, nullptr,        nullptr)); }         while(0)
@@ -143,32 +147,32 @@ TreeErr NodeVerif              (const Node_t* node, TreeErr* err, const char* fi
 #define _SET_FUNC_ONLY( node, val          ) do { NodeData_t data = {.func      = val};                             TREE_ASSERT(SetNode (node, NodeArgType::function       , data, (node)->left,  (node)->right)); }   while(0)
 #define _SET_OPER_ONLY( node, val          ) do { NodeData_t data = {.oper      = val};                             TREE_ASSERT(SetNode (node, NodeArgType::operation      , data, (node)->left,  (node)->right)); }   while(0)
 
-#define _MUL( node, left, right            ) do { NodeData_t data = {.oper      = Operation::mul};                  TREE_ASSERT(NodeCtor(node, NodeArgType::operation      , data, left,           right));  }         while(0)
-#define _DIV( node, left, right            ) do { NodeData_t data = {.oper      = Operation::dive};                 TREE_ASSERT(NodeCtor(node, NodeArgType::operation      , data, left,           right));  }         while(0)
-#define _ADD( node, left, right            ) do { NodeData_t data = {.oper      = Operation::plus};                 TREE_ASSERT(NodeCtor(node, NodeArgType::operation      , data, left,           right));  }         while(0)
-#define _SUB( node, left, right            ) do { NodeData_t data = {.oper      = Operation::minus};                TREE_ASSERT(NodeCtor(node, NodeArgType::operation      , data, left,           right));  }         while(0)
-#define _PP(  node, left, right            ) do { NodeData_t data = {.oper      = Operation::plus_plus};            TREE_ASSERT(NodeCtor(node, NodeArgType::operation      , data, left,           right));  }         while(0)
-#define _MM(  node, left, right            ) do { NodeData_t data = {.oper      = Operation::minus_minus};          TREE_ASSERT(NodeCtor(node, NodeArgType::operation      , data, left,           right));  }         while(0)
-#define _PE(  node, left, right            ) do { NodeData_t data = {.oper      = Operation::plus_equal};           TREE_ASSERT(NodeCtor(node, NodeArgType::operation      , data, left,           right));  }         while(0)
-#define _SE(  node, left, right            ) do { NodeData_t data = {.oper      = Operation::minus_equal};          TREE_ASSERT(NodeCtor(node, NodeArgType::operation      , data, left,           right));  }         while(0)
-#define _ME(  node, left, right            ) do { NodeData_t data = {.oper      = Operation::mul_equal};            TREE_ASSERT(NodeCtor(node, NodeArgType::operation      , data, left,           right));  }         while(0)
-#define _DE(  node, left, right            ) do { NodeData_t data = {.oper      = Operation::minus};                TREE_ASSERT(NodeCtor(node, NodeArgType::operation      , data, left,           right));  }         while(0)
-#define _POW( node, left, right            ) do { NodeData_t data = {.oper      = Operation::power};                TREE_ASSERT(NodeCtor(node, NodeArgType::operation      , data, left,           right));  }         while(0)
-#define _ASG( node, left                   ) do { NodeData_t data = {.oper      = Operation::assign};               TREE_ASSERT(NodeCtor(node, NodeArgType::operation      , data, left,           nullptr));  }       while(0)
-#define _GR(  node, left,  right           ) do { NodeData_t data = {.oper      = Operation::greater};              TREE_ASSERT(NodeCtor(node, NodeArgType::operation      , data, left,           right));  }         while(0)
-#define _GROE(node, left, right            ) do { NodeData_t data = {.oper      = Operation::greater_or_equal};     TREE_ASSERT(NodeCtor(node, NodeArgType::operation      , data, left,           right));  }         while(0)
-#define _LS(  node, left, right            ) do { NodeData_t data = {.oper      = Operation::less};                 TREE_ASSERT(NodeCtor(node, NodeArgType::operation      , data, left,           right));  }         while(0)
-#define _LSOE(node, left, right            ) do { NodeData_t data = {.oper      = Operation::less_or_equal};        TREE_ASSERT(NodeCtor(node, NodeArgType::operation      , data, left,           right));  }         while(0)
-#define _EQ(  node, left, right            ) do { NodeData_t data = {.oper      = Operation::equal};                TREE_ASSERT(NodeCtor(node, NodeArgType::operation      , data, left,           right));  }         while(0)
-#define _NEQ( node, left, right            ) do { NodeData_t data = {.oper      = Operation::not_equal};            TREE_ASSERT(NodeCtor(node, NodeArgType::operation      , data, left,           right));  }         while(0)
-#define _AND( node, left, right            ) do { NodeData_t data = {.oper      = Operation::bool_and};             TREE_ASSERT(NodeCtor(node, NodeArgType::operation      , data, left,           right));  }         while(0)
-#define _OR(  node, left, right            ) do { NodeData_t data = {.oper      = Operation::bool_or};              TREE_ASSERT(NodeCtor(node, NodeArgType::operation      , data, left,           right));  }         while(0)
-#define _NOT( node, left                   ) do { NodeData_t data = {.oper      = Operation::bool_not};             TREE_ASSERT(NodeCtor(node, NodeArgType::operation      , data, left,           nullptr));}         while(0)
-#define _IF(  node, left, right            ) do { NodeData_t data = {.condition = Condition::if_t};                 TREE_ASSERT(NodeCtor(node, NodeArgType::condition      , data, left,           right));  }         while(0)
-#define _ELIF(node, left, right            ) do { NodeData_t data = {.condition = Condition::else_if_t};            TREE_ASSERT(NodeCtor(node, NodeArgType::condition      , data, left,           right));  }         while(0)
-#define _ELSE(node,       right            ) do { NodeData_t data = {.condition = Condition::else_t};               TREE_ASSERT(NodeCtor(node, NodeArgType::condition      , data, nullptr,        right));  }         while(0)
-#define _RET( node, left                   ) do { NodeData_t data = {.attribute = FunctionAttribute::ret};          TREE_ASSERT(NodeCtor(node, NodeArgType::attribute      , data, left,           nullptr));}         while(0)
-#define _PRINT(node, left                  ) do { NodeData_t data = {.function = DFunction::print};                 TREE_ASSERT(NodeCtor(node, NodeArgType::dfunction      , data, left,           nullptr));}         while(0)
+#define _MUL( node, arena, left, right            ) do { NodeData_t data = {.oper      = Operation::mul};                  TREE_ASSERT(NodeCtor(node, arena, NodeArgType::operation      , data, left,           right));  }         while(0)
+#define _DIV( node, arena, left, right            ) do { NodeData_t data = {.oper      = Operation::dive};                 TREE_ASSERT(NodeCtor(node, arena, NodeArgType::operation      , data, left,           right));  }         while(0)
+#define _ADD( node, arena, left, right            ) do { NodeData_t data = {.oper      = Operation::plus};                 TREE_ASSERT(NodeCtor(node, arena, NodeArgType::operation      , data, left,           right));  }         while(0)
+#define _SUB( node, arena, left, right            ) do { NodeData_t data = {.oper      = Operation::minus};                TREE_ASSERT(NodeCtor(node, arena, NodeArgType::operation      , data, left,           right));  }         while(0)
+#define _PP(  node, arena, left, right            ) do { NodeData_t data = {.oper      = Operation::plus_plus};            TREE_ASSERT(NodeCtor(node, arena, NodeArgType::operation      , data, left,           right));  }         while(0)
+#define _MM(  node, arena, left, right            ) do { NodeData_t data = {.oper      = Operation::minus_minus};          TREE_ASSERT(NodeCtor(node, arena, NodeArgType::operation      , data, left,           right));  }         while(0)
+#define _PE(  node, arena, left, right            ) do { NodeData_t data = {.oper      = Operation::plus_equal};           TREE_ASSERT(NodeCtor(node, arena, NodeArgType::operation      , data, left,           right));  }         while(0)
+#define _SE(  node, arena, left, right            ) do { NodeData_t data = {.oper      = Operation::minus_equal};          TREE_ASSERT(NodeCtor(node, arena, NodeArgType::operation      , data, left,           right));  }         while(0)
+#define _ME(  node, arena, left, right            ) do { NodeData_t data = {.oper      = Operation::mul_equal};            TREE_ASSERT(NodeCtor(node, arena, NodeArgType::operation      , data, left,           right));  }         while(0)
+#define _DE(  node, arena, left, right            ) do { NodeData_t data = {.oper      = Operation::minus};                TREE_ASSERT(NodeCtor(node, arena, NodeArgType::operation      , data, left,           right));  }         while(0)
+#define _POW( node, arena, left, right            ) do { NodeData_t data = {.oper      = Operation::power};                TREE_ASSERT(NodeCtor(node, arena, NodeArgType::operation      , data, left,           right));  }         while(0)
+#define _ASG( node, arena, left                   ) do { NodeData_t data = {.oper      = Operation::assign};               TREE_ASSERT(NodeCtor(node, arena, NodeArgType::operation      , data, left,           nullptr));  }       while(0)
+#define _GR(  node, arena, left,  right           ) do { NodeData_t data = {.oper      = Operation::greater};              TREE_ASSERT(NodeCtor(node, arena, NodeArgType::operation      , data, left,           right));  }         while(0)
+#define _GROE(node, arena, left, right            ) do { NodeData_t data = {.oper      = Operation::greater_or_equal};     TREE_ASSERT(NodeCtor(node, arena, NodeArgType::operation      , data, left,           right));  }         while(0)
+#define _LS(  node, arena, left, right            ) do { NodeData_t data = {.oper      = Operation::less};                 TREE_ASSERT(NodeCtor(node, arena, NodeArgType::operation      , data, left,           right));  }         while(0)
+#define _LSOE(node, arena, left, right            ) do { NodeData_t data = {.oper      = Operation::less_or_equal};        TREE_ASSERT(NodeCtor(node, arena, NodeArgType::operation      , data, left,           right));  }         while(0)
+#define _EQ(  node, arena, left, right            ) do { NodeData_t data = {.oper      = Operation::equal};                TREE_ASSERT(NodeCtor(node, arena, NodeArgType::operation      , data, left,           right));  }         while(0)
+#define _NEQ( node, arena, left, right            ) do { NodeData_t data = {.oper      = Operation::not_equal};            TREE_ASSERT(NodeCtor(node, arena, NodeArgType::operation      , data, left,           right));  }         while(0)
+#define _AND( node, arena, left, right            ) do { NodeData_t data = {.oper      = Operation::bool_and};             TREE_ASSERT(NodeCtor(node, arena, NodeArgType::operation      , data, left,           right));  }         while(0)
+#define _OR(  node, arena, left, right            ) do { NodeData_t data = {.oper      = Operation::bool_or};              TREE_ASSERT(NodeCtor(node, arena, NodeArgType::operation      , data, left,           right));  }         while(0)
+#define _NOT( node, arena, left                   ) do { NodeData_t data = {.oper      = Operation::bool_not};             TREE_ASSERT(NodeCtor(node, arena, NodeArgType::operation      , data, left,           nullptr));}         while(0)
+#define _IF(  node, arena, left, right            ) do { NodeData_t data = {.condition = Condition::if_t};                 TREE_ASSERT(NodeCtor(node, arena, NodeArgType::condition      , data, left,           right));  }         while(0)
+#define _ELIF(node, arena, left, right            ) do { NodeData_t data = {.condition = Condition::else_if_t};            TREE_ASSERT(NodeCtor(node, arena, NodeArgType::condition      , data, left,           right));  }         while(0)
+#define _ELSE(node, arena,       right            ) do { NodeData_t data = {.condition = Condition::else_t};               TREE_ASSERT(NodeCtor(node, arena, NodeArgType::condition      , data, nullptr,        right));  }         while(0)
+#define _RET( node, arena, left                   ) do { NodeData_t data = {.attribute = FunctionAttribute::ret};          TREE_ASSERT(NodeCtor(node, arena, NodeArgType::attribute      , data, left,           nullptr));}         while(0)
+#define _PRINT(node, arena, left                  ) do { NodeData_t data = {.function = DFunction::print};                 TREE_ASSERT(NodeCtor(node, arena, NodeArgType::dfunction      , data, left,           nullptr));}         while(0)
 
 
 #define _SET_MUL( node, left, right        ) do { NodeData_t data = {.oper = Operation::mul};                       TREE_ASSERT(SetNode (node, NodeArgType::operation       , data, left,          right)); }          while(0)
@@ -0,0 +1,329 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <spawn.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include "lib/lib.hpp"
+#include "dump/dump-service.hpp"
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static const char* const DumpDir           = "../dot";
+static const size_t      DumpMaxKinds      = 16;
+static const size_t      DumpMaxWorkers    = 4;
+static const size_t      DumpDotBufferSize = 1 << 20;
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct RenderJob
+{
+    RenderJob* next;
+    DumpFiles  files;
+};
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct DumpService
+{
+    bool            started;
+    bool            stop;
+    bool            dot_missing;
+
+    pthread_mutex_t lock;
+    pthread_cond_t  has_jobs;
+    pthread_cond_t  all_done;
+
+    RenderJob*      head;
+    RenderJob*      tail;
+    size_t          pending;
+
+    size_t          workers_quant;
+    pthread_t*      workers;
+
+    size_t          kinds_quant;
+    const char*     kinds[DumpMaxKinds];
+};
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static DumpService Service = {false, false, false, PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, PTHREAD_COND_INITIALIZER,
+                              nullptr, nullptr, 0, 0, nullptr, 0, {}};
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+extern char** environ;
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void  DumpServiceStart ();
+static void  DumpServiceStop  ();
+static void* RenderWorker     (void* arg);
+static void  Render           (const DumpFiles* files);
+static void  MakeKindDirs     (const char* kind);
+static void  MakeDir          (const char* dir);
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+FILE* DumpOpen(const char* kind, size_t number, DumpFiles* files)
+{
+    assert(kind);
+    assert(files);
+
+    MakeKindDirs(kind);
+
+    snprintf(files->dot, DumpPathMaxLen, "%s/%s/dot/%s%lu.dot", DumpDir, kind, kind, number);
+    snprintf(files->img, DumpPathMaxLen, "%s/%s/img/%s%lu.png", DumpDir, kind, kind, number);
+
+    FILE* dot_file = fopen(files->dot, "w");
+    if (!dot_file)
+        EXIT(EXIT_FAILURE, "failed open '%s'", files->dot);
+
+    // big dumps are written with few write() calls
+    setvbuf(dot_file, nullptr, _IOFBF, DumpDotBufferSize);
+
+    return dot_file;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void DumpClose(FILE* dot_file, const DumpFiles* files)
+{
+    assert(dot_file);
+    assert(files);
+
+    fclose(dot_file);
+
+    RenderJob* job = (RenderJob*) calloc(1, sizeof(*job));
+    if (!job)
+        EXIT(EXIT_FAILURE, "failed calloc memory for dump render job.");
+
+    job->files = *files;
+
+    if (!Service.started)
+        DumpServiceStart();
+
+    pthread_mutex_lock(&Service.lock);
+
+    if (Service.tail) Service.tail->next = job;
+    else              Service.head       = job;
+
+    Service.tail = job;
+    Service.pending++;
+
+    pthread_cond_signal(&Service.has_jobs);
+    pthread_mutex_unlock(&Service.lock);
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void DumpWait()
+{
+    pthread_mutex_lock(&Service.lock);
+
+    while (Service.pending > 0)
+        pthread_cond_wait(&Service.all_done, &Service.lock);
+
+    pthread_mutex_unlock(&Service.lock);
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void DumpServiceStart()
+{
+    assert(!Service.started);
+
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+
+    Service.workers_quant = (cores > 0) ? (size_t) cores : 1;
+    if (Service.workers_quant > DumpMaxWorkers)
+        Service.workers_quant = DumpMaxWorkers;
+
+    Service.workers = (pthread_t*) calloc(Service.workers_quant, sizeof(*Service.workers));
+    if (!Service.workers)
+        EXIT(EXIT_FAILURE, "failed calloc memory for dump workers.");
+
+    for (size_t i = 0; i < Service.workers_quant; i++)
+    {
+        if (pthread_create(&Service.workers[i], nullptr, RenderWorker, nullptr) != 0)
+            EXIT(EXIT_FAILURE, "failed create dump worker thread.");
+    }
+
+    Service.started = true;
+
+    // images of the last dumps are rendered before the process ends, even after EXIT()
+    atexit(DumpServiceStop);
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void DumpServiceStop()
+{
+    DumpWait();
+
+    pthread_mutex_lock(&Service.lock);
+    Service.stop = true;
+    pthread_cond_broadcast(&Service.has_jobs);
+    pthread_mutex_unlock(&Service.lock);
+
+    for (size_t i = 0; i < Service.workers_quant; i++)
+        pthread_join(Service.workers[i], nullptr);
+
+    FREE(Service.workers);
+
+    Service.workers_quant = 0;
+    Service.started       = false;
+    Service.stop          = false;
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void* RenderWorker(void* arg)
+{
+    (void) arg;
+
+    while (true)
+    {
+        pthread_mutex_lock(&Service.lock);
+
+        while (!Service.head && !Service.stop)
+            pthread_cond_wait(&Service.has_jobs, &Service.lock);
+
+        if (!Service.head)
+        {
+            pthread_mutex_unlock(&Service.lock);
+            break;
+        }
+
+        RenderJob* job = Service.head;
+        Service.head   = job->next;
+
+        if (!Service.head)
+            Service.tail = nullptr;
+
+        pthread_mutex_unlock(&Service.lock);
+
+        Render(&job->files);
+        FREE(job);
+
+        pthread_mutex_lock(&Service.lock);
+
+        Service.pending--;
+        if (Service.pending == 0)
+            pthread_cond_broadcast(&Service.all_done);
+
+        pthread_mutex_unlock(&Service.lock);
+    }
+
+    return nullptr;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void Render(const DumpFiles* files)
+{
+    assert(files);
+
+    pthread_mutex_lock(&Service.lock);
+    bool dot_missing = Service.dot_missing;
+    pthread_mutex_unlock(&Service.lock);
+
+    if (dot_missing)
+        return;
+
+    char  dot_name[] = "dot";
+    char  format[]   = "-Tpng";
+    char  out_flag[] = "-o";
+    char  dot_path[DumpPathMaxLen] = {};
+    char  img_path[DumpPathMaxLen] = {};
+
+    memcpy(dot_path, files->dot, DumpPathMaxLen);
+    memcpy(img_path, files->img, DumpPathMaxLen);
+
+    char* argv[] = {dot_name, format, dot_path, out_flag, img_path, nullptr};
+
+    pid_t pid = 0;
+    int   err = posix_spawnp(&pid, dot_name, nullptr, nullptr, argv, environ);
+
+    if (err == ENOENT)
+    {
+        // graphviz is not installed: warn once, .dot files are still written
+        pthread_mutex_lock(&Service.lock);
+
+        if (!Service.dot_missing)
+            fprintf(stderr, "dump: 'dot' is not found, only .dot files are written to '%s'\n", DumpDir);
+
+        Service.dot_missing = true;
+        pthread_mutex_unlock(&Service.lock);
+
+        return;
+    }
+
+    if (err != 0)
+    {
+        fprintf(stderr, "dump: failed run dot for '%s': %s\n", files->dot, strerror(err));
+        return;
+    }
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void MakeKindDirs(const char* kind)
+{
+    assert(kind);
+
+    for (size_t i = 0; i < Service.kinds_quant; i++)
+    {
+        if (strcmp(Service.kinds[i], kind) == 0)
+            return;
+    }
+
+    char dir[DumpPathMaxLen] = {};
+
+    MakeDir(DumpDir);
+
+    snprintf(dir, DumpPathMaxLen, "%s/%s", DumpDir, kind);
+    MakeDir(dir);
+
+    snprintf(dir, DumpPathMaxLen, "%s/%s/dot", DumpDir, kind);
+    MakeDir(dir);
+
+    snprintf(dir, DumpPathMaxLen, "%s/%s/img", DumpDir, kind);
+    MakeDir(dir);
+
+    if (Service.kinds_quant < DumpMaxKinds)
+        Service.kinds[Service.kinds_quant++] = kind;
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void MakeDir(const char* dir)
+{
+    assert(dir);
+
+    if (mkdir(dir, 0755) != 0 && errno != EEXIST)
+        EXIT(EXIT_FAILURE, "failed make dir '%s': %s", dir, strerror(errno));
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,885 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include "lib/lib.hpp"
+#include "log/log-ring.hpp"
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+enum class LogArgType : uint8_t
+{
+    int32   ,
+    int64   ,
+    float64 ,
+    string  ,
+    pointer ,
+};
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+enum LogSectionTag : uint8_t
+{
+    LogChunkTag   = 'C',
+    LogFormatsTag = 'F',
+};
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static const size_t LogMaxArgs          = 16;
+static const size_t LogMaxStringLen     = 1024;
+static const size_t LogThreadBufferSize = 1 << 16;
+static const size_t LogFormatCacheSize  = 64;
+static const size_t LogRecordHeaderSize = 2 + sizeof(uint32_t);
+static const size_t LogMaxSpecLen       = 64;
+static const size_t LogMaxArgTextLen    = LogMaxStringLen + 512;
+
+static const char* const LogBinSignature = "log_bin_format";
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct LogFormat
+{
+    const char* format;
+    uint32_t    id;
+    size_t      args_quant;
+    LogArgType  args[LogMaxArgs];
+};
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct LogThreadBuffer
+{
+    LogThreadBuffer* next;
+    uint32_t         thread;
+    size_t           size;
+    uint8_t          data[LogThreadBufferSize];
+};
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct LogFormatCacheSlot
+{
+    const char*      format;
+    const LogFormat* log_format;
+};
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// thread side: own buffer and format ids cache, both valid only for the log generation they were made in
+struct LogThreadState
+{
+    size_t             generation;
+    LogThreadBuffer*   buffer;
+    LogFormatCacheSlot cache[LogFormatCacheSize];
+};
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct LogRing
+{
+    pthread_mutex_t  lock;
+    FILE*            file;
+    size_t           generation;
+
+    LogFormat**      formats;        // formats[0] is not used: id 0 - record without format
+    size_t           formats_quant;
+    size_t           formats_capacity;
+
+    LogThreadBuffer* buffers;
+    uint32_t         threads_quant;
+};
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct LogText
+{
+    char*  data;
+    size_t size;
+    size_t capacity;
+};
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static LogRing Ring = {PTHREAD_MUTEX_INITIALIZER, nullptr, 0, nullptr, 0, 0, nullptr, 0};
+
+static thread_local LogThreadState ThreadState = {};
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static const LogFormat* GetFormat          (const char* format);
+static const LogFormat* RegisterFormat     (const char* format);
+static void             ParseFormat        (LogFormat* log_format);
+static LogThreadBuffer* GetThreadBuffer    ();
+static void             FlushThreadBuffer  (LogThreadBuffer* buffer);
+static size_t           CalcArgsSize       (const LogFormat* log_format, va_list args);
+static uint8_t*         PutArgs            (uint8_t* data, const LogFormat* log_format, va_list args);
+static void             WriteFormats       ();
+
+static const uint8_t*   DecodeRecord       (const uint8_t* data, const uint8_t* end, const LogFormat* formats, size_t formats_quant,
+                                            LogText* text, LogRecord* record);
+static const uint8_t*   DecodeArgs         (const uint8_t* data, const uint8_t* end, const LogFormat* log_format, LogText* text);
+static LogFormat*       ReadFormats        (const uint8_t* data, size_t size, size_t* formats_quant, char** formats_chars);
+static void             TextPut            (LogText* text, const char* str, size_t len);
+static int              FormatArg          (char* str, size_t size, const char* spec, ...);
+
+static uint32_t         ReadU32            (const uint8_t** data, const uint8_t* end);
+static uint64_t         ReadU64            (const uint8_t** data, const uint8_t* end);
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void LogRingOpen(const char* bin_file)
+{
+    assert(bin_file);
+
+    pthread_mutex_lock(&Ring.lock);
+
+    assert(!Ring.file && "log is already open");
+
+    Ring.file = fopen(bin_file, "wb");
+    if (!Ring.file)
+        EXIT(EXIT_FAILURE, "failed open binary log file: '%s'", bin_file);
+
+    fwrite(LogBinSignature, sizeof(char), strlen(LogBinSignature), Ring.file);
+
+    Ring.generation++;
+    Ring.formats_quant    = 1;
+    Ring.formats_capacity = 64;
+    Ring.formats          = (LogFormat**) calloc(Ring.formats_capacity, sizeof(*Ring.formats));
+
+    if (!Ring.formats)
+        EXIT(EXIT_FAILURE, "failed calloc memory for log formats.");
+
+    pthread_mutex_unlock(&Ring.lock);
+
+    return;
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// all threads must stop logging before close: their buffers are flushed and freed here
+void LogRingClose()
+{
+    pthread_mutex_lock(&Ring.lock);
+
+    assert(Ring.file && "log is not open");
+
+    LogThreadBuffer* buffer = Ring.buffers;
+
+    while (buffer)
+    {
+        LogThreadBuffer* next = buffer->next;
+
+        FlushThreadBuffer(buffer);
+        free(buffer);
+
+        buffer = next;
+    }
+
+    WriteFormats();
+
+    fclose(Ring.file);
+
+    for (size_t i = 1; i < Ring.formats_quant; i++)
+        free(Ring.formats[i]);
+
+    free(Ring.formats);
+
+    Ring.file             = nullptr;
+    Ring.formats          = nullptr;
+    Ring.formats_quant    = 0;
+    Ring.formats_capacity = 0;
+    Ring.buffers          = nullptr;
+    Ring.threads_quant    = 0;
+
+    pthread_mutex_unlock(&Ring.lock);
+
+    return;
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+bool LogRingIsOpen()
+{
+    pthread_mutex_lock(&Ring.lock);
+    bool is_open = (Ring.file != nullptr);
+    pthread_mutex_unlock(&Ring.lock);
+
+    return is_open;
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void LogRingPut(LogRecordKind kind, LogColor color, const char* format, va_list args)
+{
+    LogThreadBuffer* buffer     = GetThreadBuffer();
+    const LogFormat* log_format = format ? GetFormat(format) : nullptr;
+    uint32_t         id         = log_format ? log_format->id : 0;
+
+    va_list size_args;
+    va_copy(size_args, args);
+    size_t size = LogRecordHeaderSize + (log_format ? CalcArgsSize(log_format, size_args) : 0);
+    va_end(size_args);
+
+    assert(size <= LogThreadBufferSize);
+
+    if (buffer->size + size > LogThreadBufferSize)
+    {
+        pthread_mutex_lock(&Ring.lock);
+        FlushThreadBuffer(buffer);
+        pthread_mutex_unlock(&Ring.lock);
+    }
+
+    uint8_t* data = buffer->data + buffer->size;
+
+    *data++ = (uint8_t) kind;
+    *data++ = (uint8_t) color;
+    memcpy(data, &id, sizeof(id));
+    data += sizeof(id);
+
+    if (log_format)
+        data = PutArgs(data, log_format, args);
+
+    buffer->size = (size_t) (data - buffer->data);
+
+    return;
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void LogRingDecode(const char* bin_file, LogRecordHandler handler)
+{
+    assert(bin_file);
+    assert(handler);
+
+    FILE* file = fopen(bin_file, "rb");
+    if (!file)
+        EXIT(EXIT_FAILURE, "failed open binary log file: '%s'", bin_file);
+
+    struct stat file_info = {};
+    stat(bin_file, &file_info);
+
+    size_t   size = (size_t) file_info.st_size;
+    uint8_t* data = (uint8_t*) calloc(size + 1, sizeof(*data));
+
+    if (!data)
+        EXIT(EXIT_FAILURE, "failed calloc memory for binary log.");
+
+    if (fread(data, sizeof(*data), size, file) != size)
+        EXIT(EXIT_FAILURE, "failed read binary log file: '%s'", bin_file);
+
+    fclose(file);
+
+    size_t signature_len = strlen(LogBinSignature);
+
+    if (size < signature_len || memcmp(data, LogBinSignature, signature_len) != 0)
+        EXIT(EXIT_FAILURE, "'%s' is not a binary log file.", bin_file);
+
+    size_t     formats_quant = 0;
+    char*      formats_chars = nullptr;
+    LogFormat* formats       = ReadFormats(data + signature_len, size - signature_len, &formats_quant, &formats_chars);
+
+    LogText        text = {};
+    const uint8_t* cur  = data + signature_len;
+    const uint8_t* end  = data + size;
+
+    while (cur < end && *cur == LogChunkTag)
+    {
+        cur++;
+        ReadU32(&cur, end); // thread, chunks are decoded in file order
+        size_t chunk_size = ReadU32(&cur, end);
+
+        if (chunk_size > (size_t) (end - cur))
+            EXIT(EXIT_FAILURE, "corrupted binary log '%s': chunk is out of file", bin_file);
+
+        const uint8_t* chunk_end = cur + chunk_size;
+
+        while (cur < chunk_end)
+        {
+            LogRecord record = {};
+            cur = DecodeRecord(cur, chunk_end, formats, formats_quant, &text, &record);
+            handler(&record);
+        }
+    }
+
+    free(text.data);
+    free(formats_chars);
+    free(formats);
+    free(data);
+
+    return;
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static const LogFormat* GetFormat(const char* format)
+{
+    assert(format);
+
+    // literals addresses are aligned poorly, so low bits are mixed in
+    size_t              hash = ((size_t) format ^ ((size_t) format >> 7)) % LogFormatCacheSize;
+    LogFormatCacheSlot* slot = &ThreadState.cache[hash];
+
+    if (slot->format == format)
+        return slot->log_format;
+
+    pthread_mutex_lock(&Ring.lock);
+    const LogFormat* log_format = RegisterFormat(format);
+    pthread_mutex_unlock(&Ring.lock);
+
+    *slot = {format, log_format};
+
+    return log_format;
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// formats quant is small (one per LOG_PRINT call site), so a linear search under lock is enough,
+// it happens once per call site and thread thanks to the cache.
+// Every format is allocated alone: threads keep pointers to it while the table grows.
+static const LogFormat* RegisterFormat(const char* format)
+{
+    assert(format);
+
+    for (size_t i = 1; i < Ring.formats_quant; i++)
+    {
+        if (Ring.formats[i]->format == format)
+            return Ring.formats[i];
+    }
+
+    if (Ring.formats_quant == Ring.formats_capacity)
+    {
+        Ring.formats_capacity *= 2;
+        Ring.formats = (LogFormat**) realloc(Ring.formats, Ring.formats_capacity * sizeof(*Ring.formats));
+        if (!Ring.formats)
+            EXIT(EXIT_FAILURE, "failed realloc memory for log formats.");
+    }
+
+    LogFormat* log_format = (LogFormat*) calloc(1, sizeof(*log_format));
+    if (!log_format)
+        EXIT(EXIT_FAILURE, "failed calloc memory for log format.");
+
+    log_format->format = format;
+    log_format->id     = (uint32_t) Ring.formats_quant;
+    ParseFormat(log_format);
+
+    Ring.formats[Ring.formats_quant++] = log_format;
+
+    return log_format;
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void ParseFormat(LogFormat* log_format)
+{
+    assert(log_format);
+    assert(log_format->format);
+
+    const char* cur = log_format->format;
+
+    log_format->args_quant = 0;
+
+    while ((cur = strchr(cur, '%')))
+    {
+        cur++;
+
+        if (*cur == '%')
+        {
+            cur++;
+            continue;
+        }
+
+        while (*cur && strchr("-+ #0", *cur))
+            cur++;
+
+        if (*cur == '*') { log_format->args[log_format->args_quant++] = LogArgType::int32; cur++; }
+        while (*cur >= '0' && *cur <= '9') cur++;
+
+        if (*cur == '.')
+        {
+            cur++;
+            if (*cur == '*') { log_format->args[log_format->args_quant++] = LogArgType::int32; cur++; }
+            while (*cur >= '0' && *cur <= '9') cur++;
+        }
+
+        bool is_long = false;
+
+        while (*cur && strchr("hlzjtL", *cur))
+        {
+            if (*cur != 'h')
+                is_long = true;
+            cur++;
+        }
+
+        LogArgType arg = LogArgType::int32;
+
+        switch (*cur)
+        {
+            case 'd': case 'i': case 'u': case 'x': case 'X': case 'o': case 'c':
+                arg = is_long ? LogArgType::int64 : LogArgType::int32;
+                break;
+            case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+                arg = LogArgType::float64;
+                break;
+            case 's': arg = LogArgType::string;  break;
+            case 'p': arg = LogArgType::pointer; break;
+            default:
+                EXIT(EXIT_FAILURE, "unsupported conversion in log format: \"%s\"", log_format->format);
+        }
+
+        if (log_format->args_quant >= LogMaxArgs)
+            EXIT(EXIT_FAILURE, "too many arguments in log format: \"%s\"", log_format->format);
+
+        log_format->args[log_format->args_quant++] = arg;
+        cur++;
+    }
+
+    return;
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static LogThreadBuffer* GetThreadBuffer()
+{
+    if (ThreadState.generation == Ring.generation && ThreadState.buffer)
+        return ThreadState.buffer;
+
+    LogThreadBuffer* buffer = (LogThreadBuffer*) calloc(1, sizeof(*buffer));
+    if (!buffer)
+        EXIT(EXIT_FAILURE, "failed calloc memory for log thread buffer.");
+
+    pthread_mutex_lock(&Ring.lock);
+
+    assert(Ring.file && "log is not open");
+
+    buffer->thread = Ring.threads_quant++;
+    buffer->next   = Ring.buffers;
+    Ring.buffers   = buffer;
+
+    ThreadState            = {};
+    ThreadState.generation = Ring.generation;
+    ThreadState.buffer     = buffer;
+
+    pthread_mutex_unlock(&Ring.lock);
+
+    return buffer;
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// Ring.lock must be taken
+static void FlushThreadBuffer(LogThreadBuffer* buffer)
+{
+    assert(buffer);
+    assert(Ring.file);
+
+    if (buffer->size == 0)
+        return;
+
+    uint8_t  tag  = LogChunkTag;
+    uint32_t size = (uint32_t) buffer->size;
+
+    fwrite(&tag,            sizeof(tag),            1,            Ring.file);
+    fwrite(&buffer->thread, sizeof(buffer->thread), 1,            Ring.file);
+    fwrite(&size,           sizeof(size),           1,            Ring.file);
+    fwrite(buffer->data,    sizeof(*buffer->data),  buffer->size, Ring.file);
+
+    buffer->size = 0;
+
+    return;
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static size_t CalcArgsSize(const LogFormat* log_format, va_list args)
+{
+    assert(log_format);
+
+    size_t size = 0;
+
+    for (size_t i = 0; i < log_format->args_quant; i++)
+    {
+        switch (log_format->args[i])
+        {
+            case LogArgType::int32:   (void) va_arg(args, int);          size += sizeof(int32_t); break;
+            case LogArgType::int64:   (void) va_arg(args, long);         size += sizeof(int64_t); break;
+            case LogArgType::float64: (void) va_arg(args, double);       size += sizeof(double);  break;
+            case LogArgType::pointer: (void) va_arg(args, void*);        size += sizeof(void*);   break;
+            case LogArgType::string:
+            {
+                const char* str = va_arg(args, const char*);
+                size += sizeof(uint32_t) + (str ? strnlen(str, LogMaxStringLen) : strlen("(null)"));
+                break;
+            }
+            default: assert(0 && "undefined log arg type"); break;
+        }
+    }
+
+    return size;
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static uint8_t* PutArgs(uint8_t* data, const LogFormat* log_format, va_list args)
+{
+    assert(data);
+    assert(log_format);
+
+    for (size_t i = 0; i < log_format->args_quant; i++)
+    {
+        switch (log_format->args[i])
+        {
+            case LogArgType::int32:
+            {
+                int32_t value = va_arg(args, int);
+                memcpy(data, &value, sizeof(value));
+                data += sizeof(value);
+                break;
+            }
+            case LogArgType::int64:
+            {
+                int64_t value = va_arg(args, long);
+                memcpy(data, &value, sizeof(value));
+                data += sizeof(value);
+                break;
+            }
+            case LogArgType::float64:
+            {
+                double value = va_arg(args, double);
+                memcpy(data, &value, sizeof(value));
+                data += sizeof(value);
+                break;
+            }
+            case LogArgType::pointer:
+            {
+                uint64_t value = (uint64_t) va_arg(args, void*);
+                memcpy(data, &value, sizeof(value));
+                data += sizeof(value);
+                break;
+            }
+            case LogArgType::string:
+            {
+                const char* str = va_arg(args, const char*);
+                if (!str) str = "(null)";
+
+                uint32_t len = (uint32_t) strnlen(str, LogMaxStringLen);
+                memcpy(data, &len, sizeof(len));
+                memcpy(data + sizeof(len), str, len);
+                data += sizeof(len) + len;
+                break;
+            }
+            default: assert(0 && "undefined log arg type"); break;
+        }
+    }
+
+    return data;
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// Ring.lock must be taken
+static void WriteFormats()
+{
+    assert(Ring.file);
+
+    uint8_t  tag   = LogFormatsTag;
+    uint32_t quant = (uint32_t) (Ring.formats_quant - 1);
+
+    fwrite(&tag,   sizeof(tag),   1, Ring.file);
+    fwrite(&quant, sizeof(quant), 1, Ring.file);
+
+    for (size_t i = 1; i < Ring.formats_quant; i++)
+    {
+        const LogFormat* log_format = Ring.formats[i];
+
+        uint32_t len        = (uint32_t) strlen(log_format->format);
+        uint8_t  args_quant = (uint8_t) log_format->args_quant;
+
+        fwrite(&len,              sizeof(len),                 1,          Ring.file);
+        fwrite(log_format->format, sizeof(char),               len,        Ring.file);
+        fwrite(&args_quant,       sizeof(args_quant),          1,          Ring.file);
+        fwrite(log_format->args,  sizeof(log_format->args[0]), args_quant, Ring.file);
+    }
+
+    return;
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static const uint8_t* DecodeRecord(const uint8_t* data, const uint8_t* end, const LogFormat* formats, size_t formats_quant,
+                                   LogText* text, LogRecord* record)
+{
+    assert(data);
+    assert(end);
+    assert(text);
+    assert(record);
+
+    if ((size_t) (end - data) < LogRecordHeaderSize)
+        EXIT(EXIT_FAILURE, "corrupted binary log: cut record");
+
+    record->kind  = (LogRecordKind) data[0];
+    record->color = (LogColor)      data[1];
+    data += 2;
+
+    uint32_t id = ReadU32(&data, end);
+
+    if (id > formats_quant)
+        EXIT(EXIT_FAILURE, "corrupted binary log: bad format id %u", id);
+
+    text->size = 0;
+
+    if (id)
+        data = DecodeArgs(data, end, &formats[id], text);
+
+    TextPut(text, "", 0);
+    record->text = text->data;
+
+    return data;
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// format is copied to text piece by piece, every conversion is printed alone with its decoded argument
+static const uint8_t* DecodeArgs(const uint8_t* data, const uint8_t* end, const LogFormat* log_format, LogText* text)
+{
+    assert(data);
+    assert(end);
+    assert(log_format);
+    assert(text);
+
+    const char* cur = log_format->format;
+    size_t      arg = 0;
+
+    char spec    [LogMaxSpecLen]    = {};
+    char arg_text[LogMaxArgTextLen] = {};
+
+    while (*cur)
+    {
+        const char* percent = strchr(cur, '%');
+
+        if (!percent)
+        {
+            TextPut(text, cur, strlen(cur));
+            break;
+        }
+
+        TextPut(text, cur, (size_t) (percent - cur));
+
+        if (percent[1] == '%')
+        {
+            TextPut(text, "%", 1);
+            cur = percent + 2;
+            continue;
+        }
+
+        // spec with '*' replaced by the decoded width / precision
+        size_t      spec_len = 0;
+        const char* spec_cur = percent;
+
+        do
+        {
+            if (spec_len + 16 >= LogMaxSpecLen)
+                EXIT(EXIT_FAILURE, "too long conversion in log format: \"%s\"", log_format->format);
+
+            if (*spec_cur == '*')
+            {
+                int32_t width = (int32_t) ReadU32(&data, end);
+                spec_len += (size_t) snprintf(spec + spec_len, LogMaxSpecLen - spec_len, "%d", width);
+                arg++;
+                spec_cur++;
+                continue;
+            }
+
+            spec[spec_len++] = *spec_cur++;
+        }
+        while (*spec_cur && !strchr("diuxXocfFeEgGaAsp", *spec_cur));
+
+        spec[spec_len++] = *spec_cur++;
+        spec[spec_len]   = '\0';
+        cur = spec_cur;
+
+        assert(arg < log_format->args_quant);
+
+        int len = 0;
+
+        switch (log_format->args[arg++])
+        {
+            case LogArgType::int32:   len = FormatArg(arg_text, sizeof(arg_text), spec, (int32_t) ReadU32(&data, end));             break;
+            case LogArgType::int64:   len = FormatArg(arg_text, sizeof(arg_text), spec, (long)    ReadU64(&data, end));             break;
+            case LogArgType::pointer: len = FormatArg(arg_text, sizeof(arg_text), spec, (void*)   ReadU64(&data, end));             break;
+            case LogArgType::float64:
+            {
+                uint64_t bits  = ReadU64(&data, end);
+                double   value = 0;
+                memcpy(&value, &bits, sizeof(value));
+                len = FormatArg(arg_text, sizeof(arg_text), spec, value);
+                break;
+            }
+            case LogArgType::string:
+            {
+                uint32_t str_len = ReadU32(&data, end);
+
+                if (str_len > LogMaxStringLen || str_len > (size_t) (end - data))
+                    EXIT(EXIT_FAILURE, "corrupted binary log: bad string");
+
+                char str[LogMaxStringLen + 1] = {};
+                memcpy(str, data, str_len);
+                data += str_len;
+
+                len = FormatArg(arg_text, sizeof(arg_text), spec, str);
+                break;
+            }
+            default: EXIT(EXIT_FAILURE, "corrupted binary log: bad arg type");
+        }
+
+        if (len > 0)
+            TextPut(text, arg_text, ((size_t) len < sizeof(arg_text)) ? (size_t) len : sizeof(arg_text) - 1);
+    }
+
+    return data;
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// the formats table is the last section, chunks before it are skipped
+static LogFormat* ReadFormats(const uint8_t* data, size_t size, size_t* formats_quant, char** formats_chars)
+{
+    assert(data);
+    assert(formats_quant);
+    assert(formats_chars);
+
+    const uint8_t* cur = data;
+    const uint8_t* end = data + size;
+
+    while (cur < end && *cur == LogChunkTag)
+    {
+        cur++;
+        ReadU32(&cur, end);
+        size_t chunk_size = ReadU32(&cur, end);
+
+        if (chunk_size > (size_t) (end - cur))
+            EXIT(EXIT_FAILURE, "corrupted binary log: chunk is out of file");
+
+        cur += chunk_size;
+    }
+
+    if (cur == end || *cur != LogFormatsTag)
+        EXIT(EXIT_FAILURE, "corrupted binary log: no formats table (log was not closed?)");
+
+    cur++;
+    *formats_quant = ReadU32(&cur, end);
+
+    // format chars are followed by args quant byte, not by '\0', so they are copied with '\0' added,
+    // table size is enough for all of them
+    LogFormat* formats = (LogFormat*) calloc(*formats_quant + 1, sizeof(*formats));
+    char*      chars   = (char*)      calloc((size_t) (end - cur) + *formats_quant, sizeof(char));
+    if (!formats || !chars)
+        EXIT(EXIT_FAILURE, "failed calloc memory for log formats.");
+
+    *formats_chars = chars;
+
+    for (size_t i = 1; i <= *formats_quant; i++)
+    {
+        size_t len = ReadU32(&cur, end);
+
+        if (len + 1 > (size_t) (end - cur))
+            EXIT(EXIT_FAILURE, "corrupted binary log: format is out of file");
+
+        memcpy(chars, cur, len);
+        cur += len;
+
+        formats[i].format     = chars;
+        chars                += len + 1;
+        formats[i].args_quant = *cur++;
+
+        if (formats[i].args_quant > LogMaxArgs || formats[i].args_quant > (size_t) (end - cur))
+            EXIT(EXIT_FAILURE, "corrupted binary log: bad format args");
+
+        memcpy(formats[i].args, cur, formats[i].args_quant);
+        cur += formats[i].args_quant;
+    }
+
+    return formats;
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void TextPut(LogText* text, const char* str, size_t len)
+{
+    assert(text);
+    assert(str);
+
+    if (text->size + len + 1 > text->capacity)
+    {
+        size_t capacity = text->capacity ? text->capacity : 256;
+        while (text->size + len + 1 > capacity)
+            capacity *= 2;
+
+        text->data = (char*) realloc(text->data, capacity);
+        if (!text->data)
+            EXIT(EXIT_FAILURE, "failed realloc memory for log text.");
+
+        text->capacity = capacity;
+    }
+
+    memcpy(text->data + text->size, str, len);
+    text->size += len;
+    text->data[text->size] = '\0';
+
+    return;
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static int FormatArg(char* str, size_t size, const char* spec, ...)
+{
+    assert(str);
+    assert(spec);
+
+    va_list args;
+    va_start(args, spec);
+
+    int len = vsnprintf(str, size, spec, args);
+
+    va_end(args);
+
+    return len;
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static uint32_t ReadU32(const uint8_t** data, const uint8_t* end)
+{
+    assert(data);
+    assert(*data);
+
+    if ((size_t) (end - *data) < sizeof(uint32_t))
+        EXIT(EXIT_FAILURE, "corrupted binary log: unexpected end of file");
+
+    uint32_t value = 0;
+    memcpy(&value, *data, sizeof(value));
+    *data += sizeof(value);
+
+    return value;
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static uint64_t ReadU64(const uint8_t** data, const uint8_t* end)
+{
+    assert(data);
+    assert(*data);
+
+    if ((size_t) (end - *data) < sizeof(uint64_t))
+        EXIT(EXIT_FAILURE, "corrupted binary log: unexpected end of file");
+
+    uint64_t value = 0;
+    memcpy(&value, *data, sizeof(value));
+    *data += sizeof(value);
+
+    return value;
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -1,16 +1,21 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdarg.h>
-#include <string.h> // for LogTitle only
+#include <string.h> // for RenderTitle only
 #include <assert.h>
 #include <time.h>
+#include <errno.h>
+#include <sys/stat.h>
 #include "log/log.hpp"
+#include "log/log-ring.hpp"
 #include "lib/lib.hpp"
 
 //---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-const char* LogName = "../Log/log.html";
-FILE*       LogFile = nullptr;
+const char* LogDir     = "../Log";
+const char* LogName    = "../Log/log.html";
+const char* LogBinName = "../Log/log.bin";
+FILE*       LogFile    = nullptr;    // html file, it is open only while binary log is decoded
 
 //---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
@@ -81,31 +86,43 @@ static void makeColor                (                        size_t nTabBefore)
 static void makeColorP               (                        size_t nTabBefore);
 static void makeH1                   (                        size_t nTabBefore);
 static void makeH2                   (                        size_t nTabBefore);
-static void LogDate                  (                        size_t nTabBefore);
+static void LogDate                  ();
 
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void LogRecordPut             (LogRecordKind kind, LogColor color, const char* format, ...);
+static void CloseLogAtExit           ();
+
+static void RenderRecord             (const LogRecord* record);
+static void RenderTextColor          (LogColor color);
+static void RenderTextColorEnd       ();
+static void RenderAdcPrint           (const char* text);
+static void RenderPrint              (LogColor color, const char* text);
+static void RenderTitle              (LogColor color, const char* title);
 
 //---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
+
 void OpenLog()
 {
-    assert(LogName && "logName = nullptr");
+    assert(LogDir);
+    assert(LogBinName);
 
-    int sys_return = system("mkdir -p ../Log/");
-    
-    if (sys_return != 0)
-        EXIT(EXIT_FAILURE, "failed create log dir.");
+    if (mkdir(LogDir, 0755) != 0 && errno != EEXIST)
+        EXIT(EXIT_FAILURE, "failed create log dir: '%s'", LogDir);
 
-    LogFile = fopen(LogName, "w");
-    if (!LogFile)
-        EXIT(EXIT_FAILURE, "failed open log file: '%s'\n", LogName);
+    LogRingOpen(LogBinName);
 
-    fprintfHtml(); fprintfNS();
-
-    makeStyle(ON_IMG(background_image,) 1);
+    // program may leave through EXIT() with log open, the html is still made then
+    static bool AtExitRegistered = false;
 
-    makeTextClass(0);
+    if (!AtExitRegistered)
+    {
+        atexit(CloseLogAtExit);
+        AtExitRegistered = true;
+    }
 
-    LogDate(3);
+    LogDate();
 
     LogPrint(White, "\n");
 
@@ -116,9 +133,36 @@ void OpenLog()
 
 void CloseLog()
 {
-    assert(LogFile);
+    assert(LogRingIsOpen());
+
+    LogDate();
+
+    LogRingClose();
+
+    LogDecode(LogBinName, LogName);
+
+    return;
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void LogDecode(const char* bin_file, const char* html_file)
+{
+    assert(bin_file);
+    assert(html_file);
+    assert(!LogFile);
+
+    LogFile = fopen(html_file, "w");
+    if (!LogFile)
+        EXIT(EXIT_FAILURE, "failed open log file: '%s'\n", html_file);
 
-    LogDate(3);
+    fprintfHtml(); fprintfNS();
+
+    makeStyle(ON_IMG(background_image,) 1);
+
+    makeTextClass(0);
+
+    LogRingDecode(bin_file, RenderRecord);
 
     fclose(LogFile);
     LogFile = nullptr;
@@ -129,12 +173,135 @@ void CloseLog()
 //---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
 void LogTextColor(LogColor color)
+{
+    LogRecordPut(LogRecordKind::color, color, nullptr);
+
+    return;
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void LogTextColorEnd()
+{
+    LogRecordPut(LogRecordKind::color_end, White, nullptr);
+
+    return;
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void LogAdcPrint(const char* format, ...)
+{
+    assert(format);
+
+    va_list args;
+    va_start(args, format);
+
+    LogRingPut(LogRecordKind::adc_print, White, format, args);
+
+    va_end(args);
+
+    return;
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void LogPrint(LogColor color, const char* format, ...)
+{
+    assert(format);
+
+    va_list args;
+    va_start(args, format);
+
+    LogRingPut(LogRecordKind::print, color, format, args);
+
+    va_end(args);
+
+    return;
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void LogTitle(LogColor color, const char* title)
+{
+    assert(title);
+
+    LogRecordPut(LogRecordKind::title, color, "%s", title);
+
+    return;
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void LogDate()
+{
+    time_t raw_time;
+    struct tm *time_info;
+    static const size_t date_len = 64;
+    char date[date_len] = {};
+
+    time(&raw_time);
+    time_info = localtime(&raw_time);
+    strftime(date, date_len, "%H:%M:%S %Y-%m-%d", time_info);
+
+    LogTitle(White, date);
+
+    return;
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void LogRecordPut(LogRecordKind kind, LogColor color, const char* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+
+    LogRingPut(kind, color, format, args);
+
+    va_end(args);
+
+    return;
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void CloseLogAtExit()
+{
+    if (LogRingIsOpen())
+        CloseLog();
+
+    return;
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void RenderRecord(const LogRecord* record)
+{
+    assert(record);
+    assert(record->text);
+
+    switch (record->kind)
+    {
+        case LogRecordKind::print:     RenderPrint        (record->color, record->text); break;
+        case LogRecordKind::adc_print: RenderAdcPrint     (               record->text); break;
+        case LogRecordKind::color:     RenderTextColor    (record->color);               break;
+        case LogRecordKind::color_end: RenderTextColorEnd ();                            break;
+        case LogRecordKind::title:     RenderTitle        (record->color, record->text); break;
+        default: EXIT(EXIT_FAILURE, "undefined log record kind: %d", (int) record->kind);
+    }
+
+    return;
+}
+
+//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void RenderTextColor(LogColor color)
 {
     static bool WasUsed = false;
 
     if (WasUsed)
     {
-        LogTextColorEnd();
+        RenderTextColorEnd();
         WasUsed = false;
     }
 
@@ -147,13 +314,13 @@ void LogTextColor(LogColor color)
 
     fprintfNTab(3);
         fprintfSpanWithArgs("class=\"color %s\"", color_html); fprintfNS();
-        
+
     return;
 }
 
 //---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-void LogTextColorEnd()
+static void RenderTextColorEnd()
 {
     fprintfNTab(3); fprintfSpanEnd(); fprintfNS();
 
@@ -162,39 +329,26 @@ void LogTextColorEnd()
 
 //---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-void LogAdcPrint(const char* format, ...)
+static void RenderAdcPrint(const char* text)
 {
-    va_list args;
-    va_start(args, format);
-
-    fprintfNTab(4); fprintfPtext(); vfprintf(LogFile, format, args); fprintfPtextEnd(); fprintfNS();
+    assert(text);
 
-    fflush(LogFile);
-
-    va_end(args);
+    fprintfNTab(4); fprintfPtext(); fprintfInHtml("%s", text); fprintfPtextEnd(); fprintfNS();
 
     return;
 }
 
 //---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-void LogPrint(LogColor color, const char* format, ...)
+static void RenderPrint(LogColor color, const char* text)
 {
-    assert(LogFile);
-    assert(format);
+    assert(text);
 
-    va_list args;
-    va_start(args, format);
-    
     const char* color_html = GetHtmlColor(color);
     fprintfNTab(3);
     fprintfSpanWithArgs("class=\"color %s\"", color_html); fprintfNS();
 
-    fprintfNTab(4); fprintfPtext(); vfprintf(LogFile, format, args); fprintfPtextEnd(); fprintfNS();
-    
-    fflush(LogFile);
-
-    va_end(args);
+    fprintfNTab(4); fprintfPtext(); fprintfInHtml("%s", text); fprintfPtextEnd(); fprintfNS();
 
     fprintfNTab(3);
     fprintfSpanEnd(); fprintfNS();
@@ -204,9 +358,8 @@ void LogPrint(LogColor color, const char* format, ...)
 
 //---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-void LogTitle(LogColor color, const char* title)
+static void RenderTitle(LogColor color, const char* title)
 {
-    assert(LogFile);
     assert(title);
 
     static const size_t ScreenSize = 45; //count in char's, that size is like h2
@@ -217,7 +370,7 @@ void LogTitle(LogColor color, const char* title)
 
     if (free_place_len > 0 && (ScreenSize - title_len) % 2 == 0) --free_place_len;
 
-    LogTextColor(color);
+    RenderTextColor(color);
 
     fprintfNTab(3);
     fprintfH2();
@@ -225,39 +378,14 @@ void LogTitle(LogColor color, const char* title)
     for (size_t i = 0; i < free_place_len; i++)
         fprintfInHtml("=");
 
-    fprintfInHtml(" ");
-    fprintfInHtml(title);
-    fprintfInHtml(" ");
+    fprintfInHtml(" %s ", title);
 
     for (size_t i = 0; i < free_place_len; i++)
         fprintfInHtml("=");
 
-    
     fprintfH2End(); fprintfNS();
 
-    LogTextColorEnd();
-
-    return;
-}
-
-//---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-
-static void LogDate(size_t nTabBefore)
-{
-    assert(LogFile);
-    assert(LogName);
-
-    time_t raw_time;
-    struct tm *time_info;
-    static const size_t date_len = 64;
-    char date[date_len] = {};
-
-    time(&raw_time);
-    time_info = localtime(&raw_time);
-    strftime(date, date_len, "%H:%M:%S %Y-%m-%d", time_info);
-
-        fprintfNTab(nTabBefore + 1);
-            LogTitle(White, date);
+    RenderTextColorEnd();
 
     return;
 }
@@ -666,7 +794,6 @@ static void fprintfInHtml(const char* format, ...)
     va_start(args, format);
 
     vfprintf(LogFile, format, args);
-    fflush(LogFile);
 
     va_end(args);
 
@@ -756,7 +883,6 @@ static void fprintfMetaWithArgs(const char* format, ...)
     fprintfInHtml("<meta ");
 
     vfprintf(LogFile, format, args);
-    fflush(LogFile);
 
     fprintfInHtml(">");
 
@@ -773,7 +899,6 @@ static void fprintfDivWithArgs(const char* format, ...)
     fprintfInHtml("<div ");
 
     vfprintf(LogFile, format, args);
-    fflush(LogFile);
 
     fprintfInHtml(">");
 
@@ -790,7 +915,6 @@ static void fprintfSpanWithArgs(const char* format, ...)
     fprintfInHtml("<span ");
 
     vfprintf(LogFile, format, args);
-    fflush(LogFile);
 
     fprintfInHtml(">");
 
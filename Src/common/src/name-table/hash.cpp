@@ -4,11 +4,11 @@
 #include "name-table/hash.hpp"
 
 
-uint64_t Hash(void* Arr, size_t ArrElemQuant, size_t ArrElemSize)
+uint64_t Hash(const void* Arr, size_t ArrElemQuant, size_t ArrElemSize)
 {
     assert(Arr != NULL);
 
-    char* ArrChar = (char*) Arr;
+    const char* ArrChar = (const char*) Arr;
     uint64_t ArrHash = 5381;
 
     for (size_t Arr_i = 0; Arr_i < ArrElemQuant * ArrElemSize; Arr_i++)
@@ -0,0 +1,250 @@
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "lib/lib.hpp"
+#include "name-table/hash.hpp"
+#include "name-table/interner/interner.hpp"
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static NameInterner Interner = {};
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static uint64_t HashName            (const NameInfo* name);
+static size_t   FindSlot            (const NameInfo* name, uint64_t hash);
+static void     SlotsRehash         ();
+static char*    CopyChars           (const NameInfo* name);
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void InternerCtor(size_t capacity)
+{
+    assert(capacity > 0);
+    assert(!Interner.slots);
+
+    size_t slots_capacity = 1;
+    while (slots_capacity < 2 * capacity)
+        slots_capacity *= 2;
+
+    Interner.slots_capacity = slots_capacity;
+    Interner.slots          = (InternSlot*) calloc(slots_capacity, sizeof(*Interner.slots));
+    Interner.names_capacity = capacity + 1;
+    Interner.names          = (NameInfo*)   calloc(Interner.names_capacity, sizeof(*Interner.names));
+
+    if (!Interner.slots || !Interner.names)
+        EXIT(EXIT_FAILURE, "failed calloc memory for names interner.");
+
+    Interner.names_size = 1; // names[NameNoId] is never used
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void InternerDtor()
+{
+    FREE(Interner.slots);
+    FREE(Interner.names);
+
+    InternCharsBlock* block = Interner.chars;
+
+    while (block)
+    {
+        InternCharsBlock* prev = block->prev;
+        FREE(block);
+        block = prev;
+    }
+
+    Interner = {};
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+NameId InternName(const NameInfo* name)
+{
+    assert(name);
+    assert(name->name);
+
+    if (!Interner.slots)
+        InternerCtor(InternerDefaultCapacity);
+
+    uint64_t hash = HashName(name);
+    size_t   slot = FindSlot(name, hash);
+
+    if (Interner.slots[slot].id != NameNoId)
+        return Interner.slots[slot].id;
+
+    if (Interner.names_size == Interner.names_capacity)
+    {
+        Interner.names_capacity *= 2;
+        Interner.names = (NameInfo*) realloc(Interner.names, Interner.names_capacity * sizeof(*Interner.names));
+        if (!Interner.names)
+            EXIT(EXIT_FAILURE, "failed realloc memory for names interner.");
+    }
+
+    NameId id = (NameId) Interner.names_size;
+    Interner.names_size++;
+
+    Interner.names[id]   = *name;
+    Interner.slots[slot] = {hash, id};
+
+    // keep load factor <= 1/2, so linear probing stays short
+    if (2 * Interner.names_size > Interner.slots_capacity)
+        SlotsRehash();
+
+    return id;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+NameId InternNameCopy(const NameInfo* name)
+{
+    assert(name);
+    assert(name->name);
+
+    NameId id = GetNameId(name);
+
+    if (id != NameNoId)
+        return id;
+
+    NameInfo copy = {CopyChars(name), name->len};
+
+    return InternName(&copy);
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+NameId GetNameId(const NameInfo* name)
+{
+    assert(name);
+    assert(name->name);
+
+    if (!Interner.slots)
+        return NameNoId;
+
+    return Interner.slots[FindSlot(name, HashName(name))].id;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+NameInfo GetInternedName(NameId id)
+{
+    assert(id != NameNoId);
+    assert(id < Interner.names_size);
+
+    return Interner.names[id];
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+size_t GetInternedNamesQuant()
+{
+    return (Interner.names_size > 0) ? Interner.names_size - 1 : 0;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static uint64_t HashName(const NameInfo* name)
+{
+    assert(name);
+
+    return Hash(name->name, name->len, sizeof(char));
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static size_t FindSlot(const NameInfo* name, uint64_t hash)
+{
+    assert(name);
+
+    size_t mask = Interner.slots_capacity - 1;
+    size_t slot = hash & mask;
+
+    while (true)
+    {
+        const InternSlot* cur = &Interner.slots[slot];
+
+        if (cur->id == NameNoId)
+            return slot;
+
+        if (cur->hash == hash)
+        {
+            const NameInfo* cur_name = &Interner.names[cur->id];
+
+            if (cur_name->len == name->len && strncmp(cur_name->name, name->name, name->len) == 0)
+                return slot;
+        }
+
+        slot = (slot + 1) & mask;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void SlotsRehash()
+{
+    size_t      old_capacity = Interner.slots_capacity;
+    InternSlot* old_slots    = Interner.slots;
+
+    Interner.slots_capacity = old_capacity * 2;
+    Interner.slots          = (InternSlot*) calloc(Interner.slots_capacity, sizeof(*Interner.slots));
+    if (!Interner.slots)
+        EXIT(EXIT_FAILURE, "failed calloc memory for names interner slots.");
+
+    size_t mask = Interner.slots_capacity - 1;
+
+    for (size_t i = 0; i < old_capacity; i++)
+    {
+        if (old_slots[i].id == NameNoId)
+            continue;
+
+        size_t slot = old_slots[i].hash & mask;
+
+        while (Interner.slots[slot].id != NameNoId)
+            slot = (slot + 1) & mask;
+
+        Interner.slots[slot] = old_slots[i];
+    }
+
+    FREE(old_slots);
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static char* CopyChars(const NameInfo* name)
+{
+    assert(name);
+
+    InternCharsBlock* block = Interner.chars;
+
+    if (!block || block->size + name->len > block->capacity)
+    {
+        size_t capacity = (name->len > InternerCharsBlockCapacity) ? name->len : InternerCharsBlockCapacity;
+
+        // header and chars share one allocation, as in the tree node arena
+        InternCharsBlock* new_block = (InternCharsBlock*) malloc(sizeof(InternCharsBlock) + capacity);
+        if (!new_block)
+            EXIT(EXIT_FAILURE, "failed malloc memory for names interner chars.");
+
+        new_block->prev     = block;
+        new_block->capacity = capacity;
+        new_block->size     = 0;
+        new_block->chars    = (char*) (new_block + 1);
+
+        Interner.chars = new_block;
+        block          = new_block;
+    }
+
+    char* chars = block->chars + block->size;
+    memcpy(chars, name->name, name->len);
+    block->size += name->len;
+
+    return chars;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
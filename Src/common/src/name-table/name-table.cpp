@@ -252,6 +252,9 @@ bool NameCmp(const Name* name1, const Name* name2)
     assert(name1);
     assert(name2);
 
+    if (name1->id != NameNoId && name2->id != NameNoId)
+        return (name1->id == name2->id);
+
     size_t len1 = name1->name.len;
     size_t len2 = name2->name.len;
 
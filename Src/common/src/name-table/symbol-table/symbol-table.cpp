@@ -0,0 +1,187 @@
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "lib/lib.hpp"
+#include "name-table/interner/interner.hpp"
+#include "name-table/symbol-table/symbol-table.hpp"
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void     HeadsReserve        (SymbolTable* table, NameId id);
+static void*    GrowArr             (void* arr, size_t* capacity, size_t elem_size);
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+SymbolTable SymbolTableCtor(size_t capacity)
+{
+    assert(capacity > 0);
+
+    SymbolTable table = {};
+
+    table.heads_capacity    = capacity;
+    table.heads             = (size_t*)        calloc(capacity, sizeof(*table.heads));
+    table.bindings_capacity = capacity;
+    table.bindings          = (SymbolBinding*) calloc(capacity, sizeof(*table.bindings));
+    table.scopes_capacity   = 16;
+    table.scopes            = (size_t*)        calloc(table.scopes_capacity, sizeof(*table.scopes));
+
+    if (!table.heads || !table.bindings || !table.scopes)
+        EXIT(EXIT_FAILURE, "failed calloc memory for symbol table.");
+
+    for (size_t i = 0; i < capacity; i++)
+        table.heads[i] = SymbolNoBinding;
+
+    return table;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void SymbolTableDtor(SymbolTable* table)
+{
+    assert(table);
+
+    FREE(table->heads);
+    FREE(table->bindings);
+    FREE(table->scopes);
+
+    *table = {};
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void SymbolTablePushScope(SymbolTable* table)
+{
+    assert(table);
+
+    if (table->scopes_size == table->scopes_capacity)
+        table->scopes = (size_t*) GrowArr(table->scopes, &table->scopes_capacity, sizeof(*table->scopes));
+
+    table->scopes[table->scopes_size] = table->bindings_size;
+    table->scopes_size++;
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void SymbolTablePopScope(SymbolTable* table)
+{
+    assert(table);
+    assert(table->scopes_size > 0);
+
+    table->scopes_size--;
+    size_t scope_begin = table->scopes[table->scopes_size];
+
+    while (table->bindings_size > scope_begin)
+    {
+        table->bindings_size--;
+        const SymbolBinding* binding = &table->bindings[table->bindings_size];
+        table->heads[binding->name.id] = binding->prev;
+    }
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+bool SymbolTableDefine(SymbolTable* table, const Name* name)
+{
+    assert(table);
+    assert(name);
+
+    NameId id = (name->id != NameNoId) ? name->id : InternName(&name->name);
+
+    HeadsReserve(table, id);
+
+    size_t head = table->heads[id];
+
+    // redefinition in the same scope, shadowing of outer scopes is allowed
+    if (head != SymbolNoBinding && table->bindings[head].scope == table->scopes_size)
+        return false;
+
+    if (table->bindings_size == table->bindings_capacity)
+        table->bindings = (SymbolBinding*) GrowArr(table->bindings, &table->bindings_capacity, sizeof(*table->bindings));
+
+    SymbolBinding* binding = &table->bindings[table->bindings_size];
+
+    binding->name    = *name;
+    binding->name.id = id;
+    binding->scope   = table->scopes_size;
+    binding->prev    = head;
+
+    table->heads[id] = table->bindings_size;
+    table->bindings_size++;
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+const Name* SymbolTableFind(const SymbolTable* table, const NameInfo* name)
+{
+    assert(table);
+    assert(name);
+
+    return SymbolTableFindById(table, GetNameId(name));
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+const Name* SymbolTableFindById(const SymbolTable* table, NameId id)
+{
+    assert(table);
+
+    if (id == NameNoId || id >= table->heads_capacity)
+        return nullptr;
+
+    size_t head = table->heads[id];
+
+    if (head == SymbolNoBinding)
+        return nullptr;
+
+    return &table->bindings[head].name;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void HeadsReserve(SymbolTable* table, NameId id)
+{
+    assert(table);
+
+    if (id < table->heads_capacity)
+        return;
+
+    size_t old_capacity = table->heads_capacity;
+
+    while (table->heads_capacity <= id)
+        table->heads_capacity *= 2;
+
+    table->heads = (size_t*) realloc(table->heads, table->heads_capacity * sizeof(*table->heads));
+    if (!table->heads)
+        EXIT(EXIT_FAILURE, "failed realloc memory for symbol table.");
+
+    for (size_t i = old_capacity; i < table->heads_capacity; i++)
+        table->heads[i] = SymbolNoBinding;
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void* GrowArr(void* arr, size_t* capacity, size_t elem_size)
+{
+    assert(arr);
+    assert(capacity);
+
+    *capacity *= 2;
+
+    void* new_arr = realloc(arr, *capacity * elem_size);
+    if (!new_arr)
+        EXIT(EXIT_FAILURE, "failed realloc memory for symbol table.");
+
+    return new_arr;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,516 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <pthread.h>
+#include "lib/lib.hpp"
+#include "profile/profile.hpp"
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static const char* const ProfileEnv          = "COMPILER_PROFILE";
+static const char* const ProfileDefaultTrace = "profile-trace.json";
+
+static const size_t ProfileThreadEvents = 1 << 12;   // first events buffer of a thread, it grows twice
+static const size_t ProfileMaxEvents    = 1 << 22;   // per thread, later events are only counted as dropped
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct ProfileEvent
+{
+    const ProfileZone* zone;
+    uint64_t           start_ns;
+    uint64_t           duration_ns;
+};
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct ProfileThread
+{
+    ProfileThread* next;
+    uint32_t       id;
+    size_t         size;
+    size_t         capacity;
+    size_t         dropped;
+    ProfileEvent*  events;
+};
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct Profile
+{
+    pthread_mutex_t   lock;
+    uint64_t          start_ns;
+    const char*       trace_file;
+
+    ProfileZone*      zones;
+    ProfileCounter*   counters;
+    ProfileCounters*  counters_arrays;
+    ProfileHistogram* histograms;
+
+    ProfileThread*    threads;
+    uint32_t          threads_quant;
+};
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static Profile Prof = {PTHREAD_MUTEX_INITIALIZER, 0, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, 0};
+
+static thread_local ProfileThread* CurrentThread = nullptr;
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static bool           ProfileInit          ();
+static void           ProfileReport        ();
+static bool           TakeRegistration     (bool* registered);
+static void           EndRegistration      (bool* registered);
+static ProfileThread* GetProfileThread     ();
+static void           PutEvent             (const ProfileZone* zone, uint64_t start_ns, uint64_t duration_ns);
+static void           AtomicMax            (uint64_t* value, uint64_t candidate);
+
+static void           PrintSummary         (FILE* stream);
+static void           PrintZones           (FILE* stream);
+static void           PrintCounters        (FILE* stream);
+static void           PrintHistograms      (FILE* stream);
+static void           WriteTrace           (const char* file);
+static void           PutJsonString        (FILE* stream, const char* str);
+static int            CompareZones         (const void* first, const void* second);
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// the only dynamic initialization: environment is read once, before main
+const bool ProfileEnabled = ProfileInit();
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void ProfileZoneEnd(ProfileZone* zone, uint64_t start_ns)
+{
+    assert(zone);
+
+    uint64_t duration_ns = ProfileNow() - start_ns;
+
+    if (TakeRegistration(&zone->registered))
+    {
+        zone->next = Prof.zones;
+        Prof.zones = zone;
+        EndRegistration(&zone->registered);
+    }
+
+    __atomic_fetch_add(&zone->calls,    1,           __ATOMIC_RELAXED);
+    __atomic_fetch_add(&zone->total_ns, duration_ns, __ATOMIC_RELAXED);
+    AtomicMax(&zone->max_ns, duration_ns);
+
+    PutEvent(zone, start_ns, duration_ns);
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void ProfileCount(ProfileCounter* counter, uint64_t value)
+{
+    assert(counter);
+
+    if (TakeRegistration(&counter->registered))
+    {
+        counter->next = Prof.counters;
+        Prof.counters = counter;
+        EndRegistration(&counter->registered);
+    }
+
+    __atomic_fetch_add(&counter->value, value, __ATOMIC_RELAXED);
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void ProfileCountAt(ProfileCounters* counters, size_t index)
+{
+    assert(counters);
+
+    if (TakeRegistration(&counters->registered))
+    {
+        counters->values = (uint64_t*) calloc(counters->quant, sizeof(*counters->values));
+        if (!counters->values)
+            EXIT(EXIT_FAILURE, "failed calloc memory for profile counters '%s'", counters->name);
+
+        counters->next        = Prof.counters_arrays;
+        Prof.counters_arrays  = counters;
+        EndRegistration(&counters->registered);
+    }
+
+    if (index < counters->quant)
+        __atomic_fetch_add(&counters->values[index], 1, __ATOMIC_RELAXED);
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void ProfileHistogramAdd(ProfileHistogram* histogram, uint64_t value)
+{
+    assert(histogram);
+
+    if (TakeRegistration(&histogram->registered))
+    {
+        histogram->next = Prof.histograms;
+        Prof.histograms = histogram;
+        EndRegistration(&histogram->registered);
+    }
+
+    size_t bucket = value ? (size_t) (64 - __builtin_clzll(value)) : 0;
+    if (bucket >= ProfileHistogramBuckets)
+        bucket = ProfileHistogramBuckets - 1;
+
+    __atomic_fetch_add(&histogram->buckets[bucket], 1, __ATOMIC_RELAXED);
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static bool ProfileInit()
+{
+    const char* env = getenv(ProfileEnv);
+
+    if (!env || !*env || strcmp(env, "0") == 0)
+        return false;
+
+    Prof.start_ns   = ProfileNow();
+    Prof.trace_file = (strcmp(env, "1") == 0) ? ProfileDefaultTrace : env;
+
+    atexit(ProfileReport);
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void ProfileReport()
+{
+    pthread_mutex_lock(&Prof.lock);
+
+    PrintSummary(stderr);
+    WriteTrace(Prof.trace_file);
+
+    pthread_mutex_unlock(&Prof.lock);
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// true - caller links the object into its list under lock and calls EndRegistration()
+static bool TakeRegistration(bool* registered)
+{
+    assert(registered);
+
+    if (__atomic_load_n(registered, __ATOMIC_ACQUIRE))
+        return false;
+
+    pthread_mutex_lock(&Prof.lock);
+
+    if (*registered)
+    {
+        pthread_mutex_unlock(&Prof.lock);
+        return false;
+    }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void EndRegistration(bool* registered)
+{
+    assert(registered);
+
+    __atomic_store_n(registered, true, __ATOMIC_RELEASE);
+
+    pthread_mutex_unlock(&Prof.lock);
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static ProfileThread* GetProfileThread()
+{
+    if (CurrentThread)
+        return CurrentThread;
+
+    ProfileThread* thread = (ProfileThread*) calloc(1, sizeof(*thread));
+    if (!thread)
+        EXIT(EXIT_FAILURE, "failed calloc memory for profile thread.");
+
+    pthread_mutex_lock(&Prof.lock);
+
+    thread->id    = Prof.threads_quant++;
+    thread->next  = Prof.threads;
+    Prof.threads  = thread;
+
+    pthread_mutex_unlock(&Prof.lock);
+
+    CurrentThread = thread;
+
+    return thread;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// events buffer is only written by its thread, report reads it at exit
+static void PutEvent(const ProfileZone* zone, uint64_t start_ns, uint64_t duration_ns)
+{
+    assert(zone);
+
+    ProfileThread* thread = GetProfileThread();
+
+    if (thread->size == thread->capacity)
+    {
+        if (thread->capacity >= ProfileMaxEvents)
+        {
+            thread->dropped++;
+            return;
+        }
+
+        size_t        capacity = thread->capacity ? thread->capacity * 2 : ProfileThreadEvents;
+        ProfileEvent* events   = (ProfileEvent*) realloc(thread->events, capacity * sizeof(*events));
+
+        if (!events)
+        {
+            thread->dropped++;
+            return;
+        }
+
+        thread->events   = events;
+        thread->capacity = capacity;
+    }
+
+    thread->events[thread->size++] = {zone, start_ns, duration_ns};
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void AtomicMax(uint64_t* value, uint64_t candidate)
+{
+    assert(value);
+
+    uint64_t cur = __atomic_load_n(value, __ATOMIC_RELAXED);
+
+    while (cur < candidate && !__atomic_compare_exchange_n(value, &cur, candidate, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        ;
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void PrintSummary(FILE* stream)
+{
+    assert(stream);
+
+    fprintf(stream, "\n========== profile (%.3lf ms) ==========\n", (double) (ProfileNow() - Prof.start_ns) * 1e-6);
+
+    PrintZones     (stream);
+    PrintCounters  (stream);
+    PrintHistograms(stream);
+
+    fprintf(stream, "\ntrace: %s\n", Prof.trace_file);
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void PrintZones(FILE* stream)
+{
+    assert(stream);
+
+    size_t zones_quant = 0;
+    for (const ProfileZone* zone = Prof.zones; zone; zone = zone->next)
+        zones_quant++;
+
+    if (zones_quant == 0)
+        return;
+
+    const ProfileZone** zones = (const ProfileZone**) calloc(zones_quant, sizeof(*zones));
+    if (!zones)
+        EXIT(EXIT_FAILURE, "failed calloc memory for profile report.");
+
+    size_t i = 0;
+    for (const ProfileZone* zone = Prof.zones; zone; zone = zone->next)
+        zones[i++] = zone;
+
+    qsort(zones, zones_quant, sizeof(*zones), CompareZones);
+
+    fprintf(stream, "\n%-32s %12s %14s %14s %14s\n", "zone", "calls", "total, ms", "avg, us", "max, us");
+
+    for (i = 0; i < zones_quant; i++)
+    {
+        const ProfileZone* zone = zones[i];
+
+        fprintf(stream, "%-32s %12lu %14.3lf %14.3lf %14.3lf\n", zone->name, zone->calls,
+                (double) zone->total_ns * 1e-6,
+                (double) zone->total_ns * 1e-3 / (double) zone->calls,
+                (double) zone->max_ns   * 1e-3);
+    }
+
+    free(zones);
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void PrintCounters(FILE* stream)
+{
+    assert(stream);
+
+    if (!Prof.counters && !Prof.counters_arrays)
+        return;
+
+    fprintf(stream, "\n%-32s %12s\n", "counter", "value");
+
+    for (const ProfileCounter* counter = Prof.counters; counter; counter = counter->next)
+        fprintf(stream, "%-32s %12lu\n", counter->name, counter->value);
+
+    for (const ProfileCounters* counters = Prof.counters_arrays; counters; counters = counters->next)
+    {
+        for (size_t i = 0; i < counters->quant; i++)
+        {
+            if (counters->values[i] == 0)
+                continue;
+
+            char name[64] = {};
+            snprintf(name, sizeof(name), "%s[%s]", counters->name, counters->get_name(i));
+
+            fprintf(stream, "%-32s %12lu\n", name, counters->values[i]);
+        }
+    }
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void PrintHistograms(FILE* stream)
+{
+    assert(stream);
+
+    for (const ProfileHistogram* histogram = Prof.histograms; histogram; histogram = histogram->next)
+    {
+        fprintf(stream, "\n%-32s %12s\n", histogram->name, "count");
+
+        for (size_t i = 0; i < ProfileHistogramBuckets; i++)
+        {
+            if (histogram->buckets[i] == 0)
+                continue;
+
+            uint64_t low  = i ? (uint64_t) 1 << (i - 1) : 0;
+            uint64_t high = i ? low * 2 : 1;
+
+            char range[64] = {};
+            snprintf(range, sizeof(range), "  [%lu, %lu)", low, high);
+
+            fprintf(stream, "%-32s %12lu\n", range, histogram->buckets[i]);
+        }
+    }
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// Chrome trace event format: complete events ("X") of zones, counters values as one counter event ("C") at the end
+static void WriteTrace(const char* file)
+{
+    assert(file);
+
+    FILE* stream = fopen(file, "w");
+    if (!stream)
+    {
+        fprintf(stderr, "profile: failed open trace file '%s'\n", file);
+        return;
+    }
+
+    fprintf(stream, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n");
+
+    for (const ProfileThread* thread = Prof.threads; thread; thread = thread->next)
+    {
+        for (size_t i = 0; i < thread->size; i++)
+        {
+            const ProfileEvent* event = &thread->events[i];
+
+            fprintf(stream, "{\"name\": ");
+            PutJsonString(stream, event->zone->name);
+            fprintf(stream, ", \"ph\": \"X\", \"pid\": 0, \"tid\": %u, \"ts\": %.3lf, \"dur\": %.3lf},\n", thread->id,
+                    (double) (event->start_ns - Prof.start_ns) * 1e-3, (double) event->duration_ns * 1e-3);
+        }
+
+        if (thread->dropped)
+            fprintf(stderr, "profile: %lu events of thread %u are not in trace\n", thread->dropped, thread->id);
+    }
+
+    fprintf(stream, "{\"name\": \"counters\", \"ph\": \"C\", \"pid\": 0, \"ts\": %.3lf, \"args\": {",
+            (double) (ProfileNow() - Prof.start_ns) * 1e-3);
+
+    const char* comma = "";
+
+    for (const ProfileCounter* counter = Prof.counters; counter; counter = counter->next)
+    {
+        fprintf(stream, "%s", comma);
+        PutJsonString(stream, counter->name);
+        fprintf(stream, ": %lu", counter->value);
+        comma = ", ";
+    }
+
+    fprintf(stream, "}}\n]}\n");
+
+    fclose(stream);
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void PutJsonString(FILE* stream, const char* str)
+{
+    assert(stream);
+    assert(str);
+
+    fputc('"', stream);
+
+    for (; *str; str++)
+    {
+        if (*str == '"' || *str == '\\')
+            fputc('\\', stream);
+
+        fputc(*str, stream);
+    }
+
+    fputc('"', stream);
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// by total time, the longest first
+static int CompareZones(const void* first, const void* second)
+{
+    assert(first);
+    assert(second);
+
+    const ProfileZone* first_zone  = *(const ProfileZone* const*) first;
+    const ProfileZone* second_zone = *(const ProfileZone* const*) second;
+
+    if (first_zone->total_ns == second_zone->total_ns)
+        return 0;
+
+    return (first_zone->total_ns > second_zone->total_ns) ? -1 : 1;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
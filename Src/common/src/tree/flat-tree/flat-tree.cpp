@@ -0,0 +1,371 @@
+#include <stdlib.h>
+#include <assert.h>
+#include "lib/lib.hpp"
+#include "tree/tree.hpp"
+#include "tree/flat-tree/flat-tree.hpp"
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct FlatTreeCounts
+{
+    size_t nodes;
+    size_t names;
+    size_t numbers;
+};
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void     CountNodes      (const Node_t* node, FlatTreeCounts* counts);
+static uint32_t FlattenNode     (FlatTree* flat, const Node_t* node, size_t* pointer);
+static uint32_t EncodePayload   (FlatTree* flat, const Node_t* node);
+
+static bool     HasLeft         (const FlatTree* flat, size_t node);
+static bool     HasRight        (const FlatTree* flat, size_t node);
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+FlatTree FlatTreeCtor(const Tree_t* tree)
+{
+    assert(tree);
+
+    FlatTree flat = {};
+
+    FlatTreeCounts counts = {};
+    CountNodes(tree->root, &counts);
+
+    if (counts.nodes == 0)
+        return flat;
+
+    if (counts.nodes > UINT32_MAX)
+        EXIT(EXIT_FAILURE, "tree is too big for flat tree: %lu nodes.", counts.nodes);
+
+    flat.kinds    = (uint8_t*)  calloc(counts.nodes, sizeof(*flat.kinds   ));
+    flat.links    = (uint8_t*)  calloc(counts.nodes, sizeof(*flat.links   ));
+    flat.sizes    = (uint32_t*) calloc(counts.nodes, sizeof(*flat.sizes   ));
+    flat.payloads = (uint32_t*) calloc(counts.nodes, sizeof(*flat.payloads));
+    flat.names    = (Name*)     calloc(counts.names   + 1, sizeof(*flat.names  ));
+    flat.numbers  = (Number*)   calloc(counts.numbers + 1, sizeof(*flat.numbers));
+
+    if (!flat.kinds || !flat.links || !flat.sizes || !flat.payloads || !flat.names || !flat.numbers)
+        EXIT(EXIT_FAILURE, "failed calloc memory for flat tree.");
+
+    size_t pointer = 0;
+    FlattenNode(&flat, tree->root, &pointer);
+
+    flat.size = pointer;
+    assert(flat.size == counts.nodes);
+
+    return flat;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void FlatTreeDtor(FlatTree* flat)
+{
+    assert(flat);
+
+    FREE(flat->kinds);
+    FREE(flat->links);
+    FREE(flat->sizes);
+    FREE(flat->payloads);
+    FREE(flat->names);
+    FREE(flat->numbers);
+
+    *flat = {};
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// tree is constructed here, its nodes go to its own arena
+void FlatTreeToTree(const FlatTree* flat, Tree_t* tree)
+{
+    assert(flat);
+    assert(tree);
+
+    TreeCtor(tree);
+
+    if (flat->size == 0)
+        return;
+
+    Node_t** nodes = (Node_t**) calloc(flat->size, sizeof(*nodes));
+    if (!nodes)
+        EXIT(EXIT_FAILURE, "failed calloc memory for flat tree nodes.");
+
+    // nodes are created in pre-order, so they keep the flat layout in memory (and in the arena)
+    for (size_t i = 0; i < flat->size; i++)
+        TREE_ASSERT(NodeCtor(&nodes[i], tree->arena, FlatTreeGetType(flat, i), FlatTreeGetData(flat, i), nullptr, nullptr));
+
+    for (size_t i = 0; i < flat->size; i++)
+    {
+        if (HasLeft (flat, i)) nodes[i]->left  = nodes[FlatTreeGetLeft (flat, i)];
+        if (HasRight(flat, i)) nodes[i]->right = nodes[FlatTreeGetRight(flat, i)];
+    }
+
+    tree->root = nodes[0];
+
+    FREE(nodes);
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+NodeArgType FlatTreeGetType(const FlatTree* flat, size_t node)
+{
+    assert(flat);
+    assert(node < flat->size);
+
+    return (NodeArgType) flat->kinds[node];
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+NodeData_t FlatTreeGetData(const FlatTree* flat, size_t node)
+{
+    assert(flat);
+    assert(node < flat->size);
+
+    NodeData_t data    = {};
+    uint32_t   payload = flat->payloads[node];
+
+    switch ((NodeArgType) flat->kinds[node])
+    {
+        case NodeArgType::number:         data.num       = flat->numbers[payload];            break;
+        case NodeArgType::name:           data.name      = flat->names  [payload];            break;
+        case NodeArgType::operation:      data.oper      = (Operation)         payload;       break;
+        case NodeArgType::connect:        data.connect   = (Connect)           payload;       break;
+        case NodeArgType::type:           data.type      = (Type)              payload;       break;
+        case NodeArgType::condition:      data.condition = (Condition)         payload;       break;
+        case NodeArgType::cycle:          data.cycle     = (Cycle)             payload;       break;
+        case NodeArgType::dfunction:      data.function  = (DFunction)         payload;       break;
+        case NodeArgType::attribute:      data.attribute = (FunctionAttribute) payload;       break;
+        case NodeArgType::initialisation: data.init      = (Initialisation)    payload;       break;
+        case NodeArgType::undefined:
+        default:                                                                              break;
+    }
+
+    return data;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+size_t FlatTreeGetLeft(const FlatTree* flat, size_t node)
+{
+    assert(flat);
+    assert(node < flat->size);
+
+    if (!HasLeft(flat, node))
+        return FlatTreeNoNode;
+
+    return node + 1;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+size_t FlatTreeGetRight(const FlatTree* flat, size_t node)
+{
+    assert(flat);
+    assert(node < flat->size);
+
+    if (!HasRight(flat, node))
+        return FlatTreeNoNode;
+
+    if (!HasLeft(flat, node))
+        return node + 1;
+
+    return node + 1 + flat->sizes[node + 1];
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+size_t FlatTreeGetNext(const FlatTree* flat, size_t node)
+{
+    assert(flat);
+    assert(node < flat->size);
+
+    size_t next = node + flat->sizes[node];
+
+    if (next >= flat->size)
+        return FlatTreeNoNode;
+
+    return next;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+size_t FlatTreeMemory(const FlatTree* flat)
+{
+    assert(flat);
+
+    return flat->size         * (sizeof(*flat->kinds) + sizeof(*flat->links) + sizeof(*flat->sizes) + sizeof(*flat->payloads)) +
+           flat->names_size   *  sizeof(*flat->names)                                                                           +
+           flat->numbers_size *  sizeof(*flat->numbers);
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+TreeErr FlatTreeVerif(const FlatTree* flat, TreeErr* err, const char* file, const int line, const char* func)
+{
+    assert(flat);
+    assert(err);
+    assert(file);
+    assert(func);
+
+    CodePlaceCtor(&err->place, file, line, func);
+
+    for (size_t i = 0; i < flat->size; i++)
+    {
+        size_t subtree_size = flat->sizes[i];
+        size_t left         = FlatTreeGetLeft (flat, i);
+        size_t right        = FlatTreeGetRight(flat, i);
+
+        size_t left_size    = (left  == FlatTreeNoNode) ? 0 : flat->sizes[left ];
+        size_t right_size   = (right == FlatTreeNoNode) ? 0 : flat->sizes[right];
+
+        RETURN_IF_FALSE(subtree_size >= 1 && i + subtree_size <= flat->size,       *err, err->err = TreeErrorType::INCORRECT_TREE_SIZE);
+        RETURN_IF_FALSE(subtree_size == 1 + left_size + right_size,                 *err, err->err = TreeErrorType::INCORRECT_TREE_SIZE);
+
+        switch ((NodeArgType) flat->kinds[i])
+        {
+            case NodeArgType::number:
+            {
+                RETURN_IF_FALSE(flat->links[i] == FLAT_NO_CHILDREN,                 *err, err->err = TreeErrorType::NUM_HAS_INCORRECT_CHILD_QUANT);
+                RETURN_IF_FALSE(flat->payloads[i] < flat->numbers_size,             *err, err->err = TreeErrorType::NUM_TYPE_NODES_ARG_IS_UNDEFINED);
+                break;
+            }
+
+            case NodeArgType::name:
+            {
+                RETURN_IF_FALSE(flat->payloads[i] < flat->names_size,               *err, err->err = TreeErrorType::VAR_TYPE_NODES_ARG_IS_UNDEFINED);
+                break;
+            }
+
+            case NodeArgType::operation:
+            case NodeArgType::connect:
+            case NodeArgType::type:
+            case NodeArgType::condition:
+            case NodeArgType::cycle:
+            case NodeArgType::dfunction:
+            case NodeArgType::attribute:
+            case NodeArgType::initialisation:
+                break;
+
+            case NodeArgType::undefined:
+            default:
+            {
+                err->err = TreeErrorType::UNDEFINED_NODE_TYPE;
+                return *err;
+            }
+        }
+    }
+
+    return *err;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void CountNodes(const Node_t* node, FlatTreeCounts* counts)
+{
+    assert(counts);
+
+    if (!node)
+        return;
+
+    counts->nodes++;
+
+    if (node->type == NodeArgType::name  ) counts->names++;
+    if (node->type == NodeArgType::number) counts->numbers++;
+
+    CountNodes(node->left,  counts);
+    CountNodes(node->right, counts);
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static uint32_t FlattenNode(FlatTree* flat, const Node_t* node, size_t* pointer)
+{
+    assert(flat);
+    assert(node);
+    assert(pointer);
+
+    size_t index = *pointer;
+    (*pointer)++;
+
+    uint8_t links = FLAT_NO_CHILDREN;
+    if (node->left ) links |= FLAT_HAS_LEFT;
+    if (node->right) links |= FLAT_HAS_RIGHT;
+
+    flat->kinds   [index] = (uint8_t) node->type;
+    flat->links   [index] = links;
+    flat->payloads[index] = EncodePayload(flat, node);
+
+    uint32_t subtree_size = 1;
+
+    if (node->left ) subtree_size += FlattenNode(flat, node->left,  pointer);
+    if (node->right) subtree_size += FlattenNode(flat, node->right, pointer);
+
+    flat->sizes[index] = subtree_size;
+
+    return subtree_size;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static uint32_t EncodePayload(FlatTree* flat, const Node_t* node)
+{
+    assert(flat);
+    assert(node);
+
+    NodeData_t data = node->data;
+
+    switch (node->type)
+    {
+        case NodeArgType::number:
+        {
+            flat->numbers[flat->numbers_size] = data.num;
+            return (uint32_t) flat->numbers_size++;
+        }
+
+        case NodeArgType::name:
+        {
+            flat->names[flat->names_size] = data.name;
+            return (uint32_t) flat->names_size++;
+        }
+
+        case NodeArgType::operation:      return (uint32_t) data.oper;
+        case NodeArgType::connect:        return (uint32_t) data.connect;
+        case NodeArgType::type:           return (uint32_t) data.type;
+        case NodeArgType::condition:      return (uint32_t) data.condition;
+        case NodeArgType::cycle:          return (uint32_t) data.cycle;
+        case NodeArgType::dfunction:      return (uint32_t) data.function;
+        case NodeArgType::attribute:      return (uint32_t) data.attribute;
+        case NodeArgType::initialisation: return (uint32_t) data.init;
+        case NodeArgType::undefined:
+        default:                          return 0;
+    }
+
+    assert(0 && "we must not be here");
+    return 0;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static bool HasLeft(const FlatTree* flat, size_t node)
+{
+    assert(flat);
+    return flat->links[node] & FLAT_HAS_LEFT;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static bool HasRight(const FlatTree* flat, size_t node)
+{
+    assert(flat);
+    return flat->links[node] & FLAT_HAS_RIGHT;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
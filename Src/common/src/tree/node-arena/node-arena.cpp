@@ -0,0 +1,123 @@
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "lib/lib.hpp"
+#include "tree/tree.hpp"
+#include "tree/node-arena/node-arena.hpp"
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static NodeArenaBlock* NodeArenaBlockCtor (NodeArenaBlock* prev, size_t capacity);
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+NodeArena* NodeArenaCtor(size_t first_block_capacity)
+{
+    assert(first_block_capacity > 0);
+
+    NodeArena* arena = (NodeArena*) calloc(1, sizeof(*arena));
+    if (!arena)
+        EXIT(EXIT_FAILURE, "failed calloc memory for node arena.");
+
+    arena->last         = NodeArenaBlockCtor(nullptr, first_block_capacity);
+    arena->blocks_quant = 1;
+    arena->nodes_quant  = 0;
+
+    return arena;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void NodeArenaDtor(NodeArena* arena)
+{
+    assert(arena);
+
+    NodeArenaBlock* block = arena->last;
+
+    while (block)
+    {
+        NodeArenaBlock* prev = block->prev;
+        FREE(block);
+        block = prev;
+    }
+
+    FREE(arena);
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+Node_t* NodeArenaAlloc(NodeArena* arena)
+{
+    assert(arena);
+    assert(arena->last);
+
+    NodeArenaBlock* block = arena->last;
+
+    if (block->pointer == block->capacity)
+    {
+        block = NodeArenaBlockCtor(block, block->capacity * 2);
+        arena->last = block;
+        arena->blocks_quant++;
+    }
+
+    Node_t* node = block->nodes + block->pointer;
+    block->pointer++;
+    arena->nodes_quant++;
+
+    memset(node, 0, sizeof(*node));
+
+    return node;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// moves all blocks of other into arena and destroys other.
+// Blocks go under arena->last, so allocations continue in the same block.
+void NodeArenaMerge(NodeArena* arena, NodeArena* other)
+{
+    assert(arena);
+    assert(arena->last);
+    assert(other);
+    assert(arena != other);
+
+    NodeArenaBlock* first = other->last;
+
+    if (first)
+    {
+        while (first->prev)
+            first = first->prev;
+
+        first->prev       = arena->last->prev;
+        arena->last->prev = other->last;
+    }
+
+    arena->blocks_quant += other->blocks_quant;
+    arena->nodes_quant  += other->nodes_quant;
+
+    FREE(other);
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static NodeArenaBlock* NodeArenaBlockCtor(NodeArenaBlock* prev, size_t capacity)
+{
+    assert(capacity > 0);
+
+    // header and nodes share one allocation, so the whole block is freed with one free()
+    NodeArenaBlock* block = (NodeArenaBlock*) malloc(sizeof(NodeArenaBlock) + capacity * sizeof(Node_t));
+    if (!block)
+        EXIT(EXIT_FAILURE, "failed malloc memory for node arena block.");
+
+    block->prev     = prev;
+    block->capacity = capacity;
+    block->pointer  = 0;
+    block->nodes    = (Node_t*) (block + 1);
+
+    return block;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,1039 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include "lib/lib.hpp"
+#include "profile/profile.hpp"
+#include "tree/tree.hpp"
+#include "tree/flat-tree/flat-tree.hpp"
+#include "tree/read-write-tree/binary-tree/binary-tree.hpp"
+#include "tree/read-write-tree/read-write-tree-global/read-write-tree-global.hpp"
+#include "name-table/interner/interner.hpp"
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct ByteBuffer
+{
+    uint8_t* data;
+    size_t   size;
+    size_t   capacity;
+};
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct ByteReader
+{
+    const uint8_t* data;
+    size_t         size;
+    size_t         pointer;
+    const char*    instream;
+};
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct PendingNode
+{
+    Node_t* node;
+    uint8_t links;
+};
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// functions [begin, end) of the root list, serialized into worker own buffer
+struct WriteWorker
+{
+    const Node_t** funcs;
+    size_t*        funcs_nodes;
+    size_t*        funcs_size;
+    size_t         begin;
+    size_t         end;
+    ByteBuffer     buffer;
+};
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// functions [begin, end) of the file, nodes are built in worker own arena
+struct ReadWorker
+{
+    const uint8_t* data;
+    const size_t*  funcs_offset;
+    const size_t*  funcs_nodes;
+    const size_t*  funcs_size;
+    Node_t**       funcs;
+    size_t         begin;
+    size_t         end;
+    const NameId*  names;
+    size_t         names_quant;
+    const char*    instream;
+    NodeArena*     arena;
+};
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static const size_t ByteBufferDefaultCapacity   = 1 << 16;
+static const size_t BinaryTreeMinFuncsPerWorker = 16;
+static const size_t BinaryTreeMaxWorkers        = 64;
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static size_t   WorkersQuantOverride = 0;
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void     ByteBufferCtor   (ByteBuffer* buffer);
+static void     PutByte          (ByteBuffer* buffer, uint8_t byte);
+static void     PutBytes         (ByteBuffer* buffer, const void* bytes, size_t size);
+static void     PutVarint        (ByteBuffer* buffer, uint64_t value);
+static void     PutNames         (ByteBuffer* buffer);
+static size_t   PutNode          (ByteBuffer* buffer, const Node_t* node);
+static void     PutNumber        (ByteBuffer* buffer, Number num);
+static void*    PutFuncs         (void* worker);
+static size_t   PutFlatNodes     (ByteBuffer* buffer, const FlatTree* flat, size_t func);
+static void     PutHeader        (ByteBuffer* header, size_t funcs_quant, const size_t* funcs_nodes, const size_t* funcs_size);
+
+static uint8_t  GetByte          (ByteReader* reader);
+static void     GetBytes         (ByteReader* reader, void* bytes, size_t size);
+static uint64_t GetVarint        (ByteReader* reader);
+static NameId*  GetNames         (ByteReader* reader, size_t* names_quant);
+static Node_t*  GetSubtree       (ByteReader* reader, NodeArena* arena, const NameId* names, size_t names_quant, size_t nodes_quant, PendingNode* stack);
+static Node_t*  GetNode          (ByteReader* reader, NodeArena* arena, const NameId* names, size_t names_quant, uint8_t* links);
+static Number   GetNumber        (ByteReader* reader);
+static void*    GetFuncs         (void* worker);
+
+static size_t   CountFuncs       (const Node_t* node);
+static void     CollectFuncs     (const Node_t* node, const Node_t** funcs, size_t* funcs_quant);
+static size_t   CountFlatFuncs   (const FlatTree* flat, size_t node);
+static void     CollectFlatFuncs (const FlatTree* flat, size_t node, size_t* funcs, size_t* funcs_quant);
+static Node_t*  LinkFuncs        (NodeArena* arena, Node_t** funcs, size_t funcs_quant);
+static size_t   GetWorkersQuant  (size_t funcs_quant);
+static void     RunWorkers       (void* (*work)(void*), void* workers, size_t worker_size, size_t workers_quant);
+static size_t   CalcFileSize     (const char* file);
+static void     CheckSignature   (ByteReader* reader);
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void PrintBinaryTree(const Tree_t* tree, const char* outstream)
+{
+    assert(tree);
+    assert(outstream);
+
+    size_t         funcs_quant = CountFuncs(tree->root);
+    const Node_t** funcs       = (const Node_t**) calloc(funcs_quant + 1, sizeof(*funcs));
+    size_t*        funcs_nodes = (size_t*)        calloc(funcs_quant + 1, sizeof(*funcs_nodes));
+    size_t*        funcs_size  = (size_t*)        calloc(funcs_quant + 1, sizeof(*funcs_size));
+
+    if (!funcs || !funcs_nodes || !funcs_size)
+        EXIT(EXIT_FAILURE, "failed calloc memory for binary tree functions index.");
+
+    size_t collected = 0;
+    CollectFuncs(tree->root, funcs, &collected);
+    assert(collected == funcs_quant);
+
+    size_t       workers_quant = GetWorkersQuant(funcs_quant);
+    WriteWorker* workers       = (WriteWorker*) calloc(workers_quant, sizeof(*workers));
+
+    if (!workers)
+        EXIT(EXIT_FAILURE, "failed calloc memory for binary tree writers.");
+
+    for (size_t i = 0; i < workers_quant; i++)
+    {
+        workers[i] = {funcs, funcs_nodes, funcs_size,
+                      funcs_quant * i / workers_quant, funcs_quant * (i + 1) / workers_quant, {}};
+        ByteBufferCtor(&workers[i].buffer);
+    }
+
+    RunWorkers(PutFuncs, workers, sizeof(*workers), workers_quant);
+
+    ByteBuffer header = {};
+    PutHeader(&header, funcs_quant, funcs_nodes, funcs_size);
+
+    FILE* out = fopen(outstream, "wb");
+    if (!out)
+        EXIT(EXIT_FAILURE, "failed open '%s'", outstream);
+
+    if (fwrite(header.data, sizeof(*header.data), header.size, out) != header.size)
+        EXIT(EXIT_FAILURE, "failed write binary tree to '%s'", outstream);
+
+    // worker buffers hold consecutive functions, so they are written in workers order
+    for (size_t i = 0; i < workers_quant; i++)
+    {
+        ByteBuffer* buffer = &workers[i].buffer;
+
+        if (fwrite(buffer->data, sizeof(*buffer->data), buffer->size, out) != buffer->size)
+            EXIT(EXIT_FAILURE, "failed write binary tree to '%s'", outstream);
+
+        FREE(buffer->data);
+    }
+
+    fclose(out);
+
+    FREE(header.data);
+    FREE(workers);
+    FREE(funcs_size);
+    FREE(funcs_nodes);
+    FREE(funcs);
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// the same file as PrintBinaryTree() writes, but every function is a [begin, begin + sizes[begin]) range
+// of the flat arrays, so its nodes are written by one linear loop without pointer chasing
+void PrintBinaryFlatTree(const FlatTree* flat, const char* outstream)
+{
+    assert(flat);
+    assert(outstream);
+
+    size_t  funcs_quant = (flat->size > 0) ? CountFlatFuncs(flat, 0) : 0;
+    size_t* funcs       = (size_t*) calloc(funcs_quant + 1, sizeof(*funcs));
+    size_t* funcs_nodes = (size_t*) calloc(funcs_quant + 1, sizeof(*funcs_nodes));
+    size_t* funcs_size  = (size_t*) calloc(funcs_quant + 1, sizeof(*funcs_size));
+
+    if (!funcs || !funcs_nodes || !funcs_size)
+        EXIT(EXIT_FAILURE, "failed calloc memory for binary tree functions index.");
+
+    size_t collected = 0;
+    if (flat->size > 0)
+        CollectFlatFuncs(flat, 0, funcs, &collected);
+    assert(collected == funcs_quant);
+
+    ByteBuffer funcs_body = {};
+    ByteBufferCtor(&funcs_body);
+
+    for (size_t i = 0; i < funcs_quant; i++)
+    {
+        size_t start = funcs_body.size;
+
+        funcs_nodes[i] = PutFlatNodes(&funcs_body, flat, funcs[i]);
+        funcs_size [i] = funcs_body.size - start;
+    }
+
+    ByteBuffer header = {};
+    PutHeader(&header, funcs_quant, funcs_nodes, funcs_size);
+
+    FILE* out = fopen(outstream, "wb");
+    if (!out)
+        EXIT(EXIT_FAILURE, "failed open '%s'", outstream);
+
+    if (fwrite(header.data,     sizeof(*header.data),     header.size,     out) != header.size     ||
+        fwrite(funcs_body.data, sizeof(*funcs_body.data), funcs_body.size, out) != funcs_body.size)
+        EXIT(EXIT_FAILURE, "failed write binary tree to '%s'", outstream);
+
+    fclose(out);
+
+    FREE(funcs_body.data);
+    FREE(header.data);
+    FREE(funcs_size);
+    FREE(funcs_nodes);
+    FREE(funcs);
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void ReadBinaryTree(Tree_t* tree, const char* instream)
+{
+    assert(tree);
+    assert(tree->arena);
+    assert(instream);
+
+    FILE* in = fopen(instream, "rb");
+    if (!in)
+        EXIT(EXIT_FAILURE, "failed open '%s'", instream);
+
+    size_t   size = CalcFileSize(instream);
+    uint8_t* data = (uint8_t*) calloc(size + 1, sizeof(*data));
+
+    if (!data)
+        EXIT(EXIT_FAILURE, "failed calloc memory for binary tree file.");
+
+    if (fread(data, sizeof(*data), size, in) != size)
+        EXIT(EXIT_FAILURE, "failed read '%s'", instream);
+
+    fclose(in);
+
+    ByteReader reader = {data, size, 0, instream};
+
+    CheckSignature(&reader);
+
+    size_t  names_quant = 0;
+    NameId* names       = GetNames(&reader, &names_quant);
+    size_t  funcs_quant = GetVarint(&reader);
+
+    if (funcs_quant > size)
+        EXIT(EXIT_FAILURE, "corrupted binary tree '%s': bad functions quant %lu", instream, funcs_quant);
+
+    size_t*  funcs_offset = (size_t*)  calloc(funcs_quant + 1, sizeof(*funcs_offset));
+    size_t*  funcs_nodes  = (size_t*)  calloc(funcs_quant + 1, sizeof(*funcs_nodes));
+    size_t*  funcs_size   = (size_t*)  calloc(funcs_quant + 1, sizeof(*funcs_size));
+    Node_t** funcs        = (Node_t**) calloc(funcs_quant + 1, sizeof(*funcs));
+
+    if (!funcs_offset || !funcs_nodes || !funcs_size || !funcs)
+        EXIT(EXIT_FAILURE, "failed calloc memory for binary tree functions index.");
+
+    for (size_t i = 0; i < funcs_quant; i++)
+    {
+        funcs_nodes[i] = GetVarint(&reader);
+        funcs_size [i] = GetVarint(&reader);
+    }
+
+    size_t offset = reader.pointer;
+
+    for (size_t i = 0; i < funcs_quant; i++)
+    {
+        if (funcs_size[i] > size - offset)
+            EXIT(EXIT_FAILURE, "corrupted binary tree '%s': function %lu is out of file", instream, i);
+
+        funcs_offset[i] = offset;
+        offset         += funcs_size[i];
+    }
+
+    if (offset != size)
+        EXIT(EXIT_FAILURE, "corrupted binary tree '%s': %lu bytes after last function", instream, size - offset);
+
+    size_t      workers_quant = GetWorkersQuant(funcs_quant);
+    ReadWorker* workers       = (ReadWorker*) calloc(workers_quant, sizeof(*workers));
+
+    if (!workers)
+        EXIT(EXIT_FAILURE, "failed calloc memory for binary tree readers.");
+
+    for (size_t i = 0; i < workers_quant; i++)
+        workers[i] = {data, funcs_offset, funcs_nodes, funcs_size, funcs,
+                      funcs_quant * i / workers_quant, funcs_quant * (i + 1) / workers_quant,
+                      names, names_quant, instream, nullptr};
+
+    RunWorkers(GetFuncs, workers, sizeof(*workers), workers_quant);
+
+    for (size_t i = 0; i < workers_quant; i++)
+        NodeArenaMerge(tree->arena, workers[i].arena);
+
+    tree->root = LinkFuncs(tree->arena, funcs, funcs_quant);
+
+    FREE(workers);
+    FREE(funcs);
+    FREE(funcs_size);
+    FREE(funcs_nodes);
+    FREE(funcs_offset);
+    FREE(names);
+    FREE(data);
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// 0 - choose by cores quant
+void SetBinaryTreeWorkersQuant(size_t workers_quant)
+{
+    WorkersQuantOverride = workers_quant;
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void ByteBufferCtor(ByteBuffer* buffer)
+{
+    assert(buffer);
+
+    buffer->size     = 0;
+    buffer->capacity = ByteBufferDefaultCapacity;
+    buffer->data     = (uint8_t*) calloc(buffer->capacity, sizeof(*buffer->data));
+
+    if (!buffer->data)
+        EXIT(EXIT_FAILURE, "failed calloc memory for binary tree buffer.");
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void PutByte(ByteBuffer* buffer, uint8_t byte)
+{
+    assert(buffer);
+
+    PutBytes(buffer, &byte, 1);
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void PutBytes(ByteBuffer* buffer, const void* bytes, size_t size)
+{
+    assert(buffer);
+    assert(bytes);
+
+    if (buffer->size + size > buffer->capacity)
+    {
+        while (buffer->size + size > buffer->capacity)
+            buffer->capacity *= 2;
+
+        buffer->data = (uint8_t*) realloc(buffer->data, buffer->capacity * sizeof(*buffer->data));
+        if (!buffer->data)
+            EXIT(EXIT_FAILURE, "failed realloc memory for binary tree buffer.");
+    }
+
+    memcpy(buffer->data + buffer->size, bytes, size);
+    buffer->size += size;
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// LEB128: 7 bits per byte, high bit - "more bytes follow"
+static void PutVarint(ByteBuffer* buffer, uint64_t value)
+{
+    assert(buffer);
+
+    uint8_t bytes[10] = {};
+    size_t  size      = 0;
+
+    do
+    {
+        uint8_t byte = value & 0x7f;
+        value >>= 7;
+
+        if (value)
+            byte |= 0x80;
+
+        bytes[size++] = byte;
+    }
+    while (value);
+
+    PutBytes(buffer, bytes, size);
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void PutNames(ByteBuffer* buffer)
+{
+    assert(buffer);
+
+    size_t names_quant = GetInternedNamesQuant();
+
+    PutVarint(buffer, names_quant);
+
+    for (NameId id = 1; id <= names_quant; id++)
+    {
+        NameInfo name_info = GetInternedName(id);
+
+        PutVarint(buffer, name_info.len);
+        PutBytes (buffer, name_info.name, name_info.len);
+    }
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// returns written nodes quant
+static size_t PutNode(ByteBuffer* buffer, const Node_t* node)
+{
+    assert(buffer);
+    assert(node);
+
+    uint8_t links = FLAT_NO_CHILDREN;
+    if (node->left ) links |= FLAT_HAS_LEFT;
+    if (node->right) links |= FLAT_HAS_RIGHT;
+
+    PutByte(buffer, (uint8_t) node->type);
+    PutByte(buffer, links);
+
+    NodeData_t data = node->data;
+
+    switch (node->type)
+    {
+        case NodeArgType::number:         PutNumber(buffer, data.num);                  break;
+        case NodeArgType::name:
+        {
+            if (data.name.id == NameNoId)
+                EXIT(EXIT_FAILURE, "name node without interned name id");
+
+            PutVarint(buffer, data.name.id);
+            PutByte  (buffer, (uint8_t) data.name.type);
+            break;
+        }
+        case NodeArgType::operation:      PutVarint(buffer, (uint64_t) data.oper);      break;
+        case NodeArgType::connect:        PutVarint(buffer, (uint64_t) data.connect);   break;
+        case NodeArgType::type:           PutVarint(buffer, (uint64_t) data.type);      break;
+        case NodeArgType::condition:      PutVarint(buffer, (uint64_t) data.condition); break;
+        case NodeArgType::cycle:          PutVarint(buffer, (uint64_t) data.cycle);     break;
+        case NodeArgType::dfunction:      PutVarint(buffer, (uint64_t) data.function);  break;
+        case NodeArgType::attribute:      PutVarint(buffer, (uint64_t) data.attribute); break;
+        case NodeArgType::initialisation: PutVarint(buffer, (uint64_t) data.init);      break;
+        case NodeArgType::undefined:
+        default:                                                                        break;
+    }
+
+    size_t nodes_quant = 1;
+
+    if (node->left ) nodes_quant += PutNode(buffer, node->left );
+    if (node->right) nodes_quant += PutNode(buffer, node->right);
+
+    return nodes_quant;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void PutNumber(ByteBuffer* buffer, Number num)
+{
+    assert(buffer);
+
+    PutByte(buffer, (uint8_t) num.type);
+
+    switch (num.type)
+    {
+        case Type::int_type:
+        {
+            int64_t  value  = num.value.int_val;
+            uint64_t zigzag = ((uint64_t) value << 1) ^ (uint64_t) (value >> 63);
+            PutVarint(buffer, zigzag);
+            break;
+        }
+        case Type::double_type: PutBytes(buffer, &num.value.double_val, sizeof(num.value.double_val)); break;
+        case Type::char_type:   PutByte (buffer, (uint8_t) num.value.char_val);                          break;
+        case Type::void_type:
+        case Type::undefined_type:
+        default:                                                                                             break;
+    }
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void* PutFuncs(void* worker)
+{
+    assert(worker);
+
+    WriteWorker* writer = (WriteWorker*) worker;
+
+    PROFILE_SCOPE("binary-tree PutFuncs");
+
+    for (size_t i = writer->begin; i < writer->end; i++)
+    {
+        size_t start = writer->buffer.size;
+
+        writer->funcs_nodes[i] = PutNode(&writer->buffer, writer->funcs[i]);
+        writer->funcs_size [i] = writer->buffer.size - start;
+
+        PROFILE_HISTOGRAM("binary-tree function nodes", writer->funcs_nodes[i]);
+    }
+
+    return nullptr;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// returns written nodes quant
+static size_t PutFlatNodes(ByteBuffer* buffer, const FlatTree* flat, size_t func)
+{
+    assert(buffer);
+    assert(flat);
+    assert(func < flat->size);
+
+    size_t end = func + flat->sizes[func];
+
+    for (size_t i = func; i < end; i++)
+    {
+        NodeArgType node_type = (NodeArgType) flat->kinds[i];
+        uint32_t    payload   = flat->payloads[i];
+
+        PutByte(buffer, flat->kinds[i]);
+        PutByte(buffer, flat->links[i]);
+
+        switch (node_type)
+        {
+            case NodeArgType::number:         PutNumber(buffer, flat->numbers[payload]);    break;
+            case NodeArgType::name:
+            {
+                Name node_name = flat->names[payload];
+
+                if (node_name.id == NameNoId)
+                    EXIT(EXIT_FAILURE, "name node without interned name id");
+
+                PutVarint(buffer, node_name.id);
+                PutByte  (buffer, (uint8_t) node_name.type);
+                break;
+            }
+            case NodeArgType::operation:
+            case NodeArgType::connect:
+            case NodeArgType::type:
+            case NodeArgType::condition:
+            case NodeArgType::cycle:
+            case NodeArgType::dfunction:
+            case NodeArgType::attribute:
+            case NodeArgType::initialisation: PutVarint(buffer, payload);                   break;
+            case NodeArgType::undefined:
+            default:                                                                        break;
+        }
+    }
+
+    return end - func;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void PutHeader(ByteBuffer* header, size_t funcs_quant, const size_t* funcs_nodes, const size_t* funcs_size)
+{
+    assert(header);
+    assert(funcs_nodes);
+    assert(funcs_size);
+
+    ByteBufferCtor(header);
+
+    PutBytes (header, ast_binary_signature, strlen(ast_binary_signature));
+    PutByte  (header, ast_binary_version);
+    PutNames (header);
+    PutVarint(header, funcs_quant);
+
+    for (size_t i = 0; i < funcs_quant; i++)
+    {
+        PutVarint(header, funcs_nodes[i]);
+        PutVarint(header, funcs_size [i]);
+    }
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static uint8_t GetByte(ByteReader* reader)
+{
+    assert(reader);
+
+    uint8_t byte = 0;
+    GetBytes(reader, &byte, 1);
+
+    return byte;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void GetBytes(ByteReader* reader, void* bytes, size_t size)
+{
+    assert(reader);
+    assert(bytes);
+
+    if (reader->pointer + size > reader->size)
+        EXIT(EXIT_FAILURE, "corrupted binary tree '%s': unexpected end of file", reader->instream);
+
+    memcpy(bytes, reader->data + reader->pointer, size);
+    reader->pointer += size;
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static uint64_t GetVarint(ByteReader* reader)
+{
+    assert(reader);
+
+    uint64_t value = 0;
+
+    for (size_t shift = 0; shift < 64; shift += 7)
+    {
+        uint8_t byte = GetByte(reader);
+        value |= (uint64_t) (byte & 0x7f) << shift;
+
+        if (!(byte & 0x80))
+            return value;
+    }
+
+    EXIT(EXIT_FAILURE, "corrupted binary tree '%s': too long varint", reader->instream);
+
+    return 0;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// file names are interned again, names[file id] is the id in this process interner
+static NameId* GetNames(ByteReader* reader, size_t* names_quant)
+{
+    assert(reader);
+    assert(names_quant);
+
+    *names_quant = GetVarint(reader);
+
+    NameId* names = (NameId*) calloc(*names_quant + 1, sizeof(*names));
+    if (!names)
+        EXIT(EXIT_FAILURE, "failed calloc memory for binary tree names.");
+
+    for (size_t i = 1; i <= *names_quant; i++)
+    {
+        size_t len = GetVarint(reader);
+
+        if (reader->pointer + len > reader->size)
+            EXIT(EXIT_FAILURE, "corrupted binary tree '%s': unexpected end of file", reader->instream);
+
+        NameInfo name_info = {(const char*) reader->data + reader->pointer, len};
+        reader->pointer += len;
+
+        names[i] = InternNameCopy(&name_info);
+    }
+
+    return names;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// one pre-order stream of nodes_quant nodes, the stack holds nodes whose children are not read yet
+static Node_t* GetSubtree(ByteReader* reader, NodeArena* arena, const NameId* names, size_t names_quant, size_t nodes_quant, PendingNode* stack)
+{
+    assert(reader);
+    assert(names);
+    assert(stack);
+
+    if (nodes_quant == 0)
+        EXIT(EXIT_FAILURE, "corrupted binary tree '%s': empty function", reader->instream);
+
+    size_t stack_size  = 0;
+    size_t nodes_count = 1;
+
+    uint8_t links = FLAT_NO_CHILDREN;
+    Node_t* root  = GetNode(reader, arena, names, names_quant, &links);
+
+    if (links != FLAT_NO_CHILDREN)
+        stack[stack_size++] = {root, links};
+
+    while (stack_size > 0)
+    {
+        if (nodes_count == nodes_quant)
+            EXIT(EXIT_FAILURE, "corrupted binary tree '%s': nodes quant is less than nodes in stream", reader->instream);
+
+        Node_t* child = GetNode(reader, arena, names, names_quant, &links);
+        nodes_count++;
+
+        PendingNode* parent = &stack[stack_size - 1];
+
+        if ((parent->links & FLAT_HAS_LEFT) && !parent->node->left)
+            parent->node->left  = child;
+        else
+            parent->node->right = child;
+
+        bool left_done  = !(parent->links & FLAT_HAS_LEFT ) || parent->node->left;
+        bool right_done = !(parent->links & FLAT_HAS_RIGHT) || parent->node->right;
+
+        if (left_done && right_done)
+            stack_size--;
+
+        if (links != FLAT_NO_CHILDREN)
+            stack[stack_size++] = {child, links};
+    }
+
+    if (nodes_count != nodes_quant)
+        EXIT(EXIT_FAILURE, "corrupted binary tree '%s': %lu nodes in stream, %lu expected", reader->instream, nodes_count, nodes_quant);
+
+    return root;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static Node_t* GetNode(ByteReader* reader, NodeArena* arena, const NameId* names, size_t names_quant, uint8_t* links)
+{
+    assert(reader);
+    assert(names);
+    assert(links);
+
+    NodeArgType node_type = (NodeArgType) GetByte(reader);
+    *links           = GetByte(reader);
+
+    NodeData_t data = {};
+
+    switch (node_type)
+    {
+        case NodeArgType::number:         data.num       = GetNumber(reader);                        break;
+        case NodeArgType::name:
+        {
+            size_t file_id = GetVarint(reader);
+
+            if (file_id == 0 || file_id > names_quant)
+                EXIT(EXIT_FAILURE, "corrupted binary tree '%s': bad name id %lu", reader->instream, file_id);
+
+            data.name.id   = names[file_id];
+            data.name.name = GetInternedName(data.name.id);
+            data.name.type = (NameType) GetByte(reader);
+            break;
+        }
+        case NodeArgType::operation:      data.oper      = (Operation)         GetVarint(reader);    break;
+        case NodeArgType::connect:        data.connect   = (Connect)           GetVarint(reader);    break;
+        case NodeArgType::type:           data.type      = (Type)              GetVarint(reader);    break;
+        case NodeArgType::condition:      data.condition = (Condition)         GetVarint(reader);    break;
+        case NodeArgType::cycle:          data.cycle     = (Cycle)             GetVarint(reader);    break;
+        case NodeArgType::dfunction:      data.function  = (DFunction)         GetVarint(reader);    break;
+        case NodeArgType::attribute:      data.attribute = (FunctionAttribute) GetVarint(reader);    break;
+        case NodeArgType::initialisation: data.init      = (Initialisation)    GetVarint(reader);    break;
+        case NodeArgType::undefined:
+        default:                                                                                     break;
+    }
+
+    Node_t* node = nullptr;
+    TREE_ASSERT(NodeCtor(&node, arena, node_type, data, nullptr, nullptr));
+
+    return node;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static Number GetNumber(ByteReader* reader)
+{
+    assert(reader);
+
+    Number num = {};
+    num.type   = (Type) GetByte(reader);
+
+    switch (num.type)
+    {
+        case Type::int_type:
+        {
+            uint64_t zigzag = GetVarint(reader);
+            num.value.int_val = (int) ((int64_t) (zigzag >> 1) ^ -(int64_t) (zigzag & 1));
+            break;
+        }
+        case Type::double_type: GetBytes(reader, &num.value.double_val, sizeof(num.value.double_val)); break;
+        case Type::char_type:   num.value.char_val = (char) GetByte(reader);                             break;
+        case Type::void_type:
+        case Type::undefined_type:
+        default:                                                                                             break;
+    }
+
+    return num;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void* GetFuncs(void* worker)
+{
+    assert(worker);
+
+    ReadWorker* reader_info = (ReadWorker*) worker;
+
+    PROFILE_SCOPE("binary-tree GetFuncs");
+
+    size_t nodes_quant     = 0;
+    size_t max_nodes_quant = 0;
+
+    for (size_t i = reader_info->begin; i < reader_info->end; i++)
+    {
+        nodes_quant += reader_info->funcs_nodes[i];
+
+        if (reader_info->funcs_nodes[i] > max_nodes_quant)
+            max_nodes_quant = reader_info->funcs_nodes[i];
+
+        // every node takes at least 2 bytes, so a bigger quant is a corrupted file, not a huge calloc
+        if (reader_info->funcs_nodes[i] > reader_info->funcs_size[i] / 2)
+            EXIT(EXIT_FAILURE, "corrupted binary tree '%s': function %lu has too many nodes", reader_info->instream, i);
+    }
+
+    PendingNode* stack = (PendingNode*) calloc(max_nodes_quant + 1, sizeof(*stack));
+    if (!stack)
+        EXIT(EXIT_FAILURE, "failed calloc memory for binary tree reader stack.");
+
+    reader_info->arena = NodeArenaCtor((nodes_quant > 0) ? nodes_quant : 1);
+
+    for (size_t i = reader_info->begin; i < reader_info->end; i++)
+    {
+        ByteReader reader = {reader_info->data + reader_info->funcs_offset[i], reader_info->funcs_size[i], 0, reader_info->instream};
+
+        reader_info->funcs[i] = GetSubtree(&reader, reader_info->arena, reader_info->names, reader_info->names_quant, reader_info->funcs_nodes[i], stack);
+
+        if (reader.pointer != reader.size)
+            EXIT(EXIT_FAILURE, "corrupted binary tree '%s': function %lu size mismatch", reader_info->instream, i);
+    }
+
+    FREE(stack);
+
+    return nullptr;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// top level functions are the non connect nodes of the root connect list
+static size_t CountFuncs(const Node_t* node)
+{
+    if (!node)
+        return 0;
+
+    if (node->type == NodeArgType::connect)
+        return CountFuncs(node->left) + CountFuncs(node->right);
+
+    return 1;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void CollectFuncs(const Node_t* node, const Node_t** funcs, size_t* funcs_quant)
+{
+    assert(funcs);
+    assert(funcs_quant);
+
+    if (!node)
+        return;
+
+    if (node->type == NodeArgType::connect)
+    {
+        CollectFuncs(node->left,  funcs, funcs_quant);
+        CollectFuncs(node->right, funcs, funcs_quant);
+        return;
+    }
+
+    funcs[(*funcs_quant)++] = node;
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// the same root connect list as CountFuncs() walks, in flat layout
+static size_t CountFlatFuncs(const FlatTree* flat, size_t node)
+{
+    assert(flat);
+
+    if (node == FlatTreeNoNode)
+        return 0;
+
+    if (FlatTreeGetType(flat, node) == NodeArgType::connect)
+        return CountFlatFuncs(flat, FlatTreeGetLeft(flat, node)) + CountFlatFuncs(flat, FlatTreeGetRight(flat, node));
+
+    return 1;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void CollectFlatFuncs(const FlatTree* flat, size_t node, size_t* funcs, size_t* funcs_quant)
+{
+    assert(flat);
+    assert(funcs);
+    assert(funcs_quant);
+
+    if (node == FlatTreeNoNode)
+        return;
+
+    if (FlatTreeGetType(flat, node) == NodeArgType::connect)
+    {
+        CollectFlatFuncs(flat, FlatTreeGetLeft (flat, node), funcs, funcs_quant);
+        CollectFlatFuncs(flat, FlatTreeGetRight(flat, node), funcs, funcs_quant);
+        return;
+    }
+
+    funcs[(*funcs_quant)++] = node;
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// the same right nested list the parser builds: connect(f1, connect(f2, ... fn))
+static Node_t* LinkFuncs(NodeArena* arena, Node_t** funcs, size_t funcs_quant)
+{
+    assert(funcs);
+
+    if (funcs_quant == 0)
+        return nullptr;
+
+    Node_t* root = funcs[funcs_quant - 1];
+
+    for (size_t i = funcs_quant - 1; i > 0; i--)
+    {
+        Node_t* connect_node = nullptr;
+        _CONNECT(&connect_node, arena, funcs[i - 1], root);
+        root = connect_node;
+    }
+
+    return root;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static size_t GetWorkersQuant(size_t funcs_quant)
+{
+    size_t workers_quant = WorkersQuantOverride;
+
+    if (workers_quant == 0)
+    {
+        long cores    = sysconf(_SC_NPROCESSORS_ONLN);
+        workers_quant = (cores > 0) ? (size_t) cores : 1;
+
+        if (workers_quant > funcs_quant / BinaryTreeMinFuncsPerWorker)
+            workers_quant = funcs_quant / BinaryTreeMinFuncsPerWorker;
+    }
+
+    if (workers_quant > funcs_quant)          workers_quant = funcs_quant;
+    if (workers_quant > BinaryTreeMaxWorkers) workers_quant = BinaryTreeMaxWorkers;
+    if (workers_quant == 0)                   workers_quant = 1;
+
+    return workers_quant;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// workers[0] runs in the calling thread, the others in new threads
+static void RunWorkers(void* (*work)(void*), void* workers, size_t worker_size, size_t workers_quant)
+{
+    assert(work);
+    assert(workers);
+    assert(workers_quant > 0);
+
+    pthread_t* threads = (pthread_t*) calloc(workers_quant, sizeof(*threads));
+    if (!threads)
+        EXIT(EXIT_FAILURE, "failed calloc memory for binary tree threads.");
+
+    for (size_t i = 1; i < workers_quant; i++)
+    {
+        if (pthread_create(&threads[i], nullptr, work, (char*) workers + i * worker_size) != 0)
+            EXIT(EXIT_FAILURE, "failed create binary tree worker thread.");
+    }
+
+    work(workers);
+
+    for (size_t i = 1; i < workers_quant; i++)
+        pthread_join(threads[i], nullptr);
+
+    FREE(threads);
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static size_t CalcFileSize(const char* file)
+{
+    assert(file);
+
+    struct stat buf = {};
+    stat(file, &buf);
+    return (size_t) buf.st_size;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void CheckSignature(ByteReader* reader)
+{
+    assert(reader);
+
+    size_t signature_len = strlen(ast_binary_signature);
+
+    if (reader->size < signature_len + 1 || memcmp(reader->data, ast_binary_signature, signature_len) != 0)
+        EXIT(EXIT_FAILURE, "Bad signature. '%s' is not a binary AST file.", reader->instream);
+
+    reader->pointer = signature_len;
+
+    uint8_t version = GetByte(reader);
+
+    if (version != ast_binary_version)
+        EXIT(EXIT_FAILURE, "Bad version of binary AST file '%s': %u, expected %u.", reader->instream, version, ast_binary_version);
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
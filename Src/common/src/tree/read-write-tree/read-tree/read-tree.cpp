@@ -1,13 +1,18 @@
-#define WORD_ARRAY_POINTER         // for struct WordArray in read-file/read-file.hpp
-#define WORD_SAVE_INPUT_STREAM     // for struct WordArray in read-file/read-file.hpp
-
+#include <stdlib.h>
+#include <stdio.h>
 #include <string.h>
 #include <assert.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "lib/lib.hpp"
+#include "profile/profile.hpp"
 #include "tree/tree.hpp"
 #include "tree/read-write-tree/read-tree/read-tree.hpp"
 #include "tree/read-write-tree/read-write-tree-global/read-write-tree-global.hpp"
-
-#include "read-file/read-file.hpp"
+#include "tree/read-write-tree/binary-tree/binary-tree.hpp"
+#include "name-table/interner/interner.hpp"
 
 #ifdef _DEBUG
 #include "tree/tree-dump/tree-dump.hpp"
@@ -16,253 +21,956 @@
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
+// Text AST reader: one pass over the mapped file, words are picked straight from it
+// (no word array), nodes are built as soon as their words are read.
+// The writer does not print connect nodes, so lists are connected here
+// in the same way as recursive descent in the front-end does it.
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
 const char* const bad_signature_massage = "Bad signature. Possible reason - that incorrect tree text format for this compiler.";
+const char* const bad_tree_massage      = "Bad tree text format.";
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static void CheckSignature        (WordArray* word_array);
-static void CheckSignatureBegin   (WordArray* word_array);
-static void CheckSignatureName    (WordArray* word_array);
-static void CheckSignatureAutor   (WordArray* word_array);
-static void CheckSignatureVersion (WordArray* word_array);
+struct TextReader
+{
+    const char*   data;
+    size_t        size;
+    size_t        pointer;
+
+    size_t        line;
+    size_t        line_begin;
+
+    const char*   instream;
+
+    const NameId* names;
+    size_t        names_quant;
+
+    NodeArena*    arena;
+};
 
-static void CheckSignatureHelper  (WordArray* word_array, const char* correct);
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
+struct TextWord
+{
+    const char* word;
+    size_t      len;
+    size_t      line;
+    size_t      in_line;
+};
 
-static Type GetType               (const Word* word);
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct OperationWord
+{
+    const char* word;
+    Operation   operation;
+};
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-Tree_t ReadTree(WordArray* word_array)
+// "*=" and "-=" are printed as "*" and "--" by the writer, so they are read as mul and minus_minus
+static const OperationWord OperationsWords[] =
 {
-    assert(word_array);
+    {assign_operation          , Operation::assign          },
+    {plus_operation            , Operation::plus            },
+    {minus_operation           , Operation::minus           },
+    {mul_operation             , Operation::mul             },
+    {div_operation             , Operation::dive            },
+    {power_operation           , Operation::power           },
+    {equal_operation           , Operation::equal           },
+    {not_equal_operation       , Operation::not_equal       },
+    {greater_operation         , Operation::greater         },
+    {greater_or_equal_operation, Operation::greater_or_equal},
+    {less_operation            , Operation::less            },
+    {less_or_equal_operation   , Operation::less_or_equal   },
+    {bool_and_operation        , Operation::bool_and        },
+    {bool_or_operation         , Operation::bool_or         },
+    {bool_not_operation        , Operation::bool_not        },
+    {plus_plus_operation       , Operation::plus_plus       },
+    {minus_minus_operation     , Operation::minus_minus     },
+    {plus_equal_operation      , Operation::plus_equal      },
+    {div_equal_operation       , Operation::div_equal       },
+};
+
+static const size_t OperationsWordsQuant = sizeof(OperationsWords) / sizeof(OperationsWords[0]);
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static const size_t NumberWordMaxLen = 64;
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-    CheckSignature(word_array);
+static void      ReadTextTree          (Tree_t* tree, const char* instream);
+
+static void      CheckSignature        (TextReader* reader);
+static NameId*   GetNamesTable         (TextReader* reader, size_t* names_quant);
+
+static Node_t*   GetDefFuncs           (TextReader* reader);
+static Node_t*   GetDefFunc            (TextReader* reader);
+static Node_t*   GetDefFuncArgs        (TextReader* reader);
+static Node_t*   GetBody               (TextReader* reader);
+static Node_t*   GetStatements         (TextReader* reader);
+static Node_t*   GetConditions         (TextReader* reader);
+static Node_t*   GetConditionBranch    (TextReader* reader, const char* keyword, Condition condition);
+static Node_t*   GetCycle              (TextReader* reader, const char* keyword, Cycle cycle);
+static Node_t*   GetNode               (TextReader* reader);
+static Node_t*   GetOptionalNode       (TextReader* reader);
+static Node_t*   GetReturn             (TextReader* reader);
+static Node_t*   GetDefVariable        (TextReader* reader);
+static Node_t*   GetAssign             (TextReader* reader);
+static Node_t*   GetOperation          (TextReader* reader);
+static Node_t*   GetCallFunction       (TextReader* reader);
+static Node_t*   GetNumber             (TextReader* reader);
+static Node_t*   GetName               (TextReader* reader);
+static Node_t*   GetType               (TextReader* reader);
+
+static void      AppendToList          (NodeArena* arena, Node_t*** tail, Node_t* node);
+
+static TextWord  PickWord              (TextReader* reader);
+static TextWord  ConsumeWord           (TextReader* reader);
+static void      SkipSpaces            (TextReader* reader);
+static bool      IsKeyword             (TextReader* reader, const char* keyword);
+static void      ConsumeKeyword        (TextReader* reader, const char* keyword);
+static bool      IsWord                (const TextWord* word, const char* correct);
+static bool      IsEnd                 (TextReader* reader);
+static size_t    WordToSize            (TextReader* reader, const TextWord* word);
+
+static void      SyntaxErr             (const TextReader* reader, const TextWord* word, const char* massage, const char* correct);
 
-    Tree_t tree = {};
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void ReadTree(Tree_t* tree, const char* instream, AstFormat format)
+{
+    assert(tree);
+    assert(instream);
 
+    PROFILE_SCOPE("ReadTree");
 
+    switch (format)
+    {
+        case AstFormat::text:   ReadTextTree  (tree, instream); break;
+        case AstFormat::binary: ReadBinaryTree(tree, instream); break;
+        default: assert(0 && "undefined ast format"); break;
+    }
 
-    return tree;
+    return;
 }
 
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+AstFormat GetAstFileFormat(const char* instream)
+{
+    assert(instream);
+
+    FILE* stream = fopen(instream, "rb");
+    if (!stream)
+        EXIT(EXIT_FAILURE, "failed open '%s'", instream);
+
+    size_t signature_len = strlen(ast_binary_signature);
+    char   signature[32] = {};
+
+    assert(signature_len < sizeof(signature));
+
+    size_t read_len = fread(signature, sizeof(*signature), signature_len, stream);
+    fclose(stream);
+
+    if (read_len == signature_len && memcmp(signature, ast_binary_signature, signature_len) == 0)
+        return AstFormat::binary;
+
+    return AstFormat::text;
+}
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static Tree_t GetTree(WordArray* word_array)
+static void ReadTextTree(Tree_t* tree, const char* instream)
 {
-    assert(word_array);
+    assert(tree);
+    assert(instream);
+
+    int fd = open(instream, O_RDONLY);
+    if (fd < 0)
+        EXIT(EXIT_FAILURE, "failed open '%s'", instream);
+
+    struct stat file_info = {};
+    if (fstat(fd, &file_info) != 0 || file_info.st_size == 0)
+        EXIT(EXIT_FAILURE, "%s\n'%s' is empty", bad_signature_massage, instream);
+
+    size_t size = (size_t) file_info.st_size;
+    void*  data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    if (data == MAP_FAILED)
+        EXIT(EXIT_FAILURE, "failed map '%s'", instream);
 
-    return {};
+    close(fd);
+
+    TextReader reader = {};
+    reader.data       = (const char*) data;
+    reader.size       = size;
+    reader.line       = 1;
+    reader.instream   = instream;
+    reader.arena      = tree->arena;
+
+    CheckSignature(&reader);
+
+    size_t  names_quant = 0;
+    NameId* names       = GetNamesTable(&reader, &names_quant);
+
+    reader.names       = names;
+    reader.names_quant = names_quant;
+
+    tree->root = GetDefFuncs(&reader);
+
+    FREE(names);
+    munmap(data, size);
+
+    return;
 }
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static Node_t* GetDefFuncNode(WordArray* word_array)
+static void CheckSignature(TextReader* reader)
 {
-    assert(word_array);
+    assert(reader);
 
-    
-    Word word = ConsumeWord(word_array);
-    if (!IsWordDefFunc(word.word))
-    return nullptr;
-    
-    
-    Node_t* type_node = GetTypeNode(word_array);
+    const char* const signature[] =
+    {
+        ast_file_signature,
+        ast_file_signature_name,
+        ast_file_signature_autor,
+        ast_file_signature_version,
+    };
+
+    for (size_t i = 0; i < sizeof(signature) / sizeof(signature[0]); i++)
+    {
+        TextWord word = ConsumeWord(reader);
+
+        if (!IsWord(&word, signature[i]))
+            SyntaxErr(reader, &word, bad_signature_massage, signature[i]);
+    }
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// file ids of names are remapped to ids of the running interner
+static NameId* GetNamesTable(TextReader* reader, size_t* names_quant)
+{
+    assert(reader);
+    assert(names_quant);
+
+    ConsumeKeyword(reader, names_table);
+
+    TextWord quant_word = ConsumeWord(reader);
+    *names_quant = WordToSize(reader, &quant_word);
+
+    NameId* names = (NameId*) calloc(*names_quant + 1, sizeof(*names));
+    if (!names)
+        EXIT(EXIT_FAILURE, "failed calloc memory for ast names table.");
+
+    for (size_t i = 1; i <= *names_quant; i++)
+    {
+        TextWord id_word   = ConsumeWord(reader);
+        TextWord name_word = ConsumeWord(reader);
+
+        if (WordToSize(reader, &id_word) != i)
+            SyntaxErr(reader, &id_word, bad_tree_massage, "next name id");
+
+        NameInfo name_info = {name_word.word, name_word.len};
+        names[i] = InternNameCopy(&name_info);
+    }
+
+    return names;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static Node_t* GetDefFuncs(TextReader* reader)
+{
+    assert(reader);
+
+    Node_t*  root = nullptr;
+    Node_t** tail = &root;
+
+    while (!IsEnd(reader))
+        AppendToList(reader->arena, &tail, GetDefFunc(reader));
+
+    return root;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static Node_t* GetDefFunc(TextReader* reader)
+{
+    assert(reader);
+
+    ConsumeKeyword(reader, def_func);
+    ConsumeKeyword(reader, "{");
+
+    Node_t* type_node = GetType(reader);
+    Node_t* name_node = GetName(reader);
+
+    type_node->left = name_node;
+
+    ConsumeKeyword(reader, arguments);
+    ConsumeKeyword(reader, "{");
+    name_node->left = GetDefFuncArgs(reader);
+    ConsumeKeyword(reader, "}");
+
+    name_node->right = GetBody(reader);
+
+    ConsumeKeyword(reader, "}");
 
     Node_t* def_func_node = {};
+    _DEF_FUNC(&def_func_node, reader->arena, type_node);
 
     return def_func_node;
 }
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
+// every argument has its own connect node: connect(arg_1, connect(arg_2, ... connect(arg_n, nullptr)))
+static Node_t* GetDefFuncArgs(TextReader* reader)
+{
+    assert(reader);
+
+    Node_t*  args = nullptr;
+    Node_t** tail = &args;
+
+    while (!IsKeyword(reader, "}"))
+    {
+        Node_t* type_node = GetType(reader);
+        type_node->left   = GetName(reader);
+
+        Node_t* connect_node = {};
+        _CONNECT(&connect_node, reader->arena, type_node, nullptr);
+
+        *tail = connect_node;
+        tail  = &connect_node->right;
+    }
+
+    return args;
+}
+
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
+static Node_t* GetBody(TextReader* reader)
+{
+    assert(reader);
+
+    ConsumeKeyword(reader, body);
+    ConsumeKeyword(reader, "{");
+
+    Node_t* statements = GetStatements(reader);
+
+    ConsumeKeyword(reader, "}");
+
+    return statements;
+}
+
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static Node_t* GetTypeNode(WordArray* word_array)
+static Node_t* GetStatements(TextReader* reader)
 {
-    assert(word_array);
+    assert(reader);
 
-    Word word = word_array->words[word_array->pointer];
+    Node_t*  statements = nullptr;
+    Node_t** tail       = &statements;
 
-    Type type = GetType(&word);
+    while (!IsKeyword(reader, "}"))
+    {
+        Node_t* statement = nullptr;
 
-    Node_t* node = {};
-    _TYPE(&node, type, nullptr);
+        if      (IsKeyword(reader, condition_if)) statement = GetConditions(reader);
+        else if (IsKeyword(reader, cycle_while))  statement = GetCycle     (reader, cycle_while, Cycle::while_t);
+        else if (IsKeyword(reader, cycle_for))    statement = GetCycle     (reader, cycle_for,   Cycle::for_t  );
+        else                                      statement = GetNode      (reader);
 
-    return node;
+        AppendToList(reader->arena, &tail, statement);
+    }
+
+    return statements;
 }
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// if [else_if ...] [else]: connect(if, else_if), connect(if, else) or connect(if, connect(else_if, else))
+static Node_t* GetConditions(TextReader* reader)
+{
+    assert(reader);
+
+    Node_t* if_node = GetConditionBranch(reader, condition_if, Condition::if_t);
+
+    Node_t*  else_if_node = nullptr;
+    Node_t** tail         = &else_if_node;
+
+    while (IsKeyword(reader, condition_else_if))
+        AppendToList(reader->arena, &tail, GetConditionBranch(reader, condition_else_if, Condition::else_if_t));
+
+    Node_t* else_node = nullptr;
+
+    if (IsKeyword(reader, condition_else))
+        else_node = GetConditionBranch(reader, condition_else, Condition::else_t);
+
+    if (!else_if_node && !else_node)
+        return if_node;
+
+    Node_t* connect_node = {};
+
+    if (else_if_node && else_node)
+    {
+        Node_t* connect_node_2 = {};
+        _CONNECT(&connect_node_2, reader->arena, else_if_node, else_node     );
+        _CONNECT(&connect_node  , reader->arena, if_node     , connect_node_2);
+    }
+
+    else
+        _CONNECT(&connect_node, reader->arena, if_node, else_if_node ? else_if_node : else_node);
+
+    return connect_node;
+}
+
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static Node_t* GetConditionBranch(TextReader* reader, const char* keyword, Condition condition_type)
+{
+    assert(reader);
+    assert(keyword);
+
+    ConsumeKeyword(reader, keyword);
+    ConsumeKeyword(reader, "{");
+
+    Node_t* condition_node = nullptr;
+
+    if (condition_type != Condition::else_t)
+    {
+        ConsumeKeyword(reader, condition);
+        ConsumeKeyword(reader, "{");
+        condition_node = GetOptionalNode(reader);
+        ConsumeKeyword(reader, "}");
+    }
+
+    Node_t* body_node = GetBody(reader);
+
+    ConsumeKeyword(reader, "}");
+
+    Node_t* branch_node = {};
+
+    switch (condition_type)
+    {
+        case Condition::if_t:      _IF  (&branch_node, reader->arena, condition_node, body_node); break;
+        case Condition::else_if_t: _ELIF(&branch_node, reader->arena, condition_node, body_node); break;
+        case Condition::else_t:    _ELSE(&branch_node, reader->arena,                 body_node); break;
+        case Condition::undefined_condition:
+        default: assert(0 && "undefined condition type"); break;
+    }
+
+    return branch_node;
+}
+
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static void CheckSignature(WordArray* word_array)
+// 'for' condition is connect(connect(init, condition), step), as the front-end builds it
+static Node_t* GetCycle(TextReader* reader, const char* keyword, Cycle cycle)
 {
-    assert(word_array);
+    assert(reader);
+    assert(keyword);
 
-    CheckSignatureBegin   (word_array);
-    CheckSignatureName    (word_array);
-    CheckSignatureAutor   (word_array);
-    CheckSignatureVersion (word_array);
+    ConsumeKeyword(reader, keyword);
+    ConsumeKeyword(reader, "{");
 
-    return;
+    ConsumeKeyword(reader, cycle_condition);
+    ConsumeKeyword(reader, "{");
+
+    Node_t* condition_node = GetOptionalNode(reader);
+
+    if (cycle == Cycle::for_t)
+    {
+        Node_t* bool_node   = GetNode(reader);
+        Node_t* assign_node = GetNode(reader);
+
+        Node_t* connect_node_1 = {};
+        Node_t* connect_node_2 = {};
+
+        _CONNECT(&connect_node_1, reader->arena, condition_node, bool_node  );
+        _CONNECT(&connect_node_2, reader->arena, connect_node_1, assign_node);
+
+        condition_node = connect_node_2;
+    }
+
+    ConsumeKeyword(reader, "}");
+
+    Node_t* body_node = GetBody(reader);
+
+    ConsumeKeyword(reader, "}");
+
+    Node_t* cycle_node = {};
+
+    switch (cycle)
+    {
+        case Cycle::while_t: _WHILE(&cycle_node, reader->arena, condition_node, body_node); break;
+        case Cycle::for_t:   _FOR  (&cycle_node, reader->arena, condition_node, body_node); break;
+        case Cycle::undefined_cycle:
+        default: assert(0 && "undefined cycle type"); break;
+    }
+
+    return cycle_node;
 }
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static void CheckSignatureBegin(WordArray* word_array)
+static Node_t* GetNode(TextReader* reader)
 {
-    assert(word_array);
+    assert(reader);
 
-    CheckSignatureHelper(word_array, ast_file_signature);
+    if (IsKeyword(reader, ret))             return GetReturn       (reader);
+    if (IsKeyword(reader, define_variable)) return GetDefVariable  (reader);
+    if (IsKeyword(reader, assign))          return GetAssign       (reader);
+    if (IsKeyword(reader, operation))       return GetOperation    (reader);
+    if (IsKeyword(reader, call_function))   return GetCallFunction (reader);
+    if (IsKeyword(reader, number))          return GetNumber       (reader);
+    if (IsKeyword(reader, name))            return GetName         (reader);
 
-    return;
+    TextWord word = PickWord(reader);
+    SyntaxErr(reader, &word, bad_tree_massage, "statement or expression");
+
+    return nullptr;
 }
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static void CheckSignatureName(WordArray* word_array)
+static Node_t* GetOptionalNode(TextReader* reader)
 {
-    assert(word_array);
+    assert(reader);
 
-    CheckSignatureHelper(word_array, ast_file_signature_name);
+    if (IsKeyword(reader, "}"))
+        return nullptr;
 
-    return;
+    return GetNode(reader);
 }
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static void CheckSignatureAutor(WordArray* word_array)
+static Node_t* GetReturn(TextReader* reader)
 {
-    assert(word_array);
+    assert(reader);
 
-    CheckSignatureHelper(word_array, ast_file_signature_autor);
+    ConsumeKeyword(reader, ret);
+    ConsumeKeyword(reader, "{");
 
-    return;
+    Node_t* value_node = GetOptionalNode(reader);
+
+    ConsumeKeyword(reader, "}");
+
+    Node_t* return_node = {};
+    _RET(&return_node, reader->arena, value_node);
+
+    return return_node;
 }
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static void CheckSignatureVersion(WordArray* word_array)
+static Node_t* GetDefVariable(TextReader* reader)
 {
-    assert(word_array);
+    assert(reader);
 
-    CheckSignatureHelper(word_array, ast_file_signature_version);
+    ConsumeKeyword(reader, define_variable);
+    ConsumeKeyword(reader, "{");
 
-    return;
+    Node_t* type_node = GetType(reader);
+    type_node->left   = GetName(reader);
+
+    ConsumeKeyword(reader, assign);
+    ConsumeKeyword(reader, "{");
+    Node_t* value_node = GetOptionalNode(reader);
+    ConsumeKeyword(reader, "}");
+
+    ConsumeKeyword(reader, "}");
+
+    Node_t* def_variable_node = {};
+    _DEF_VAR(&def_variable_node, reader->arena, type_node, value_node);
+
+    return def_variable_node;
 }
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static void CheckSignatureHelper(WordArray* word_array, const char* correct)
+static Node_t* GetAssign(TextReader* reader)
 {
-    assert(word_array);
-    assert(correct);
+    assert(reader);
+
+    ConsumeKeyword(reader, assign);
+    ConsumeKeyword(reader, "{");
+
+    Node_t* name_node  = GetName(reader);
+    Node_t* value_node = GetOptionalNode(reader);
+
+    ConsumeKeyword(reader, "}");
+
+    Node_t* asg_variable_node = {};
+    _ASG_VAR(&asg_variable_node, reader->arena, name_node, value_node);
+
+    return asg_variable_node;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// unary operations ('-', '!') have only the left operand
+static Node_t* GetOperation(TextReader* reader)
+{
+    assert(reader);
 
-    Word word = word_array->words[word_array->pointer];
+    ConsumeKeyword(reader, operation);
 
-    if (strcmp(word.word, correct) != 0)
+    TextWord  operation_word = ConsumeWord(reader);
+    Operation operation_type = Operation::undefined_operation;
+
+    for (size_t i = 0; i < OperationsWordsQuant; i++)
     {
-        EXIT(EXIT_FAILURE,  "%s\n"
-                            "'%s' - here must be '%s'\n"
-                            "%s:%lu:%lu\n",
-                            bad_signature_massage, 
-                            word.word, correct,
-                            word_array->input_stream, word.line, word.inLine
-            );
+        if (IsWord(&operation_word, OperationsWords[i].word))
+        {
+            operation_type = OperationsWords[i].operation;
+            break;
+        }
     }
 
-    word_array->pointer++;
+    if (operation_type == Operation::undefined_operation)
+        SyntaxErr(reader, &operation_word, bad_tree_massage, "operation");
 
-    return;
+    ConsumeKeyword(reader, "{");
+
+    Node_t* left_node  = GetOptionalNode(reader);
+    Node_t* right_node = GetOptionalNode(reader);
+
+    ConsumeKeyword(reader, "}");
+
+    Node_t* operation_node = {};
+    _OPER(&operation_node, reader->arena, operation_type, left_node, right_node);
+
+    return operation_node;
 }
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static Node_t* GetCallFunction(TextReader* reader)
+{
+    assert(reader);
+
+    ConsumeKeyword(reader, call_function);
+    ConsumeKeyword(reader, "{");
+
+    Node_t* name_node = GetName(reader);
+
+    if (IsKeyword(reader, call_function_arguments))
+    {
+        ConsumeKeyword(reader, call_function_arguments);
+        ConsumeKeyword(reader, "{");
+
+        Node_t** tail = &name_node->left;
+
+        while (!IsKeyword(reader, "}"))
+            AppendToList(reader->arena, &tail, GetNode(reader));
+
+        ConsumeKeyword(reader, "}");
+    }
+
+    ConsumeKeyword(reader, "}");
+
+    Node_t* call_func_node = {};
+    _CALL_FUNC(&call_func_node, reader->arena, name_node);
+
+    return call_func_node;
+}
+
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static Node_t* GetNumber(TextReader* reader)
+{
+    assert(reader);
+
+    ConsumeKeyword(reader, number);
+
+    TextWord number_word = ConsumeWord(reader);
+
+    if (number_word.len == 0 || number_word.len >= NumberWordMaxLen)
+        SyntaxErr(reader, &number_word, bad_tree_massage, "number");
+
+    // mapped file has no '\0' after the word, so strtol/strtod work on a copy
+    char number_str[NumberWordMaxLen] = {};
+    memcpy(number_str, number_word.word, number_word.len);
+
+    Number num = {};
+    char*  end = nullptr;
+
+    if (memchr(number_str, '.', number_word.len))
+    {
+        num.type             = Type::double_type;
+        num.value.double_val = strtod(number_str, &end);
+    }
+
+    else
+    {
+        num.type          = Type::int_type;
+        num.value.int_val = (int) strtol(number_str, &end, 10);
+    }
+
+    if (end == number_str)
+    {
+        num.type           = Type::char_type;
+        num.value.char_val = number_str[0];
+    }
+
+    else if (end != number_str + number_word.len)
+        SyntaxErr(reader, &number_word, bad_tree_massage, "number");
+
+    Node_t* node = {};
+    _NUM(&node, reader->arena, num);
+
+    return node;
+}
+
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static Type GetType(const Word* word)
+static Node_t* GetName(TextReader* reader)
 {
-    assert(word);
+    assert(reader);
 
-    const char* word_str = word->word;
+    ConsumeKeyword(reader, name);
 
-    assert(word_str);
+    TextWord id_word = ConsumeWord(reader);
+    size_t   file_id = WordToSize(reader, &id_word);
+
+    if (file_id == NameNoId || file_id > reader->names_quant)
+        SyntaxErr(reader, &id_word, bad_tree_massage, "id from names table");
+
+    Name node_name = {};
+    node_name.id   = reader->names[file_id];
+    node_name.name = GetInternedName(node_name.id);
+
+    Node_t* node = {};
+    _NAME(&node, reader->arena, node_name);
+
+    return node;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-    for (size_t type_i = 0; type_i < DefaultTypesQuant; type_i++)
+static Node_t* GetType(TextReader* reader)
+{
+    assert(reader);
+
+    ConsumeKeyword(reader, type);
+
+    TextWord type_word = ConsumeWord(reader);
+    Type     node_type = Type::undefined_type;
+
+    if      (IsWord(&type_word, int_type   )) node_type = Type::int_type;
+    else if (IsWord(&type_word, char_type  )) node_type = Type::char_type;
+    else if (IsWord(&type_word, double_type)) node_type = Type::double_type;
+    else if (IsWord(&type_word, void_type  )) node_type = Type::void_type;
+    else
+        SyntaxErr(reader, &type_word, bad_tree_massage, "type");
+
+    Node_t* node = {};
+    _TYPE(&node, reader->arena, node_type, nullptr);
+
+    return node;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// *tail is the slot of the last list element: list is connect(node_1, connect(node_2, ... node_n))
+static void AppendToList(NodeArena* arena, Node_t*** tail, Node_t* node)
+{
+    assert(tail);
+    assert(*tail);
+
+    if (!**tail)
     {
-        DefaultType type = DefaultTypes[type_i];
-        
-        bool flag = strcmp(word_str, type.nameInfo.name);
-        RETURN_IF_TRUE(flag, type.value);
+        **tail = node;
+        return;
     }
 
-    return Type::undefined_type;
+    Node_t* connect_node = {};
+    _CONNECT(&connect_node, arena, **tail, node);
+
+    **tail = connect_node;
+    *tail  = &connect_node->right;
+
+    return;
 }
 
-//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-Word ConsumeWord(WordArray* word_array)
+static TextWord PickWord(TextReader* reader)
 {
-    assert(word_array);
+    assert(reader);
+
+    SkipSpaces(reader);
+
+    TextWord word = {};
+    word.word     = reader->data + reader->pointer;
+    word.line     = reader->line;
+    word.in_line  = reader->pointer - reader->line_begin + 1;
 
-    word_array->pointer++;
+    size_t end = reader->pointer;
 
-    return word_array->words[word_array->pointer - 1];
+    while (end < reader->size && reader->data[end] != ' '  && reader->data[end] != '\t' &&
+                                 reader->data[end] != '\n' && reader->data[end] != '\r')
+        end++;
+
+    word.len = end - reader->pointer;
+
+    return word;
 }
 
-//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-Word PickWord(WordArray* word_array)
+static TextWord ConsumeWord(TextReader* reader)
 {
-    assert(word_array);
+    assert(reader);
+
+    TextWord word = PickWord(reader);
+
+    if (word.len == 0)
+        SyntaxErr(reader, &word, bad_tree_massage, "some word, not end of file");
 
-    return word_array->words[word_array->pointer];
+    reader->pointer += word.len;
+
+    return word;
 }
 
-//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static bool IsWordDefFunc(const char* word)
+static void SkipSpaces(TextReader* reader)
 {
-    assert(word);
-    return (strcmp(word, def_func) == 0);
+    assert(reader);
+
+    while (reader->pointer < reader->size)
+    {
+        char c = reader->data[reader->pointer];
+
+        if (c == '\n')
+        {
+            reader->line++;
+            reader->line_begin = reader->pointer + 1;
+        }
+
+        else if (c != ' ' && c != '\t' && c != '\r')
+            break;
+
+        reader->pointer++;
+    }
+
+    return;
 }
 
-//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static bool IsWordDefVariable(const char* word)
+// keywords can be of two words ("CYCLE: for"), the writer separates them with one space
+static bool IsKeyword(TextReader* reader, const char* keyword)
 {
-    assert(word);
-    return (strcmp(word, define_variable) == 0);
+    assert(reader);
+    assert(keyword);
+
+    SkipSpaces(reader);
+
+    size_t len  = strlen(keyword);
+    size_t left = reader->size - reader->pointer;
+
+    if (left < len || strncmp(reader->data + reader->pointer, keyword, len) != 0)
+        return false;
+
+    if (left == len)
+        return true;
+
+    char next = reader->data[reader->pointer + len];
+
+    return next == ' ' || next == '\t' || next == '\n' || next == '\r';
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void ConsumeKeyword(TextReader* reader, const char* keyword)
+{
+    assert(reader);
+    assert(keyword);
+
+    if (!IsKeyword(reader, keyword))
+    {
+        TextWord word = PickWord(reader);
+        SyntaxErr(reader, &word, bad_tree_massage, keyword);
+    }
+
+    reader->pointer += strlen(keyword);
+
+    return;
 }
 
-//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static bool IsWordCallFunc(const char* word)
+static bool IsWord(const TextWord* word, const char* correct)
 {
     assert(word);
-    return (strcmp(word, call_function) == 0);
+    assert(correct);
+
+    return strlen(correct) == word->len && strncmp(word->word, correct, word->len) == 0;
 }
 
-//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static bool IsWordAssign(const char* word)
+static bool IsEnd(TextReader* reader)
 {
+    assert(reader);
+
+    SkipSpaces(reader);
+
+    return reader->pointer == reader->size;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static size_t WordToSize(TextReader* reader, const TextWord* word)
+{
+    assert(reader);
     assert(word);
-    return (strcmp(word, assign) == 0);
+
+    size_t value = 0;
+
+    for (size_t i = 0; i < word->len; i++)
+    {
+        char c = word->word[i];
+
+        if (c < '0' || c > '9')
+            SyntaxErr(reader, word, bad_tree_massage, "unsigned number");
+
+        value = value * 10 + (size_t) (c - '0');
+    }
+
+    if (word->len == 0)
+        SyntaxErr(reader, word, bad_tree_massage, "unsigned number");
+
+    return value;
 }
 
-//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static bool IsWordType(const char* word)
+static void SyntaxErr(const TextReader* reader, const TextWord* word, const char* massage, const char* correct)
 {
+    assert(reader);
     assert(word);
-    return (strcmp(word, type) == 0);
+    assert(massage);
+    assert(correct);
+
+    EXIT(EXIT_FAILURE,  "%s\n"
+                        "'%.*s' - here must be '%s'\n"
+                        "%s:%lu:%lu\n",
+                        massage,
+                        (int) word->len, word->word, correct,
+                        reader->instream, word->line, word->in_line
+        );
 }
 
-//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,264 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <assert.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "lib/lib.hpp"
+#include "tree/read-write-tree/write-buffer/write-buffer.hpp"
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static const char   Tabs[]          = "\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t"
+                                      "\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t";
+static const size_t TabsLen         = sizeof(Tabs) - 1;
+
+static const size_t NumberMaxLen    = 32;
+static const size_t DoubleMaxLen    = 512; // "%f" of DBL_MAX is 316 chars
+
+// doubles are printed as "%f": 6 digits after the point
+static const double DoubleScale     = 1e6;
+static const size_t DoubleFracLen   = 6;
+static const double DoubleFastLimit = 1e9; // |value| * DoubleScale < 2^53, so it is exact enough
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void   Reserve     (WriteBuffer* buffer, size_t size);
+static size_t SizeToStr   (uint64_t value, char* str);
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void WriteBufferCtor(WriteBuffer* buffer, size_t capacity)
+{
+    assert(buffer);
+    assert(capacity > 0);
+
+    buffer->data     = (char*) calloc(capacity, sizeof(*buffer->data));
+    buffer->size     = 0;
+    buffer->capacity = capacity;
+
+    if (!buffer->data)
+        EXIT(EXIT_FAILURE, "failed calloc memory for write buffer.");
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void WriteBufferDtor(WriteBuffer* buffer)
+{
+    assert(buffer);
+
+    free(buffer->data);
+    *buffer = {};
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void WriteBufferFlush(WriteBuffer* buffer, const char* outstream)
+{
+    assert(buffer);
+    assert(outstream);
+
+    int fd = open(outstream, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        EXIT(EXIT_FAILURE, "failed open '%s'", outstream);
+
+    size_t written = 0;
+
+    // one write() for the whole buffer, the loop is only for partial writes
+    while (written < buffer->size)
+    {
+        ssize_t result = write(fd, buffer->data + written, buffer->size - written);
+
+        if (result <= 0)
+            EXIT(EXIT_FAILURE, "failed write '%s'", outstream);
+
+        written += (size_t) result;
+    }
+
+    if (close(fd) != 0)
+        EXIT(EXIT_FAILURE, "failed close '%s'", outstream);
+
+    buffer->size = 0;
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void BufferPutChar(WriteBuffer* buffer, char c)
+{
+    assert(buffer);
+
+    if (buffer->size == buffer->capacity)
+        Reserve(buffer, 1);
+
+    buffer->data[buffer->size++] = c;
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void BufferPutBytes(WriteBuffer* buffer, const void* bytes, size_t size)
+{
+    assert(buffer);
+    assert(bytes);
+
+    Reserve(buffer, size);
+
+    memcpy(buffer->data + buffer->size, bytes, size);
+    buffer->size += size;
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void BufferPutStr(WriteBuffer* buffer, const char* str)
+{
+    assert(buffer);
+    assert(str);
+
+    BufferPutBytes(buffer, str, strlen(str));
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void BufferPutTabs(WriteBuffer* buffer, size_t tabs_quant)
+{
+    assert(buffer);
+
+    while (tabs_quant > TabsLen)
+    {
+        BufferPutBytes(buffer, Tabs, TabsLen);
+        tabs_quant -= TabsLen;
+    }
+
+    BufferPutBytes(buffer, Tabs, tabs_quant);
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void BufferPutSize(WriteBuffer* buffer, size_t value)
+{
+    assert(buffer);
+
+    char   str[NumberMaxLen] = {};
+    size_t len = SizeToStr(value, str);
+
+    BufferPutBytes(buffer, str, len);
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void BufferPutInt(WriteBuffer* buffer, int64_t value)
+{
+    assert(buffer);
+
+    if (value < 0)
+    {
+        BufferPutChar(buffer, '-');
+        BufferPutSize(buffer, (uint64_t) 0 - (uint64_t) value);
+        return;
+    }
+
+    BufferPutSize(buffer, (uint64_t) value);
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// same text as printf("%f"): when value * 1e6 is a whole number it is printed
+// as two integers, the rest (big, long fraction, inf, nan) goes to snprintf
+void BufferPutDouble(WriteBuffer* buffer, double value)
+{
+    assert(buffer);
+
+    double   scaled = fabs(value * DoubleScale);
+    uint64_t digits = (fabs(value) < DoubleFastLimit) ? (uint64_t) scaled : 0;
+
+    if (!(fabs(value) < DoubleFastLimit) || scaled - (double) digits > 0)
+    {
+        char str[DoubleMaxLen] = {};
+        int  len = snprintf(str, sizeof(str), "%f", value);
+
+        BufferPutBytes(buffer, str, (size_t) len);
+        return;
+    }
+
+    if (signbit(value))
+        BufferPutChar(buffer, '-');
+
+    uint64_t scale = (uint64_t) DoubleScale;
+
+    BufferPutSize(buffer, digits / scale);
+    BufferPutChar(buffer, '.');
+
+    char   frac[NumberMaxLen] = {};
+    size_t frac_len = SizeToStr(digits % scale, frac);
+
+    for (size_t i = frac_len; i < DoubleFracLen; i++)
+        BufferPutChar(buffer, '0');
+
+    BufferPutBytes(buffer, frac, frac_len);
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void Reserve(WriteBuffer* buffer, size_t size)
+{
+    assert(buffer);
+
+    if (buffer->size + size <= buffer->capacity)
+        return;
+
+    size_t capacity = (buffer->capacity > 0) ? buffer->capacity : WriteBufferDefaultCapacity;
+
+    while (buffer->size + size > capacity)
+        capacity *= 2;
+
+    buffer->data = (char*) realloc(buffer->data, capacity);
+    if (!buffer->data)
+        EXIT(EXIT_FAILURE, "failed realloc memory for write buffer.");
+
+    buffer->capacity = capacity;
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static size_t SizeToStr(uint64_t value, char* str)
+{
+    assert(str);
+
+    char   reversed[NumberMaxLen] = {};
+    size_t len = 0;
+
+    do
+    {
+        reversed[len++] = (char) ('0' + value % 10);
+        value /= 10;
+    }
+    while (value > 0);
+
+    for (size_t i = 0; i < len; i++)
+        str[i] = reversed[len - 1 - i];
+
+    return len;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
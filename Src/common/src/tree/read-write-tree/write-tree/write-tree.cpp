@@ -1,9 +1,14 @@
 #include <stdlib.h>
+#include <string.h>
 #include <assert.h>
 #include "lib/lib.hpp"
+#include "profile/profile.hpp"
 #include "tree/tree.hpp"
 #include "tree/read-write-tree/write-tree/write-tree.hpp"
 #include "tree/read-write-tree/read-write-tree-global/read-write-tree-global.hpp"
+#include "name-table/interner/interner.hpp"
+#include "tree/read-write-tree/binary-tree/binary-tree.hpp"
+#include "tree/read-write-tree/write-buffer/write-buffer.hpp"
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
@@ -26,44 +31,45 @@
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static void PrintSignature         (FILE* outstream);
+static void PrintSignature         (WriteBuffer* outstream);
+static void PrintNamesTable        (WriteBuffer* outstream);
 
-static void PrintDefFunc           (FILE* outstream, const Node_t* node ON_TAB(, size_t nTabBefore));
-static void PrintDefFuncArg        (FILE* outstream, const Node_t* node ON_TAB(, size_t nTabBefore));
-static void PrintCondition         (FILE* outstream, const Node_t* node ON_TAB(, size_t nTabBefore));
-static void PrintConditionIf       (FILE* outstream, const Node_t* node ON_TAB(, size_t nTabBefore));
-static void PrintConditionElseIf   (FILE* outstream, const Node_t* node ON_TAB(, size_t nTabBefore));
-static void PrintConditionElse     (FILE* outstream, const Node_t* node ON_TAB(, size_t nTabBefore));
-static void PrintCycle             (FILE* outstream, const Node_t* node ON_TAB(, size_t nTabBefore));
-static void PrintCycleWhile        (FILE* outstream, const Node_t* node ON_TAB(, size_t nTabBefore));
-static void PrintCycleFor          (FILE* outstream, const Node_t* node ON_TAB(, size_t nTabBefore));
-static void PrintReturn            (FILE* outstream, const Node_t* node ON_TAB(, size_t nTabBefore));
-static void PrintDefVariable       (FILE* outstream, const Node_t* node ON_TAB(, size_t nTabBefore));
-static void PrintAssign            (FILE* outstream, const Node_t* node ON_TAB(, size_t nTabBefore));
-static void PrintOperation         (FILE* outstream, const Node_t* node ON_TAB(, size_t nTabBefore));
-static void PrintCallFunction      (FILE* outstream, const Node_t* node ON_TAB(, size_t nTabBefore));
-static void PrintCallFunctionArgs  (FILE* outstream, const Node_t* node ON_TAB(, size_t nTabBefore));
-static void PrintNumber            (FILE* outstream, const Node_t* node ON_TAB(, size_t nTabBefore));
-static void PrintName              (FILE* outstream, const Node_t* node ON_TAB(, size_t nTabBefore));
-static void PrintType              (FILE* outstream, const Node_t* node ON_TAB(, size_t nTabBefore));
+static void PrintDefFunc           (WriteBuffer* outstream, const Node_t* node ON_TAB(, size_t nTabBefore));
+static void PrintDefFuncArg        (WriteBuffer* outstream, const Node_t* node ON_TAB(, size_t nTabBefore));
+static void PrintCondition         (WriteBuffer* outstream, const Node_t* node ON_TAB(, size_t nTabBefore));
+static void PrintConditionIf       (WriteBuffer* outstream, const Node_t* node ON_TAB(, size_t nTabBefore));
+static void PrintConditionElseIf   (WriteBuffer* outstream, const Node_t* node ON_TAB(, size_t nTabBefore));
+static void PrintConditionElse     (WriteBuffer* outstream, const Node_t* node ON_TAB(, size_t nTabBefore));
+static void PrintCycle             (WriteBuffer* outstream, const Node_t* node ON_TAB(, size_t nTabBefore));
+static void PrintCycleWhile        (WriteBuffer* outstream, const Node_t* node ON_TAB(, size_t nTabBefore));
+static void PrintCycleFor          (WriteBuffer* outstream, const Node_t* node ON_TAB(, size_t nTabBefore));
+static void PrintReturn            (WriteBuffer* outstream, const Node_t* node ON_TAB(, size_t nTabBefore));
+static void PrintDefVariable       (WriteBuffer* outstream, const Node_t* node ON_TAB(, size_t nTabBefore));
+static void PrintAssign            (WriteBuffer* outstream, const Node_t* node ON_TAB(, size_t nTabBefore));
+static void PrintOperation         (WriteBuffer* outstream, const Node_t* node ON_TAB(, size_t nTabBefore));
+static void PrintCallFunction      (WriteBuffer* outstream, const Node_t* node ON_TAB(, size_t nTabBefore));
+static void PrintCallFunctionArgs  (WriteBuffer* outstream, const Node_t* node ON_TAB(, size_t nTabBefore));
+static void PrintNumber            (WriteBuffer* outstream, const Node_t* node ON_TAB(, size_t nTabBefore));
+static void PrintName              (WriteBuffer* outstream, const Node_t* node ON_TAB(, size_t nTabBefore));
+static void PrintType              (WriteBuffer* outstream, const Node_t* node ON_TAB(, size_t nTabBefore));
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
 ON_TAB
 (
-static void PrintNTab         (FILE* outstream, size_t nTab                                   );
-static void PrintSlashN       (FILE* outstream                                                );
+static void PrintNTab         (WriteBuffer* outstream, size_t nTab                                   );
+static void PrintSlashN       (WriteBuffer* outstream                                                );
 )
-static void PrintLeftBracket  (FILE* outstream                     ON_TAB(, size_t nTab      ));
-static void PrintRightBracket (FILE* outstream                     ON_TAB(, size_t nTab      ));
-static void PrintBefore       (FILE* outstream                     ON_TAB(, size_t nTab      ));
-static void PrintAfter        (FILE* outstream                                                );
+static void PrintLeftBracket  (WriteBuffer* outstream                     ON_TAB(, size_t nTab      ));
+static void PrintRightBracket (WriteBuffer* outstream                     ON_TAB(, size_t nTab      ));
+static void PrintBefore       (WriteBuffer* outstream                     ON_TAB(, size_t nTab      ));
+static void PrintAfter        (WriteBuffer* outstream                                                );
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
 OFF_TAB
 (
-static void PrintSpace        (FILE* outstream                                                );
+static void PrintSpace        (WriteBuffer* outstream                                                );
 )
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -76,48 +82,111 @@ void WherePrintTreeIs(const char* func);
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-void PrintTree(const Tree_t* tree, const char* outstream)
+void PrintTree(const Tree_t* tree, const char* outstream, AstFormat format)
 {
     WHERE_PRINT_TREE_IS();
 
     assert(tree);
     assert(outstream);
 
-    FILE* out = fopen(outstream, "wb");
+    PROFILE_SCOPE("PrintTree");
 
-    if (!out)
-        EXIT(EXIT_FAILURE, "failed open '%s'", outstream);
+    if (format == AstFormat::binary)
+    {
+        PrintBinaryTree(tree, outstream);
+        return;
+    }
+
+    // the whole text is made in memory and written with one write()
+    WriteBuffer out = {};
+    WriteBufferCtor(&out, WriteBufferDefaultCapacity);
+
+    PrintSignature (&out);
+    PrintNamesTable(&out);
+    PrintDefFunc   (&out, tree->root ON_TAB(, 0));
 
-    PrintSignature(out);
-    PrintDefFunc  (out, tree->root ON_TAB(, 0));
+    WriteBufferFlush(&out, outstream);
+    WriteBufferDtor (&out);
 
     return;
 }
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static void PrintSignature(FILE* outstream)
+AstFormat GetAstFormat(const char* format_name)
+{
+    assert(format_name);
+
+    if (strcmp(format_name, "text")   == 0) return AstFormat::text;
+    if (strcmp(format_name, "binary") == 0) return AstFormat::binary;
+
+    EXIT(EXIT_FAILURE, "unknown ast format '%s', expected 'text' or 'binary'", format_name);
+
+    return AstFormat::text;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void PrintSignature(WriteBuffer* outstream)
 {
     WHERE_PRINT_TREE_IS();
 
     assert(outstream);
 
-    fprintf(outstream,  "%s\n"
-                        "%s\n"
-                        "%s\n"
-                        "%s\n"
-                        "\n",
-                        ast_file_signature,
-                        ast_file_signature_name,
-                        ast_file_signature_autor,
-                        ast_file_signature_version
-                    );
+    const char* const signature[] =
+    {
+        ast_file_signature,
+        ast_file_signature_name,
+        ast_file_signature_autor,
+        ast_file_signature_version,
+    };
+
+    for (size_t i = 0; i < sizeof(signature) / sizeof(signature[0]); i++)
+    {
+        BufferPutStr (outstream, signature[i]);
+        BufferPutChar(outstream, '\n');
+    }
+
+    BufferPutChar(outstream, '\n');
 
+    return;
 }
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static void PrintDefFunc(FILE* outstream, const Node_t* node ON_TAB(, size_t nTabBefore))
+// interned names go to the file once, name nodes refer to them by id,
+// so the reader does not have to hash the strings again
+static void PrintNamesTable(WriteBuffer* outstream)
+{
+    WHERE_PRINT_TREE_IS();
+
+    assert(outstream);
+
+    size_t names_quant = GetInternedNamesQuant();
+
+    BufferPutStr (outstream, names_table);
+    BufferPutChar(outstream, ' ');
+    BufferPutSize(outstream, names_quant);
+    BufferPutChar(outstream, '\n');
+
+    for (NameId id = 1; id <= names_quant; id++)
+    {
+        NameInfo name_info = GetInternedName(id);
+
+        BufferPutSize (outstream, id);
+        BufferPutChar (outstream, ' ');
+        BufferPutBytes(outstream, name_info.name, name_info.len);
+        BufferPutChar (outstream, '\n');
+    }
+
+    BufferPutChar(outstream, '\n');
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void PrintDefFunc(WriteBuffer* outstream, const Node_t* node ON_TAB(, size_t nTabBefore))
 {
     WHERE_PRINT_TREE_IS();
 
@@ -141,7 +210,7 @@ static void PrintDefFunc(FILE* outstream, const Node_t* node ON_TAB(, size_t nTa
     const Node_t* body_node = node->left->left->right;
 
     PrintBefore       (outstream              ON_TAB(, nTabBefore    ));
-    fprintf           (outstream, "%s",       def_func                );
+    BufferPutStr      (outstream,             def_func                );
     PrintAfter        (outstream                                      );
     PrintLeftBracket  (outstream              ON_TAB(, nTabBefore    ));
 
@@ -150,14 +219,14 @@ static void PrintDefFunc(FILE* outstream, const Node_t* node ON_TAB(, size_t nTa
     ON_TAB(PrintSlashN(outstream                                     ));
 
     PrintBefore       (outstream              ON_TAB(, nTabBefore + 1));
-    fprintf           (outstream, "%s",       arguments               );
+    BufferPutStr      (outstream,             arguments               );
     PrintAfter        (outstream                                      );
     PrintLeftBracket  (outstream              ON_TAB(, nTabBefore + 1));
     PrintDefFuncArg   (outstream, args_node   ON_TAB(, nTabBefore + 2));
     PrintRightBracket (outstream              ON_TAB(, nTabBefore + 1));
     ON_TAB(PrintSlashN(outstream                                     ));
     PrintBefore       (outstream              ON_TAB(, nTabBefore + 1));
-    fprintf           (outstream, "%s",       body                    );
+    BufferPutStr      (outstream,             body                    );
     PrintAfter        (outstream                                      );
     PrintLeftBracket  (outstream              ON_TAB(, nTabBefore + 1));
     PrintCondition    (outstream, body_node   ON_TAB(, nTabBefore + 2));
@@ -172,7 +241,7 @@ static void PrintDefFunc(FILE* outstream, const Node_t* node ON_TAB(, size_t nTa
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static void PrintDefFuncArg(FILE* outstream, const Node_t* node ON_TAB(, size_t nTabBefore))
+static void PrintDefFuncArg(WriteBuffer* outstream, const Node_t* node ON_TAB(, size_t nTabBefore))
 {
     WHERE_PRINT_TREE_IS();
 
@@ -200,7 +269,7 @@ static void PrintDefFuncArg(FILE* outstream, const Node_t* node ON_TAB(, size_t
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static void PrintCondition(FILE* outstream, const Node_t* node ON_TAB(, size_t nTabBefore))
+static void PrintCondition(WriteBuffer* outstream, const Node_t* node ON_TAB(, size_t nTabBefore))
 {
     WHERE_PRINT_TREE_IS();
 
@@ -235,7 +304,7 @@ static void PrintCondition(FILE* outstream, const Node_t* node ON_TAB(, size_t n
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static void PrintConditionIf(FILE* outstream, const Node_t* node ON_TAB(, size_t nTabBefore))
+static void PrintConditionIf(WriteBuffer* outstream, const Node_t* node ON_TAB(, size_t nTabBefore))
 {
     WHERE_PRINT_TREE_IS();
 
@@ -245,12 +314,12 @@ static void PrintConditionIf(FILE* outstream, const Node_t* node ON_TAB(, size_t
         EXIT(EXIT_FAILURE, "here must be connect node (left = if; right = else(if))'");
 
     PrintBefore      (outstream                 ON_TAB(, nTabBefore    ));
-    fprintf          (outstream, "%s",          condition_if            );
+    BufferPutStr     (outstream,                condition_if            );
     PrintAfter       (outstream                                         );
     PrintLeftBracket (outstream                 ON_TAB(, nTabBefore    ));
     
     PrintBefore      (outstream                 ON_TAB(, nTabBefore + 1));
-    fprintf          (outstream, "%s",          condition               );
+    BufferPutStr     (outstream,                condition               );
     PrintAfter       (outstream                                         );
     PrintLeftBracket (outstream                 ON_TAB(, nTabBefore + 1));
     PrintAssign      (outstream, node->left     ON_TAB(, nTabBefore + 2));
@@ -258,7 +327,7 @@ static void PrintConditionIf(FILE* outstream, const Node_t* node ON_TAB(, size_t
     ON_TAB(PrintSlashN(outstream                                       ));
 
     PrintBefore      (outstream                 ON_TAB(, nTabBefore + 1));
-    fprintf          (outstream, "%s",          body                    );
+    BufferPutStr     (outstream,                body                    );
     PrintAfter       (outstream                                         );
     PrintLeftBracket (outstream                 ON_TAB(, nTabBefore + 1));
     PrintCondition   (outstream, node->right    ON_TAB(, nTabBefore + 2));
@@ -274,7 +343,7 @@ static void PrintConditionIf(FILE* outstream, const Node_t* node ON_TAB(, size_t
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static void PrintConditionElseIf(FILE* outstream, const Node_t* node ON_TAB(, size_t nTabBefore))
+static void PrintConditionElseIf(WriteBuffer* outstream, const Node_t* node ON_TAB(, size_t nTabBefore))
 {
     WHERE_PRINT_TREE_IS();
 
@@ -290,12 +359,12 @@ static void PrintConditionElseIf(FILE* outstream, const Node_t* node ON_TAB(, si
     }
 
     PrintBefore      (outstream                   ON_TAB(, nTabBefore    ));
-    fprintf          (outstream, "%s",            condition_else_if       );
+    BufferPutStr     (outstream,                  condition_else_if       );
     PrintAfter       (outstream                                           );
     PrintLeftBracket (outstream                   ON_TAB(, nTabBefore    ));
     
     PrintBefore      (outstream                   ON_TAB(, nTabBefore + 1));
-    fprintf          (outstream, "%s",            condition               );
+    BufferPutStr     (outstream,                  condition               );
     PrintAfter       (outstream                                           );
     PrintLeftBracket (outstream                   ON_TAB(, nTabBefore + 1));
     PrintAssign      (outstream, node->left       ON_TAB(, nTabBefore + 2));
@@ -303,7 +372,7 @@ static void PrintConditionElseIf(FILE* outstream, const Node_t* node ON_TAB(, si
     ON_TAB(PrintSlashN(outstream                                         ));
 
     PrintBefore      (outstream                   ON_TAB(, nTabBefore + 1));
-    fprintf          (outstream, "%s",            body                    );
+    BufferPutStr     (outstream,                  body                    );
     PrintAfter       (outstream                                           );
     PrintLeftBracket (outstream                   ON_TAB(, nTabBefore + 1));
     PrintCondition   (outstream, node->right      ON_TAB(, nTabBefore + 2));
@@ -319,7 +388,7 @@ static void PrintConditionElseIf(FILE* outstream, const Node_t* node ON_TAB(, si
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static void PrintConditionElse(FILE* outstream, const Node_t* node ON_TAB(, size_t nTabBefore))
+static void PrintConditionElse(WriteBuffer* outstream, const Node_t* node ON_TAB(, size_t nTabBefore))
 {
     WHERE_PRINT_TREE_IS();
 
@@ -331,12 +400,12 @@ static void PrintConditionElse(FILE* outstream, const Node_t* node ON_TAB(, size
         EXIT(EXIT_FAILURE, "here must be condition 'else'");
 
     PrintBefore      (outstream               ON_TAB(, nTabBefore    ));
-    fprintf          (outstream, "%s",        condition_else          );
+    BufferPutStr     (outstream,              condition_else          );
     PrintAfter       (outstream                                       );
     PrintLeftBracket (outstream               ON_TAB(, nTabBefore    ));
     
     PrintBefore      (outstream               ON_TAB(, nTabBefore + 1));
-    fprintf          (outstream, "%s",        body                    );
+    BufferPutStr     (outstream,              body                    );
     PrintAfter       (outstream                                       );
     PrintLeftBracket (outstream               ON_TAB(, nTabBefore + 1));
     PrintCondition    (outstream, node->right ON_TAB(, nTabBefore + 2));
@@ -351,7 +420,7 @@ static void PrintConditionElse(FILE* outstream, const Node_t* node ON_TAB(, size
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static void PrintCycle(FILE* outstream, const Node_t* node ON_TAB(, size_t nTabBefore))
+static void PrintCycle(WriteBuffer* outstream, const Node_t* node ON_TAB(, size_t nTabBefore))
 {
     WHERE_PRINT_TREE_IS();
 
@@ -379,7 +448,7 @@ static void PrintCycle(FILE* outstream, const Node_t* node ON_TAB(, size_t nTabB
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static void PrintCycleWhile(FILE* outstream, const Node_t* node ON_TAB(, size_t nTabBefore))
+static void PrintCycleWhile(WriteBuffer* outstream, const Node_t* node ON_TAB(, size_t nTabBefore))
 {
     WHERE_PRINT_TREE_IS();
 
@@ -400,11 +469,11 @@ static void PrintCycleWhile(FILE* outstream, const Node_t* node ON_TAB(, size_t
         EXIT(EXIT_FAILURE, "here must be cycle 'while'");
 
     PrintBefore      (outstream             ON_TAB(, nTabBefore    ));
-    fprintf          (outstream, "%s",      cycle_while             );
+    BufferPutStr     (outstream,            cycle_while             );
     PrintAfter       (outstream                                     );
     PrintLeftBracket (outstream             ON_TAB(, nTabBefore    ));
     PrintBefore      (outstream             ON_TAB(, nTabBefore + 1));
-    fprintf          (outstream, "%s",      cycle_condition         );
+    BufferPutStr     (outstream,            cycle_condition         );
     PrintAfter       (outstream                                     );
     PrintLeftBracket (outstream             ON_TAB(, nTabBefore + 1));
     PrintAssign      (outstream, node->left ON_TAB(, nTabBefore + 2));
@@ -413,7 +482,7 @@ static void PrintCycleWhile(FILE* outstream, const Node_t* node ON_TAB(, size_t
     ON_TAB(PrintSlashN(outstream                                   ));
 
     PrintBefore      (outstream             ON_TAB(, nTabBefore + 1));
-    fprintf          (outstream, "%s",      body                     );
+    BufferPutStr     (outstream,            body                     );
     PrintAfter       (outstream                                     );
     PrintLeftBracket (outstream             ON_TAB(, nTabBefore + 1));
     PrintCondition   (outstream, node->right ON_TAB(, nTabBefore + 2));
@@ -428,7 +497,7 @@ static void PrintCycleWhile(FILE* outstream, const Node_t* node ON_TAB(, size_t
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static void PrintCycleFor(FILE* outstream, const Node_t* node ON_TAB(, size_t nTabBefore))
+static void PrintCycleFor(WriteBuffer* outstream, const Node_t* node ON_TAB(, size_t nTabBefore))
 {
     WHERE_PRINT_TREE_IS();
 
@@ -449,11 +518,11 @@ static void PrintCycleFor(FILE* outstream, const Node_t* node ON_TAB(, size_t nT
         EXIT(EXIT_FAILURE, "here must be cycle 'for'");
 
     PrintBefore      (outstream             ON_TAB(, nTabBefore    ));
-    fprintf          (outstream, "%s",      cycle_for               );
+    BufferPutStr     (outstream,            cycle_for               );
     PrintAfter       (outstream                                     );
     PrintLeftBracket (outstream             ON_TAB(, nTabBefore    ));
     PrintBefore      (outstream             ON_TAB(, nTabBefore + 1));
-    fprintf          (outstream, "%s",      cycle_condition         );
+    BufferPutStr     (outstream,            cycle_condition         );
     PrintAfter       (outstream                                     );
     PrintLeftBracket (outstream             ON_TAB(, nTabBefore + 1));
     PrintDefVariable (outstream, node->left ON_TAB(, nTabBefore + 2));
@@ -462,7 +531,7 @@ static void PrintCycleFor(FILE* outstream, const Node_t* node ON_TAB(, size_t nT
     ON_TAB(PrintSlashN(outstream                                   ));
 
     PrintBefore      (outstream             ON_TAB(, nTabBefore + 1));
-    fprintf          (outstream, "%s",      body                    );
+    BufferPutStr     (outstream,            body                    );
     PrintAfter       (outstream                                     );
     PrintLeftBracket (outstream             ON_TAB(, nTabBefore + 1));
     PrintCondition   (outstream, node->right ON_TAB(, nTabBefore + 2));
@@ -477,7 +546,7 @@ static void PrintCycleFor(FILE* outstream, const Node_t* node ON_TAB(, size_t nT
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static void PrintReturn(FILE* outstream, const Node_t* node ON_TAB(, size_t nTabBefore))
+static void PrintReturn(WriteBuffer* outstream, const Node_t* node ON_TAB(, size_t nTabBefore))
 {
     WHERE_PRINT_TREE_IS();
 
@@ -502,7 +571,7 @@ static void PrintReturn(FILE* outstream, const Node_t* node ON_TAB(, size_t nTab
         return PrintDefVariable(outstream, node ON_TAB(, nTabBefore));
 
     PrintBefore      (outstream             ON_TAB(, nTabBefore    ));
-    fprintf          (outstream, "%s",      ret                     );
+    BufferPutStr     (outstream,            ret                     );
     PrintAfter       (outstream                                     );
     PrintLeftBracket (outstream             ON_TAB(, nTabBefore    ));
     PrintOperation   (outstream, node->left ON_TAB(, nTabBefore + 1));
@@ -515,7 +584,7 @@ static void PrintReturn(FILE* outstream, const Node_t* node ON_TAB(, size_t nTab
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static void PrintDefVariable(FILE* outstream, const Node_t* node ON_TAB(, size_t nTabBefore))
+static void PrintDefVariable(WriteBuffer* outstream, const Node_t* node ON_TAB(, size_t nTabBefore))
 {
     WHERE_PRINT_TREE_IS();
 
@@ -537,7 +606,7 @@ static void PrintDefVariable(FILE* outstream, const Node_t* node ON_TAB(, size_t
 
 
     PrintBefore       (outstream                                ON_TAB(, nTabBefore    ));
-    fprintf           (outstream, "%s",                         define_variable         );
+    BufferPutStr      (outstream,                               define_variable         );
     PrintAfter        (outstream                                                        );
     PrintLeftBracket  (outstream                                ON_TAB(, nTabBefore    ));
     PrintType         (outstream, node->left                    ON_TAB(, nTabBefore + 1));
@@ -545,7 +614,7 @@ static void PrintDefVariable(FILE* outstream, const Node_t* node ON_TAB(, size_t
     ON_TAB(PrintSlashN(outstream                                                       ));
 
     PrintBefore       (outstream                                ON_TAB(, nTabBefore + 1));
-    fprintf           (outstream, "%s",                         assign                   );
+    BufferPutStr      (outstream,                               assign                   );
     PrintAfter        (outstream                                                        );
     PrintLeftBracket  (outstream                                ON_TAB(, nTabBefore + 1));
     PrintOperation    (outstream, node->right                   ON_TAB(, nTabBefore + 2));
@@ -559,7 +628,7 @@ static void PrintDefVariable(FILE* outstream, const Node_t* node ON_TAB(, size_t
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static void PrintAssign(FILE* outstream, const Node_t* node ON_TAB(, size_t nTabBefore))
+static void PrintAssign(WriteBuffer* outstream, const Node_t* node ON_TAB(, size_t nTabBefore))
 {
     WHERE_PRINT_TREE_IS();
 
@@ -581,7 +650,7 @@ static void PrintAssign(FILE* outstream, const Node_t* node ON_TAB(, size_t nTab
 
 
     PrintBefore      (outstream                         ON_TAB(, nTabBefore    ));
-    fprintf          (outstream, "%s",                  assign                  );
+    BufferPutStr     (outstream,                        assign                  );
     PrintAfter       (outstream                                                 );
     PrintLeftBracket (outstream                         ON_TAB(, nTabBefore    ));
     PrintName        (outstream, node->left             ON_TAB(, nTabBefore + 1));
@@ -595,7 +664,7 @@ static void PrintAssign(FILE* outstream, const Node_t* node ON_TAB(, size_t nTab
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static void PrintOperation(FILE* outstream, const Node_t* node ON_TAB(, size_t nTabBefore))
+static void PrintOperation(WriteBuffer* outstream, const Node_t* node ON_TAB(, size_t nTabBefore))
 {
     WHERE_PRINT_TREE_IS();
 
@@ -617,33 +686,34 @@ static void PrintOperation(FILE* outstream, const Node_t* node ON_TAB(, size_t n
 
     PrintBefore(outstream ON_TAB(, nTabBefore));
 
-    fprintf(outstream, "%s ", operation);
+    BufferPutStr (outstream, operation);
+    BufferPutChar(outstream, ' ');
 
     Operation operation = node->data.oper;
 
     switch (operation)
     {
-        case Operation::assign:            fprintf(outstream, "%s", assign_operation          ); break;
-        case Operation::plus:              fprintf(outstream, "%s", plus_operation            ); break;
-        case Operation::minus:             fprintf(outstream, "%s", minus_operation           ); break;
-        case Operation::mul:               fprintf(outstream, "%s", mul_operation             ); break;
-        case Operation::dive:              fprintf(outstream, "%s", div_operation             ); break;
-        case Operation::power:             fprintf(outstream, "%s", power_operation           ); break;
-        case Operation::equal:             fprintf(outstream, "%s", equal_operation           ); break;
-        case Operation::not_equal:         fprintf(outstream, "%s", not_equal_operation       ); break;
-        case Operation::greater:           fprintf(outstream, "%s", greater_operation         ); break;
-        case Operation::greater_or_equal:  fprintf(outstream, "%s", greater_or_equal_operation); break;
-        case Operation::less:              fprintf(outstream, "%s", less_operation            ); break;
-        case Operation::less_or_equal:     fprintf(outstream, "%s", less_or_equal_operation   ); break;
-        case Operation::bool_and:          fprintf(outstream, "%s", bool_and_operation        ); break;
-        case Operation::bool_or:           fprintf(outstream, "%s", bool_or_operation         ); break;
-        case Operation::bool_not:          fprintf(outstream, "%s", bool_not_operation        ); break;
-        case Operation::plus_plus:         fprintf(outstream, "%s", plus_plus_operation       ); break; 
-        case Operation::minus_minus:       fprintf(outstream, "%s", minus_minus_operation     ); break;
-        case Operation::plus_equal:        fprintf(outstream, "%s", plus_equal_operation      ); break;
-        case Operation::minus_equal:       fprintf(outstream, "%s", minus_minus_operation     ); break;
-        case Operation::mul_equal:         fprintf(outstream, "%s", mul_equal_operation       ); break;
-        case Operation::div_equal:         fprintf(outstream, "%s", div_equal_operation       ); break;
+        case Operation::assign:            BufferPutStr(outstream, assign_operation          ); break;
+        case Operation::plus:              BufferPutStr(outstream, plus_operation            ); break;
+        case Operation::minus:             BufferPutStr(outstream, minus_operation           ); break;
+        case Operation::mul:               BufferPutStr(outstream, mul_operation             ); break;
+        case Operation::dive:              BufferPutStr(outstream, div_operation             ); break;
+        case Operation::power:             BufferPutStr(outstream, power_operation           ); break;
+        case Operation::equal:             BufferPutStr(outstream, equal_operation           ); break;
+        case Operation::not_equal:         BufferPutStr(outstream, not_equal_operation       ); break;
+        case Operation::greater:           BufferPutStr(outstream, greater_operation         ); break;
+        case Operation::greater_or_equal:  BufferPutStr(outstream, greater_or_equal_operation); break;
+        case Operation::less:              BufferPutStr(outstream, less_operation            ); break;
+        case Operation::less_or_equal:     BufferPutStr(outstream, less_or_equal_operation   ); break;
+        case Operation::bool_and:          BufferPutStr(outstream, bool_and_operation        ); break;
+        case Operation::bool_or:           BufferPutStr(outstream, bool_or_operation         ); break;
+        case Operation::bool_not:          BufferPutStr(outstream, bool_not_operation        ); break;
+        case Operation::plus_plus:         BufferPutStr(outstream, plus_plus_operation       ); break; 
+        case Operation::minus_minus:       BufferPutStr(outstream, minus_minus_operation     ); break;
+        case Operation::plus_equal:        BufferPutStr(outstream, plus_equal_operation      ); break;
+        case Operation::minus_equal:       BufferPutStr(outstream, minus_minus_operation     ); break;
+        case Operation::mul_equal:         BufferPutStr(outstream, mul_equal_operation       ); break;
+        case Operation::div_equal:         BufferPutStr(outstream, div_equal_operation       ); break;
         case Operation::undefined_operation:
         default:  EXIT(EXIT_FAILURE, "undefined operation type.");
     }
@@ -662,7 +732,7 @@ static void PrintOperation(FILE* outstream, const Node_t* node ON_TAB(, size_t n
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static void PrintCallFunction(FILE* outstream, const Node_t* node ON_TAB(, size_t nTabBefore))
+static void PrintCallFunction(WriteBuffer* outstream, const Node_t* node ON_TAB(, size_t nTabBefore))
 {
     WHERE_PRINT_TREE_IS();
 
@@ -681,7 +751,7 @@ static void PrintCallFunction(FILE* outstream, const Node_t* node ON_TAB(, size_
         return PrintNumber(outstream, node ON_TAB(, nTabBefore));
 
     PrintBefore           (outstream                       ON_TAB(, nTabBefore    ));
-    fprintf               (outstream, "%s",                call_function           );
+    BufferPutStr          (outstream,                      call_function           );
     PrintAfter            (outstream                                               );
     PrintLeftBracket      (outstream                       ON_TAB(, nTabBefore    ));
 
@@ -699,7 +769,7 @@ static void PrintCallFunction(FILE* outstream, const Node_t* node ON_TAB(, size_
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
 
-static void PrintCallFunctionArgs(FILE* outstream, const Node_t* node ON_TAB(, size_t nTabBefore))
+static void PrintCallFunctionArgs(WriteBuffer* outstream, const Node_t* node ON_TAB(, size_t nTabBefore))
 {
     WHERE_PRINT_TREE_IS();
 
@@ -708,7 +778,7 @@ static void PrintCallFunctionArgs(FILE* outstream, const Node_t* node ON_TAB(, s
     if (!node) return;
 
     PrintBefore      (outstream                       ON_TAB(, nTabBefore    ));
-    fprintf          (outstream, "%s",                call_function_arguments );
+    BufferPutStr     (outstream,                      call_function_arguments );
     PrintAfter       (outstream                                               );
 
     PrintLeftBracket (outstream                       ON_TAB(, nTabBefore    ));
@@ -718,7 +788,7 @@ static void PrintCallFunctionArgs(FILE* outstream, const Node_t* node ON_TAB(, s
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static void PrintNumber(FILE* outstream, const Node_t* node ON_TAB(, size_t nTabBefore))
+static void PrintNumber(WriteBuffer* outstream, const Node_t* node ON_TAB(, size_t nTabBefore))
 {
     WHERE_PRINT_TREE_IS();
 
@@ -732,7 +802,8 @@ static void PrintNumber(FILE* outstream, const Node_t* node ON_TAB(, size_t nTab
 
     PrintBefore(outstream ON_TAB(, nTabBefore));
 
-    fprintf(outstream, "%s ", number);
+    BufferPutStr (outstream, number);
+    BufferPutChar(outstream, ' ');
 
     Type        num_type = node->data.num.type;
     NumberValue value    = node->data.num.value;
@@ -749,9 +820,9 @@ static void PrintNumber(FILE* outstream, const Node_t* node ON_TAB(, size_t nTab
 
     switch (num_type)
     {
-        case Type::int_type:    fprintf(outstream, "%d", value.int_val);    break;
-        case Type::char_type:   fprintf(outstream, "%c", value.char_val);   break;
-        case Type::double_type: fprintf(outstream, "%f", value.double_val); break;
+        case Type::int_type:    BufferPutInt   (outstream, value.int_val);    break;
+        case Type::char_type:   BufferPutChar  (outstream, value.char_val);   break;
+        case Type::double_type: BufferPutDouble(outstream, value.double_val); break;
         case Type::void_type:
         case Type::undefined_type:
         default: EXIT(EXIT_FAILURE, "undef num type.");
@@ -764,7 +835,7 @@ static void PrintNumber(FILE* outstream, const Node_t* node ON_TAB(, size_t nTab
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static void PrintName(FILE* outstream, const Node_t* node ON_TAB(, size_t nTabBefore))
+static void PrintName(WriteBuffer* outstream, const Node_t* node ON_TAB(, size_t nTabBefore))
 {
     WHERE_PRINT_TREE_IS();
 
@@ -776,13 +847,14 @@ static void PrintName(FILE* outstream, const Node_t* node ON_TAB(, size_t nTabBe
     if (node->type != NodeArgType::name)
         EXIT(EXIT_FAILURE, "here must be node with type 'name'");
 
-    fprintf(outstream, "%s ", name);
+    NameId node_name_id = node->data.name.id;
 
-    const char* node_name    = node->data.name.name.name;
-    size_t      node_name_len = node->data.name.name.len;
+    if (node_name_id == NameNoId)
+        EXIT(EXIT_FAILURE, "name node without interned name id");
 
-    for (size_t i = 0; i < node_name_len; i++)
-        fprintf(outstream, "%c", node_name[i]);
+    BufferPutStr (outstream, name);
+    BufferPutChar(outstream, ' ');
+    BufferPutSize(outstream, node_name_id);
 
     PrintAfter(outstream);
 
@@ -791,7 +863,7 @@ static void PrintName(FILE* outstream, const Node_t* node ON_TAB(, size_t nTabBe
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static void PrintType(FILE* outstream, const Node_t* node ON_TAB(, size_t nTabBefore))
+static void PrintType(WriteBuffer* outstream, const Node_t* node ON_TAB(, size_t nTabBefore))
 {
     WHERE_PRINT_TREE_IS();
 
@@ -803,15 +875,16 @@ static void PrintType(FILE* outstream, const Node_t* node ON_TAB(, size_t nTabBe
     if (node->type != NodeArgType::type)
         EXIT(EXIT_FAILURE, "here node arg type must be 'type'");
 
-    fprintf(outstream, "%s ", type);
+    BufferPutStr (outstream, type);
+    BufferPutChar(outstream, ' ');
 
     Type node_type = node->data.type;
     switch (node_type)
     {
-        case Type::int_type:       fprintf(outstream, "%s", int_type   ); break;
-        case Type::char_type:      fprintf(outstream, "%s", char_type  ); break;
-        case Type::double_type:    fprintf(outstream, "%s", double_type); break;
-        case Type::void_type:      fprintf(outstream, "%s", void_type  ); break;
+        case Type::int_type:       BufferPutStr(outstream, int_type   ); break;
+        case Type::char_type:      BufferPutStr(outstream, char_type  ); break;
+        case Type::double_type:    BufferPutStr(outstream, double_type); break;
+        case Type::void_type:      BufferPutStr(outstream, void_type  ); break;
         case Type::undefined_type:
         default: EXIT(EXIT_FAILURE, "undef type of node arg type");
     }
@@ -823,7 +896,7 @@ static void PrintType(FILE* outstream, const Node_t* node ON_TAB(, size_t nTabBe
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static void PrintLeftBracket(FILE* outstream ON_TAB(, size_t nTab))
+static void PrintLeftBracket(WriteBuffer* outstream ON_TAB(, size_t nTab))
 {
     assert(outstream);
     
@@ -831,7 +904,7 @@ static void PrintLeftBracket(FILE* outstream ON_TAB(, size_t nTab))
     PrintNTab(outstream, nTab);
     )
 
-    fprintf(outstream, "{");
+    BufferPutChar(outstream, '{');
 
     PrintAfter(outstream);
 
@@ -840,7 +913,7 @@ static void PrintLeftBracket(FILE* outstream ON_TAB(, size_t nTab))
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static void PrintRightBracket(FILE* outstream ON_TAB(, size_t nTab))
+static void PrintRightBracket(WriteBuffer* outstream ON_TAB(, size_t nTab))
 {
     assert(outstream);
 
@@ -848,7 +921,7 @@ static void PrintRightBracket(FILE* outstream ON_TAB(, size_t nTab))
     PrintNTab(outstream, nTab);
     )
 
-    fprintf(outstream, "}");
+    BufferPutChar(outstream, '}');
 
     PrintAfter(outstream);
 
@@ -859,24 +932,22 @@ static void PrintRightBracket(FILE* outstream ON_TAB(, size_t nTab))
 
 ON_TAB(
 
-static void PrintNTab(FILE* outstream, size_t nTab)
+static void PrintNTab(WriteBuffer* outstream, size_t nTab)
 {
     assert(outstream);
-    for (size_t i = 0; i < nTab; i++)
-    {
-        fprintf(outstream, "\t");
-    }
+
+    BufferPutTabs(outstream, nTab);
 
     return;
 }
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static void PrintSlashN(FILE* outstream)
+static void PrintSlashN(WriteBuffer* outstream)
 {
     assert(outstream);
 
-    fprintf(outstream, "\n");
+    BufferPutChar(outstream, '\n');
 
     return;
 }
@@ -887,11 +958,11 @@ static void PrintSlashN(FILE* outstream)
 
 OFF_TAB(
 
-static void PrintSpace(FILE* outstream)
+static void PrintSpace(WriteBuffer* outstream)
 {
     assert(outstream);
 
-    fprintf(outstream, " ");
+    BufferPutChar(outstream, ' ');
 
     return;
 }
@@ -900,7 +971,7 @@ static void PrintSpace(FILE* outstream)
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static void PrintBefore(FILE* outstream ON_TAB(, size_t nTab))
+static void PrintBefore(WriteBuffer* outstream ON_TAB(, size_t nTab))
 {
     assert(outstream);
 
@@ -913,7 +984,7 @@ static void PrintBefore(FILE* outstream ON_TAB(, size_t nTab))
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static void PrintAfter(FILE* outstream)
+static void PrintAfter(WriteBuffer* outstream)
 {
     assert(outstream);
 
@@ -7,14 +7,15 @@
 #include "tree/tree-dump/tree-dump.hpp"
 #include "lib/lib.hpp"
 #include "dump/global-dump.hpp"
+#include "dump/dump-service.hpp"
 
 
 static void DotNodeBegin          (FILE* dotFile);
 static void DotCreateAllNodes     (FILE* dotFile, const Node_t* node);
 static void DotCreateEdges        (FILE* dotFile, const Node_t* node);
 static void DotCreateEdgesHelper  (FILE* dotFile, const Node_t* node);
-static void TreeDumpHelper        (const Tree_t* tree, const char* dotFileName, const char* file, const int line, const char* func);
-static void NodeDumpHelper        (const Node_t* node, const char* dotFileName, const char* file, const int line, const char* func);
+static void TreeDumpHelper        (const Tree_t* tree, FILE* dotFile, const char* file, const int line, const char* func);
+static void NodeDumpHelper        (const Node_t* node, FILE* dotFile, const char* file, const int line, const char* func);
 
 
 static const char* GetNodeColor       (const Node_t* node);
@@ -53,25 +54,12 @@ void NodeDump(const Node_t* node, const char* file, const int line, const char*
 
     static size_t ImgQuant = 1;
 
-    system("mkdir -p ../dot/");
-    system("mkdir -p ../dot/node/");
-    system("mkdir -p ../dot/node/img/");
-    system("mkdir -p ../dot/node/dot/");
+    DumpFiles files   = {};
+    FILE*     dotFile = DumpOpen("node", ImgQuant, &files);
 
-    static const size_t MaxBufferLen = 64;
+    NodeDumpHelper(node, dotFile, file, line, func);
 
-    char outfile[MaxBufferLen] = {};
-    snprintf(outfile, MaxBufferLen,"../dot/node/img/node%lu.png", ImgQuant);
-    
-    char dotFileName[MaxBufferLen] = {};
-    snprintf(dotFileName, MaxBufferLen, "../dot/node/dot/node%lu.dot", ImgQuant);
-
-    NodeDumpHelper(node, dotFileName, file, line, func);
-    
-    static const size_t MaxCommandLen = 512;
-    char command[MaxCommandLen] = {};
-    snprintf(command, MaxCommandLen, "dot -Tpng %s > %s", dotFileName, outfile);
-    system(command);
+    DumpClose(dotFile, &files);
 
     ImgQuant++;
     return;
@@ -79,17 +67,14 @@ void NodeDump(const Node_t* node, const char* file, const int line, const char*
 
 //----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static void NodeDumpHelper(const Node_t* node, const char* dotFileName, const char* file, const int line, const char* func)
+static void NodeDumpHelper(const Node_t* node, FILE* dotFile, const char* file, const int line, const char* func)
 {
     assert(node);
-    assert(dotFileName);
+    assert(dotFile);
     assert(file);
     assert(func);
     assert(line);
 
-    FILE* dotFile = fopen(dotFileName, "w");
-    assert(dotFile);
-
     DotNodeBegin(dotFile);
 
     DotCreateDumpPlace(dotFile, file, line, func);
@@ -99,9 +84,6 @@ static void NodeDumpHelper(const Node_t* node, const char* dotFileName, const ch
 
     DotEnd(dotFile);
 
-    fclose(dotFile);
-    dotFile = nullptr;
-
     return;
 }
 
@@ -113,45 +95,29 @@ void TreeDump(const Tree_t* tree, const char* file, const int line, const char*
     assert(file);
     assert(func);
 
-    system("mkdir -p ../dot/");
-    system("mkdir -p ../dot/tree/");
-    system("mkdir -p ../dot/tree/img/");
-    system("mkdir -p ../dot/tree/dot/");
-
     static size_t ImgQuant = 1;
 
-    static const size_t MaxBufferLen = 64;
-
-    char outfile[MaxBufferLen] = {};
-    snprintf(outfile, MaxBufferLen, "../dot/tree/img/tree%lu.png", ImgQuant);
-    
-    char dotFileName[MaxBufferLen ] = {};
-    snprintf(dotFileName, MaxBufferLen, "../dot/tree/dot/tree%lu.dot", ImgQuant);
-    
-    TreeDumpHelper(tree, dotFileName, file, line, func);
-    
-    static const size_t MaxCommandLen = 512;
-    char command    [MaxCommandLen] = {};
-    snprintf(command, MaxCommandLen, "dot -Tpng %s > %s", dotFileName, outfile);
-    system(command);
-    
+    DumpFiles files   = {};
+    FILE*     dotFile = DumpOpen("tree", ImgQuant, &files);
+
+    TreeDumpHelper(tree, dotFile, file, line, func);
+
+    DumpClose(dotFile, &files);
+
     ImgQuant++;
     return;
 }
 
 //----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static void TreeDumpHelper(const Tree_t* tree, const char* dotFileName, const char* file, const int line, const char* func)
+static void TreeDumpHelper(const Tree_t* tree, FILE* dotFile, const char* file, const int line, const char* func)
 {
     assert(tree);
-    assert(dotFileName);
+    assert(dotFile);
     assert(file);
     assert(func);
     assert(line);
 
-    FILE* dotFile = fopen(dotFileName, "w");
-    assert(dotFile);
-
     DotNodeBegin(dotFile);
 
     DotCreateDumpPlace(dotFile, file, line, func);
@@ -161,9 +127,6 @@ static void TreeDumpHelper(const Tree_t* tree, const char* dotFileName, const ch
 
     DotEnd(dotFile);
 
-    fclose(dotFile);
-    dotFile = nullptr;
-
     return;
 }
 
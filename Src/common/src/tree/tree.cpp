@@ -1,9 +1,9 @@
 #include <assert.h>
 #include "tree/tree.hpp"
 #include "lib/lib.hpp"
+#include "tree/node-arena/node-arena.hpp"
 
 #ifdef _DEBUG
-#include "read-tree/tokens/tokens-dump/tokens-dump.hpp"
 #include "tree/tree-dump/tree-dump.hpp"
 #endif
 
@@ -35,14 +35,36 @@ static TreeErr AllNodeVerif                (const Node_t* node, size_t* treeSize
 
 // //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
+void TreeCtor(Tree_t* tree)
+{
+    assert(tree);
+
+    tree->root  = nullptr;
+    tree->arena = NodeArenaCtor(NodeArenaDefaultBlockCapacity);
+
+    return;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
 void TreeDtor(Tree_t* tree)
 {
     assert(tree);
+
+    // all nodes of the tree are in its arena, so they are released at once, without the nodes walk
+    if (tree->arena)
+    {
+        NodeArenaDtor(tree->arena);
+        tree->arena = nullptr;
+        tree->root  = nullptr;
+        return;
+    }
+
     assert(tree->root);
 
     TreeErr Err = {};
 
-    TREE_ASSERT(NodeAndUnderTreeDtor(tree->root));
+    TREE_ASSERT(NodeAndUnderTreeDtor(tree->root, nullptr));
     tree->root = nullptr;
 
     // InputDataDtor(&tree->inputData);
@@ -52,27 +74,32 @@ void TreeDtor(Tree_t* tree)
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-TreeErr NodeAndUnderTreeDtor(Node_t* node)
+TreeErr NodeAndUnderTreeDtor(Node_t* node, const NodeArena* arena)
 {
     TreeErr err = {};
 
     if (node == nullptr) return err;
 
-    if (node->left ) NodeAndUnderTreeDtor(node->left );
-    if (node->right) NodeAndUnderTreeDtor(node->right);
+    if (node->left ) NodeAndUnderTreeDtor(node->left,  arena);
+    if (node->right) NodeAndUnderTreeDtor(node->right, arena);
 
-    NodeDtor(node);
+    NodeDtor(node, arena);
 
     return err;
 }
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-TreeErr NodeCtor(Node_t** node, NodeArgType type, NodeData_t data, Node_t* left, Node_t* right)
+// arena is the arena of the tree the node is built for (tree->arena),
+// nullptr - the node is calloc'ed and has to be freed by NodeDtor(node, nullptr)
+TreeErr NodeCtor(Node_t** node, NodeArena* arena, NodeArgType type, NodeData_t data, Node_t* left, Node_t* right)
 {
     TreeErr err = {};
 
-    *node = (Node_t*) calloc(1, sizeof(Node_t));
+    if (arena)
+        *node = NodeArenaAlloc(arena);
+    else
+        *node = (Node_t*) calloc(1, sizeof(Node_t));
  
     if (*node == NULL)
     {
@@ -92,7 +119,9 @@ TreeErr NodeCtor(Node_t** node, NodeArgType type, NodeData_t data, Node_t* left,
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-TreeErr NodeDtor(Node_t* node)
+// arena is the arena of the tree the node is taken from: its nodes are released with the arena in TreeDtor(),
+// nullptr - the tree has no arena, so its nodes are calloc'ed and freed one by one
+TreeErr NodeDtor(Node_t* node, const NodeArena* arena)
 {
     assert(node);
 
@@ -101,7 +130,10 @@ TreeErr NodeDtor(Node_t* node)
     node->left  = nullptr;
     node->right = nullptr;
 
-    FREE(node);
+    if (!arena)
+    {
+        FREE(node);
+    }
 
     CodePlaceCtor(&err.place, __FILE__, __LINE__, __func__);
     return err;
@@ -109,7 +141,7 @@ TreeErr NodeDtor(Node_t* node)
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-TreeErr NodeCopy(Node_t** copy, const Node_t* node)
+TreeErr NodeCopy(Node_t** copy, NodeArena* arena, const Node_t* node)
 {
     assert(node);
 
@@ -120,7 +152,7 @@ TreeErr NodeCopy(Node_t** copy, const Node_t* node)
     Node_t*     left  = node->left;
     Node_t*     right = node->right;
 
-    TREE_ASSERT(NodeCtor(copy, type, data, left, right));
+    TREE_ASSERT(NodeCtor(copy, arena, type, data, left, right));
 
     if (*copy == nullptr)
     {
@@ -129,10 +161,10 @@ TreeErr NodeCopy(Node_t** copy, const Node_t* node)
     }
 
     if (node->left)
-        TREE_ASSERT(NodeCopy(&(*copy)->left,  node->left));
+        TREE_ASSERT(NodeCopy(&(*copy)->left,  arena, node->left));
 
     if (node->right)
-        TREE_ASSERT(NodeCopy(&(*copy)->right, node->right));
+        TREE_ASSERT(NodeCopy(&(*copy)->right, arena, node->right));
 
     return NODE_VERIF(*copy, err);
 }
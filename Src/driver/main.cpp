@@ -0,0 +1,173 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include "tree/tree.hpp"
+#include "lib/lib.hpp"
+#include "read-tree/file-read/file-read.hpp"
+#include "read-tree/tokens/tokens.hpp"
+#include "read-tree/recursive-descent/recursive-descent.hpp"
+#include "tree/read-write-tree/write-tree/write-tree.hpp"
+#include "name-table/interner/interner.hpp"
+#include "optimize/optimize.hpp"
+#include "ir/ir.hpp"
+#include "codegen/codegen.hpp"
+#include "assembler/assembler.hpp"
+
+#ifdef _DEBUG
+#include "log/log.hpp"
+#include "tree/tree-dump/tree-dump.hpp"
+#include "read-tree/tokens/tokens-dump/tokens-dump.hpp"
+#endif
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// All stages in one process: the tree from GetTree goes to the next stages in memory,
+// AST file is only an optional dump (-dump-ast) of the front-end tree, it is not read back.
+// '-inline-report' prints what the middle-end inlined and folded, '-unroll' sets the unrolling factor
+// (0 - no unrolling), '-unroll-budget' - nodes a cycle may grow by, '-eval-budget' - nodes a compile time call of a pure function
+// may run (0 - no compile time calls), '-dump-ir' writes optimized IR of the optimized tree.
+// The optimized tree goes to the code generator, SPU code is written to a file only with '-dump-code'
+// (the processor runs it as the back-end output), there is no assembler text of the generated code.
+//
+// driver [-input <programm>] [-dump-ast <file>] [-dump-format text|binary] [-inline-report] [-unroll <factor>] [-unroll-budget <nodes>] [-eval-budget <nodes>] [-dump-ir <file>] [-dump-code <file>]
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct DriverOptions
+{
+    const char*     input;
+    const char*     dump_ast;
+    AstFormat       dump_format;
+    const char*     dump_ir;
+    const char*     dump_code;
+    OptimizeOptions optimize;
+};
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static DriverOptions ParseOptions    (int argc, const char* argv[]);
+static const char*   GetOptionValue  (int argc, const char* argv[], int* argv_i);
+static size_t        GetSizeValue    (const char* value);
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+int main(int argc, const char* argv[])
+{
+    ON_DEBUG(
+    COLOR_PRINT(GREEN, "DRIVER START\n\n");
+    LOG_OPEN();
+    )
+
+    DriverOptions options = ParseOptions(argc, argv);
+
+    //================ front-end ================
+
+    InputData buffer    = ReadFile(options.input);
+
+    TokensArr tokensArr = ReadInputBuffer(&buffer);
+
+    ON_DEBUG(
+    TOKEN_GRAPHIC_DUMP(&tokensArr)
+    );
+
+    Tree_t    tree      = {};
+    TreeCtor(&tree);
+    tree.root           = GetTree(&tokensArr, &buffer, tree.arena);
+
+    if (options.dump_ast)
+        PrintTree(&tree, options.dump_ast, options.dump_format);
+
+    //================ midle-end ================
+
+    OptimizeTree(&tree, &options.optimize);
+
+    if (options.dump_ir)
+        DumpIr(&tree, options.dump_ir, options.optimize.report);
+
+    //================ back-end =================
+
+    ON_DEBUG(
+    TREE_GRAPHIC_DUMP(&tree)
+    );
+
+    CodeArr code = {};
+    GenerateCode(&tree, &code);
+
+    if (options.dump_code)
+        WriteCodeArr(&code, options.dump_code);
+
+    //===========================================
+
+    // names in the tree point to the programm text, so it is freed last
+    CodeArrDtor  (&code);
+    TokenDtor    (&tokensArr);
+    TreeDtor     (&tree);
+    InputDataDtor(&buffer);
+    InternerDtor ();
+
+    ON_DEBUG(
+    LOG_CLOSE();
+    COLOR_PRINT(GREEN, "\nDRIVER END\n");
+    )
+
+    return EXIT_SUCCESS;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static DriverOptions ParseOptions(int argc, const char* argv[])
+{
+    assert(argv);
+
+    DriverOptions options = {"programm/programm.asm", nullptr, AstFormat::text, nullptr, nullptr, OptimizeDefaultOptions};
+
+    for (int argv_i = 1; argv_i < argc; argv_i++)
+    {
+        if      (strcmp(argv[argv_i], "-input")         == 0) options.input                  = GetOptionValue(argc, argv, &argv_i);
+        else if (strcmp(argv[argv_i], "-dump-ast")      == 0) options.dump_ast               = GetOptionValue(argc, argv, &argv_i);
+        else if (strcmp(argv[argv_i], "-dump-format")   == 0) options.dump_format            = GetAstFormat(GetOptionValue(argc, argv, &argv_i));
+        else if (strcmp(argv[argv_i], "-inline-report") == 0) options.optimize.report        = stdout;
+        else if (strcmp(argv[argv_i], "-unroll")        == 0) options.optimize.unroll.factor = GetSizeValue(GetOptionValue(argc, argv, &argv_i));
+        else if (strcmp(argv[argv_i], "-unroll-budget") == 0) options.optimize.unroll.budget = GetSizeValue(GetOptionValue(argc, argv, &argv_i));
+        else if (strcmp(argv[argv_i], "-eval-budget")   == 0) options.optimize.eval_budget   = GetSizeValue(GetOptionValue(argc, argv, &argv_i));
+        else if (strcmp(argv[argv_i], "-dump-ir")       == 0) options.dump_ir                = GetOptionValue(argc, argv, &argv_i);
+        else if (strcmp(argv[argv_i], "-dump-code")     == 0) options.dump_code              = GetOptionValue(argc, argv, &argv_i);
+        else
+            EXIT(EXIT_FAILURE, "unknown option '%s'.\nusage: %s [-input <programm>] [-dump-ast <file>] [-dump-format text|binary] [-inline-report] [-unroll <factor>] [-unroll-budget <nodes>] [-eval-budget <nodes>] [-dump-ir <file>] [-dump-code <file>]", argv[argv_i], argv[0]);
+    }
+
+    return options;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static const char* GetOptionValue(int argc, const char* argv[], int* argv_i)
+{
+    assert(argv);
+    assert(argv_i);
+
+    if (*argv_i + 1 >= argc)
+        EXIT(EXIT_FAILURE, "no value after '%s'", argv[*argv_i]);
+
+    (*argv_i)++;
+
+    return argv[*argv_i];
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static size_t GetSizeValue(const char* value)
+{
+    assert(value);
+
+    char*         end    = nullptr;
+    unsigned long number = strtoul(value, &end, 10);
+
+    if (end == value || *end != '\0' || value[0] == '-')
+        EXIT(EXIT_FAILURE, "'%s' is not a non-negative number", value);
+
+    return number;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -9,7 +9,8 @@
 
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-Node_t* GetTree (const TokensArr* tokens, const InputData* inputData);
+// nodes are built in arena (tree->arena of the tree being parsed)
+Node_t* GetTree (const TokensArr* tokens, const InputData* inputData, NodeArena* arena);
 
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
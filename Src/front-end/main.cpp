@@ -1,10 +1,12 @@
 #include <stdlib.h>
+#include <string.h>
 #include "tree/tree.hpp"
 #include "lib/lib.hpp"
 #include "read-tree/file-read/file-read.hpp"
 #include "read-tree/tokens/tokens.hpp"
 #include "read-tree/recursive-descent/recursive-descent.hpp"
 #include "tree/read-write-tree/write-tree/write-tree.hpp"
+#include "name-table/interner/interner.hpp"
 
 // #define _DEBUG
 
@@ -14,15 +16,26 @@
 #include "read-tree/tokens/tokens-dump/tokens-dump.hpp"
 #endif
 
-int main()
+// frontend [programm] [ast] [-format text|binary] - default paths are used for missing arguments,
+// '-format' sets the AST file format (text by default)
+
+int main(int argc, const char* argv[])
 {
     ON_DEBUG(
     COLOR_PRINT(GREEN, "FRONTEND START\n\n");
     LOG_OPEN();
     )
 
-    const char* input   = "programm/programm.asm";
-    const char* output  = "tree/tree.ast";
+    const char* input   = (argc > 1) ? argv[1] : "programm/programm.asm";
+    const char* output  = (argc > 2) ? argv[2] : "tree/tree.ast";
+    AstFormat   format  = AstFormat::text;
+
+    for (int argv_i = 3; argv_i < argc; argv_i++)
+    {
+        if (strcmp(argv[argv_i], "-format") == 0 && argv_i + 1 < argc) format = GetAstFormat(argv[++argv_i]);
+        else
+            EXIT(EXIT_FAILURE, "unknown option '%s'.\nusage: %s [programm] [ast] [-format text|binary]", argv[argv_i], argv[0]);
+    }
 
     InputData buffer    = ReadFile(input);
 
@@ -33,17 +46,19 @@ int main()
     );
 
     Tree_t    tree      = {};
-    tree.root           = GetTree(&tokensArr, &buffer);
+    TreeCtor(&tree);
+    tree.root           = GetTree(&tokensArr, &buffer, tree.arena);
 
     ON_DEBUG(
     TREE_GRAPHIC_DUMP(&tree)
     );
 
-    PrintTree(&tree, output);
+    PrintTree(&tree, output, format);
 
     InputDataDtor(&buffer);
     TokenDtor    (&tokensArr);
     TreeDtor     (&tree);
+    InternerDtor ();
     
 
     ON_DEBUG(
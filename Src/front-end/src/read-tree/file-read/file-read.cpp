@@ -4,6 +4,7 @@
 #include <sys/stat.h>
 #include <malloc.h>
 #include "lib/lib.hpp"
+#include "profile/profile.hpp"
 #include "read-tree/file-read/file-read.hpp"
 
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -22,6 +23,8 @@ InputData ReadFile(const char* inputFile)
 {
     assert(inputFile);
 
+    PROFILE_SCOPE("ReadFile");
+
     FILE* inputStream = fopen(inputFile, "rb");
 
     if (!inputStream)
@@ -6,6 +6,7 @@
 #include "read-tree/syntax-err/syntax-err.hpp"
 #include "read-tree/file-read/file-read.hpp"
 #include "read-tree/recursive-descent/recursive-descent.hpp"
+#include "profile/profile.hpp"
 
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
@@ -15,45 +16,91 @@
 #include "read-tree/tokens/tokens-dump/tokens-dump.hpp"
 #endif
 
+//------------ Binary operations precedence ------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static const size_t NotBinaryOperationPrecedence = 0;
+static const size_t BoolOperationPrecedence      = 1;
+static const size_t AddSubPrecedence             = 2;
+static const size_t MulDivPrecedence             = 3;
+static const size_t PowPrecedence                = 4;
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct OperationPrecedence
+{
+    Operation operation;
+    size_t    precedence;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// indexed by Operation: the bigger precedence - the tighter operation binds
+static const OperationPrecedence OperationsPrecedence[] =
+{
+    {Operation::undefined_operation, NotBinaryOperationPrecedence},
+    {Operation::plus               , AddSubPrecedence            },
+    {Operation::minus              , AddSubPrecedence            },
+    {Operation::mul                , MulDivPrecedence            },
+    {Operation::dive               , MulDivPrecedence            },
+    {Operation::power              , PowPrecedence               },
+    {Operation::assign             , NotBinaryOperationPrecedence},
+    {Operation::greater            , BoolOperationPrecedence     },
+    {Operation::greater_or_equal   , BoolOperationPrecedence     },
+    {Operation::less               , BoolOperationPrecedence     },
+    {Operation::less_or_equal      , BoolOperationPrecedence     },
+    {Operation::equal              , BoolOperationPrecedence     },
+    {Operation::not_equal          , BoolOperationPrecedence     },
+    {Operation::bool_and           , BoolOperationPrecedence     },
+    {Operation::bool_or            , BoolOperationPrecedence     },
+    {Operation::bool_not           , NotBinaryOperationPrecedence},
+    {Operation::plus_equal         , NotBinaryOperationPrecedence},
+    {Operation::minus_equal        , NotBinaryOperationPrecedence},
+    {Operation::mul_equal          , NotBinaryOperationPrecedence},
+    {Operation::div_equal          , NotBinaryOperationPrecedence},
+    {Operation::plus_plus          , NotBinaryOperationPrecedence},
+    {Operation::minus_minus        , NotBinaryOperationPrecedence},
+};
+
+static const size_t OperationsPrecedenceQuant = sizeof(OperationsPrecedence) / sizeof(OperationsPrecedence[0]);
+
 //------------ Recusrsive Descent function  ---------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static Node_t*   GetDefFunc                     (const Token_t* tokensArr, size_t* tp, const InputData* inputData);
-static Node_t*   GetDefFuncArgs                 (const Token_t* tokensArr, size_t* tp, const InputData* inputData);
+static Node_t*   GetDefFunc                     (const Token_t* tokensArr, size_t* tp, const InputData* inputData, NodeArena* arena);
+static Node_t*   GetDefFuncArgs                 (const Token_t* tokensArr, size_t* tp, const InputData* inputData, NodeArena* arena);
 
-static Node_t*   GetCondition                   (const Token_t* tokensArr, size_t* tp, const InputData* inputData);
-static Node_t*   GetIfCondition                 (const Token_t* tokensArr, size_t* tp, const InputData* inputData);
-static Node_t*   GetElseIfCondition             (const Token_t* tokensArr, size_t* tp, const InputData* inputData);
-static Node_t*   GetElseCondition               (const Token_t* tokensArr, size_t* tp, const InputData* inputData);
+static Node_t*   GetCondition                   (const Token_t* tokensArr, size_t* tp, const InputData* inputData, NodeArena* arena);
+static Node_t*   GetIfCondition                 (const Token_t* tokensArr, size_t* tp, const InputData* inputData, NodeArena* arena);
+static Node_t*   GetElseIfCondition             (const Token_t* tokensArr, size_t* tp, const InputData* inputData, NodeArena* arena);
+static Node_t*   GetElseCondition               (const Token_t* tokensArr, size_t* tp, const InputData* inputData, NodeArena* arena);
 
-static Node_t*   GetCycle                       (const Token_t* tokensArr, size_t* tp, const InputData* inputData);
-static Node_t*   GetWhile                       (const Token_t* tokensArr, size_t* tp, const InputData* inputData);
-static Node_t*   GetFor                         (const Token_t* tokensArr, size_t* tp, const InputData* inputData);
+static Node_t*   GetCycle                       (const Token_t* tokensArr, size_t* tp, const InputData* inputData, NodeArena* arena);
+static Node_t*   GetWhile                       (const Token_t* tokensArr, size_t* tp, const InputData* inputData, NodeArena* arena);
+static Node_t*   GetFor                         (const Token_t* tokensArr, size_t* tp, const InputData* inputData, NodeArena* arena);
 
-static Node_t*   GetPrint                       (const Token_t* tokensArr, size_t* tp, const InputData* inputData);
-static Node_t*   GetPrintArgs                   (const Token_t* tokensArr, size_t* tp, const InputData* inputData);
+static Node_t*   GetPrint                       (const Token_t* tokensArr, size_t* tp, const InputData* inputData, NodeArena* arena);
+static Node_t*   GetPrintArgs                   (const Token_t* tokensArr, size_t* tp, const InputData* inputData, NodeArena* arena);
 
-static Node_t*   GetReturn                      (const Token_t* tokensArr, size_t* tp, const InputData* inputData);
+static Node_t*   GetReturn                      (const Token_t* tokensArr, size_t* tp, const InputData* inputData, NodeArena* arena);
 
-static Node_t*   GetDefVariable                 (const Token_t* tokensArr, size_t* tp, const InputData* inputData);
-static Node_t*   GetAssign                      (const Token_t* tokensArr, size_t* tp, const InputData* inputData);
+static Node_t*   GetDefVariable                 (const Token_t* tokensArr, size_t* tp, const InputData* inputData, NodeArena* arena);
+static Node_t*   GetAssign                      (const Token_t* tokensArr, size_t* tp, const InputData* inputData, NodeArena* arena);
 
 static Node_t*   GetPlusPlus                    (const Token_t* tokensArr, size_t* tp, const InputData* inputData);
 static Node_t*   GetPlusEqual                   (const Token_t* tokensArr, size_t* tp, const InputData* inputData);
 
-static Node_t*   GetBoolOperation               (const Token_t* tokensArr, size_t* tp, const InputData* inputData);
-static Node_t*   GetAddSub                      (const Token_t* tokensArr, size_t* tp, const InputData* inputData);
-static Node_t*   GetMulDiv                      (const Token_t* tokensArr, size_t* tp, const InputData* inputData);
-static Node_t*   GetBracket                     (const Token_t* tokensArr, size_t* tp, const InputData* inputData);
-static Node_t*   GetPow                         (const Token_t* tokensArr, size_t* tp, const InputData* inputData);
-static Node_t*   GetCallFunction                (const Token_t* tokensArr, size_t* tp, const InputData* inputData);
-static Node_t*   GetCallFunctionArgs            (const Token_t* tokensArr, size_t* tp, const InputData* inputData);
-static Node_t*   GetNot                         (const Token_t* tokensArr, size_t* tp, const InputData* inputData);
-static Node_t*   GetMinus                       (const Token_t* tokensArr, size_t* tp, const InputData* inputData);
+static Node_t*   GetBoolOperation               (const Token_t* tokensArr, size_t* tp, const InputData* inputData, NodeArena* arena);
+static Node_t*   GetExpression                  (const Token_t* tokensArr, size_t* tp, const InputData* inputData, NodeArena* arena, size_t min_precedence);
+static Node_t*   GetPrimary                     (const Token_t* tokensArr, size_t* tp, const InputData* inputData, NodeArena* arena);
+static Node_t*   GetBracket                     (const Token_t* tokensArr, size_t* tp, const InputData* inputData, NodeArena* arena);
+static Node_t*   GetCallFunction                (const Token_t* tokensArr, size_t* tp, const InputData* inputData, NodeArena* arena);
+static Node_t*   GetCallFunctionArgs            (const Token_t* tokensArr, size_t* tp, const InputData* inputData, NodeArena* arena);
+static Node_t*   GetNot                         (const Token_t* tokensArr, size_t* tp, const InputData* inputData, NodeArena* arena);
+static Node_t*   GetMinus                       (const Token_t* tokensArr, size_t* tp, const InputData* inputData, NodeArena* arena);
 
-static Node_t*   GetNumber                      (const Token_t* tokensArr, size_t* tp, const InputData* inputData);
-static Node_t*   GetName                        (const Token_t* tokensArr, size_t* tp, const InputData* inputData);
+static Node_t*   GetNumber                      (const Token_t* tokensArr, size_t* tp, const InputData* inputData, NodeArena* arena);
+static Node_t*   GetName                        (const Token_t* tokensArr, size_t* tp, const InputData* inputData, NodeArena* arena);
 
-static Node_t*   GetType                        (const Token_t* tokensArr, size_t* tp, const InputData* inputData);
+static Node_t*   GetType                        (const Token_t* tokensArr, size_t* tp, const InputData* inputData, NodeArena* arena);
 
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
@@ -61,6 +108,7 @@ static Number    GetTokenNumber                  (const Token_t* token);
 static Name      GetTokenName                    (const Token_t* token);
 static Type      GetTokenType                    (const Token_t* token);
 static Operation GetTokenOperation               (const Token_t* token);
+static size_t    GetTokenPrecedence              (const Token_t* token);
 
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
@@ -75,10 +123,6 @@ static bool      IsTokenSeparatorComma            (const Token_t* token);
 static bool      IsTokenCycle                     (const Token_t* token);
 static bool      IsTokenAssign                    (const Token_t* token);
 static bool      IsTokenSemicolon                 (const Token_t* token);
-static bool      IsBoolOperation                  (const Token_t* token);
-static bool      IsAddSub                         (const Token_t* token);
-static bool      IsMulDiv                         (const Token_t* token);
-static bool      IsPow                            (const Token_t* token);
 static bool      IsTokenLeftRoundBracket          (const Token_t* token);
 static bool      IsTokenRightRoundBracket         (const Token_t* token);
 static bool      IsTokenMinus                     (const Token_t* token);
@@ -111,12 +155,14 @@ const Token_t* PickNextToken                      (const Token_t* tokenArr, cons
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-Node_t* GetTree(const TokensArr* tokensArr, const InputData* inputData)
+Node_t* GetTree(const TokensArr* tokensArr, const InputData* inputData, NodeArena* arena)
 {
     assert(tokensArr);
 
+    PROFILE_SCOPE("GetTree");
+
     size_t  tp   = 0;
-    Node_t* node = GetDefFunc(tokensArr->arr, &tp, inputData);
+    Node_t* node = GetDefFunc(tokensArr->arr, &tp, inputData, arena);
 
     const Token_t* token = ConsumeToken(tokensArr->arr, &tp);
     if (!IsTokenEnd(token))
@@ -131,7 +177,7 @@ Node_t* GetTree(const TokensArr* tokensArr, const InputData* inputData)
 
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static Node_t* GetDefFunc(const Token_t* tokensArr, size_t* tp, const InputData* inputData)
+static Node_t* GetDefFunc(const Token_t* tokensArr, size_t* tp, const InputData* inputData, NodeArena* arena)
 {
     assert(tokensArr);
     assert(tp);
@@ -140,8 +186,8 @@ static Node_t* GetDefFunc(const Token_t* tokensArr, size_t* tp, const InputData*
     if (IsTokenEnd(token))
         return nullptr;
 
-    Node_t* type_node = GetType(tokensArr, tp, inputData);
-    Node_t* name_node = GetName(tokensArr, tp, inputData);
+    Node_t* type_node = GetType(tokensArr, tp, inputData, arena);
+    Node_t* name_node = GetName(tokensArr, tp, inputData, arena);
 
     type_node->left = name_node;
 
@@ -149,7 +195,7 @@ static Node_t* GetDefFunc(const Token_t* tokensArr, size_t* tp, const InputData*
     if (!IsTokenLeftRoundBracket(token))
         SYNTAX_ERR_FOR_TOKEN(token, inputData, "expected '('");
 
-    Node_t* args_node = GetDefFuncArgs(tokensArr, tp, inputData);
+    Node_t* args_node = GetDefFuncArgs(tokensArr, tp, inputData, arena);
     
     name_node->left = args_node;
     
@@ -161,30 +207,30 @@ static Node_t* GetDefFunc(const Token_t* tokensArr, size_t* tp, const InputData*
     if (!IsTokenLeftCurlyBracket(token))
         SYNTAX_ERR_FOR_TOKEN(token, inputData, "expected '{'");
 
-    Node_t* return_node = GetCondition(tokensArr, tp, inputData);
+    Node_t* return_node = GetCondition(tokensArr, tp, inputData, arena);
     name_node->right = return_node;
 
     token = ConsumeToken(tokensArr, tp);
     if (!IsTokenRightCurlyBracket(token))
         SYNTAX_ERR_FOR_TOKEN(token, inputData, "expected '}'");
 
-    Node_t* next_def_func_node = GetDefFunc(tokensArr, tp, inputData);
+    Node_t* next_def_func_node = GetDefFunc(tokensArr, tp, inputData, arena);
 
     Node_t* def_func_node = {};
-    _DEF_FUNC(&def_func_node, type_node);
+    _DEF_FUNC(&def_func_node, arena, type_node);
 
     if (!next_def_func_node)
         return def_func_node;
 
     Node_t* connect_node = {};
-    _CONNECT(&connect_node, def_func_node, next_def_func_node);
+    _CONNECT(&connect_node, arena, def_func_node, next_def_func_node);
 
     return connect_node;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static Node_t* GetDefFuncArgs(const Token_t* tokensArr, size_t* tp, const InputData* inputData)
+static Node_t* GetDefFuncArgs(const Token_t* tokensArr, size_t* tp, const InputData* inputData, NodeArena* arena)
 {
     assert(tokensArr);
     assert(tp);
@@ -194,14 +240,14 @@ static Node_t* GetDefFuncArgs(const Token_t* tokensArr, size_t* tp, const InputD
     if (!IsTokenType(token))
         return nullptr;
 
-    Node_t* type_node = GetType(tokensArr, tp, inputData);
+    Node_t* type_node = GetType(tokensArr, tp, inputData, arena);
 
-    Node_t* name_node = GetName(tokensArr, tp, inputData);
+    Node_t* name_node = GetName(tokensArr, tp, inputData, arena);
 
     type_node->left = name_node;
 
     Node_t* connect_node = {};
-    _CONNECT(&connect_node, type_node, nullptr);
+    _CONNECT(&connect_node, arena, type_node, nullptr);
 
     token = PickToken(tokensArr, tp);
     if (!IsTokenSeparatorComma(token))
@@ -209,7 +255,7 @@ static Node_t* GetDefFuncArgs(const Token_t* tokensArr, size_t* tp, const InputD
 
     (*tp)++;
 
-    Node_t* next_name_node = GetDefFuncArgs(tokensArr, tp, inputData);
+    Node_t* next_name_node = GetDefFuncArgs(tokensArr, tp, inputData, arena);
     
     connect_node->right = next_name_node;
 
@@ -218,7 +264,7 @@ static Node_t* GetDefFuncArgs(const Token_t* tokensArr, size_t* tp, const InputD
 
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static Node_t* GetCondition(const Token_t* tokensArr, size_t* tp, const InputData* inputData)
+static Node_t* GetCondition(const Token_t* tokensArr, size_t* tp, const InputData* inputData, NodeArena* arena)
 {
     assert(tokensArr);
     assert(tp);
@@ -232,58 +278,58 @@ static Node_t* GetCondition(const Token_t* tokensArr, size_t* tp, const InputDat
 
     if (!IsTokenConditionIf(token))
     {
-        Node_t* cycle_node          = GetCycle     (tokensArr, tp, inputData);
-        Node_t* next_condition_node = GetCondition (tokensArr, tp, inputData);
+        Node_t* cycle_node          = GetCycle     (tokensArr, tp, inputData, arena);
+        Node_t* next_condition_node = GetCondition (tokensArr, tp, inputData, arena);
 
         if (!next_condition_node)
             return cycle_node;
 
-        _CONNECT(&main_connect_node, cycle_node, next_condition_node);
+        _CONNECT(&main_connect_node, arena, cycle_node, next_condition_node);
         return main_connect_node;    
     }
 
-    Node_t* if_node      = GetIfCondition    (tokensArr, tp, inputData);
-    Node_t* else_if_node = GetElseIfCondition(tokensArr, tp, inputData);
-    Node_t* else_node    = GetElseCondition  (tokensArr, tp, inputData);
+    Node_t* if_node      = GetIfCondition    (tokensArr, tp, inputData, arena);
+    Node_t* else_if_node = GetElseIfCondition(tokensArr, tp, inputData, arena);
+    Node_t* else_node    = GetElseCondition  (tokensArr, tp, inputData, arena);
 
     Node_t* connect_node = {};
 
     if (!else_node && else_if_node)
-        _CONNECT(&connect_node, if_node, else_if_node);
+        _CONNECT(&connect_node, arena, if_node, else_if_node);
 
     else if (else_node && !else_if_node)
-        _CONNECT(&connect_node, if_node, else_node);
+        _CONNECT(&connect_node, arena, if_node, else_node);
 
     else if (else_node && else_if_node)
     {
         Node_t* connect_node_2 = {};
-        _CONNECT(&connect_node_2, else_if_node, else_node     );
-        _CONNECT(&connect_node  , if_node     , connect_node_2);
+        _CONNECT(&connect_node_2, arena, else_if_node, else_node     );
+        _CONNECT(&connect_node  , arena, if_node     , connect_node_2);
     }
 
     else
     {
-        Node_t* next_condition = GetCondition(tokensArr, tp, inputData);
+        Node_t* next_condition = GetCondition(tokensArr, tp, inputData, arena);
         if (!next_condition)
             return if_node;
 
-        _CONNECT(&connect_node, if_node, next_condition);
+        _CONNECT(&connect_node, arena, if_node, next_condition);
         return connect_node;
     }
 
-    Node_t* next_condition = GetCondition(tokensArr, tp, inputData);
+    Node_t* next_condition = GetCondition(tokensArr, tp, inputData, arena);
 
     if (!next_condition)
         return connect_node;
     
-    _CONNECT(&main_connect_node, connect_node, next_condition);
+    _CONNECT(&main_connect_node, arena, connect_node, next_condition);
 
     return main_connect_node;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static Node_t* GetIfCondition(const Token_t* tokensArr, size_t* tp, const InputData* inputData)
+static Node_t* GetIfCondition(const Token_t* tokensArr, size_t* tp, const InputData* inputData, NodeArena* arena)
 {
     assert(tokensArr);
     assert(tp);
@@ -301,7 +347,7 @@ static Node_t* GetIfCondition(const Token_t* tokensArr, size_t* tp, const InputD
 
     size_t old_tp = *tp;
 
-    Node_t* bool_node = GetAssign(tokensArr, tp, inputData);
+    Node_t* bool_node = GetAssign(tokensArr, tp, inputData, arena);
 
     if (old_tp == *tp)
         SYNTAX_ERR_FOR_TOKEN(token, inputData, "expected bool");
@@ -316,21 +362,21 @@ static Node_t* GetIfCondition(const Token_t* tokensArr, size_t* tp, const InputD
 
     old_tp = *tp;
 
-    Node_t* body_node = GetCondition(tokensArr, tp, inputData);
+    Node_t* body_node = GetCondition(tokensArr, tp, inputData, arena);
 
     token = ConsumeToken(tokensArr, tp);
 
     if (!IsTokenRightCurlyBracket(token))
         SYNTAX_ERR_FOR_TOKEN(token, inputData, "expected '}'");
 
-    _IF(&if_node, bool_node, body_node);
+    _IF(&if_node, arena, bool_node, body_node);
     
     return if_node;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static Node_t* GetElseIfCondition(const Token_t* tokensArr, size_t* tp, const InputData* inputData)
+static Node_t* GetElseIfCondition(const Token_t* tokensArr, size_t* tp, const InputData* inputData, NodeArena* arena)
 {
     assert(tokensArr);
     assert(tp);
@@ -345,7 +391,7 @@ static Node_t* GetElseIfCondition(const Token_t* tokensArr, size_t* tp, const In
     if (!IsTokenLeftRoundBracket(token))
         SYNTAX_ERR_FOR_TOKEN(token, inputData, "expected '('");
 
-    Node_t* bool_node = GetAssign(tokensArr, tp, inputData);
+    Node_t* bool_node = GetAssign(tokensArr, tp, inputData, arena);
 
     token = ConsumeToken(tokensArr, tp);
     if (!IsTokenRightRoundBracket(token))
@@ -355,7 +401,7 @@ static Node_t* GetElseIfCondition(const Token_t* tokensArr, size_t* tp, const In
     if (!IsTokenLeftCurlyBracket(token))
         SYNTAX_ERR_FOR_TOKEN(token, inputData, "expected '{'");
 
-    Node_t* body_node = GetCondition(tokensArr, tp, inputData);
+    Node_t* body_node = GetCondition(tokensArr, tp, inputData, arena);
 
     token = ConsumeToken(tokensArr, tp);
     if (!IsTokenRightCurlyBracket(token))
@@ -364,15 +410,15 @@ static Node_t* GetElseIfCondition(const Token_t* tokensArr, size_t* tp, const In
     
 
     Node_t* else_if_node = {};
-    _ELIF(&else_if_node, bool_node, body_node);
+    _ELIF(&else_if_node, arena, bool_node, body_node);
 
-    Node_t* next_else_if_node = GetElseIfCondition(tokensArr, tp, inputData);
+    Node_t* next_else_if_node = GetElseIfCondition(tokensArr, tp, inputData, arena);
     
     if (!next_else_if_node)
         return else_if_node;
 
     Node_t* connect_node = {};
-    _CONNECT(&connect_node, else_if_node, next_else_if_node);
+    _CONNECT(&connect_node, arena, else_if_node, next_else_if_node);
 
     return connect_node;
 }
@@ -380,7 +426,7 @@ static Node_t* GetElseIfCondition(const Token_t* tokensArr, size_t* tp, const In
 
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static Node_t* GetElseCondition(const Token_t* tokensArr, size_t* tp, const InputData* inputData)
+static Node_t* GetElseCondition(const Token_t* tokensArr, size_t* tp, const InputData* inputData, NodeArena* arena)
 {
     assert(tokensArr);
     assert(tp);
@@ -396,7 +442,7 @@ static Node_t* GetElseCondition(const Token_t* tokensArr, size_t* tp, const Inpu
         SYNTAX_ERR_FOR_TOKEN(token, inputData, "expected '{'");
 
     
-    Node_t* body_node = GetCondition(tokensArr, tp, inputData);
+    Node_t* body_node = GetCondition(tokensArr, tp, inputData, arena);
 
     token = ConsumeToken(tokensArr, tp);
     if (!IsTokenRightCurlyBracket(token))
@@ -404,31 +450,31 @@ static Node_t* GetElseCondition(const Token_t* tokensArr, size_t* tp, const Inpu
 
 
     Node_t* else_node = {};
-    _ELSE(&else_node, body_node);
+    _ELSE(&else_node, arena, body_node);
 
     return else_node;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static Node_t* GetCycle(const Token_t* tokensArr, size_t* tp, const InputData* inputData)
+static Node_t* GetCycle(const Token_t* tokensArr, size_t* tp, const InputData* inputData, NodeArena* arena)
 {
     assert(tokensArr);
     assert(tp);
 
     const Token_t* token = PickToken(tokensArr, tp);
     if (IsTokenCycleFor(token))
-        return GetFor(tokensArr, tp, inputData);
+        return GetFor(tokensArr, tp, inputData, arena);
 
     if (IsTokenCycleWhile(token))
-        return GetWhile(tokensArr, tp, inputData);
+        return GetWhile(tokensArr, tp, inputData, arena);
 
-    return GetPrint(tokensArr, tp, inputData);
+    return GetPrint(tokensArr, tp, inputData, arena);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static Node_t* GetWhile(const Token_t* tokensArr, size_t* tp, const InputData* inputData)
+static Node_t* GetWhile(const Token_t* tokensArr, size_t* tp, const InputData* inputData, NodeArena* arena)
 {
     assert(tokensArr);
     assert(tp);
@@ -441,7 +487,7 @@ static Node_t* GetWhile(const Token_t* tokensArr, size_t* tp, const InputData* i
     if (!IsTokenLeftRoundBracket(token))
         SYNTAX_ERR_FOR_TOKEN(token, inputData, "expected '('");
 
-    Node_t* bool_node = GetDefVariable(tokensArr, tp, inputData);
+    Node_t* bool_node = GetDefVariable(tokensArr, tp, inputData, arena);
 
     token = ConsumeToken(tokensArr, tp);
     if (!IsTokenRightRoundBracket(token))
@@ -451,21 +497,21 @@ static Node_t* GetWhile(const Token_t* tokensArr, size_t* tp, const InputData* i
     if (!IsTokenLeftCurlyBracket(token))
         SYNTAX_ERR_FOR_TOKEN(token, inputData, "expected '{'");
     
-    Node_t* condition_node = GetCondition(tokensArr, tp, inputData);
+    Node_t* condition_node = GetCondition(tokensArr, tp, inputData, arena);
 
     token = ConsumeToken(tokensArr, tp);
     if (!IsTokenRightCurlyBracket(token))
         SYNTAX_ERR_FOR_TOKEN(token, inputData, "expected '}'");
 
     Node_t* while_node = {};
-    _WHILE(&while_node, bool_node, condition_node);
+    _WHILE(&while_node, arena, bool_node, condition_node);
 
     return while_node;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static Node_t* GetFor(const Token_t* tokensArr, size_t* tp, const InputData* inputData)
+static Node_t* GetFor(const Token_t* tokensArr, size_t* tp, const InputData* inputData, NodeArena* arena)
 {
     assert(tokensArr);
     assert(tp);
@@ -479,20 +525,20 @@ static Node_t* GetFor(const Token_t* tokensArr, size_t* tp, const InputData* inp
         SYNTAX_ERR_FOR_TOKEN(token, inputData, "expected '('");
 
 
-    Node_t* assign_node_1 = GetDefVariable(tokensArr, tp, inputData);
+    Node_t* assign_node_1 = GetDefVariable(tokensArr, tp, inputData, arena);
 
     token = ConsumeToken(tokensArr, tp);
     if (!IsTokenSemicolon(token))
         SYNTAX_ERR_FOR_TOKEN(token, inputData, "expected ';'");    
 
-    Node_t* bool_node = GetAssign(tokensArr, tp, inputData);
+    Node_t* bool_node = GetAssign(tokensArr, tp, inputData, arena);
 
     token = ConsumeToken(tokensArr, tp);
     if (!IsTokenSemicolon(token))
         SYNTAX_ERR_FOR_TOKEN(token, inputData, "expected ';'");
 
 
-    Node_t* assign_node_2 = GetAssign(tokensArr, tp, inputData);
+    Node_t* assign_node_2 = GetAssign(tokensArr, tp, inputData, arena);
 
     token = ConsumeToken(tokensArr, tp);
     if (!IsTokenRightRoundBracket(token))
@@ -503,7 +549,7 @@ static Node_t* GetFor(const Token_t* tokensArr, size_t* tp, const InputData* inp
         SYNTAX_ERR_FOR_TOKEN(token, inputData, "expected '{'");
 
 
-    Node_t* condition_node = GetCondition(tokensArr, tp, inputData);
+    Node_t* condition_node = GetCondition(tokensArr, tp, inputData, arena);
     
     token = ConsumeToken(tokensArr, tp);
     if (!IsTokenRightCurlyBracket(token))
@@ -513,12 +559,12 @@ static Node_t* GetFor(const Token_t* tokensArr, size_t* tp, const InputData* inp
     Node_t* connect_node_1 = {};
     Node_t* connect_node_2 = {};
 
-    _CONNECT(&connect_node_1, assign_node_1, bool_node);
-    _CONNECT(&connect_node_2, connect_node_1, assign_node_2);
+    _CONNECT(&connect_node_1, arena, assign_node_1, bool_node);
+    _CONNECT(&connect_node_2, arena, connect_node_1, assign_node_2);
 
 
     Node_t* for_node = {};
-    _FOR(&for_node, connect_node_2, condition_node);
+    _FOR(&for_node, arena, connect_node_2, condition_node);
 
     return for_node;
 }
@@ -526,7 +572,7 @@ static Node_t* GetFor(const Token_t* tokensArr, size_t* tp, const InputData* inp
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
 
-static Node_t* GetPrint(const Token_t* tokensArr, size_t* tp, const InputData* inputData)
+static Node_t* GetPrint(const Token_t* tokensArr, size_t* tp, const InputData* inputData, NodeArena* arena)
 {
     assert(tokensArr);
     assert(tp);
@@ -535,7 +581,7 @@ static Node_t* GetPrint(const Token_t* tokensArr, size_t* tp, const InputData* i
     const Token_t* token = PickToken(tokensArr, tp);
 
     if (!IsTokenPrint(token))
-        return GetReturn(tokensArr, tp, inputData);
+        return GetReturn(tokensArr, tp, inputData, arena);
     
     (*tp)++;
 
@@ -544,8 +590,8 @@ static Node_t* GetPrint(const Token_t* tokensArr, size_t* tp, const InputData* i
         SYNTAX_ERR_FOR_TOKEN(token, inputData, "expeted '(");
     
     
-    Node_t* print_args_node = GetPrintArgs(tokensArr, tp, inputData);
-    _PRINT(&print_node, print_args_node);
+    Node_t* print_args_node = GetPrintArgs(tokensArr, tp, inputData, arena);
+    _PRINT(&print_node, arena, print_args_node);
 
 
     token = ConsumeToken(tokensArr, tp);
@@ -562,7 +608,7 @@ static Node_t* GetPrint(const Token_t* tokensArr, size_t* tp, const InputData* i
 
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static Node_t* GetPrintArgs(const Token_t* tokensArr, size_t* tp, const InputData* inputData)
+static Node_t* GetPrintArgs(const Token_t* tokensArr, size_t* tp, const InputData* inputData, NodeArena* arena)
 {
     assert(tokensArr);
     assert(tp);
@@ -573,12 +619,12 @@ static Node_t* GetPrintArgs(const Token_t* tokensArr, size_t* tp, const InputDat
         SYNTAX_ERR_FOR_TOKEN(token, inputData, "expected name like 'print' arg");
 
 
-    return GetName(tokensArr, tp, inputData);
+    return GetName(tokensArr, tp, inputData, arena);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static Node_t* GetReturn(const Token_t* tokensArr, size_t* tp, const InputData* inputData)
+static Node_t* GetReturn(const Token_t* tokensArr, size_t* tp, const InputData* inputData, NodeArena* arena)
 {
     assert(tokensArr);
     assert(tp);
@@ -587,13 +633,13 @@ static Node_t* GetReturn(const Token_t* tokensArr, size_t* tp, const InputData*
     const Token_t* token = PickToken(tokensArr, tp);
 
     if (!IsTokenFuncAttrReturn(token))
-        return_node = GetDefVariable(tokensArr, tp, inputData);
+        return_node = GetDefVariable(tokensArr, tp, inputData, arena);
     
     else
     {
         (*tp)++;
-        Node_t* bool_operation_node = GetBoolOperation(tokensArr, tp, inputData);
-        _RET(&return_node, bool_operation_node);
+        Node_t* bool_operation_node = GetBoolOperation(tokensArr, tp, inputData, arena);
+        _RET(&return_node, arena, bool_operation_node);
     }
 
     token = ConsumeToken(tokensArr, tp);
@@ -605,7 +651,7 @@ static Node_t* GetReturn(const Token_t* tokensArr, size_t* tp, const InputData*
 
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static Node_t* GetDefVariable(const Token_t* tokensArr, size_t* tp, const InputData* inputData)
+static Node_t* GetDefVariable(const Token_t* tokensArr, size_t* tp, const InputData* inputData, NodeArena* arena)
 {
     assert(tp);
     assert(tokensArr);
@@ -614,10 +660,10 @@ static Node_t* GetDefVariable(const Token_t* tokensArr, size_t* tp, const InputD
     const Token_t* token = PickToken(tokensArr, tp);
     
     if (!IsTokenType(token))
-        return GetAssign(tokensArr, tp, inputData);
+        return GetAssign(tokensArr, tp, inputData, arena);
     
-    Node_t* type_node = GetType(tokensArr, tp, inputData);    
-    Node_t* name_node = GetName(tokensArr, tp, inputData);
+    Node_t* type_node = GetType(tokensArr, tp, inputData, arena);    
+    Node_t* name_node = GetName(tokensArr, tp, inputData, arena);
 
     type_node->left = name_node;
 
@@ -625,18 +671,18 @@ static Node_t* GetDefVariable(const Token_t* tokensArr, size_t* tp, const InputD
     if (!IsTokenAssign(token))
         SYNTAX_ERR_FOR_TOKEN(token, inputData, "expected '='");
 
-    Node_t* bool_operation_node = GetBoolOperation(tokensArr, tp, inputData);
+    Node_t* bool_operation_node = GetBoolOperation(tokensArr, tp, inputData, arena);
 
 
     Node_t* def_variable_node = {};
-    _DEF_VAR(&def_variable_node, type_node, bool_operation_node);
+    _DEF_VAR(&def_variable_node, arena, type_node, bool_operation_node);
 
     return def_variable_node;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static Node_t* GetAssign(const Token_t* tokensArr, size_t* tp, const InputData* inputData)
+static Node_t* GetAssign(const Token_t* tokensArr, size_t* tp, const InputData* inputData, NodeArena* arena)
 {
     assert(tp);
     assert(tokensArr);
@@ -645,18 +691,18 @@ static Node_t* GetAssign(const Token_t* tokensArr, size_t* tp, const InputData*
     const Token_t* next_token = PickNextToken(tokensArr, tp);
 
     if (!(IsTokenName(token) && IsTokenAssign(next_token)))
-        return GetBoolOperation(tokensArr, tp, inputData);
+        return GetBoolOperation(tokensArr, tp, inputData, arena);
     
-    Node_t* name_node = GetName(tokensArr, tp, inputData);
+    Node_t* name_node = GetName(tokensArr, tp, inputData, arena);
 
     token = ConsumeToken(tokensArr, tp);
     if (!IsTokenAssign(token))
         SYNTAX_ERR_FOR_TOKEN(token, inputData, "expected '='");
 
-    Node_t* bool_operation_node = GetBoolOperation(tokensArr, tp, inputData);
+    Node_t* bool_operation_node = GetBoolOperation(tokensArr, tp, inputData, arena);
 
     Node_t* asg_variable_node = {};
-    _ASG_VAR(&asg_variable_node, name_node, bool_operation_node);
+    _ASG_VAR(&asg_variable_node, arena, name_node, bool_operation_node);
 
     return asg_variable_node;
 }
@@ -687,102 +733,42 @@ static Node_t* GetPlusEqual(const Token_t* tokensArr, size_t* tp, const InputDat
 
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static Node_t* GetBoolOperation(const Token_t* tokensArr, size_t* tp, const InputData* inputData)
+static Node_t* GetBoolOperation(const Token_t* tokensArr, size_t* tp, const InputData* inputData, NodeArena* arena)
 {
     assert(tp);
     assert(tokensArr);
 
-    Node_t* node = GetAddSub(tokensArr, tp, inputData);
-
-    const Token_t* token = PickToken(tokensArr, tp);
-
-    while (IsBoolOperation(token))
-    {
-        Operation operation = GetTokenOperation(token);
-        (*tp)++;
-        
-        Node_t* node2 = GetAddSub(tokensArr, tp, inputData);
-    
-        Node_t* new_node = {};
-    
-        switch (operation)
-        {
-            case Operation::greater:             _GR  (&new_node, node, node2); break;
-            case Operation::greater_or_equal:    _GROE(&new_node, node, node2); break;
-            case Operation::less:                _LS  (&new_node, node, node2); break;
-            case Operation::less_or_equal:       _LSOE(&new_node, node, node2); break;
-            case Operation::equal:               _EQ  (&new_node, node, node2); break;
-            case Operation::not_equal:           _NEQ (&new_node, node, node2); break;
-            case Operation::bool_and:            _AND (&new_node, node, node2); break;
-            case Operation::bool_or:             _OR  (&new_node, node, node2); break;
-    
-            case Operation::bool_not:
-            case Operation::plus_plus:
-            case Operation::minus_minus:
-            case Operation::plus_equal:
-            case Operation::minus_equal:
-            case Operation::mul_equal:
-            case Operation::div_equal:
-            case Operation::plus:
-            case Operation::minus:
-            case Operation::mul:
-            case Operation::dive:
-            case Operation::power:
-            case Operation::assign: break;
-            case Operation::undefined_operation:
-            default:
-            {
-                assert(0 && "you forgot about some bool operation in get booo operation");
-                break;
-            }
-        }
-
-        TREE_ASSERT(SwapNode(&new_node, &node));
-
-        token = PickToken(tokensArr, tp);
-    }
-
-    return node;
+    return GetExpression(tokensArr, tp, inputData, arena, BoolOperationPrecedence);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static Node_t* GetAddSub(const Token_t* tokensArr, size_t* tp, const InputData* inputData)
+// precedence climbing: parse operand, then eat binary operations with precedence >= min_precedence,
+// right operand of each one is parsed with (precedence + 1), so all binary operations are left associative
+static Node_t* GetExpression(const Token_t* tokensArr, size_t* tp, const InputData* inputData, NodeArena* arena, size_t min_precedence)
 {
     assert(tp);
     assert(tokensArr);
+    assert(min_precedence > NotBinaryOperationPrecedence);
 
-    size_t old_tp = *tp;
-
-    Node_t* node = GetMulDiv(tokensArr, tp, inputData);
+    Node_t* node = GetPrimary(tokensArr, tp, inputData, arena);
 
-    const Token_t* token = PickToken(tokensArr, tp);
+    const Token_t* token      = PickToken(tokensArr, tp);
+    size_t         precedence = GetTokenPrecedence(token);
 
-    if (old_tp == *tp)
-        SYNTAX_ERR_FOR_TOKEN(token, inputData, "expected math expression");
-    
-    
-    while(IsAddSub(token))
+    while (precedence >= min_precedence)
     {
         Operation operation = GetTokenOperation(token);
         (*tp)++;
 
-        Node_t* node2 = GetMulDiv(tokensArr, tp, inputData);
-        Node_t* new_node = {};
+        Node_t* right_node = GetExpression(tokensArr, tp, inputData, arena, precedence + 1);
 
-        if (operation == Operation::plus)
-            _ADD(&new_node, node, node2);
-    
-        else if (operation == Operation::minus)
-            _SUB(&new_node, node, node2);
-    
-        else
-        {
-            assert(0 && "incorrect operation type");
-        }
+        Node_t* operation_node = {};
+        _OPER(&operation_node, arena, operation, node, right_node);
+        node = operation_node;
 
-        TREE_ASSERT(SwapNode(&node, &new_node));
-        token = PickToken(tokensArr, tp);
+        token      = PickToken(tokensArr, tp);
+        precedence = GetTokenPrecedence(token);
     }
 
     return node;
@@ -790,91 +776,45 @@ static Node_t* GetAddSub(const Token_t* tokensArr, size_t* tp, const InputData*
 
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static Node_t* GetMulDiv(const Token_t* tokensArr, size_t* tp, const InputData* inputData)
+static Node_t* GetPrimary(const Token_t* tokensArr, size_t* tp, const InputData* inputData, NodeArena* arena)
 {
     assert(tp);
     assert(tokensArr);
 
-    size_t old_tp = *tp;
-
-    Node_t* node = GetPow(tokensArr, tp, inputData);
-
     const Token_t* token = PickToken(tokensArr, tp);
-    if (old_tp == *tp)
-        SYNTAX_ERR_FOR_TOKEN(token, inputData, "expected math expression");
-
-    while (IsMulDiv(token))
-    {
-        Operation operation = GetTokenOperation(token);
-        (*tp)++;
-
-        Node_t* node2 = GetPow(tokensArr, tp, inputData);
-        Node_t* new_node = {};
-    
-        if (operation == Operation::mul)
-        {
-            _MUL(&new_node, node, node2);
-        }
-
-        else if (operation == Operation::dive)
-        {
-            _DIV(&new_node, node, node2);
-        }
-
-        else
-        {
-            assert(0 && "not a */ operation in get mul div");
-        }
-        TREE_ASSERT(SwapNode(&node, &new_node));
-        token = PickToken(tokensArr, tp);
-    }
 
-    return node;
-}
-
-//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    if (IsTokenMinus(token))
+        return GetMinus(tokensArr, tp, inputData, arena);
 
-static Node_t* GetPow(const Token_t* tokensArr, size_t* tp, const InputData* inputData)
-{
-    assert(tp);
-    assert(tokensArr);
+    if (IsTokenOperationNot(token))
+        return GetNot(tokensArr, tp, inputData, arena);
 
-    Node_t* node = GetCallFunction(tokensArr, tp, inputData);
+    if (IsTokenLeftRoundBracket(token))
+        return GetBracket(tokensArr, tp, inputData, arena);
 
-    const Token_t* token = PickToken(tokensArr, tp);
-    while(IsPow(token))
-    {
-        Node_t* node2 = GetCallFunction(tokensArr, tp, inputData);
-        (*tp)++;
+    if (IsCallFunction(tokensArr, tp))
+        return GetCallFunction(tokensArr, tp, inputData, arena);
 
-        Node_t* new_node = {};
-        _POW(&new_node, node, node2);
-        TREE_ASSERT(SwapNode(&node, &new_node));
-        token = PickToken(tokensArr, tp);
-    }
+    if (IsTokenNum(token))
+        return GetNumber(tokensArr, tp, inputData, arena);
 
-    return node;
+    return GetName(tokensArr, tp, inputData, arena);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static Node_t* GetCallFunction(const Token_t* tokensArr, size_t* tp, const InputData* inputData)
+static Node_t* GetCallFunction(const Token_t* tokensArr, size_t* tp, const InputData* inputData, NodeArena* arena)
 {
     assert(tokensArr);
     assert(tp);
 
-    const Token_t* token = PickToken(tokensArr, tp);
-
-    if (!IsCallFunction(tokensArr, tp))
-        return GetMinus(tokensArr, tp, inputData);
+    Node_t* name_node = GetName(tokensArr, tp, inputData, arena);
 
-    Node_t* name_node = GetName(tokensArr, tp, inputData);
-
-    token = ConsumeToken(tokensArr, tp);
+    const Token_t* token = ConsumeToken(tokensArr, tp);
     if (!IsTokenLeftRoundBracket(token))
         SYNTAX_ERR_FOR_TOKEN(token, inputData, "expected '('");
 
-    Node_t* args_node = GetCallFunctionArgs(tokensArr, tp, inputData);
+    Node_t* args_node = GetCallFunctionArgs(tokensArr, tp, inputData, arena);
 
     token = ConsumeToken(tokensArr, tp);
     if (!IsTokenRightRoundBracket(token))
@@ -883,14 +823,14 @@ static Node_t* GetCallFunction(const Token_t* tokensArr, size_t* tp, const Input
     name_node->left = args_node;
 
     Node_t* call_func_node = {};
-    _CALL_FUNC(&call_func_node, name_node);
+    _CALL_FUNC(&call_func_node, arena, name_node);
 
     return call_func_node;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static Node_t* GetCallFunctionArgs(const Token_t* tokensArr, size_t* tp, const InputData* inputData)
+static Node_t* GetCallFunctionArgs(const Token_t* tokensArr, size_t* tp, const InputData* inputData, NodeArena* arena)
 {
     assert(tokensArr);
     assert(tp);
@@ -900,7 +840,7 @@ static Node_t* GetCallFunctionArgs(const Token_t* tokensArr, size_t* tp, const I
     if (IsTokenRightRoundBracket(token))
         return nullptr;
 
-    Node_t* bool_operation_node = GetBoolOperation(tokensArr, tp, inputData);    
+    Node_t* bool_operation_node = GetBoolOperation(tokensArr, tp, inputData, arena);    
     
 
     token = PickToken(tokensArr, tp);
@@ -910,7 +850,7 @@ static Node_t* GetCallFunctionArgs(const Token_t* tokensArr, size_t* tp, const I
     (*tp)++;
 
     size_t old_tp = *tp;
-    Node_t* next_name_node = GetCallFunctionArgs(tokensArr, tp, inputData);
+    Node_t* next_name_node = GetCallFunctionArgs(tokensArr, tp, inputData, arena);
 
     token = PickToken(tokensArr, tp);
     if (old_tp == *tp)
@@ -920,85 +860,62 @@ static Node_t* GetCallFunctionArgs(const Token_t* tokensArr, size_t* tp, const I
         return bool_operation_node;
 
     Node_t* connect_node = {};
-    _CONNECT(&connect_node, bool_operation_node, next_name_node);
+    _CONNECT(&connect_node, arena, bool_operation_node, next_name_node);
 
     return connect_node;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static Node_t* GetMinus(const Token_t* tokensArr, size_t* tp, const InputData* inputData)
+static Node_t* GetMinus(const Token_t* tokensArr, size_t* tp, const InputData* inputData, NodeArena* arena)
 {
     assert(tokensArr);
     assert(tp);
 
     const Token_t* token = PickToken(tokensArr, tp);
-    if (!IsTokenMinus(token))
-        return GetNot(tokensArr, tp, inputData);
-
-    (*tp)++;
 
-    token = ConsumeToken(tokensArr, tp);
     if (IsNotAssignOperationBeforeMinus(tokensArr, *tp))
         SYNTAX_ERR_FOR_TOKEN(token, inputData, "Operation before '-'");
-    
-    size_t old_tp = *tp;
 
-    Node_t* node = GetMulDiv(tokensArr, tp, inputData);
+    (*tp)++;
 
-    token = PickToken(tokensArr, tp);
-    if (old_tp == *tp)
-        SYNTAX_ERR_FOR_TOKEN(token, inputData, "Nothig after '-'");
+    Node_t* node = GetExpression(tokensArr, tp, inputData, arena, MulDivPrecedence);
 
     Node_t* new_node = {};
-    _SUB(&new_node, node, nullptr);
+    _SUB(&new_node, arena, node, nullptr);
 
     return new_node;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static Node_t* GetNot(const Token_t* tokensArr, size_t* tp, const InputData* inputData)
+static Node_t* GetNot(const Token_t* tokensArr, size_t* tp, const InputData* inputData, NodeArena* arena)
 {
     assert(tokensArr);
     assert(tp);
 
-    const Token_t* token = PickToken(tokensArr, tp);
-    if (!IsTokenOperationNot(token))
-        return GetBracket(tokensArr, tp, inputData);
-
-    size_t old_tp = *tp;
-
     (*tp)++;
 
-    Node_t* node = GetMulDiv(tokensArr, tp, inputData);
-
-    token = PickToken(tokensArr, tp);
-    if (old_tp == *tp)
-        SYNTAX_ERR_FOR_TOKEN(token, inputData, "nothing after '!'");
+    Node_t* node = GetExpression(tokensArr, tp, inputData, arena, MulDivPrecedence);
 
     Node_t* not_node = {};
-    _NOT(&not_node, node);
+    _NOT(&not_node, arena, node);
 
     return not_node;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static Node_t* GetBracket(const Token_t* tokensArr, size_t* tp, const InputData* inputData)
+static Node_t* GetBracket(const Token_t* tokensArr, size_t* tp, const InputData* inputData, NodeArena* arena)
 {
     assert(tp);
     assert(tokensArr);
 
-    const Token_t* token = PickToken(tokensArr, tp);
-    if (!IsTokenLeftRoundBracket(token))
-        return GetNumber(tokensArr, tp, inputData);
-
     (*tp)++;
 
-    Node_t* node = GetBoolOperation(tokensArr, tp, inputData);
+    Node_t* node = GetBoolOperation(tokensArr, tp, inputData, arena);
 
-    token = ConsumeToken(tokensArr, tp);
+    const Token_t* token = ConsumeToken(tokensArr, tp);
     if (!IsTokenRightRoundBracket(token))
         SYNTAX_ERR_FOR_TOKEN(token, inputData, "expected ')'");
 
@@ -1007,27 +924,27 @@ static Node_t* GetBracket(const Token_t* tokensArr, size_t* tp, const InputData*
 
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static Node_t* GetNumber(const Token_t* tokensArr, size_t* tp, const InputData* inputData)
+static Node_t* GetNumber(const Token_t* tokensArr, size_t* tp, const InputData* inputData, NodeArena* arena)
 {
     assert(tokensArr);
     assert(tp);
 
     const Token_t* token = PickToken(tokensArr, tp);
     if (!IsTokenNum(token))
-        return GetName(tokensArr, tp, inputData);
+        SYNTAX_ERR_FOR_TOKEN(token, inputData, "expected number");
     
     Number val = GetTokenNumber(token);
     (*tp)++;
 
     Node_t* node = {};
-    _NUM(&node, val);
+    _NUM(&node, arena, val);
 
     return node;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static Node_t* GetName(const Token_t* tokensArr, size_t* tp, const InputData* inputData)
+static Node_t* GetName(const Token_t* tokensArr, size_t* tp, const InputData* inputData, NodeArena* arena)
 {
     assert(tp);
     assert(tokensArr);
@@ -1041,14 +958,14 @@ static Node_t* GetName(const Token_t* tokensArr, size_t* tp, const InputData* in
     (*tp)++;
 
     Node_t* node = {};
-    _NAME(&node, name);
+    _NAME(&node, arena, name);
 
     return node;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static Node_t* GetType(const Token_t* tokensArr, size_t* tp, const InputData* inputData)
+static Node_t* GetType(const Token_t* tokensArr, size_t* tp, const InputData* inputData, NodeArena* arena)
 {
     assert(tokensArr);
     assert(tp);
@@ -1061,7 +978,7 @@ static Node_t* GetType(const Token_t* tokensArr, size_t* tp, const InputData* in
     (*tp)++;
 
     Node_t* node = {};
-    _TYPE(&node, type, nullptr);
+    _TYPE(&node, arena, type, nullptr);
 
     return node;
 }
@@ -1100,6 +1017,21 @@ static Operation GetTokenOperation(const Token_t* token)
     return token->data.operation;
 }
 
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static size_t GetTokenPrecedence(const Token_t* token)
+{
+    assert(token);
+    RETURN_IF_FALSE(token->type == TokenType::TokenOperation_t, NotBinaryOperationPrecedence);
+
+    size_t operation_i = (size_t) token->data.operation;
+
+    assert(operation_i < OperationsPrecedenceQuant);
+    assert(OperationsPrecedence[operation_i].operation == token->data.operation);
+
+    return OperationsPrecedence[operation_i].precedence;
+}
+
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -1163,26 +1095,6 @@ static bool IsTokenSemicolon(const Token_t* token)
 
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static bool IsBoolOperation(const Token_t* token)
-{
-    assert(token);
-    RETURN_IF_FALSE(token->type == TokenType::TokenOperation_t, false);
-
-    Operation operation = token->data.operation;
-
-    return  (operation == Operation::greater         ) ||
-            (operation == Operation::greater_or_equal) ||
-            (operation == Operation::less            ) ||
-            (operation == Operation::less_or_equal   ) ||
-            (operation == Operation::equal           ) ||
-            (operation == Operation::not_equal       ) ||
-            (operation == Operation::bool_and        ) ||
-            (operation == Operation::bool_or         ) ||
-            (operation == Operation::bool_not        );            
-}
-
-//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-
 static bool IsTokenOperation(const Token_t* token)
 {   
     assert(token);
@@ -1191,43 +1103,6 @@ static bool IsTokenOperation(const Token_t* token)
 
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static bool IsAddSub(const Token_t* token)
-{
-    assert(token);
-    RETURN_IF_FALSE(token->type == TokenType::TokenOperation_t, false);
-
-    Operation operation = token->data.operation;
-
-    return  (operation == Operation::plus ) || 
-            (operation == Operation::minus);
-}
-
-//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-
-static bool IsMulDiv(const Token_t* token)
-{
-    assert(token);
-    RETURN_IF_FALSE(token->type == TokenType::TokenOperation_t, false);
-
-    Operation operation = token->data.operation;
-    return  (operation == Operation::mul ) ||
-            (operation == Operation::dive);
-}
-
-//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-
-static bool IsPow(const Token_t* token)
-{
-    assert(token);
-    RETURN_IF_FALSE(token->type == TokenType::TokenOperation_t, false);
-
-    Operation operation = token->data.operation;
-
-    return (operation == Operation::power);
-}
-
-//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-
 static bool IsTokenMinus(const Token_t* token)
 {
     assert(token);
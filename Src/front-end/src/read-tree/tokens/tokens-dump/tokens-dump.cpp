@@ -2,13 +2,14 @@
 #include <assert.h>
 #include <ctype.h>
 #include "dump/global-dump.hpp"
+#include "dump/dump-service.hpp"
 #include "read-tree/tokens/tokens.hpp"
 #include "read-tree/tokens/tokens-dump/tokens-dump.hpp"
 #include "log/log.hpp"
 
 
 
-static void TokenGraphicDumpHelper(const TokensArr* tokensArr, const char* dotFileName, const char* file, const int line, const char* func);
+static void TokenGraphicDumpHelper(const TokensArr* tokensArr, FILE* dotFile, const char* file, const int line, const char* func);
 
 static void DotTokenBegin    (FILE* dotFile);
 static void CreateAllTokens  (const TokensArr* tokensArr, FILE* dotFile);
@@ -110,44 +111,28 @@ void TokenGraphicDump(const TokensArr* tokensArr, const char* file, const int li
     assert(file);
     assert(func);
 
-    system("mkdir -p ../dot/");
-    system("mkdir -p ../dot/tokens/");
-    system("mkdir -p ../dot/tokens/img/");
-    system("mkdir -p ../dot/tokens/dot/");
-
     static size_t ImgQuant = 1;
 
-    static const size_t MaxBufferLen = 128;
-    char outfile[MaxBufferLen] = {};
-    snprintf(outfile, MaxBufferLen, "../dot/tokens/img/tokens%lu.png", ImgQuant);
-    
-    
-    char dotFileName[MaxBufferLen] = {};
-    snprintf(dotFileName, MaxBufferLen, "../dot/tokens/dot/tokens%lu.dot", ImgQuant);
-    
-    TokenGraphicDumpHelper(tokensArr, dotFileName, file, line, func);
+    DumpFiles files   = {};
+    FILE*     dotFile = DumpOpen("tokens", ImgQuant, &files);
 
+    TokenGraphicDumpHelper(tokensArr, dotFile, file, line, func);
+
+    DumpClose(dotFile, &files);
 
-    static const size_t MaxCommandLen = 512;
-    char command[MaxCommandLen] = {};
-    snprintf(command, MaxCommandLen, "dot -Tpng %s > %s", dotFileName, outfile);
-    system(command);
-    
     ImgQuant++;
     return;
 }
 
 //----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
-static void TokenGraphicDumpHelper(const TokensArr* tokensArr, const char* dotFileName, const char* file, const int line, const char* func)
+static void TokenGraphicDumpHelper(const TokensArr* tokensArr, FILE* dotFile, const char* file, const int line, const char* func)
 {
     assert(tokensArr);
+    assert(dotFile);
     assert(file);
     assert(func);
 
-    FILE* dotFile = fopen(dotFileName, "w");
-    assert(dotFile);
-
     DotTokenBegin(dotFile);
 
     DotCreateDumpPlace(dotFile, file, line, func);
@@ -155,8 +140,6 @@ static void TokenGraphicDumpHelper(const TokensArr* tokensArr, const char* dotFi
     CreateAllTokens(tokensArr, dotFile);
     DotEnd(dotFile);
 
-    fclose(dotFile);
-
     return;
 }
 
@@ -3,10 +3,12 @@
 #include <stdlib.h>
 #include <string.h>
 #include "lib/lib.hpp"
+#include "profile/profile.hpp"
 #include "read-tree/tokens/tokens.hpp"
 #include "tree/node-and-token-types.hpp"
 #include "read-tree/file-read/file-read.hpp"
 #include "read-tree/syntax-err/syntax-err.hpp"
+#include "name-table/interner/interner.hpp"
 
 
 #ifdef _DEBUG
@@ -85,6 +87,8 @@ TokensArr ReadInputBuffer (const InputData* inputData)
     assert(inputData->buffer);
     assert(inputData->inputStream);
 
+    PROFILE_SCOPE("ReadInputBuffer");
+
     const char* input       = inputData->buffer;
     size_t      buffer_size = inputData->size;
 
@@ -206,6 +210,9 @@ TokensArr ReadInputBuffer (const InputData* inputData)
     tokensArr.arr  = tokens;
     tokensArr.size = tokens_arr_size;
 
+    PROFILE_COUNT("tokens", tokens_arr_size);
+    PROFILE_COUNT("source bytes", buffer_size);
+
     return tokensArr;
 }
 
@@ -527,6 +534,7 @@ static Name GetName(const char* word)
 
     name.name.len = i;
     name.name.name = word;
+    name.id = InternName(&name.name);
     return name;
 }
 
@@ -1,12 +1,30 @@
 # NOT A MAKEFILE TO MAKE COMMON/
-# HERE ARE COMMON SETTINGS FOR ALL MAKEFILES (make-front.mk, make-midle.mk, make-back.mk)
+# HERE ARE COMMON SETTINGS FOR ALL MAKEFILES (make-front.mk, make-midle.mk, make-back.mk, make-driver.mk)
 
-FRONT_DIR := front-end
-MIDLE_DIR := midle-end
-BACK_DIR  := back-end
+FRONT_DIR  := front-end
+MIDLE_DIR  := midle-end
+BACK_DIR   := back-end
+BENCH_DIR  := bench
+DRIVER_DIR := driver
 
 COMMON_DIR := common
 
 COMMON_INC := -I./$(COMMON_DIR)/include
 
 
+
+
+# profile-guided release builds (see pgo-* targets in Makefile):
+# pgo-gen - release build with instrumentation, its runs write profiles (.gcda) next to the objects,
+# pgo-use - release build that reads them, it must use the same OUT_O_DIR as pgo-gen
+PGO_RELEASE_FLAGS := -DNDEBUG -O3 -ffast-math -flto -g0 -fvisibility=hidden -march=native
+
+ifeq ($(BUILD_TYPE), pgo-gen)
+	CFLAGS  += $(PGO_RELEASE_FLAGS) -fprofile-generate -fprofile-update=atomic
+	LDFLAGS += -fprofile-generate
+endif
+
+ifeq ($(BUILD_TYPE), pgo-use)
+	CFLAGS  += $(PGO_RELEASE_FLAGS) -s -fprofile-use -fprofile-partial-training -Wno-missing-profile
+	LDFLAGS += -fprofile-use
+endif
@@ -6,7 +6,7 @@ endif
 SFML_FLAGS = -lsfml-graphics -lsfml-window -lsfml-system
 
 CFLAGS ?= 
-LDFLAGS = $(SFML_FLAGS)
+LDFLAGS = $(SFML_FLAGS) -pthread
 
 BUILD_TYPE ?= debug
 # BUILD_TYPE ?= release
@@ -40,7 +40,7 @@ endif
 
 OUT_O_DIR       ?= bin
 EXECUTABLE_DIR ?= build
-INCLUDE 	    = -I./$(BACK_DIR)/include $(COMMON_INC)
+INCLUDE 	    = -I./$(BACK_DIR)/include -I./$(MIDLE_DIR)/include $(COMMON_INC)
 SRC 		    = ./src
 EXECUTABLE     ?= backend
 
@@ -53,15 +53,31 @@ CSRC =  $(BACK_DIR)/main.cpp                                      \
 		$(BACK_DIR)/src/console/consoleCmd.cpp                       \
 		$(BACK_DIR)/src/assembler/assembler.cpp                       \
 		$(BACK_DIR)/src/processor/processor.cpp                        \
+		$(BACK_DIR)/src/codegen/codegen.cpp                             \
+		$(BACK_DIR)/src/codegen/register-alloc/register-alloc.cpp       \
+		$(BACK_DIR)/src/codegen/code-cache/code-cache.cpp               \
+		$(MIDLE_DIR)/src/ir/ir.cpp                                      \
+		$(MIDLE_DIR)/src/ir/ir-lower/ir-lower.cpp                        \
+		$(MIDLE_DIR)/src/ir/ir-opt/ir-opt.cpp                            \
 		$(COMMON_DIR)/src/lib/lib.cpp                                   \
+		$(COMMON_DIR)/src/profile/profile.cpp                           \
 		$(COMMON_DIR)/src/read-file/read-file.cpp                        \
 		$(COMMON_DIR)/src/tree/read-write-tree/read-tree/read-tree.cpp    \
+		$(COMMON_DIR)/src/tree/read-write-tree/binary-tree/binary-tree.cpp \
+		$(COMMON_DIR)/src/tree/read-write-tree/write-buffer/write-buffer.cpp \
+		$(COMMON_DIR)/src/tree/tree.cpp                                   \
+		$(COMMON_DIR)/src/tree/node-arena/node-arena.cpp                  \
+		$(COMMON_DIR)/src/tree/flat-tree/flat-tree.cpp                    \
+		$(COMMON_DIR)/src/name-table/hash.cpp                             \
+		$(COMMON_DIR)/src/name-table/interner/interner.cpp                \
 
 
 
 ifeq ($(BUILD_TYPE), debug)
 	CSRC += $(COMMON_DIR)/src/log/log.cpp                 \
+			$(COMMON_DIR)/src/log/log-ring.cpp            \
 			$(COMMON_DIR)/src/dump/global-dump.cpp         \
+			$(COMMON_DIR)/src/dump/dump-service.cpp        \
 			$(COMMON_DIR)/src/tree/tree-dump/tree-dump.cpp  \
 
 
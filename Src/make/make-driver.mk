@@ -0,0 +1,160 @@
+ifeq ($(origin CC),default)
+  CC = g++
+endif
+
+
+CFLAGS ?=
+LDFLAGS = -pthread
+
+BUILD_TYPE ?= debug
+# BUILD_TYPE ?= release
+
+
+ifeq ($(BUILD_TYPE), release)
+	CFLAGS += -DNDEBUG -O3 -ffast-math -flto -g0 -fvisibility=hidden -march=native -s
+endif 
+
+ifeq ($(BUILD_TYPE), debug)
+	CFLAGS += -D _DEBUG -ggdb3 -std=c++17 -O0 -Wall -Wextra -Weffc++                                     \
+			  -Waggressive-loop-optimizations -Wc++14-compat -Wmissing-declarations                       \
+			  -Wcast-align -Wcast-qual -Wchar-subscripts -Wconditionally-supported                         \
+			  -Wconversion -Wctor-dtor-privacy -Wempty-body -Wfloat-equal -Wformat-nonliteral               \
+			  -Wnon-virtual-dtor -Wopenmp-simd -Woverloaded-virtual -Wpacked -Wpointer-arith                 \
+			  -fstrict-overflow -flto-odr-type-merging -fno-omit-frame-pointer -Wstack-usage=8192             \
+			  -Winit-self -Wredundant-decls -Wshadow -Wsign-conversion -Wsign-promo -Wstrict-null-sentinel     \
+			  -Wformat-security -Wformat-signedness -Wformat=2 -Winline -Wlogical-op -pie -fPIE -Werror=vla     \
+			  -Wstrict-overflow=2 -Wsuggest-attribute=noreturn -Wsuggest-final-methods -Wsuggest-final-types     \
+			  -Wsuggest-override -Wswitch-default -Wswitch-enum -Wsync-nand -Wundef -Wunreachable-code -Wunused   \
+			  -Wuseless-cast -Wvariadic-macros -Wno-literal-suffix -Wno-missing-field-initializers -Wno-narrowing  \
+			  -Wno-old-style-cast -Wno-varargs -Wstack-protector -fcheck-new -fsized-deallocation -fstack-protector \
+			  -fsanitize=address,alignment,bool,bounds,enum,float-cast-overflow,float-divide-by-zero,integer-divide-by-zero,leak,nonnull-attribute,null,object-size,return,returns-nonnull-attribute,shift,signed-integer-overflow,undefined,unreachable,vla-bound,vptr \
+
+	LDFLAGS += -fsanitize=address,undefined -lasan -lubsan
+endif
+
+-include make/common.mk
+
+OUT_O_DIR	   ?= bin
+EXECUTABLE_DIR ?= build
+INCLUDE 	    = -I./$(FRONT_DIR)/include -I./$(MIDLE_DIR)/include -I./$(BACK_DIR)/include $(COMMON_INC)
+SRC 			= src
+EXECUTABLE 	   ?= driver
+
+
+
+override CFLAGS += $(INCLUDE)
+
+CSRC =  $(DRIVER_DIR)/main.cpp 					  			   			    \
+		$(FRONT_DIR)/src/read-tree/tokens/tokens.cpp 			            \
+		$(FRONT_DIR)/src/read-tree/file-read/file-read.cpp	                \
+		$(FRONT_DIR)/src/read-tree/syntax-err/syntax-err.cpp                \
+		$(FRONT_DIR)/src/read-tree/recursive-descent/recursive-descent.cpp  \
+		$(MIDLE_DIR)/src/optimize/optimize.cpp                              \
+		$(MIDLE_DIR)/src/fresh-name/fresh-name.cpp                          \
+		$(MIDLE_DIR)/src/tail-recursion/tail-recursion.cpp                  \
+		$(MIDLE_DIR)/src/call-graph/call-graph.cpp                          \
+		$(MIDLE_DIR)/src/pure-eval/pure-eval.cpp                            \
+		$(MIDLE_DIR)/src/inliner/inliner.cpp                                \
+		$(MIDLE_DIR)/src/const-fold/const-fold.cpp                          \
+		$(MIDLE_DIR)/src/loop-opt/loop-opt.cpp                              \
+		$(MIDLE_DIR)/src/unroll/unroll.cpp                                  \
+		$(MIDLE_DIR)/src/ir/ir.cpp                                          \
+		$(MIDLE_DIR)/src/ir/ir-lower/ir-lower.cpp                            \
+		$(MIDLE_DIR)/src/ir/ir-opt/ir-opt.cpp                                \
+		$(MIDLE_DIR)/src/cse/cse.cpp                                        \
+		$(BACK_DIR)/src/codegen/codegen.cpp                                 \
+		$(BACK_DIR)/src/codegen/register-alloc/register-alloc.cpp           \
+		$(BACK_DIR)/src/codegen/code-cache/code-cache.cpp                   \
+		$(BACK_DIR)/src/assembler/assembler.cpp                             \
+		$(BACK_DIR)/src/stack/hash.cpp                                      \
+		$(BACK_DIR)/src/stack/stack.cpp                                     \
+		$(COMMON_DIR)/src/read-file/read-file.cpp                           \
+		$(COMMON_DIR)/src/lib/lib.cpp								        \
+		$(COMMON_DIR)/src/profile/profile.cpp                              \
+		$(COMMON_DIR)/src/tree/tree.cpp							            \
+		$(COMMON_DIR)/src/tree/node-arena/node-arena.cpp                    \
+		$(COMMON_DIR)/src/tree/flat-tree/flat-tree.cpp                      \
+		$(COMMON_DIR)/src/name-table/hash.cpp      				  	        \
+		$(COMMON_DIR)/src/name-table/name-table.cpp    				        \
+		$(COMMON_DIR)/src/name-table/interner/interner.cpp                \
+		$(COMMON_DIR)/src/tree/read-write-tree/write-tree/write-tree.cpp    \
+		$(COMMON_DIR)/src/tree/read-write-tree/binary-tree/binary-tree.cpp  \
+		$(COMMON_DIR)/src/tree/read-write-tree/write-buffer/write-buffer.cpp \
+
+ifeq ($(BUILD_TYPE), debug)
+
+CSRC += $(COMMON_DIR)/src/log/log.cpp								       \
+		$(COMMON_DIR)/src/log/log-ring.cpp							       \
+		$(COMMON_DIR)/src/dump/global-dump.cpp			                   \
+		$(COMMON_DIR)/src/dump/dump-service.cpp			                   \
+		$(COMMON_DIR)/src/tree/tree-dump/tree-dump.cpp 				       \
+		$(FRONT_DIR)/src/read-tree/tokens/tokens-dump/tokens-dump.cpp      \
+	    # $(FRONT_DIR)/src/nameTable/nameTableLog/nameTableLog.cpp           \
+
+endif
+
+COBJ := $(addprefix $(OUT_O_DIR)/,$(CSRC:.cpp=.o))
+DEPS = $(COBJ:.o=.d)
+
+.PHONY: all
+
+all: $(EXECUTABLE_DIR)/$(EXECUTABLE)
+
+$(EXECUTABLE_DIR)/$(EXECUTABLE): $(COBJ)
+	@mkdir -p $(@D)
+	$(CC) $^ -o $@ $(LDFLAGS)
+
+$(COBJ) : $(OUT_O_DIR)/%.o : %.cpp
+	@mkdir -p $(@D)
+	$(CC) $(CFLAGS) -c $< -o $@
+
+$(DEPS) : $(OUT_O_DIR)/%.d : %.cpp
+	@mkdir -p $(@D)
+	@$(CC) -E $(CFLAGS) $< -MM -MT $(@:.d=.o) > $@
+
+
+#======= run ==========================================
+
+PROGRAMM ?= programm/programm.asm
+
+run:
+	./$(EXECUTABLE_DIR)/$(EXECUTABLE) -input $(PROGRAMM)
+
+rebuild:
+	make clean && make
+
+rerun:
+	make && make run
+
+#======= clean ========================================
+
+.PHONY: clean clean_dirs clean_log clean_dot
+
+clean:
+	rm -rf $(COBJ) $(DEPS) $(EXECUTABLE_DIR)/$(EXECUTABLE) $(OUT_O_DIR)/$(SRC)
+
+clean_dirs:
+	rm -rf $(OUT_O_DIR) $(EXECUTABLE_DIR)
+
+clean_log:
+	rm -rf ../Log/
+
+clean_dot:
+	rm -rf ../dot/
+
+#========= iwyu ======================================
+
+.PHONY: iwyu
+
+f ?= main.cpp
+
+iwyu:
+	iwyu $(INCLUDE) $(f)
+
+#==================================================
+
+NODEPS = clean clean_dirs clean_log clean_dot iwyu
+
+ifeq (0, $(words $(findstring $(MAKECMDGOALS), $(NODEPS))))
+include $(DEPS)
+endif
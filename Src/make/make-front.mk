@@ -4,7 +4,7 @@ endif
 
 
 CFLAGS ?=
-LDFLAGS =
+LDFLAGS = -pthread
 
 BUILD_TYPE ?= debug
 # BUILD_TYPE ?= release
@@ -50,15 +50,23 @@ CSRC =  $(FRONT_DIR)/main.cpp 					  			   			    \
 		$(FRONT_DIR)/src/read-tree/syntax-err/syntax-err.cpp                \
 		$(FRONT_DIR)/src/read-tree/recursive-descent/recursive-descent.cpp  \
 		$(COMMON_DIR)/src/lib/lib.cpp								        \
+		$(COMMON_DIR)/src/profile/profile.cpp                              \
 		$(COMMON_DIR)/src/tree/tree.cpp							            \
+		$(COMMON_DIR)/src/tree/node-arena/node-arena.cpp                    \
+		$(COMMON_DIR)/src/tree/flat-tree/flat-tree.cpp                      \
 		$(COMMON_DIR)/src/name-table/hash.cpp      				  	        \
 		$(COMMON_DIR)/src/name-table/name-table.cpp    				        \
+		$(COMMON_DIR)/src/name-table/interner/interner.cpp                \
 		$(COMMON_DIR)/src/tree/read-write-tree/write-tree/write-tree.cpp    \
+		$(COMMON_DIR)/src/tree/read-write-tree/binary-tree/binary-tree.cpp  \
+		$(COMMON_DIR)/src/tree/read-write-tree/write-buffer/write-buffer.cpp \
 
 ifeq ($(BUILD_TYPE), debug)
 
 CSRC += $(COMMON_DIR)/src/log/log.cpp								       \
+		$(COMMON_DIR)/src/log/log-ring.cpp							       \
 		$(COMMON_DIR)/src/dump/global-dump.cpp			                   \
+		$(COMMON_DIR)/src/dump/dump-service.cpp			                   \
 		$(COMMON_DIR)/src/tree/tree-dump/tree-dump.cpp 				       \
 		$(FRONT_DIR)/src/read-tree/tokens/tokens-dump/tokens-dump.cpp      \
 	    # $(FRONT_DIR)/src/nameTable/nameTableLog/nameTableLog.cpp           \
@@ -0,0 +1,137 @@
+#!/bin/bash
+
+# Runs stages binaries over a corpus of programms for profile-guided build (see pgo-* targets in Makefile).
+#
+# pgo.sh run    <stages> <runs> <ast dir> <programms...> - train pgo-gen binaries
+# pgo.sh report <stages> <runs> <ast dir> <programms...> - time debug, release and pgo binaries
+#
+# front-end is run as 'frontend <programm> <ast>', back-end as 'backend <ast> <code> -run' on the front-end output,
+# so both code generation and the SPU dispatch loop are trained and timed.
+# 'spu cmd/s' of back-end is SPU commands (the "spu cmd" profile counters of one COMPILER_PROFILE run, they are
+# the same for every build) over the whole back-end time, reading the AST and code generation included.
+
+MODE=$1
+STAGES=$2
+RUNS=$3
+AST_DIR=$4
+shift 4
+CORPUS=("$@")
+
+if [ ${#CORPUS[@]} -eq 0 ]; then
+    echo "pgo: corpus is empty" >&2
+    exit 1
+fi
+
+mkdir -p "$AST_DIR"
+
+#======= helpers ======================================
+
+# run_stage <stage> <binary>: one pass over the corpus
+run_stage()
+{
+    local stage=$1
+    local binary=$2
+
+    for programm in "${CORPUS[@]}"; do
+        local ast="$AST_DIR/$(basename "$programm" .s).ast"
+        local code="$AST_DIR/$(basename "$programm" .s).spu"
+
+        case $stage in
+            front) "$binary" "$programm" "$ast"  ;;
+            back)  "$binary" "$ast" "$code" -run ;;
+            *)     echo "pgo: undefined stage '$stage'" >&2; exit 1 ;;
+        esac > /dev/null 2>&1 || { echo "pgo: '$binary' failed on '$programm'" >&2; exit 1; }
+    done
+}
+
+# spu_commands <binary>: SPU commands executed by back-end over one pass of the corpus
+spu_commands()
+{
+    local binary=$1
+    local commands=0
+
+    for programm in "${CORPUS[@]}"; do
+        local ast="$AST_DIR/$(basename "$programm" .s).ast"
+        local code="$AST_DIR/$(basename "$programm" .s).spu"
+
+        # profile summary goes to stderr, the trace is not needed
+        local counted=$(COMPILER_PROFILE=/dev/null "$binary" "$ast" "$code" -run 2>&1 > /dev/null |
+                        awk '/^spu cmd\[/ { commands += $NF } END { print commands + 0 }')
+
+        commands=$((commands + counted))
+    done
+
+    echo $commands
+}
+
+# time_stage <stage> <binary>: ms for RUNS passes over the corpus
+time_stage()
+{
+    local start=$(date +%s%N)
+
+    for ((run = 0; run < RUNS; run++)); do
+        run_stage "$1" "$2"
+    done
+
+    local end=$(date +%s%N)
+    echo $(( (end - start) / 1000000 ))
+}
+
+#======= modes ========================================
+
+# back-end reads front-end output, so front-end is run first in both modes
+case $MODE in
+    run)
+        for stage in $STAGES; do
+            for ((run = 0; run < RUNS; run++)); do
+                run_stage "$stage" "./build/${stage}end-pgo-gen"
+            done
+        done
+        ;;
+
+    report)
+        corpus_bytes=$(cat "${CORPUS[@]}" | wc -c)
+        programms=$(( ${#CORPUS[@]} * RUNS ))
+
+        echo "corpus: ${#CORPUS[@]} programms, $corpus_bytes bytes, $RUNS runs"
+        echo
+        printf "%-6s %-8s %12s %16s %12s %14s\n" "stage" "build" "total, ms" "ms per programm" "KB/s" "spu cmd/s"
+
+        for stage in $STAGES; do
+            commands=0
+
+            # debug binary is the one 'make <stage>' builds
+            for build in debug release pgo; do
+                case $build in
+                    debug)   binary="./build/${stage}end"         ;;
+                    release) binary="./build/${stage}end-release" ;;
+                    pgo)     binary="./build/${stage}end-pgo"     ;;
+                esac
+
+                if [ ! -x "$binary" ]; then
+                    printf "%-6s %-8s %12s\n" "$stage" "$build" "no binary"
+                    continue
+                fi
+
+                ms=$(time_stage "$stage" "$binary") || exit 1
+                [ "$ms" -eq 0 ] && ms=1
+
+                # ASTs are written by the timed front-end runs, so commands are counted after them
+                [ "$stage" == "back" ] && [ "$commands" -eq 0 ] && commands=$(spu_commands "$binary")
+
+                awk -v stage="$stage" -v build="$build" -v ms="$ms" -v programms="$programms" -v bytes="$((corpus_bytes * RUNS))" \
+                    -v commands="$((commands * RUNS))" \
+                    'BEGIN {
+                        printf "%-6s %-8s %12d %16.3f %12.1f", stage, build, ms, ms / programms, bytes / 1024 / (ms / 1000)
+                        if (commands > 0) printf " %14.0f\n", commands / (ms / 1000)
+                        else              printf " %14s\n",   "-"
+                    }'
+            done
+        done
+        ;;
+
+    *)
+        echo "pgo: undefined mode '$MODE', expected 'run' or 'report'" >&2
+        exit 1
+        ;;
+esac
@@ -0,0 +1,70 @@
+#!/bin/bash
+
+# Compiles programms with the stages binaries, runs them on the processor and compares
+# their 'print' output with <programm>.out next to them (see 'test' target in Makefile).
+#
+# test.sh <build dir> <work dir> <programms...>
+#
+# every programm is run five times: 'frontend -> backend' checks the code generator on the tree as it is written,
+# 'frontend -> midleend -> backend' - on the optimized one, 'backend -ir' - the IR path on the written tree,
+# 'backend -cache' on the optimized tree twice - cold (empty cache) and warm (code of every function is taken from it).
+# ASTs are binary: the text format has no 'print'.
+
+BUILD_DIR=$1
+WORK_DIR=$2
+shift 2
+PROGRAMMS=("$@")
+
+if [ ${#PROGRAMMS[@]} -eq 0 ]; then
+    echo "test: no programms" >&2
+    exit 1
+fi
+
+mkdir -p "$WORK_DIR"
+
+#======= helpers ======================================
+
+# run_code <ast> <code> [backend options...]: numbers printed by the programm, one per line
+run_code()
+{
+    "$BUILD_DIR/backend" "$1" "$2" -run "${@:3}" 2>&1 | sed 's/\x1b\[[0-9;]*m//g' | grep -o 'Programm out: .*' | sed 's/Programm out: //'
+}
+
+# check <name> <expected> <got>
+check()
+{
+    if [ "$2" == "$3" ]; then
+        echo "test: $1 - ok"
+        return 0
+    fi
+
+    echo "test: $1 - FAILED"
+    diff <(echo "$2") <(echo "$3")
+    return 1
+}
+
+#======= tests ========================================
+
+failed=0
+
+for programm in "${PROGRAMMS[@]}"; do
+    name=$(basename "$programm" .s)
+    ast="$WORK_DIR/$name.bin"
+    optimized="$WORK_DIR/$name-opt.bin"
+    code="$WORK_DIR/$name.spu"
+    cache="$WORK_DIR/$name.cache"
+    expected=$(cat "${programm%.s}.out")
+
+    "$BUILD_DIR/frontend" "$programm" "$ast"       -format binary > /dev/null 2>&1 || { echo "test: $name - frontend failed"; failed=1; continue; }
+    "$BUILD_DIR/midleend" "$ast"      "$optimized" -format binary > /dev/null 2>&1 || { echo "test: $name - midleend failed"; failed=1; continue; }
+
+    check "$name"             "$expected" "$(run_code "$ast"       "$code")"                  || failed=1
+    check "$name -O"          "$expected" "$(run_code "$optimized" "$code")"                  || failed=1
+    check "$name -ir"         "$expected" "$(run_code "$ast"       "$code" -ir)"              || failed=1
+
+    rm -f "$cache"
+    check "$name -cache cold" "$expected" "$(run_code "$optimized" "$code" -cache "$cache")" || failed=1
+    check "$name -cache warm" "$expected" "$(run_code "$optimized" "$code" -cache "$cache")" || failed=1
+done
+
+exit $failed
@@ -0,0 +1,55 @@
+#ifndef CALL_GRAPH_HPP
+#define CALL_GRAPH_HPP
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#include <stdint.h>
+#include "tree/tree.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// Functions of the tree root list and their calls. Strongly connected components are found by Tarjan,
+// function is recursive, when its component has more than one function or it calls itself.
+// 'order' has callees before callers (components in reverse topological order), so passes over it go bottom-up.
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static const size_t CallGraphNoFunction = SIZE_MAX;
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct CallGraphFunction
+{
+    Node_t* def;            // def_function node
+    Node_t* name;           // its name node: left = args, right = body
+    size_t* callees;        // function indexes, one for every call in the body
+    size_t  callees_quant;
+    size_t  callees_capacity;
+    size_t  callers_quant;  // call sites of this function in the whole programm
+    bool    is_recursive;
+
+    size_t  scc_index;      // Tarjan state
+    size_t  scc_lowlink;
+    bool    scc_on_stack;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct CallGraph
+{
+    CallGraphFunction* functions;
+    size_t             functions_quant;
+    size_t             names_quant;
+    size_t*            by_name;         // NameId -> function index, CallGraphNoFunction - not a function
+    size_t*            order;           // function indexes, callees first
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void   CallGraphCtor       (CallGraph* graph, Tree_t* tree);
+void   CallGraphDtor       (CallGraph* graph);
+size_t GetCallGraphFunction(const CallGraph* graph, NameId name);
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#endif // CALL_GRAPH_HPP
@@ -0,0 +1,26 @@
+#ifndef CONST_FOLD_HPP
+#define CONST_FOLD_HPP
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#include <stdint.h>
+#include "tree/tree.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// Operations on int numbers become numbers, with the SPU meaning of every operation:
+// comparisons and 'and', 'or', 'not' give 0 / 1, '^' with exponent <= 0 gives 1.
+// Division by 0 and results out of int are left for the run time.
+// x + 0, 0 + x, x - 0, x * 1, 1 * x, x / 1 become x, nothing else is removed, so every call stays.
+// arena - arena of the tree, removed nodes go to NodeDtor() with it. Returns quantity of folded nodes.
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+size_t FoldConstants  (Node_t* node, const NodeArena* arena);
+
+// value of the operation on int operands with the same meaning, false - it is left for the run time
+bool   GetFoldedValue (Operation operation, int64_t left, int64_t right, bool is_unary, int64_t* value);
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#endif // CONST_FOLD_HPP
@@ -0,0 +1,32 @@
+#ifndef CSE_HPP
+#define CSE_HPP
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#include "tree/tree.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// Common subexpressions of a basic block (statements between control statements, 'if' condition included)
+// are computed once: 'int f.cse.N = E' before the first statement with E, every E becomes 'f.cse.N'.
+// Value numbering: numbers, names and operations are hash-consed into a DAG, a name value is
+// its variable with the count of its assignments so far, so an assignment kills all values built on the variable.
+// Only expressions without calls and assignments are taken; the biggest repeated expression is taken first.
+// An expression with '/' is not moved before a call of its statement, so a division by zero happens in its place.
+// First E is moved to the temp definition and other E nodes become names, so the tree has fewer nodes.
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct CseStats
+{
+    size_t temps;
+    size_t removed_nodes;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void EliminateCommonSubexpressions (Tree_t* tree, CseStats* stats);
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#endif // CSE_HPP
@@ -0,0 +1,19 @@
+#ifndef FRESH_NAME_HPP
+#define FRESH_NAME_HPP
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#include "tree/tree.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// Names made by passes: 'name.suffix', or 'name.suffix.k' when the programm already has such name.
+// '.' is not a part of names in the source programm, so these names never meet user names.
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+NameId NewFreshName (NameId name, const char* suffix);
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#endif // FRESH_NAME_HPP
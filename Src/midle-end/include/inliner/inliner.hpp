@@ -0,0 +1,71 @@
+#ifndef INLINER_HPP
+#define INLINER_HPP
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#include <stdio.h>
+#include "tree/tree.hpp"
+#include "call-graph/call-graph.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// Bodies of small non-recursive functions take place of their calls, functions are walked callees first,
+// so a callee is already inlined into, when its own calls are met.
+//   expression: callee body is only 'return E' - the call becomes E with arguments in place of parameters,
+//               every argument must be a number or variable, or an expression without calls and assignments
+//               used once in E (so nothing is evaluated twice or in other order);
+//   statements: call is the whole value of a statement ('int x = f(..)', 'x = f(..)', 'return f(..)', 'f(..)')
+//               and the callee has its only 'return' at the end - the statement becomes
+//               'int p.N = arg' for every parameter, callee statements and the statement with the returned value.
+// Callee variables are renamed to 'name.N' (N - inline site), so they never meet caller names.
+// Callee body must fit InlineCalleeMaxSize nodes, caller grows by InlineCallerMaxGrowth nodes at most.
+// arena - arena of the tree of the graph, replaced calls go to NodeDtor() with it.
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static const size_t InlineCalleeMaxSize   = 48;
+static const size_t InlineCallerMaxGrowth = 512;
+static const size_t InlineMaxArgs         = 16;
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+enum class InlineResult
+{
+    expression    ,
+    statements    ,
+    recursive     ,
+    callee_size   ,
+    caller_budget ,
+    body_shape    ,
+    call_context  ,
+    args_shape    ,
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct InlineSite
+{
+    NameId       caller;
+    NameId       callee;
+    InlineResult result;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct InlineReport
+{
+    InlineSite* sites;
+    size_t      sites_quant;
+    size_t      sites_capacity;
+    size_t      inlined_quant;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void InlineFunctions    (CallGraph* graph, NodeArena* arena, InlineReport* report);
+void InlineReportDtor   (InlineReport* report);
+void PrintInlineReport  (const InlineReport* report, FILE* stream);
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#endif // INLINER_HPP
@@ -0,0 +1,25 @@
+#ifndef IR_LOWER_HPP
+#define IR_LOWER_HPP
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#include "ir/ir.hpp"
+#include "tree/tree.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// Tree_t -> IR in SSA form. Statements are lowered into blocks as they go, a variable is not a memory cell:
+// its current value in a block is looked up through predecessors, phis are placed where values meet
+// (on-the-fly SSA construction: a block is sealed when all its predecessors are known,
+// phis of not sealed blocks get their operands on sealing). Phis may be trivial, ir-opt removes them.
+// 'and', 'or' are lowered to branches, 'not x' is 'x == 0', '-x' is '0 - x'.
+// 'return f(..)' in f assigns the arguments and jumps to the body, as the tree codegen does.
+// Code after 'return' goes to a block without predecessors.
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void LowerTree (const Tree_t* tree, IrModule* module);
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#endif // IR_LOWER_HPP
@@ -0,0 +1,39 @@
+#ifndef IR_OPT_HPP
+#define IR_OPT_HPP
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#include "ir/ir.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// Dataflow passes over IR functions:
+//   copy propagation - phis with one value (besides themselves) are replaced by it;
+//   sparse conditional constant propagation - values are unknown, constant or varying, only executable
+//     edges bring values to phis, so constants go through branches, which they decide;
+//     constant values become numbers, decided branches become jumps, unreachable blocks are removed;
+//   jump threading - block of one 'jmp' is skipped by its only predecessor;
+//   global value numbering - pure instruction is replaced by the same one in its dominator;
+//   dead code elimination - only values, which reach print, return, call, branch or '/' (it may trap), stay;
+//   sinking - arithmetic used only by phis goes to the end of its block, after reads of the phis it is for.
+// Constants are folded as const-fold does: no folding of int overflow and division by zero.
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct IrStats
+{
+    size_t copies;
+    size_t constants;
+    size_t branches;
+    size_t blocks;
+    size_t numbered;
+    size_t dead;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void OptimizeIr (IrModule* module, IrStats* stats);
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#endif // IR_OPT_HPP
@@ -0,0 +1,149 @@
+#ifndef IR_HPP
+#define IR_HPP
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdint.h>
+#include "tree/tree.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// Mid-level IR: every function is an array of instructions and an array of basic blocks,
+// instructions and blocks refer to each other by index. Every instruction defines at most one value,
+// the value is the index of its instruction (%N in the dump), it is assigned once (SSA).
+// Block has its phis (and undefs of variables read before assignment) apart from other instructions,
+// the last instruction of a block is its terminator: 'jmp', 'br' or 'ret'.
+// Operands of phi (one per predecessor, in order of IrBlock::preds) and arguments of call
+// are in IrFunction::operands from IrInstr::operands, so instructions have fixed size.
+// Block 0 is the entry: arguments, then 'jmp' to the body, which is also the target of tail self calls.
+// Values are int, as SPU words are.
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+typedef size_t IrValue;
+typedef size_t IrBlockId;
+
+static const IrValue   IrNoValue = SIZE_MAX;
+static const IrBlockId IrNoBlock = SIZE_MAX;
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+enum class IrOp
+{
+    nop    ,    // removed instruction
+    number ,    // number
+    arg    ,    // argument number 'number'
+    undef  ,    // variable read before assignment
+    phi    ,
+    add    ,
+    sub    ,
+    mul    ,
+    div    ,
+    pow    ,
+    lt     ,    // comparisons are 1 or 0
+    le     ,
+    gt     ,
+    ge     ,
+    eq     ,
+    ne     ,
+    call   ,
+    print  ,
+    ret    ,
+    jmp    ,    // target
+    br     ,    // a != 0 - target, else other
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct IrInstr
+{
+    IrOp      op;
+    int       number;
+    IrValue   a;
+    IrValue   b;
+    size_t    operands;         // first phi operand or call argument in IrFunction::operands
+    size_t    operands_quant;
+    NameId    callee;
+    NameId    name;             // variable of the value, NameNoId - temporary
+    IrBlockId block;
+    IrBlockId target;
+    IrBlockId other;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct IrList
+{
+    size_t  size;
+    size_t  capacity;
+    size_t* items;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct IrBlock
+{
+    IrList phis;
+    IrList instrs;
+    IrList preds;
+    bool   is_removed;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct IrFunction
+{
+    NameId    name;
+    size_t    args_quant;
+
+    IrInstr*  instrs;
+    size_t    instrs_quant;
+    size_t    instrs_capacity;
+
+    IrBlock*  blocks;
+    size_t    blocks_quant;
+    size_t    blocks_capacity;
+
+    IrList    operands;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct IrModule
+{
+    IrFunction* functions;
+    size_t      functions_quant;
+    size_t      functions_capacity;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void        IrModuleCtor     (IrModule* module);
+void        IrModuleDtor     (IrModule* module);
+IrFunction* NewIrFunction    (IrModule* module, NameId name, size_t args_quant);
+
+IrBlockId   NewIrBlock       (IrFunction* function);
+IrValue     NewIrInstr       (IrFunction* function, IrBlockId block, IrOp op);
+IrValue     NewIrPhi         (IrFunction* function, IrBlockId block, NameId name);
+void        AddIrPred        (IrFunction* function, IrBlockId block, IrBlockId pred);
+void        RemoveIrPred     (IrFunction* function, IrBlockId block, IrBlockId pred);
+size_t      GetIrPredIndex   (const IrFunction* function, IrBlockId block, IrBlockId pred);
+size_t      NewIrOperands    (IrFunction* function, size_t quant);
+IrValue*    GetIrOperands    (const IrFunction* function, const IrInstr* instr);
+IrInstr*    GetIrTerminator  (const IrFunction* function, IrBlockId block);
+
+void        IrListPush       (IrList* list, size_t item);
+void        IrListDtor       (IrList* list);
+
+bool        IsIrBinary       (IrOp op);
+bool        IsIrComparison   (IrOp op);
+
+void        PrintIr          (const IrModule* module, FILE* stream);
+
+// lowers the tree, optimizes IR and prints it to the file, IR passes stats go to report (nullptr - nowhere)
+void        DumpIr           (const Tree_t* tree, const char* path, FILE* report);
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#endif // IR_HPP
@@ -0,0 +1,40 @@
+#ifndef LOOP_OPT_HPP
+#define LOOP_OPT_HPP
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#include "tree/tree.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// Cycles are optimized from the outermost one in, everything goes before the cycle statement:
+//   invariants:  arithmetic without calls and assignments, whose variables are not assigned in the cycle
+//                (init, condition, step and body), become 'int f.licm.N = E' before the cycle;
+//                '/' by not a nonzero number and '^' by not a number are left, the body may never run;
+//   powers:      x ^ k with variable or number x and number k <= LoopPowerMaxChain becomes x * x * ..,
+//                everywhere in the programm, SPU has no power command and loops for it;
+//   inductions:  i assigned only by 'i = i + c' once per iteration (the 'for' step or a statement of the
+//                'while' body), its products i * k (k - number or invariant variable) met LoopReduceMinUses
+//                times at least become 'f.sr.N', it starts as i * k and grows by c * k next to 'i' step.
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static const int    LoopPowerMaxChain = 4;
+static const size_t LoopReduceMinUses = 2;
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct LoopStats
+{
+    size_t hoisted;
+    size_t powers;
+    size_t reduced;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void OptimizeLoops (Tree_t* tree, LoopStats* stats);
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#endif // LOOP_OPT_HPP
@@ -0,0 +1,36 @@
+#ifndef OPTIMIZE_HPP
+#define OPTIMIZE_HPP
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#include <stdio.h>
+#include "tree/tree.hpp"
+#include "unroll/unroll.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// Middle-end passes over the whole programm: recursion to accumulator form (tail-recursion/tail-recursion.hpp),
+// compile time calls of pure functions (pure-eval/pure-eval.hpp), inlining (inliner/inliner.hpp), loop invariants and inductions (loop-opt/loop-opt.hpp),
+// unrolling (unroll/unroll.hpp), then constant folding (const-fold/const-fold.hpp), which meets numbers brought by inlined arguments
+// and by induction starts, and common subexpressions (cse/cse.hpp) of what is left.
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct OptimizeOptions
+{
+    UnrollConfig unroll;
+    size_t       eval_budget;   // nodes one compile time call may run, 0 - pure calls are not evaluated
+    FILE*        report;        // summaries of the passes and the inline report, nullptr - no report
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static const OptimizeOptions OptimizeDefaultOptions = {UnrollDefaultConfig, 100000, nullptr};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void OptimizeTree (Tree_t* tree, const OptimizeOptions* options);
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#endif // OPTIMIZE_HPP
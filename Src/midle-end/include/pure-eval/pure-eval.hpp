@@ -0,0 +1,32 @@
+#ifndef PURE_EVAL_HPP
+#define PURE_EVAL_HPP
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#include "tree/tree.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// Function is pure, when its body has no 'print' and it calls only pure functions (there are no globals,
+// so a function changes nothing but its own variables). A call of a pure function with arguments of numbers
+// and operations only is run at compile time by a tree interpreter with the SPU meaning of every node
+// and becomes the number it returns. Arguments are folded first, so 'f(g(3))' is folded too.
+// Interpreter gives up (the call stays) on a variable read before assignment, a double number,
+// division by 0, a result out of int, wrong argument quantity, more than budget nodes run or too deep recursion.
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct EvalStats
+{
+    size_t pure;            // pure functions
+    size_t evaluated;       // calls replaced by numbers
+    size_t gave_up;         // calls of pure functions with number arguments left for the run time
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void EvaluatePureCalls (Tree_t* tree, size_t budget, EvalStats* stats);
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#endif // PURE_EVAL_HPP
@@ -0,0 +1,27 @@
+#ifndef TAIL_RECURSION_HPP
+#define TAIL_RECURSION_HPP
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#include "tree/tree.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// Recursion with the work after the call, 'return A + f(..)' or 'return A * f(..)' in int f, becomes a tail call
+// of 'f.acc' with one more parameter - accumulator of what was left to do:
+//   return A op f(args) -> return f.acc(args, acc op A)
+//   return f(args)      -> return f.acc(args, acc)
+//   return E            -> return acc op E
+// and f itself becomes 'return f.acc(params, 0 or 1)'. Code generator turns tail calls of f.acc into jumps,
+// so such recursion needs no stack. int '+' and '*' wrap around, so changed order of operations gives the same value.
+// Function is left as is, when A has calls or assignments (they would run in other order),
+// when '+' and '*' are mixed, or when f is called anywhere else in its body.
+// Returns quantity of rewritten functions.
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+size_t AccumulateTailRecursion (Tree_t* tree);
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#endif // TAIL_RECURSION_HPP
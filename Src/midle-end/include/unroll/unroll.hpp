@@ -0,0 +1,46 @@
+#ifndef UNROLL_HPP
+#define UNROLL_HPP
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#include "tree/tree.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// Cycles 'i cmp bound' ('<', '<=' with step c > 0, '>', '>=' with c < 0), where i is changed only by
+// 'i = i + c' (the 'for' step or the last statement of the 'while' body) and bound is a number or a variable
+// not assigned in the cycle. Inner cycles are unrolled first.
+//   full:    'for' from number to number with at most full_trips iterations becomes its init, body copies
+//            with i replaced by its value on every iteration, and 'i = last value';
+//   partial: cycle runs factor bodies per check while 'i + (factor - 1) * c cmp bound',
+//            the rest iterations run in the remainder 'while (i cmp bound)' after it.
+// The cycle may grow by budget nodes, factor is decreased to fit it.
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct UnrollConfig
+{
+    size_t factor;          // bodies in one partially unrolled iteration, < 2 - cycles are not unrolled
+    size_t full_trips;
+    size_t budget;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static const UnrollConfig UnrollDefaultConfig = {4, 8, 256};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct UnrollStats
+{
+    size_t full;
+    size_t partial;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void UnrollLoops (Tree_t* tree, const UnrollConfig* config, UnrollStats* stats);
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+#endif // UNROLL_HPP
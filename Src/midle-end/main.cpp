@@ -0,0 +1,90 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include "tree/tree.hpp"
+#include "lib/lib.hpp"
+#include "optimize/optimize.hpp"
+#include "ir/ir.hpp"
+#include "tree/read-write-tree/read-tree/read-tree.hpp"
+#include "tree/read-write-tree/write-tree/write-tree.hpp"
+#include "name-table/interner/interner.hpp"
+
+#ifdef _DEBUG
+#include "tree/tree-dump/tree-dump.hpp"
+#include "log/log.hpp"
+#endif // _DEBUG
+
+// midleend [ast] [optimized ast] [-format text|binary] [-inline-report] [-unroll <factor>] [-unroll-budget <nodes>] [-eval-budget <nodes>] [-dump-ir <file>]
+// - default paths are used for missing arguments, AST of any format is read, '-format' sets the optimized AST format
+// (text by default), '-inline-report' prints inlined call sites and folded nodes to stdout,
+// '-unroll' sets the unrolling factor (0 - no unrolling), '-unroll-budget' - nodes a cycle may grow by,
+// '-eval-budget' - nodes a compile time call of a pure function may run (0 - no compile time calls),
+// '-dump-ir' writes optimized IR of the optimized tree to the file
+
+static size_t GetSizeValue (const char* value);
+
+int main(int argc, const char* argv[])
+{
+    ON_DEBUG(
+    COLOR_PRINT(GREEN, "\n\nMIDLEEND START\n\n");
+    LOG_OPEN();
+    )
+
+    const char*     input   = (argc > 1) ? argv[1] : "tree/tree.ast";
+    const char*     output  = (argc > 2) ? argv[2] : "tree/tree.ast";
+    const char*     ir_dump = nullptr;
+    AstFormat       format  = AstFormat::text;
+    OptimizeOptions options = OptimizeDefaultOptions;
+
+    for (int argv_i = 3; argv_i < argc; argv_i++)
+    {
+        if      (strcmp(argv[argv_i], "-format")        == 0 && argv_i + 1 < argc) format                = GetAstFormat(argv[++argv_i]);
+        else if (strcmp(argv[argv_i], "-inline-report") == 0)                   options.report        = stdout;
+        else if (strcmp(argv[argv_i], "-unroll")        == 0 && argv_i + 1 < argc) options.unroll.factor = GetSizeValue(argv[++argv_i]);
+        else if (strcmp(argv[argv_i], "-unroll-budget") == 0 && argv_i + 1 < argc) options.unroll.budget = GetSizeValue(argv[++argv_i]);
+        else if (strcmp(argv[argv_i], "-eval-budget")   == 0 && argv_i + 1 < argc) options.eval_budget   = GetSizeValue(argv[++argv_i]);
+        else if (strcmp(argv[argv_i], "-dump-ir")       == 0 && argv_i + 1 < argc) ir_dump               = argv[++argv_i];
+        else
+            EXIT(EXIT_FAILURE, "unknown option '%s'.\nusage: %s [ast] [optimized ast] [-format text|binary] [-inline-report] [-unroll <factor>] [-unroll-budget <nodes>] [-eval-budget <nodes>] [-dump-ir <file>]", argv[argv_i], argv[0]);
+    }
+
+    Tree_t tree = {};
+    TreeCtor(&tree);
+
+    ReadTree(&tree, input, GetAstFileFormat(input));
+
+    OptimizeTree(&tree, &options);
+
+    ON_DEBUG(
+    TREE_GRAPHIC_DUMP(&tree);
+    )
+
+    PrintTree(&tree, output, format);
+
+    if (ir_dump)
+        DumpIr(&tree, ir_dump, options.report);
+
+    TreeDtor(&tree);
+    InternerDtor();
+
+    ON_DEBUG(
+    COLOR_PRINT(GREEN, "\n\nMIDLEEND END\n\n");
+    LOG_CLOSE();
+    )
+
+    return EXIT_SUCCESS;
+}
+
+static size_t GetSizeValue(const char* value)
+{
+    assert(value);
+
+    char*         end    = nullptr;
+    unsigned long number = strtoul(value, &end, 10);
+
+    if (end == value || *end != '\0' || value[0] == '-')
+        EXIT(EXIT_FAILURE, "'%s' is not a non-negative number", value);
+
+    return number;
+}
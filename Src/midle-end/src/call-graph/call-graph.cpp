@@ -0,0 +1,276 @@
+#include <stdlib.h>
+#include <assert.h>
+#include "call-graph/call-graph.hpp"
+#include "lib/lib.hpp"
+#include "name-table/interner/interner.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static const size_t CallGraphDefaultCallees = 4;
+static const size_t CallGraphNoScc          = SIZE_MAX;
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct SccState
+{
+    size_t  index;
+    size_t* stack;
+    size_t  stack_size;
+    size_t  order_size;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static size_t CountFunctions     (const Node_t* node);
+static void   AddFunctions       (CallGraph* graph, Node_t* node);
+static void   AddCalls           (CallGraph* graph, size_t caller, const Node_t* node);
+static void   AddCallee          (CallGraphFunction* function, size_t callee);
+static void   FindScc            (CallGraph* graph, SccState* state, size_t function_i);
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void CallGraphCtor(CallGraph* graph, Tree_t* tree)
+{
+    assert(graph);
+    assert(tree);
+
+    *graph = {};
+
+    graph->functions_quant = CountFunctions(tree->root);
+    graph->names_quant     = GetInternedNamesQuant();
+    graph->functions       = (CallGraphFunction*) calloc(graph->functions_quant + 1, sizeof(*graph->functions));
+    graph->by_name         = (size_t*)            calloc(graph->names_quant     + 1, sizeof(*graph->by_name));
+    graph->order           = (size_t*)            calloc(graph->functions_quant + 1, sizeof(*graph->order));
+
+    if (!graph->functions || !graph->by_name || !graph->order)
+        EXIT(EXIT_FAILURE, "failed calloc memory for call graph.");
+
+    for (size_t i = 0; i <= graph->names_quant; i++)
+        graph->by_name[i] = CallGraphNoFunction;
+
+    size_t functions_quant = graph->functions_quant;
+    graph->functions_quant = 0;
+    AddFunctions(graph, tree->root);
+    assert(graph->functions_quant == functions_quant);
+
+    for (size_t i = 0; i < graph->functions_quant; i++)
+        AddCalls(graph, i, graph->functions[i].name->right);
+
+    SccState state = {};
+    state.stack    = (size_t*) calloc(graph->functions_quant + 1, sizeof(*state.stack));
+    if (!state.stack)
+        EXIT(EXIT_FAILURE, "failed calloc memory for call graph.");
+
+    for (size_t i = 0; i < graph->functions_quant; i++)
+        graph->functions[i].scc_index = CallGraphNoScc;
+
+    for (size_t i = 0; i < graph->functions_quant; i++)
+    {
+        if (graph->functions[i].scc_index == CallGraphNoScc)
+            FindScc(graph, &state, i);
+    }
+
+    assert(state.order_size == graph->functions_quant);
+
+    FREE(state.stack);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void CallGraphDtor(CallGraph* graph)
+{
+    assert(graph);
+
+    for (size_t i = 0; i < graph->functions_quant; i++)
+    {
+        FREE(graph->functions[i].callees);
+    }
+
+    FREE(graph->functions);
+    FREE(graph->by_name);
+    FREE(graph->order);
+
+    *graph = {};
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+size_t GetCallGraphFunction(const CallGraph* graph, NameId name)
+{
+    assert(graph);
+
+    if (name == NameNoId || name > graph->names_quant)
+        return CallGraphNoFunction;
+
+    return graph->by_name[name];
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static size_t CountFunctions(const Node_t* node)
+{
+    if (!node) return 0;
+
+    if (node->type == NodeArgType::connect)
+        return CountFunctions(node->left) + CountFunctions(node->right);
+
+    return 1;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void AddFunctions(CallGraph* graph, Node_t* node)
+{
+    assert(graph);
+
+    if (!node) return;
+
+    if (node->type == NodeArgType::connect)
+    {
+        AddFunctions(graph, node->left);
+        AddFunctions(graph, node->right);
+        return;
+    }
+
+    if (node->type != NodeArgType::initialisation || node->data.init != Initialisation::def_function)
+        EXIT(EXIT_FAILURE, "here must be def func node");
+
+    Node_t* name_node = node->left->left;
+    NameId  id        = name_node->data.name.id;
+
+    assert(id != NameNoId);
+    assert(id <= graph->names_quant);
+
+    if (graph->by_name[id] != CallGraphNoFunction)
+    {
+        NameInfo name = GetInternedName(id);
+        EXIT(EXIT_FAILURE, "function '%.*s' is defined twice", (int) name.len, name.name);
+    }
+
+    CallGraphFunction* function = &graph->functions[graph->functions_quant];
+
+    function->def  = node;
+    function->name = name_node;
+
+    graph->by_name[id] = graph->functions_quant;
+    graph->functions_quant++;
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void AddCalls(CallGraph* graph, size_t caller, const Node_t* node)
+{
+    assert(graph);
+
+    if (!node) return;
+
+    if (node->type == NodeArgType::initialisation && node->data.init == Initialisation::call_function)
+    {
+        size_t callee = GetCallGraphFunction(graph, node->left->data.name.id);
+
+        if (callee == CallGraphNoFunction)
+        {
+            NameInfo name = node->left->data.name.name;
+            EXIT(EXIT_FAILURE, "call of undefined function '%.*s'", (int) name.len, name.name);
+        }
+
+        AddCallee(&graph->functions[caller], callee);
+        graph->functions[callee].callers_quant++;
+
+        return AddCalls(graph, caller, node->left->left);
+    }
+
+    AddCalls(graph, caller, node->left);
+    AddCalls(graph, caller, node->right);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void AddCallee(CallGraphFunction* function, size_t callee)
+{
+    assert(function);
+
+    if (function->callees_quant == function->callees_capacity)
+    {
+        function->callees_capacity = (function->callees_capacity == 0) ? CallGraphDefaultCallees : 2 * function->callees_capacity;
+        function->callees          = (size_t*) realloc(function->callees, function->callees_capacity * sizeof(*function->callees));
+        if (!function->callees)
+            EXIT(EXIT_FAILURE, "failed realloc memory for call graph callees.");
+    }
+
+    function->callees[function->callees_quant] = callee;
+    function->callees_quant++;
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// Tarjan: a component is complete, when its root is met back on the way up, it goes to 'order' at once,
+// all components it calls are already there
+static void FindScc(CallGraph* graph, SccState* state, size_t function_i)
+{
+    assert(graph);
+    assert(state);
+
+    CallGraphFunction* function = &graph->functions[function_i];
+
+    function->scc_index    = state->index;
+    function->scc_lowlink  = state->index;
+    function->scc_on_stack = true;
+    state->index++;
+
+    state->stack[state->stack_size++] = function_i;
+
+    for (size_t i = 0; i < function->callees_quant; i++)
+    {
+        size_t             callee_i = function->callees[i];
+        CallGraphFunction* callee   = &graph->functions[callee_i];
+
+        if (callee_i == function_i)
+            function->is_recursive = true;
+
+        if (callee->scc_index == CallGraphNoScc)
+        {
+            FindScc(graph, state, callee_i);
+
+            if (callee->scc_lowlink < function->scc_lowlink)
+                function->scc_lowlink = callee->scc_lowlink;
+        }
+
+        else if (callee->scc_on_stack && callee->scc_index < function->scc_lowlink)
+            function->scc_lowlink = callee->scc_index;
+    }
+
+    if (function->scc_lowlink != function->scc_index)
+        return;
+
+    size_t scc_begin = state->order_size;
+    size_t member_i  = 0;
+
+    do
+    {
+        member_i = state->stack[--state->stack_size];
+        graph->functions[member_i].scc_on_stack = false;
+        graph->order[state->order_size++] = member_i;
+    }
+    while (member_i != function_i);
+
+    if (state->order_size - scc_begin > 1)
+    {
+        for (size_t i = scc_begin; i < state->order_size; i++)
+            graph->functions[graph->order[i]].is_recursive = true;
+    }
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
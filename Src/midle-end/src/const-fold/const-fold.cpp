@@ -0,0 +1,241 @@
+#include <stdint.h>
+#include <limits.h>
+#include <assert.h>
+#include "const-fold/const-fold.hpp"
+#include "lib/lib.hpp"
+#include "profile/profile.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static bool IsIntNumber     (const Node_t* node);
+static bool IsIntNumberEq   (const Node_t* node, int value);
+static bool FoldOperation   (Node_t* node, const NodeArena* arena);
+static bool FoldIdentity    (Node_t* node, const NodeArena* arena);
+static void SetIntNumber    (Node_t* node, int value, const NodeArena* arena);
+static void ReplaceByChild  (Node_t* node, Node_t* child, Node_t* other, const NodeArena* arena);
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+size_t FoldConstants(Node_t* node, const NodeArena* arena)
+{
+    if (!node) return 0;
+
+    size_t folded = FoldConstants(node->left, arena) + FoldConstants(node->right, arena);
+
+    if (node->type != NodeArgType::operation)
+        return folded;
+
+    if (FoldOperation(node, arena) || FoldIdentity(node, arena))
+    {
+        PROFILE_COUNT("folded constants", 1);
+        folded++;
+    }
+
+    return folded;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static bool IsIntNumber(const Node_t* node)
+{
+    return node && node->type == NodeArgType::number && node->data.num.type == Type::int_type;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static bool IsIntNumberEq(const Node_t* node, int value)
+{
+    return IsIntNumber(node) && node->data.num.value.int_val == value;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static bool FoldOperation(Node_t* node, const NodeArena* arena)
+{
+    assert(node);
+
+    Operation operation = node->data.oper;
+
+    // unary minus is 'minus' node without right child, 'not' has its operand in left
+    bool is_unary = (operation == Operation::bool_not) || (operation == Operation::minus && !node->right);
+
+    if (!IsIntNumber(node->left) || (!is_unary && !IsIntNumber(node->right)))
+        return false;
+
+    int64_t left  = node->left->data.num.value.int_val;
+    int64_t right = is_unary ? 0 : node->right->data.num.value.int_val;
+    int64_t value = 0;
+
+    if (!GetFoldedValue(operation, left, right, is_unary, &value))
+        return false;
+
+    if (value < INT_MIN || value > INT_MAX)
+        return false;
+
+    SetIntNumber(node, (int) value, arena);
+
+    return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static bool FoldIdentity(Node_t* node, const NodeArena* arena)
+{
+    assert(node);
+
+    Operation operation = node->data.oper;
+
+    if (!node->left || !node->right)
+        return false;
+
+    switch (operation)
+    {
+        case Operation::plus:
+        {
+            if (IsIntNumberEq(node->right, 0)) { ReplaceByChild(node, node->left,  node->right, arena); return true; }
+            if (IsIntNumberEq(node->left,  0)) { ReplaceByChild(node, node->right, node->left,  arena); return true; }
+            return false;
+        }
+
+        case Operation::mul:
+        {
+            if (IsIntNumberEq(node->right, 1)) { ReplaceByChild(node, node->left,  node->right, arena); return true; }
+            if (IsIntNumberEq(node->left,  1)) { ReplaceByChild(node, node->right, node->left,  arena); return true; }
+            return false;
+        }
+
+        case Operation::minus:
+        case Operation::dive:
+        {
+            int neutral = (operation == Operation::minus) ? 0 : 1;
+
+            if (IsIntNumberEq(node->right, neutral)) { ReplaceByChild(node, node->left, node->right, arena); return true; }
+            return false;
+        }
+
+        case Operation::power:
+        case Operation::assign:
+        case Operation::greater:
+        case Operation::greater_or_equal:
+        case Operation::less:
+        case Operation::less_or_equal:
+        case Operation::equal:
+        case Operation::not_equal:
+        case Operation::bool_and:
+        case Operation::bool_or:
+        case Operation::bool_not:
+        case Operation::plus_equal:
+        case Operation::minus_equal:
+        case Operation::mul_equal:
+        case Operation::div_equal:
+        case Operation::plus_plus:
+        case Operation::minus_minus:
+        case Operation::undefined_operation:
+        default: return false;
+    }
+
+    return false;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// operands are int, int64_t has room for every result except '^', it is checked on every step
+bool GetFoldedValue(Operation operation, int64_t left, int64_t right, bool is_unary, int64_t* value)
+{
+    assert(value);
+
+    switch (operation)
+    {
+        case Operation::plus:             *value = left + right;                     return true;
+        case Operation::minus:            *value = is_unary ? -left : left - right;  return true;
+        case Operation::mul:              *value = left * right;                     return true;
+        case Operation::greater:          *value = (left >  right);                  return true;
+        case Operation::greater_or_equal: *value = (left >= right);                  return true;
+        case Operation::less:             *value = (left <  right);                  return true;
+        case Operation::less_or_equal:    *value = (left <= right);                  return true;
+        case Operation::equal:            *value = (left == right);                  return true;
+        case Operation::not_equal:        *value = (left != right);                  return true;
+        case Operation::bool_and:         *value = (left != 0 && right != 0);        return true;
+        case Operation::bool_or:          *value = (left != 0 || right != 0);        return true;
+        case Operation::bool_not:         *value = (left == 0);                      return true;
+
+        case Operation::dive:
+        {
+            if (right == 0)
+                return false;
+
+            *value = left / right;
+            return true;
+        }
+
+        case Operation::power:
+        {
+            // 0, 1 and -1 never leave int, so the exponent is not run through
+            if (left >= -1 && left <= 1 && right > 0)
+            {
+                *value = (left == -1 && right % 2 == 0) ? 1 : left;
+                return true;
+            }
+
+            *value = 1;
+
+            for (int64_t i = 0; i < right; i++)
+            {
+                *value *= left;
+
+                if (*value < INT_MIN || *value > INT_MAX)
+                    return false;
+            }
+
+            return true;
+        }
+
+        case Operation::assign:
+        case Operation::plus_equal:
+        case Operation::minus_equal:
+        case Operation::mul_equal:
+        case Operation::div_equal:
+        case Operation::plus_plus:
+        case Operation::minus_minus:
+        case Operation::undefined_operation:
+        default: return false;
+    }
+
+    return false;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void SetIntNumber(Node_t* node, int value, const NodeArena* arena)
+{
+    assert(node);
+
+    TREE_ASSERT(NodeAndUnderTreeDtor(node->left,  arena));
+    TREE_ASSERT(NodeAndUnderTreeDtor(node->right, arena));
+
+    Number number        = {};
+    number.type          = Type::int_type;
+    number.value.int_val = value;
+
+    _SET_NUM(node, number);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// node takes place of its operation: parent keeps its pointer, so the child is moved into the node
+static void ReplaceByChild(Node_t* node, Node_t* child, Node_t* other, const NodeArena* arena)
+{
+    assert(node);
+    assert(child);
+
+    TREE_ASSERT(NodeAndUnderTreeDtor(other, arena));
+
+    TREE_ASSERT(SetNode(node, child->type, child->data, child->left, child->right));
+    TREE_ASSERT(NodeDtor(child, arena));
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,934 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <assert.h>
+#include "cse/cse.hpp"
+#include "fresh-name/fresh-name.hpp"
+#include "lib/lib.hpp"
+#include "profile/profile.hpp"
+#include "name-table/hash.hpp"
+#include "name-table/interner/interner.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// value of a DAG node: kind is the node type and operation / number type,
+// a, b are operands values (operation), value and version (name) or number bits
+struct CseKey
+{
+    uint64_t kind;
+    uint64_t a;
+    uint64_t b;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct CseValue
+{
+    CseKey key;
+    size_t slot;            // place in the hash table, values of size 0 are not in it
+    size_t first;           // first occurrence of the value, CseNoOccurrence - none
+    size_t last;
+    size_t size;            // nodes in the expression
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// operation node of the block with a value of pure expression
+struct CseOccurrence
+{
+    Node_t* node;
+    size_t  statement;
+    size_t  value;
+    size_t  next;           // next occurrence of the same value
+    size_t  left;           // occurrences of the operands, CseNoOccurrence - not an operation
+    size_t  right;
+    bool    can_trap;       // has '/' by not a nonzero number
+    bool    is_replaced;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct CseCandidate
+{
+    size_t value;
+    size_t size;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct CseStatement
+{
+    Node_t** slot;
+    bool     is_ordered;    // no calls and lazy 'and' / 'or': every part of it is evaluated, left to right
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct Cse
+{
+    NameId           function;
+    NodeArena*       arena;           // arena of the tree, new nodes go to it
+
+    size_t*          table;           // value numbers, 0 - empty slot
+    size_t           table_capacity;
+
+    CseValue*        values;          // values[0] is not used
+    size_t           values_quant;
+    size_t           values_capacity;
+
+    CseOccurrence*   occurrences;
+    size_t           occurrences_quant;
+    size_t           occurrences_capacity;
+
+    CseStatement*    statements;
+    size_t           statements_quant;
+    size_t           statements_capacity;
+
+    size_t*          versions;        // assignments quantity of every name id
+    size_t           versions_capacity;
+
+    CseCandidate*    candidates;
+    size_t           candidates_capacity;
+
+    CseStats*        stats;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static const size_t CseNoOccurrence     = SIZE_MAX;
+static const size_t CseDefaultCapacity  = 64;
+static const size_t CseMinSize          = 3;    // smaller expressions are not worth a variable
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void    CseCtor                 (Cse* cse, CseStats* stats, NodeArena* arena);
+static void    CseDtor                 (Cse* cse);
+
+static void    EliminateInFunctions    (Cse* cse, Node_t* node);
+static void    EliminateInBody         (Cse* cse, Node_t** slot);
+static void    AddStatement            (Cse* cse, Node_t** slot);
+static void    FlushBlock              (Cse* cse);
+
+static void    NumberStatement         (Cse* cse, size_t statement);
+static size_t  NumberExpression        (Cse* cse, Node_t* node, size_t statement, size_t* occurrence);
+static size_t  NumberOperation         (Cse* cse, Node_t* node, size_t statement, size_t* occurrence);
+static void    NumberArgs              (Cse* cse, Node_t* node, size_t statement);
+static size_t  GetValue                (Cse* cse, const CseKey* key, size_t size);
+static size_t  NewUniqueValue          (Cse* cse);
+static void    AddOccurrence           (Cse* cse, CseOccurrence* occurrence);
+static size_t  GetVersion              (const Cse* cse, NameId id);
+static void    BumpVersion             (Cse* cse, NameId id);
+
+static void    EliminateValues         (Cse* cse);
+static int     CompareCandidates       (const void* first, const void* second);
+static size_t  GetAliveFirst           (const Cse* cse, size_t value, size_t* alive);
+static void    ReplaceValue            (Cse* cse, size_t first);
+static void    MarkReplaced            (Cse* cse, size_t occurrence);
+
+static bool    HasSideEffect           (const Node_t* node);
+static bool    HasInnerSideEffect      (const Node_t* statement);
+static bool    IsOrdered               (const Node_t* node);
+static bool    IsNonzeroNumber         (const Node_t* node);
+static size_t  GetTreeSize             (const Node_t* node);
+static void    SetNameNode             (Node_t* node, NameId id);
+static Node_t* NewNameNode             (NodeArena* arena, NameId id);
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void EliminateCommonSubexpressions(Tree_t* tree, CseStats* stats)
+{
+    assert(tree);
+    assert(stats);
+
+    PROFILE_SCOPE("EliminateCommonSubexpressions");
+
+    *stats = {};
+
+    Cse cse = {};
+    CseCtor(&cse, stats, tree->arena);
+
+    EliminateInFunctions(&cse, tree->root);
+
+    CseDtor(&cse);
+
+    PROFILE_COUNT("cse temps",         stats->temps);
+    PROFILE_COUNT("cse removed nodes", stats->removed_nodes);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void CseCtor(Cse* cse, CseStats* stats, NodeArena* arena)
+{
+    assert(cse);
+    assert(stats);
+
+    cse->stats = stats;
+    cse->arena = arena;
+
+    cse->table_capacity       = CseDefaultCapacity;
+    cse->values_capacity      = CseDefaultCapacity;
+    cse->occurrences_capacity = CseDefaultCapacity;
+    cse->statements_capacity  = CseDefaultCapacity;
+    cse->versions_capacity    = GetInternedNamesQuant() + 1;
+    cse->candidates_capacity  = CseDefaultCapacity;
+
+    cse->table       = (size_t*)        calloc(cse->table_capacity,       sizeof(size_t));
+    cse->values      = (CseValue*)      calloc(cse->values_capacity,      sizeof(CseValue));
+    cse->occurrences = (CseOccurrence*) calloc(cse->occurrences_capacity, sizeof(CseOccurrence));
+    cse->statements  = (CseStatement*)  calloc(cse->statements_capacity,  sizeof(CseStatement));
+    cse->versions    = (size_t*)        calloc(cse->versions_capacity,    sizeof(size_t));
+    cse->candidates  = (CseCandidate*)  calloc(cse->candidates_capacity,  sizeof(CseCandidate));
+
+    if (!cse->table || !cse->values || !cse->occurrences || !cse->statements || !cse->versions || !cse->candidates)
+        EXIT(EXIT_FAILURE, "failed calloc memory for cse.");
+
+    cse->values_quant = 1;
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void CseDtor(Cse* cse)
+{
+    assert(cse);
+
+    FREE(cse->table);
+    FREE(cse->values);
+    FREE(cse->occurrences);
+    FREE(cse->statements);
+    FREE(cse->versions);
+    FREE(cse->candidates);
+
+    *cse = {};
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void EliminateInFunctions(Cse* cse, Node_t* node)
+{
+    assert(cse);
+
+    if (!node) return;
+
+    if (node->type == NodeArgType::connect)
+    {
+        EliminateInFunctions(cse, node->left);
+        EliminateInFunctions(cse, node->right);
+        return;
+    }
+
+    if (node->type != NodeArgType::initialisation || node->data.init != Initialisation::def_function)
+        EXIT(EXIT_FAILURE, "here must be def func node");
+
+    Node_t* name_node = node->left->left;
+
+    cse->function = name_node->data.name.id;
+
+    EliminateInBody(cse, &name_node->right);
+    FlushBlock     (cse);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// straight statements go to the current block, control statements end it, their bodies are new blocks
+static void EliminateInBody(Cse* cse, Node_t** slot)
+{
+    assert(cse);
+    assert(slot);
+
+    Node_t* node = *slot;
+
+    if (!node) return;
+
+    if (node->type == NodeArgType::connect)
+    {
+        EliminateInBody(cse, &node->left);
+        EliminateInBody(cse, &node->right);
+        return;
+    }
+
+    // 'if' condition is evaluated every time the statement is met, so it is the last part of the block
+    if (node->type == NodeArgType::condition && node->data.condition == Condition::if_t && !HasSideEffect(node->left))
+        AddStatement(cse, slot);
+
+    if (node->type == NodeArgType::condition || node->type == NodeArgType::cycle)
+    {
+        FlushBlock     (cse);
+        EliminateInBody(cse, &node->right);
+        FlushBlock     (cse);
+        return;
+    }
+
+    if (HasInnerSideEffect(node))
+    {
+        FlushBlock(cse);
+        return;
+    }
+
+    AddStatement(cse, slot);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void AddStatement(Cse* cse, Node_t** slot)
+{
+    assert(cse);
+    assert(slot);
+
+    if (cse->statements_quant == cse->statements_capacity)
+    {
+        cse->statements_capacity *= 2;
+        cse->statements = (CseStatement*) realloc(cse->statements, cse->statements_capacity * sizeof(CseStatement));
+
+        if (!cse->statements)
+            EXIT(EXIT_FAILURE, "failed realloc memory for cse statements.");
+    }
+
+    CseStatement* statement = &cse->statements[cse->statements_quant++];
+
+    statement->slot       = slot;
+    statement->is_ordered = IsOrdered(*slot);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void FlushBlock(Cse* cse)
+{
+    assert(cse);
+
+    for (size_t i = 0; i < cse->statements_quant; i++)
+        NumberStatement(cse, i);
+
+    EliminateValues(cse);
+
+    for (size_t i = 1; i < cse->values_quant; i++)
+    {
+        if (cse->values[i].size != 0)
+            cse->table[cse->values[i].slot] = 0;
+    }
+
+    cse->values_quant      = 1;
+    cse->occurrences_quant = 0;
+    cse->statements_quant  = 0;
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void NumberStatement(Cse* cse, size_t statement)
+{
+    assert(cse);
+
+    Node_t*     node       = *cse->statements[statement].slot;
+    size_t      occurrence = CseNoOccurrence;
+    NodeArgType type       = node->type;
+
+    if (type == NodeArgType::condition)
+    {
+        NumberExpression(cse, node->left, statement, &occurrence);
+        return;
+    }
+
+    if (type == NodeArgType::initialisation && node->data.init == Initialisation::def_variable)
+    {
+        NumberExpression(cse, node->right, statement, &occurrence);
+        BumpVersion     (cse, node->left->left->data.name.id);
+        return;
+    }
+
+    if (type == NodeArgType::initialisation && node->data.init == Initialisation::assign_variable)
+    {
+        NumberExpression(cse, node->right, statement, &occurrence);
+        BumpVersion     (cse, node->left->data.name.id);
+        return;
+    }
+
+    if (type == NodeArgType::attribute && node->data.attribute == FunctionAttribute::ret)
+    {
+        NumberExpression(cse, node->left, statement, &occurrence);
+        return;
+    }
+
+    // 'print' reads its variable only
+    if (type == NodeArgType::dfunction)
+        return;
+
+    NumberExpression(cse, node, statement, &occurrence);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// returns value number of the node, 0 - no node; occurrence - its operation occurrence
+static size_t NumberExpression(Cse* cse, Node_t* node, size_t statement, size_t* occurrence)
+{
+    assert(cse);
+    assert(occurrence);
+
+    *occurrence = CseNoOccurrence;
+
+    if (!node) return 0;
+
+    CseKey key = {};
+    key.kind   = (uint64_t) node->type;
+
+    switch (node->type)
+    {
+        case NodeArgType::number:
+        {
+            Number number = node->data.num;
+
+            key.a = (uint64_t) number.type;
+
+            switch (number.type)
+            {
+                case Type::int_type:    key.b = (uint64_t) (int64_t) number.value.int_val;  break;
+                case Type::char_type:   key.b = (uint64_t) (int64_t) number.value.char_val; break;
+                case Type::double_type: memcpy(&key.b, &number.value.double_val, sizeof(double)); break;
+                case Type::void_type:
+                case Type::undefined_type:
+                default: return NewUniqueValue(cse);
+            }
+
+            return GetValue(cse, &key, 1);
+        }
+
+        case NodeArgType::name:
+        {
+            NameId id = node->data.name.id;
+
+            key.a = (uint64_t) id;
+            key.b = GetVersion(cse, id);
+
+            return GetValue(cse, &key, 1);
+        }
+
+        case NodeArgType::operation:
+            return NumberOperation(cse, node, statement, occurrence);
+
+        case NodeArgType::initialisation:
+        {
+            // call value is new every time, but its arguments are the block expressions too
+            if (node->data.init == Initialisation::call_function)
+                NumberArgs(cse, node->left->left, statement);
+
+            return NewUniqueValue(cse);
+        }
+
+        case NodeArgType::connect:
+        case NodeArgType::type:
+        case NodeArgType::condition:
+        case NodeArgType::cycle:
+        case NodeArgType::dfunction:
+        case NodeArgType::attribute:
+        case NodeArgType::undefined:
+        default: return NewUniqueValue(cse);
+    }
+
+    return 0;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static size_t NumberOperation(Cse* cse, Node_t* node, size_t statement, size_t* occurrence)
+{
+    assert(cse);
+    assert(node);
+    assert(occurrence);
+
+    size_t left_occurrence  = CseNoOccurrence;
+    size_t right_occurrence = CseNoOccurrence;
+
+    size_t left  = NumberExpression(cse, node->left,  statement, &left_occurrence);
+    size_t right = NumberExpression(cse, node->right, statement, &right_occurrence);
+
+    size_t left_size  = left  ? cse->values[left ].size : 0;
+    size_t right_size = right ? cse->values[right].size : 0;
+
+    // operand of unknown value (call) makes the operation value unknown too
+    if ((left && left_size == 0) || (right && right_size == 0))
+        return NewUniqueValue(cse);
+
+    CseKey key = {};
+    key.kind   = (uint64_t) NodeArgType::operation | ((uint64_t) node->data.oper << 8);
+    key.a      = left;
+    key.b      = right;
+
+    size_t value = GetValue(cse, &key, 1 + left_size + right_size);
+
+    bool can_trap = (node->data.oper == Operation::dive && !IsNonzeroNumber(node->right));
+
+    if (left_occurrence  != CseNoOccurrence) can_trap = can_trap || cse->occurrences[left_occurrence ].can_trap;
+    if (right_occurrence != CseNoOccurrence) can_trap = can_trap || cse->occurrences[right_occurrence].can_trap;
+
+    CseOccurrence new_occurrence = {};
+    new_occurrence.node          = node;
+    new_occurrence.statement     = statement;
+    new_occurrence.value         = value;
+    new_occurrence.next          = CseNoOccurrence;
+    new_occurrence.left          = left_occurrence;
+    new_occurrence.right         = right_occurrence;
+    new_occurrence.can_trap      = can_trap;
+
+    *occurrence = cse->occurrences_quant;
+    AddOccurrence(cse, &new_occurrence);
+
+    return value;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void NumberArgs(Cse* cse, Node_t* node, size_t statement)
+{
+    assert(cse);
+
+    if (!node) return;
+
+    if (node->type == NodeArgType::connect)
+    {
+        NumberArgs(cse, node->left,  statement);
+        NumberArgs(cse, node->right, statement);
+        return;
+    }
+
+    size_t occurrence = CseNoOccurrence;
+    NumberExpression(cse, node, statement, &occurrence);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// hash-consing: equal keys get one value number
+static size_t GetValue(Cse* cse, const CseKey* key, size_t size)
+{
+    assert(cse);
+    assert(key);
+
+    // table is half empty at most
+    if (2 * cse->values_quant >= cse->table_capacity)
+    {
+        FREE(cse->table);
+
+        cse->table_capacity *= 2;
+        cse->table = (size_t*) calloc(cse->table_capacity, sizeof(size_t));
+
+        if (!cse->table)
+            EXIT(EXIT_FAILURE, "failed calloc memory for cse table.");
+
+        size_t mask = cse->table_capacity - 1;
+
+        for (size_t i = 1; i < cse->values_quant; i++)
+        {
+            if (cse->values[i].size == 0)
+                continue;
+
+            size_t slot = Hash(&cse->values[i].key, 1, sizeof(CseKey)) & mask;
+
+            while (cse->table[slot])
+                slot = (slot + 1) & mask;
+
+            cse->table[slot]    = i;
+            cse->values[i].slot = slot;
+        }
+    }
+
+    size_t mask = cse->table_capacity - 1;
+    size_t slot = Hash(key, 1, sizeof(CseKey)) & mask;
+
+    while (cse->table[slot])
+    {
+        size_t value = cse->table[slot];
+
+        if (memcmp(&cse->values[value].key, key, sizeof(CseKey)) == 0)
+            return value;
+
+        slot = (slot + 1) & mask;
+    }
+
+    size_t value = NewUniqueValue(cse);
+
+    cse->values[value].key  = *key;
+    cse->values[value].slot = slot;
+    cse->values[value].size = size;
+    cse->table[slot]        = value;
+
+    return value;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// value out of the table: size 0 means unknown value, it is never equal to other
+static size_t NewUniqueValue(Cse* cse)
+{
+    assert(cse);
+
+    if (cse->values_quant == cse->values_capacity)
+    {
+        cse->values_capacity *= 2;
+        cse->values = (CseValue*) realloc(cse->values, cse->values_capacity * sizeof(CseValue));
+
+        if (!cse->values)
+            EXIT(EXIT_FAILURE, "failed realloc memory for cse values.");
+    }
+
+    size_t value = cse->values_quant++;
+
+    cse->values[value]       = {};
+    cse->values[value].first = CseNoOccurrence;
+    cse->values[value].last  = CseNoOccurrence;
+
+    return value;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void AddOccurrence(Cse* cse, CseOccurrence* occurrence)
+{
+    assert(cse);
+    assert(occurrence);
+
+    if (cse->occurrences_quant == cse->occurrences_capacity)
+    {
+        cse->occurrences_capacity *= 2;
+        cse->occurrences = (CseOccurrence*) realloc(cse->occurrences, cse->occurrences_capacity * sizeof(CseOccurrence));
+
+        if (!cse->occurrences)
+            EXIT(EXIT_FAILURE, "failed realloc memory for cse occurrences.");
+    }
+
+    size_t    index = cse->occurrences_quant++;
+    CseValue* value = &cse->values[occurrence->value];
+
+    cse->occurrences[index] = *occurrence;
+
+    if (value->last == CseNoOccurrence) value->first = index;
+    else                                cse->occurrences[value->last].next = index;
+
+    value->last = index;
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static size_t GetVersion(const Cse* cse, NameId id)
+{
+    assert(cse);
+
+    return ((size_t) id < cse->versions_capacity) ? cse->versions[id] : 0;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void BumpVersion(Cse* cse, NameId id)
+{
+    assert(cse);
+
+    if ((size_t) id >= cse->versions_capacity)
+    {
+        size_t old_capacity = cse->versions_capacity;
+
+        cse->versions_capacity = 2 * (size_t) id + 1;
+        cse->versions = (size_t*) realloc(cse->versions, cse->versions_capacity * sizeof(size_t));
+
+        if (!cse->versions)
+            EXIT(EXIT_FAILURE, "failed realloc memory for cse versions.");
+
+        memset(cse->versions + old_capacity, 0, (cse->versions_capacity - old_capacity) * sizeof(size_t));
+    }
+
+    cse->versions[id]++;
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void EliminateValues(Cse* cse)
+{
+    assert(cse);
+
+    size_t candidates_quant = 0;
+
+    for (size_t i = 1; i < cse->values_quant; i++)
+    {
+        CseValue* value = &cse->values[i];
+
+        if (value->size < CseMinSize || value->first == value->last)
+            continue;
+
+        if (candidates_quant == cse->candidates_capacity)
+        {
+            cse->candidates_capacity *= 2;
+            cse->candidates = (CseCandidate*) realloc(cse->candidates, cse->candidates_capacity * sizeof(CseCandidate));
+
+            if (!cse->candidates)
+                EXIT(EXIT_FAILURE, "failed realloc memory for cse candidates.");
+        }
+
+        cse->candidates[candidates_quant++] = {i, value->size};
+    }
+
+    // the biggest expression first: its parts inside it are not taken again
+    qsort(cse->candidates, candidates_quant, sizeof(*cse->candidates), CompareCandidates);
+
+    for (size_t i = 0; i < candidates_quant; i++)
+    {
+        size_t value = cse->candidates[i].value;
+        size_t alive = 0;
+        size_t first = GetAliveFirst(cse, value, &alive);
+
+        if (alive < 2)
+            continue;
+
+        const CseOccurrence* occurrence = &cse->occurrences[first];
+
+        // moved before the statement, '/' would trap before the calls and lazy operands evaluated earlier in it
+        if (occurrence->can_trap && !cse->statements[occurrence->statement].is_ordered)
+            continue;
+
+        ReplaceValue(cse, first);
+    }
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static int CompareCandidates(const void* first, const void* second)
+{
+    assert(first);
+    assert(second);
+
+    const CseCandidate* first_candidate  = (const CseCandidate*) first;
+    const CseCandidate* second_candidate = (const CseCandidate*) second;
+
+    if (first_candidate->size != second_candidate->size)
+        return (first_candidate->size > second_candidate->size) ? -1 : 1;
+
+    // equal sizes keep the block order, so the temps numbers do not depend on qsort
+    return (first_candidate->value < second_candidate->value) ? -1 : 1;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static size_t GetAliveFirst(const Cse* cse, size_t value, size_t* alive)
+{
+    assert(cse);
+    assert(alive);
+
+    size_t first = CseNoOccurrence;
+
+    for (size_t i = cse->values[value].first; i != CseNoOccurrence; i = cse->occurrences[i].next)
+    {
+        if (cse->occurrences[i].is_replaced)
+            continue;
+
+        if (first == CseNoOccurrence)
+            first = i;
+
+        (*alive)++;
+    }
+
+    return first;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// 'int f.cse.N = E' before the statement of the first E, the first E is moved there,
+// every E node becomes the temp name, so parent pointers stay valid
+static void ReplaceValue(Cse* cse, size_t first)
+{
+    assert(cse);
+
+    NameId temp = NewFreshName(cse->function, "cse");
+
+    Node_t* expression = cse->occurrences[first].node;
+    Node_t* moved      = nullptr;
+    TREE_ASSERT(NodeCtor(&moved, cse->arena, expression->type, expression->data, expression->left, expression->right));
+
+    Node_t* type_node = nullptr;
+    _TYPE(&type_node, cse->arena, Type::int_type, NewNameNode(cse->arena, temp));
+
+    Node_t* def_node = nullptr;
+    _DEF_VAR(&def_node, cse->arena, type_node, moved);
+
+    Node_t** statement_slot = cse->statements[cse->occurrences[first].statement].slot;
+    _CONNECT(statement_slot, cse->arena, def_node, *statement_slot);
+
+    for (size_t i = first; i != CseNoOccurrence; i = cse->occurrences[i].next)
+    {
+        CseOccurrence* occurrence = &cse->occurrences[i];
+
+        if (occurrence->is_replaced)
+            continue;
+
+        MarkReplaced(cse, i);
+
+        if (i != first)
+        {
+            cse->stats->removed_nodes += GetTreeSize(occurrence->node) - 1;
+
+            TREE_ASSERT(NodeAndUnderTreeDtor(occurrence->node->left,  cse->arena));
+            TREE_ASSERT(NodeAndUnderTreeDtor(occurrence->node->right, cse->arena));
+        }
+
+        SetNameNode(occurrence->node, temp);
+    }
+
+    cse->stats->temps++;
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void MarkReplaced(Cse* cse, size_t occurrence)
+{
+    assert(cse);
+
+    if (occurrence == CseNoOccurrence) return;
+
+    CseOccurrence* replaced = &cse->occurrences[occurrence];
+
+    replaced->is_replaced = true;
+
+    MarkReplaced(cse, replaced->left);
+    MarkReplaced(cse, replaced->right);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// assignments inside expressions and '++', '+=' ... change variables in the middle of the statement
+static bool HasSideEffect(const Node_t* node)
+{
+    if (!node) return false;
+
+    if (node->type == NodeArgType::initialisation && node->data.init == Initialisation::assign_variable)
+        return true;
+
+    if (node->type == NodeArgType::operation)
+    {
+        switch (node->data.oper)
+        {
+            case Operation::assign:
+            case Operation::plus_equal:
+            case Operation::minus_equal:
+            case Operation::mul_equal:
+            case Operation::div_equal:
+            case Operation::plus_plus:
+            case Operation::minus_minus:         return true;
+
+            case Operation::plus:
+            case Operation::minus:
+            case Operation::mul:
+            case Operation::dive:
+            case Operation::power:
+            case Operation::greater:
+            case Operation::greater_or_equal:
+            case Operation::less:
+            case Operation::less_or_equal:
+            case Operation::equal:
+            case Operation::not_equal:
+            case Operation::bool_and:
+            case Operation::bool_or:
+            case Operation::bool_not:
+            case Operation::undefined_operation:
+            default: break;
+        }
+    }
+
+    return HasSideEffect(node->left) || HasSideEffect(node->right);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// statement itself may be an assignment, only its value may not have one
+static bool HasInnerSideEffect(const Node_t* statement)
+{
+    assert(statement);
+
+    if (statement->type == NodeArgType::initialisation && (statement->data.init == Initialisation::def_variable ||
+                                                          statement->data.init == Initialisation::assign_variable))
+        return HasSideEffect(statement->right);
+
+    return HasSideEffect(statement);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static bool IsOrdered(const Node_t* node)
+{
+    if (!node) return true;
+
+    if (node->type == NodeArgType::initialisation && node->data.init == Initialisation::call_function)
+        return false;
+
+    if (node->type == NodeArgType::operation && (node->data.oper == Operation::bool_and || node->data.oper == Operation::bool_or))
+        return false;
+
+    return IsOrdered(node->left) && IsOrdered(node->right);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static bool IsNonzeroNumber(const Node_t* node)
+{
+    return node && node->type == NodeArgType::number && node->data.num.type == Type::int_type && node->data.num.value.int_val != 0;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static size_t GetTreeSize(const Node_t* node)
+{
+    if (!node) return 0;
+
+    return 1 + GetTreeSize(node->left) + GetTreeSize(node->right);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void SetNameNode(Node_t* node, NameId id)
+{
+    assert(node);
+
+    Name name = {};
+    name.id   = id;
+    name.name = GetInternedName(id);
+
+    _SET_NAME(node, name);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static Node_t* NewNameNode(NodeArena* arena, NameId id)
+{
+    Name name = {};
+    name.id   = id;
+    name.name = GetInternedName(id);
+
+    Node_t* node = nullptr;
+    _NAME(&node, arena, name);
+
+    return node;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
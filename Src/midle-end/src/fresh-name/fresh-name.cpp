@@ -0,0 +1,40 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include "fresh-name/fresh-name.hpp"
+#include "lib/lib.hpp"
+#include "name-table/interner/interner.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+NameId NewFreshName(NameId name, const char* suffix)
+{
+    assert(suffix);
+
+    NameInfo info     = GetInternedName(name);
+    size_t   capacity = info.len + strlen(suffix) + 32;
+    char*    buffer   = (char*) calloc(capacity, sizeof(char));
+
+    if (!buffer)
+        EXIT(EXIT_FAILURE, "failed calloc memory for fresh name.");
+
+    NameId id = NameNoId;
+
+    for (size_t k = 0; id == NameNoId; k++)
+    {
+        int len = (k == 0) ? snprintf(buffer, capacity, "%.*s.%s",     (int) info.len, info.name, suffix)
+                           : snprintf(buffer, capacity, "%.*s.%s.%lu", (int) info.len, info.name, suffix, k);
+
+        NameInfo fresh = {buffer, (size_t) len};
+
+        if (GetNameId(&fresh) == NameNoId)
+            id = InternNameCopy(&fresh);
+    }
+
+    free(buffer);
+
+    return id;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
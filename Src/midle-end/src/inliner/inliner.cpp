@@ -0,0 +1,829 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include "inliner/inliner.hpp"
+#include "fresh-name/fresh-name.hpp"
+#include "lib/lib.hpp"
+#include "profile/profile.hpp"
+#include "name-table/interner/interner.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static const size_t InlineDefaultCapacity = 16;
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+enum class BodyShape
+{
+    none       ,
+    expression ,
+    statements ,
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// callee variable in the inlined copy: renamed variable ('to') or copy of an argument ('value')
+struct InlineBinding
+{
+    NameId        from;
+    NameId        to;
+    const Node_t* value;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct Inliner
+{
+    CallGraph*       graph;
+    NodeArena*       arena;
+    InlineReport*    report;
+    size_t           caller;
+    size_t           growth;
+    size_t           site;
+
+    InlineBinding*   bindings;
+    size_t           bindings_quant;
+    size_t           bindings_capacity;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void          InlineStatements       (Inliner* inl, Node_t** slot, bool is_body);
+static void          InlineStatement        (Inliner* inl, Node_t** slot, bool is_body);
+static void          InlineValue            (Inliner* inl, Node_t** value_slot, Node_t** statement_slot);
+static void          InlineExpression       (Inliner* inl, Node_t** slot);
+static void          TryInlineCall          (Inliner* inl, Node_t** call_slot, Node_t** statement_slot);
+static InlineResult  InlineCall             (Inliner* inl, Node_t** call_slot, Node_t** statement_slot, const CallGraphFunction* callee);
+
+static void          InlineAsExpression     (Inliner* inl, Node_t** call_slot, const Node_t* value, Node_t** params, Node_t** args, size_t args_quant);
+static void          InlineAsStatements     (Inliner* inl, Node_t** call_slot, Node_t** statement_slot, const Node_t* body, Node_t** params, Node_t** args, size_t args_quant);
+static void          AppendBodyCopy         (Inliner* inl, Node_t*** tail, const Node_t* node, const Node_t* last_return);
+
+static BodyShape     GetBodyShape           (const Node_t* body, const Node_t** last_return);
+static bool          AreArgsSubstitutable   (const Node_t* value, Node_t** params, Node_t** args, size_t args_quant);
+static const Node_t* GetLastStatement       (const Node_t* node);
+static size_t        CountStatements        (const Node_t* node);
+static size_t        CountReturns           (const Node_t* node);
+static size_t        CountNameUses          (const Node_t* node, NameId id);
+static size_t        CountNodes             (const Node_t* node);
+static bool          HasCallOrAssign        (const Node_t* node);
+static bool          HasAssign              (const Node_t* node);
+static bool          CollectList            (Node_t* node, Node_t** items, size_t* quant);
+
+static void          BindingsClear          (Inliner* inl);
+static void          AddBinding             (Inliner* inl, NameId from, NameId to, const Node_t* value);
+static InlineBinding GetBinding             (Inliner* inl, NameId from);
+static NameId        NewInlineName          (NameId name, size_t site);
+static Node_t*       CopyBound              (Inliner* inl, const Node_t* node);
+static Node_t*       NewNameNode            (NodeArena* arena, const Node_t* like, NameId id);
+static void          AppendStatement        (NodeArena* arena, Node_t*** tail, Node_t* statement);
+
+static void          AddSite                (Inliner* inl, NameId callee, InlineResult result);
+static const char*   GetInlineResultName    (InlineResult result);
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void InlineFunctions(CallGraph* graph, NodeArena* arena, InlineReport* report)
+{
+    assert(graph);
+    assert(report);
+
+    PROFILE_SCOPE("InlineFunctions");
+
+    Inliner inl = {};
+    inl.graph   = graph;
+    inl.arena   = arena;
+    inl.report  = report;
+
+    inl.bindings_capacity = InlineDefaultCapacity;
+    inl.bindings          = (InlineBinding*) calloc(inl.bindings_capacity, sizeof(*inl.bindings));
+    if (!inl.bindings)
+        EXIT(EXIT_FAILURE, "failed calloc memory for inliner.");
+
+    for (size_t i = 0; i < graph->functions_quant; i++)
+    {
+        inl.caller = graph->order[i];
+        inl.growth = 0;
+
+        InlineStatements(&inl, &graph->functions[inl.caller].name->right, true);
+    }
+
+    FREE(inl.bindings);
+
+    PROFILE_COUNT("inlined call sites", report->inlined_quant);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void InlineReportDtor(InlineReport* report)
+{
+    assert(report);
+
+    FREE(report->sites);
+    *report = {};
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void PrintInlineReport(const InlineReport* report, FILE* stream)
+{
+    assert(report);
+    assert(stream);
+
+    fprintf(stream, "inline: %lu of %lu call sites inlined\n", report->inlined_quant, report->sites_quant);
+
+    for (size_t i = 0; i < report->sites_quant; i++)
+    {
+        const InlineSite* site   = &report->sites[i];
+        NameInfo          caller = GetInternedName(site->caller);
+        NameInfo          callee = GetInternedName(site->callee);
+
+        fprintf(stream, "    %.*s -> %.*s: %s\n", (int) caller.len, caller.name, (int) callee.len, callee.name,
+                                                  GetInlineResultName(site->result));
+    }
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// is_body - statements are a body, a call may become statements here (not in 'for' init and step)
+static void InlineStatements(Inliner* inl, Node_t** slot, bool is_body)
+{
+    assert(inl);
+    assert(slot);
+
+    Node_t* node = *slot;
+
+    if (!node) return;
+
+    if (node->type == NodeArgType::connect)
+    {
+        InlineStatements(inl, &node->left,  is_body);
+        InlineStatements(inl, &node->right, is_body);
+        return;
+    }
+
+    InlineStatement(inl, slot, is_body);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void InlineStatement(Inliner* inl, Node_t** slot, bool is_body)
+{
+    assert(inl);
+    assert(slot);
+
+    Node_t*     node           = *slot;
+    NodeArgType type           = node->type;
+    Node_t**    statement_slot = is_body ? slot : nullptr;
+
+    if (type == NodeArgType::condition)
+    {
+        InlineExpression(inl, &node->left);
+        InlineStatements(inl, &node->right, true);
+        return;
+    }
+
+    if (type == NodeArgType::cycle && node->data.cycle == Cycle::while_t)
+    {
+        InlineExpression(inl, &node->left);
+        InlineStatements(inl, &node->right, true);
+        return;
+    }
+
+    // for node: left = connect(connect(init, condition), step), right = body
+    if (type == NodeArgType::cycle && node->data.cycle == Cycle::for_t)
+    {
+        InlineStatements(inl, &node->left->left->left,  false);
+        InlineExpression(inl, &node->left->left->right);
+        InlineStatements(inl, &node->left->right,       false);
+        InlineStatements(inl, &node->right,             true);
+        return;
+    }
+
+    // print takes only a variable
+    if (type == NodeArgType::dfunction)
+        return;
+
+    if (type == NodeArgType::attribute && node->data.attribute == FunctionAttribute::ret)
+        return InlineValue(inl, &node->left, statement_slot);
+
+    if (type == NodeArgType::initialisation && (node->data.init == Initialisation::def_variable || node->data.init == Initialisation::assign_variable))
+        return InlineValue(inl, &node->right, statement_slot);
+
+    InlineValue(inl, slot, statement_slot);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// value is the whole value of a statement, its call may be inlined as statements
+static void InlineValue(Inliner* inl, Node_t** value_slot, Node_t** statement_slot)
+{
+    assert(inl);
+    assert(value_slot);
+
+    Node_t* value = *value_slot;
+
+    if (!value) return;
+
+    if (value->type != NodeArgType::initialisation || value->data.init != Initialisation::call_function)
+        return InlineExpression(inl, value_slot);
+
+    InlineExpression(inl, &value->left->left);
+    TryInlineCall   (inl, value_slot, statement_slot);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void InlineExpression(Inliner* inl, Node_t** slot)
+{
+    assert(inl);
+    assert(slot);
+
+    Node_t* node = *slot;
+
+    if (!node) return;
+
+    if (node->type == NodeArgType::initialisation && node->data.init == Initialisation::call_function)
+    {
+        InlineExpression(inl, &node->left->left);
+        TryInlineCall   (inl, slot, nullptr);
+        return;
+    }
+
+    InlineExpression(inl, &node->left);
+    InlineExpression(inl, &node->right);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void TryInlineCall(Inliner* inl, Node_t** call_slot, Node_t** statement_slot)
+{
+    assert(inl);
+    assert(call_slot);
+
+    NameId callee_id = (*call_slot)->left->data.name.id;
+    size_t callee_i  = GetCallGraphFunction(inl->graph, callee_id);
+
+    if (callee_i == CallGraphNoFunction)
+    {
+        NameInfo name = GetInternedName(callee_id);
+        EXIT(EXIT_FAILURE, "call of undefined function '%.*s'", (int) name.len, name.name);
+    }
+
+    InlineResult result = InlineCall(inl, call_slot, statement_slot, &inl->graph->functions[callee_i]);
+
+    AddSite(inl, callee_id, result);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static InlineResult InlineCall(Inliner* inl, Node_t** call_slot, Node_t** statement_slot, const CallGraphFunction* callee)
+{
+    assert(inl);
+    assert(call_slot);
+    assert(callee);
+
+    if (callee->is_recursive)
+        return InlineResult::recursive;
+
+    const Node_t* body = callee->name->right;
+    size_t        size = CountNodes(body);
+
+    if (size > InlineCalleeMaxSize)
+        return InlineResult::callee_size;
+
+    if (inl->growth + size > InlineCallerMaxGrowth)
+        return InlineResult::caller_budget;
+
+    Node_t* params[InlineMaxArgs] = {};
+    Node_t* args  [InlineMaxArgs] = {};
+    size_t  params_quant          = 0;
+    size_t  args_quant            = 0;
+
+    if (!CollectList(callee->name->left, params, &params_quant) || !CollectList((*call_slot)->left->left, args, &args_quant))
+        return InlineResult::args_shape;
+
+    // wrong arguments quantity is reported by the code generator
+    if (params_quant != args_quant)
+        return InlineResult::args_shape;
+
+    const Node_t* last_return = nullptr;
+    BodyShape     shape       = GetBodyShape(body, &last_return);
+
+    if (shape == BodyShape::expression && AreArgsSubstitutable(last_return->left, params, args, args_quant))
+    {
+        InlineAsExpression(inl, call_slot, last_return->left, params, args, args_quant);
+        inl->growth += size;
+        return InlineResult::expression;
+    }
+
+    if (shape == BodyShape::none)
+        return InlineResult::body_shape;
+
+    if (!statement_slot)
+        return (shape == BodyShape::expression) ? InlineResult::args_shape : InlineResult::call_context;
+
+    InlineAsStatements(inl, call_slot, statement_slot, body, params, args, args_quant);
+    inl->growth += size;
+
+    return InlineResult::statements;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void InlineAsExpression(Inliner* inl, Node_t** call_slot, const Node_t* value, Node_t** params, Node_t** args, size_t args_quant)
+{
+    assert(inl);
+    assert(call_slot);
+    assert(value);
+    assert(params);
+    assert(args);
+
+    BindingsClear(inl);
+    inl->site++;
+
+    for (size_t i = 0; i < args_quant; i++)
+        AddBinding(inl, params[i]->left->data.name.id, NameNoId, args[i]);
+
+    Node_t* call = *call_slot;
+
+    *call_slot = CopyBound(inl, value);
+
+    TREE_ASSERT(NodeAndUnderTreeDtor(call, inl->arena));
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void InlineAsStatements(Inliner* inl, Node_t** call_slot, Node_t** statement_slot, const Node_t* body, Node_t** params, Node_t** args, size_t args_quant)
+{
+    assert(inl);
+    assert(call_slot);
+    assert(statement_slot);
+    assert(params);
+    assert(args);
+
+    BindingsClear(inl);
+    inl->site++;
+
+    Node_t*  list = nullptr;
+    Node_t** tail = &list;
+
+    for (size_t i = 0; i < args_quant; i++)
+    {
+        const Node_t* param     = params[i];
+        NameId        param_id  = param->left->data.name.id;
+        NameId        renamed   = NewInlineName(param_id, inl->site);
+        Node_t*       type_node = nullptr;
+        Node_t*       def_node  = nullptr;
+
+        AddBinding(inl, param_id, renamed, nullptr);
+
+        _TYPE   (&type_node, inl->arena, param->data.type, NewNameNode(inl->arena, param->left, renamed));
+        _DEF_VAR(&def_node,  inl->arena, type_node, args[i]);
+
+        AppendStatement(inl->arena, &tail, def_node);
+    }
+
+    const Node_t* last_return = nullptr;
+    GetBodyShape(body, &last_return);
+
+    AppendBodyCopy(inl, &tail, body, last_return);
+
+    Node_t* returned = nullptr;
+
+    if (last_return && last_return->left)
+        returned = CopyBound(inl, last_return->left);
+    else
+    {
+        Number zero = {};
+        zero.type   = Type::int_type;
+        _NUM(&returned, inl->arena, zero);
+    }
+
+    Node_t* call      = *call_slot;
+    Node_t* statement = *statement_slot;
+
+    // arguments went to parameter definitions, only the call and its name are left
+    call->left->left = nullptr;
+    TREE_ASSERT(NodeAndUnderTreeDtor(call, inl->arena));
+
+    *call_slot = returned;
+
+    // 'f(..);' keeps the returned value only when it does something
+    if (call_slot == statement_slot)
+    {
+        statement = returned;
+
+        if (!HasCallOrAssign(returned))
+        {
+            TREE_ASSERT(NodeAndUnderTreeDtor(returned, inl->arena));
+            statement = nullptr;
+        }
+    }
+
+    if (statement)
+        AppendStatement(inl->arena, &tail, statement);
+
+    *statement_slot = list;
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void AppendBodyCopy(Inliner* inl, Node_t*** tail, const Node_t* node, const Node_t* last_return)
+{
+    assert(inl);
+    assert(tail);
+
+    if (!node || node == last_return) return;
+
+    if (node->type == NodeArgType::connect)
+    {
+        AppendBodyCopy(inl, tail, node->left,  last_return);
+        AppendBodyCopy(inl, tail, node->right, last_return);
+        return;
+    }
+
+    AppendStatement(inl->arena, tail, CopyBound(inl, node));
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// expression   - body is 'return E', E has no assignments (calls in E keep their order),
+// statements   - 'return' is only the last statement, or there is no 'return' at all (function returns 0),
+// none         - 'return' in the middle of the body
+static BodyShape GetBodyShape(const Node_t* body, const Node_t** last_return)
+{
+    assert(last_return);
+
+    const Node_t* last    = GetLastStatement(body);
+    size_t        returns = CountReturns(body);
+
+    *last_return = nullptr;
+
+    if (returns == 0)
+        return BodyShape::statements;
+
+    if (returns > 1 || last->type != NodeArgType::attribute || last->data.attribute != FunctionAttribute::ret)
+        return BodyShape::none;
+
+    *last_return = last;
+
+    if (CountStatements(body) == 1 && last->left && !HasAssign(last->left))
+        return BodyShape::expression;
+
+    return BodyShape::statements;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// arguments are evaluated before the callee body, substitution must not change what is evaluated and when:
+// numbers and variables go anywhere, expression without calls and assignments is not evaluated twice,
+// one argument with calls may be used once in E without calls (nothing else is evaluated around it)
+static bool AreArgsSubstitutable(const Node_t* value, Node_t** params, Node_t** args, size_t args_quant)
+{
+    assert(value);
+    assert(params);
+    assert(args);
+
+    size_t impure_quant = 0;
+
+    for (size_t i = 0; i < args_quant; i++)
+    {
+        const Node_t* arg  = args[i];
+        size_t        uses = CountNameUses(value, params[i]->left->data.name.id);
+
+        if (arg->type == NodeArgType::number || arg->type == NodeArgType::name)
+            continue;
+
+        if (!HasCallOrAssign(arg))
+        {
+            if (uses > 1)
+                return false;
+
+            continue;
+        }
+
+        impure_quant++;
+
+        if (uses != 1 || impure_quant > 1 || HasCallOrAssign(value))
+            return false;
+    }
+
+    return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static const Node_t* GetLastStatement(const Node_t* node)
+{
+    if (!node) return nullptr;
+
+    if (node->type != NodeArgType::connect)
+        return node;
+
+    const Node_t* last = GetLastStatement(node->right);
+
+    return last ? last : GetLastStatement(node->left);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static size_t CountStatements(const Node_t* node)
+{
+    if (!node) return 0;
+
+    if (node->type == NodeArgType::connect)
+        return CountStatements(node->left) + CountStatements(node->right);
+
+    return 1;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static size_t CountReturns(const Node_t* node)
+{
+    if (!node) return 0;
+
+    size_t returns = (node->type == NodeArgType::attribute && node->data.attribute == FunctionAttribute::ret) ? 1 : 0;
+
+    return returns + CountReturns(node->left) + CountReturns(node->right);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static size_t CountNameUses(const Node_t* node, NameId id)
+{
+    if (!node) return 0;
+
+    // function names of calls are not variables
+    if (node->type == NodeArgType::initialisation && node->data.init == Initialisation::call_function)
+        return CountNameUses(node->left->left, id);
+
+    size_t uses = (node->type == NodeArgType::name && node->data.name.id == id) ? 1 : 0;
+
+    return uses + CountNameUses(node->left, id) + CountNameUses(node->right, id);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static size_t CountNodes(const Node_t* node)
+{
+    if (!node) return 0;
+
+    return 1 + CountNodes(node->left) + CountNodes(node->right);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static bool HasCallOrAssign(const Node_t* node)
+{
+    if (!node) return false;
+
+    if (node->type == NodeArgType::initialisation && (node->data.init == Initialisation::call_function || node->data.init == Initialisation::assign_variable))
+        return true;
+
+    return HasCallOrAssign(node->left) || HasCallOrAssign(node->right);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static bool HasAssign(const Node_t* node)
+{
+    if (!node) return false;
+
+    if (node->type == NodeArgType::initialisation && node->data.init == Initialisation::assign_variable)
+        return true;
+
+    return HasAssign(node->left) || HasAssign(node->right);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// parameters and arguments are connect lists, false - more than InlineMaxArgs
+static bool CollectList(Node_t* node, Node_t** items, size_t* quant)
+{
+    assert(items);
+    assert(quant);
+
+    if (!node) return true;
+
+    if (node->type == NodeArgType::connect)
+        return CollectList(node->left, items, quant) && CollectList(node->right, items, quant);
+
+    if (*quant == InlineMaxArgs)
+        return false;
+
+    items[*quant] = node;
+    (*quant)++;
+
+    return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void BindingsClear(Inliner* inl)
+{
+    assert(inl);
+
+    inl->bindings_quant = 0;
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void AddBinding(Inliner* inl, NameId from, NameId to, const Node_t* value)
+{
+    assert(inl);
+
+    if (inl->bindings_quant == inl->bindings_capacity)
+    {
+        inl->bindings_capacity *= 2;
+        inl->bindings           = (InlineBinding*) realloc(inl->bindings, inl->bindings_capacity * sizeof(*inl->bindings));
+        if (!inl->bindings)
+            EXIT(EXIT_FAILURE, "failed realloc memory for inliner bindings.");
+    }
+
+    inl->bindings[inl->bindings_quant] = {from, to, value};
+    inl->bindings_quant++;
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// callee has few names, so they are found by linear search; a name met first is a callee local, it is renamed
+static InlineBinding GetBinding(Inliner* inl, NameId from)
+{
+    assert(inl);
+
+    for (size_t i = 0; i < inl->bindings_quant; i++)
+    {
+        if (inl->bindings[i].from == from)
+            return inl->bindings[i];
+    }
+
+    AddBinding(inl, from, NewInlineName(from, inl->site), nullptr);
+
+    return inl->bindings[inl->bindings_quant - 1];
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static NameId NewInlineName(NameId name, size_t site)
+{
+    char suffix[32] = {};
+    snprintf(suffix, sizeof(suffix), "%lu", site);
+
+    return NewFreshName(name, suffix);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static Node_t* CopyBound(Inliner* inl, const Node_t* node)
+{
+    assert(inl);
+
+    if (!node) return nullptr;
+
+    if (node->type == NodeArgType::name)
+    {
+        InlineBinding binding = GetBinding(inl, node->data.name.id);
+
+        if (binding.value)
+        {
+            Node_t* copy = nullptr;
+            TREE_ASSERT(NodeCopy(&copy, inl->arena, binding.value));
+            return copy;
+        }
+
+        return NewNameNode(inl->arena, node, binding.to);
+    }
+
+    // function name of a call is kept, only its arguments are copied
+    if (node->type == NodeArgType::initialisation && node->data.init == Initialisation::call_function)
+    {
+        Node_t* name_node = nullptr;
+        Node_t* call_node = nullptr;
+
+        TREE_ASSERT(NodeCtor(&name_node, inl->arena, node->left->type, node->left->data, CopyBound(inl, node->left->left), nullptr));
+        TREE_ASSERT(NodeCtor(&call_node, inl->arena, node->type,       node->data,       name_node,                        nullptr));
+
+        return call_node;
+    }
+
+    Node_t* left  = CopyBound(inl, node->left);
+    Node_t* right = CopyBound(inl, node->right);
+    Node_t* copy  = nullptr;
+
+    TREE_ASSERT(NodeCtor(&copy, inl->arena, node->type, node->data, left, right));
+
+    return copy;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static Node_t* NewNameNode(NodeArena* arena, const Node_t* like, NameId id)
+{
+    assert(like);
+    assert(like->type == NodeArgType::name);
+
+    Name name = like->data.name;
+    name.id   = id;
+    name.name = GetInternedName(id);
+
+    Node_t* node = nullptr;
+    _NAME(&node, arena, name);
+
+    return node;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// statements list: connect(statement_1, connect(statement_2, ...))
+static void AppendStatement(NodeArena* arena, Node_t*** tail, Node_t* statement)
+{
+    assert(tail);
+    assert(*tail);
+    assert(statement);
+
+    Node_t* connect = nullptr;
+    _CONNECT(&connect, arena, statement, nullptr);
+
+    **tail = connect;
+    *tail  = &connect->right;
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void AddSite(Inliner* inl, NameId callee, InlineResult result)
+{
+    assert(inl);
+
+    InlineReport* report = inl->report;
+
+    if (report->sites_quant == report->sites_capacity)
+    {
+        report->sites_capacity = (report->sites_capacity == 0) ? InlineDefaultCapacity : 2 * report->sites_capacity;
+        report->sites          = (InlineSite*) realloc(report->sites, report->sites_capacity * sizeof(*report->sites));
+        if (!report->sites)
+            EXIT(EXIT_FAILURE, "failed realloc memory for inline report.");
+    }
+
+    NameId caller = inl->graph->functions[inl->caller].name->data.name.id;
+
+    report->sites[report->sites_quant] = {caller, callee, result};
+    report->sites_quant++;
+
+    if (result == InlineResult::expression || result == InlineResult::statements)
+        report->inlined_quant++;
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static const char* GetInlineResultName(InlineResult result)
+{
+    switch (result)
+    {
+        case InlineResult::expression:    return "inlined as expression";
+        case InlineResult::statements:    return "inlined as statements";
+        case InlineResult::recursive:     return "recursive callee";
+        case InlineResult::callee_size:   return "callee is too big";
+        case InlineResult::caller_budget: return "caller growth budget is spent";
+        case InlineResult::body_shape:    return "callee 'return' is not at the end";
+        case InlineResult::call_context:  return "callee has statements, call is a part of expression";
+        case InlineResult::args_shape:    return "arguments can not take place of parameters";
+        default: assert(0 && "undefined inline result");
+    }
+
+    return "";
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,1086 @@
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "ir/ir-lower/ir-lower.hpp"
+#include "lib/lib.hpp"
+#include "profile/profile.hpp"
+#include "name-table/interner/interner.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct IrLowerBlock
+{
+    bool   is_sealed;
+    IrList incomplete;      // phis waiting for predecessors
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// 'if' and its 'else if', 'else' are neighbours in the body connect list, not children of one node
+struct IrIfChain
+{
+    bool      is_open;
+    IrBlockId end;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct IrLower
+{
+    IrFunction*   function;
+    const Node_t* function_name;
+    IrBlockId     block;            // current block
+    IrBlockId     body;             // after arguments, tail self calls jump here
+
+    size_t        names_quant;
+    size_t*       locals;           // locals[NameId] = index + 1 of the variable in the function, 0 - not met
+    NameId*       vars;             // NameId of every variable of the function
+    size_t        vars_quant;
+
+    IrValue*      defs;             // defs[block * vars_quant + var], current value of var at the end of block
+    size_t        defs_capacity;
+    IrLowerBlock* blocks;
+    size_t        blocks_capacity;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void      IrLowerCtor        (IrLower* lower);
+static void      IrLowerDtor        (IrLower* lower);
+
+static void      LowerFunctions     (IrLower* lower, IrModule* module, const Node_t* node);
+static void      LowerFunction      (IrLower* lower, IrModule* module, const Node_t* node);
+static void      CollectVars        (IrLower* lower, const Node_t* node);
+static void      ClearVars          (IrLower* lower);
+static void      LowerArgs          (IrLower* lower, const Node_t* node, size_t* arg_i);
+
+static void      LowerBody          (IrLower* lower, const Node_t* node);
+static void      LowerStatements    (IrLower* lower, const Node_t* node, IrIfChain* chain);
+static void      LowerCondition     (IrLower* lower, const Node_t* node, IrIfChain* chain);
+static void      LowerIfBranch      (IrLower* lower, const Node_t* node, IrIfChain* chain);
+static void      CloseIfChain       (IrLower* lower, IrIfChain* chain);
+static void      LowerStatement     (IrLower* lower, const Node_t* node);
+static void      LowerWhile         (IrLower* lower, const Node_t* node);
+static void      LowerFor           (IrLower* lower, const Node_t* node);
+static void      LowerReturn        (IrLower* lower, const Node_t* node);
+static void      LowerTailCall      (IrLower* lower, const Node_t* node);
+static void      AssignArgs         (IrLower* lower, const Node_t* node, const IrValue* values, size_t* arg_i);
+
+static IrValue   LowerExpression    (IrLower* lower, const Node_t* node);
+static IrValue   LowerNumber        (IrLower* lower, const Node_t* node);
+static IrValue   LowerOperation     (IrLower* lower, const Node_t* node);
+static IrValue   LowerBoolValue     (IrLower* lower, const Node_t* node);
+static void      LowerBranch        (IrLower* lower, const Node_t* node, IrBlockId true_block, IrBlockId false_block);
+static IrValue   LowerCall          (IrLower* lower, const Node_t* node);
+static void      LowerCallArgs      (IrLower* lower, const Node_t* node, IrList* values);
+static IrOp      GetIrOp            (Operation operation);
+
+static IrBlockId NewBlock           (IrLower* lower);
+static void      SealBlock          (IrLower* lower, IrBlockId block);
+static void      Jump               (IrLower* lower, IrBlockId target);
+static IrValue   NewBinary          (IrLower* lower, IrOp op, IrValue a, IrValue b);
+static IrValue   NewNumber          (IrLower* lower, int number);
+
+static size_t    GetVar             (const IrLower* lower, const Node_t* name_node);
+static void      WriteVariable      (IrLower* lower, size_t var, IrBlockId block, IrValue value);
+static IrValue   ReadVariable       (IrLower* lower, size_t var, IrBlockId block);
+static IrValue   ReadVariableInPreds(IrLower* lower, size_t var, IrBlockId block);
+static void      AddPhiOperands     (IrLower* lower, size_t var, IrValue phi);
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void LowerTree(const Tree_t* tree, IrModule* module)
+{
+    assert(tree);
+    assert(module);
+
+    PROFILE_SCOPE("LowerTree");
+
+    IrLower lower = {};
+    IrLowerCtor(&lower);
+
+    LowerFunctions(&lower, module, tree->root);
+
+    IrLowerDtor(&lower);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void IrLowerCtor(IrLower* lower)
+{
+    assert(lower);
+
+    lower->names_quant = GetInternedNamesQuant();
+    lower->locals      = (size_t*) calloc(lower->names_quant + 1, sizeof(*lower->locals));
+    lower->vars        = (NameId*) calloc(lower->names_quant + 1, sizeof(*lower->vars));
+
+    if (!lower->locals || !lower->vars)
+        EXIT(EXIT_FAILURE, "failed calloc memory for ir lowering.");
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void IrLowerDtor(IrLower* lower)
+{
+    assert(lower);
+
+    for (size_t i = 0; i < lower->blocks_capacity; i++)
+        IrListDtor(&lower->blocks[i].incomplete);
+
+    FREE(lower->locals);
+    FREE(lower->vars);
+    FREE(lower->defs);
+    FREE(lower->blocks);
+
+    *lower = {};
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void LowerFunctions(IrLower* lower, IrModule* module, const Node_t* node)
+{
+    assert(lower);
+    assert(module);
+
+    if (!node) return;
+
+    if (node->type == NodeArgType::connect)
+    {
+        LowerFunctions(lower, module, node->left);
+        LowerFunctions(lower, module, node->right);
+        return;
+    }
+
+    if (node->type != NodeArgType::initialisation || node->data.init != Initialisation::def_function)
+        EXIT(EXIT_FAILURE, "here must be def func node");
+
+    LowerFunction(lower, module, node);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void LowerFunction(IrLower* lower, IrModule* module, const Node_t* node)
+{
+    assert(lower);
+    assert(module);
+    assert(node);
+
+    const Node_t* name_node = node->left->left;
+    const Node_t* args_node = name_node->left;
+    const Node_t* body_node = name_node->right;
+
+    ClearVars  (lower);
+    CollectVars(lower, args_node);
+    CollectVars(lower, body_node);
+
+    lower->function      = NewIrFunction(module, name_node->data.name.id, 0);
+    lower->function_name = name_node;
+
+    IrBlockId entry = NewBlock(lower);
+    SealBlock(lower, entry);
+
+    size_t args_quant = 0;
+
+    lower->block = entry;
+    LowerArgs(lower, args_node, &args_quant);
+    lower->function->args_quant = args_quant;
+
+    lower->body = NewBlock(lower);
+    Jump(lower, lower->body);
+    lower->block = lower->body;
+
+    LowerBody(lower, body_node);
+
+    // function without 'return' at the end returns 0
+    if (!GetIrTerminator(lower->function, lower->block))
+    {
+        IrValue zero = NewNumber(lower, 0);
+        IrValue ret  = NewIrInstr(lower->function, lower->block, IrOp::ret);
+        lower->function->instrs[ret].a = zero;
+    }
+
+    SealBlock(lower, lower->body);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// every name, except names of called functions, is a variable
+static void CollectVars(IrLower* lower, const Node_t* node)
+{
+    assert(lower);
+
+    if (!node) return;
+
+    if (node->type == NodeArgType::initialisation && node->data.init == Initialisation::call_function)
+        return CollectVars(lower, node->left->left);
+
+    if (node->type == NodeArgType::name)
+    {
+        NameId id = node->data.name.id;
+
+        assert(id != NameNoId);
+        assert(id <= lower->names_quant);
+
+        if (lower->locals[id] == 0)
+        {
+            lower->vars[lower->vars_quant] = id;
+            lower->vars_quant++;
+            lower->locals[id] = lower->vars_quant;
+        }
+    }
+
+    CollectVars(lower, node->left);
+    CollectVars(lower, node->right);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void ClearVars(IrLower* lower)
+{
+    assert(lower);
+
+    for (size_t i = 0; i < lower->vars_quant; i++)
+        lower->locals[lower->vars[i]] = 0;
+
+    lower->vars_quant = 0;
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void LowerArgs(IrLower* lower, const Node_t* node, size_t* arg_i)
+{
+    assert(lower);
+    assert(arg_i);
+
+    if (!node) return;
+
+    if (node->type == NodeArgType::connect)
+    {
+        LowerArgs(lower, node->left,  arg_i);
+        LowerArgs(lower, node->right, arg_i);
+        return;
+    }
+
+    IrValue arg = NewIrInstr(lower->function, lower->block, IrOp::arg);
+
+    lower->function->instrs[arg].number = (int) *arg_i;
+    lower->function->instrs[arg].name   = node->left->data.name.id;
+
+    WriteVariable(lower, GetVar(lower, node->left), lower->block, arg);
+    (*arg_i)++;
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void LowerBody(IrLower* lower, const Node_t* node)
+{
+    assert(lower);
+
+    IrIfChain chain = {};
+
+    LowerStatements(lower, node, &chain);
+    CloseIfChain   (lower, &chain);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void LowerStatements(IrLower* lower, const Node_t* node, IrIfChain* chain)
+{
+    assert(lower);
+    assert(chain);
+
+    if (!node) return;
+
+    if (node->type == NodeArgType::connect)
+    {
+        LowerStatements(lower, node->left,  chain);
+        LowerStatements(lower, node->right, chain);
+        return;
+    }
+
+    if (node->type == NodeArgType::condition)
+        return LowerCondition(lower, node, chain);
+
+    CloseIfChain  (lower, chain);
+    LowerStatement(lower, node);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void LowerCondition(IrLower* lower, const Node_t* node, IrIfChain* chain)
+{
+    assert(lower);
+    assert(node);
+    assert(chain);
+
+    switch (node->data.condition)
+    {
+        case Condition::if_t:
+        {
+            CloseIfChain(lower, chain);
+
+            chain->is_open = true;
+            chain->end     = NewBlock(lower);
+
+            LowerIfBranch(lower, node, chain);
+            return;
+        }
+
+        case Condition::else_if_t:
+        {
+            if (!chain->is_open)
+                EXIT(EXIT_FAILURE, "'else if' without 'if'");
+
+            LowerIfBranch(lower, node, chain);
+            return;
+        }
+
+        case Condition::else_t:
+        {
+            if (!chain->is_open)
+                EXIT(EXIT_FAILURE, "'else' without 'if'");
+
+            LowerBody   (lower, node->right);
+            CloseIfChain(lower, chain);
+            return;
+        }
+
+        case Condition::undefined_condition:
+        default: EXIT(EXIT_FAILURE, "undefined condition type.");
+    }
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void LowerIfBranch(IrLower* lower, const Node_t* node, IrIfChain* chain)
+{
+    assert(lower);
+    assert(node);
+    assert(chain);
+
+    IrBlockId then_block = NewBlock(lower);
+    IrBlockId next_block = NewBlock(lower);
+
+    LowerBranch(lower, node->left, then_block, next_block);
+    SealBlock  (lower, then_block);
+    SealBlock  (lower, next_block);
+
+    lower->block = then_block;
+    LowerBody(lower, node->right);
+    Jump     (lower, chain->end);
+
+    lower->block = next_block;
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void CloseIfChain(IrLower* lower, IrIfChain* chain)
+{
+    assert(lower);
+    assert(chain);
+
+    if (!chain->is_open) return;
+
+    Jump     (lower, chain->end);
+    SealBlock(lower, chain->end);
+
+    lower->block = chain->end;
+    *chain = {};
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void LowerStatement(IrLower* lower, const Node_t* node)
+{
+    assert(lower);
+    assert(node);
+
+    NodeArgType type = node->type;
+
+    if (type == NodeArgType::cycle && node->data.cycle == Cycle::while_t)
+        return LowerWhile(lower, node);
+
+    if (type == NodeArgType::cycle && node->data.cycle == Cycle::for_t)
+        return LowerFor(lower, node);
+
+    if (type == NodeArgType::attribute && node->data.attribute == FunctionAttribute::ret)
+        return LowerReturn(lower, node);
+
+    if (type == NodeArgType::dfunction && node->data.function == DFunction::print)
+    {
+        IrValue value = ReadVariable(lower, GetVar(lower, node->left), lower->block);
+        IrValue print = NewIrInstr(lower->function, lower->block, IrOp::print);
+        lower->function->instrs[print].a = value;
+        return;
+    }
+
+    if (type == NodeArgType::initialisation && node->data.init == Initialisation::def_variable)
+    {
+        IrValue value = LowerExpression(lower, node->right);
+        WriteVariable(lower, GetVar(lower, node->left->left), lower->block, value);
+        return;
+    }
+
+    if (type == NodeArgType::initialisation && node->data.init == Initialisation::assign_variable)
+    {
+        IrValue value = LowerExpression(lower, node->right);
+        WriteVariable(lower, GetVar(lower, node->left), lower->block, value);
+        return;
+    }
+
+    // expression as statement (function call): its value is not used
+    LowerExpression(lower, node);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void LowerWhile(IrLower* lower, const Node_t* node)
+{
+    assert(lower);
+    assert(node);
+
+    IrBlockId header = NewBlock(lower);
+    IrBlockId body   = NewBlock(lower);
+    IrBlockId exit   = NewBlock(lower);
+
+    Jump(lower, header);
+    lower->block = header;
+
+    LowerBranch(lower, node->left, body, exit);
+    SealBlock  (lower, body);
+    SealBlock  (lower, exit);
+
+    lower->block = body;
+    LowerBody(lower, node->right);
+    Jump     (lower, header);
+    SealBlock(lower, header);
+
+    lower->block = exit;
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// for node: left = connect(connect(init, condition), step), right = body
+static void LowerFor(IrLower* lower, const Node_t* node)
+{
+    assert(lower);
+    assert(node);
+    assert(node->left);
+    assert(node->left->left);
+
+    const Node_t* init_node      = node->left->left->left;
+    const Node_t* condition_node = node->left->left->right;
+    const Node_t* step_node      = node->left->right;
+
+    LowerBody(lower, init_node);
+
+    IrBlockId header = NewBlock(lower);
+    IrBlockId body   = NewBlock(lower);
+    IrBlockId exit   = NewBlock(lower);
+
+    Jump(lower, header);
+    lower->block = header;
+
+    if (condition_node)
+        LowerBranch(lower, condition_node, body, exit);
+    else
+        Jump(lower, body);
+
+    SealBlock(lower, body);
+    SealBlock(lower, exit);
+
+    lower->block = body;
+    LowerBody(lower, node->right);
+    LowerBody(lower, step_node);
+    Jump     (lower, header);
+    SealBlock(lower, header);
+
+    lower->block = exit;
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void LowerReturn(IrLower* lower, const Node_t* node)
+{
+    assert(lower);
+    assert(node);
+
+    const Node_t* value_node = node->left;
+
+    if (value_node && value_node->type == NodeArgType::initialisation && value_node->data.init == Initialisation::call_function &&
+        value_node->left->data.name.id == lower->function_name->data.name.id)
+        return LowerTailCall(lower, value_node);
+
+    IrValue value = value_node ? LowerExpression(lower, value_node) : NewNumber(lower, 0);
+    IrValue ret   = NewIrInstr(lower->function, lower->block, IrOp::ret);
+    lower->function->instrs[ret].a = value;
+
+    // code after 'return' is not reachable
+    lower->block = NewBlock(lower);
+    SealBlock(lower, lower->block);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// arguments are computed before any parameter is changed, then the body starts again
+static void LowerTailCall(IrLower* lower, const Node_t* node)
+{
+    assert(lower);
+    assert(node);
+
+    IrList values = {};
+    LowerCallArgs(lower, node->left->left, &values);
+
+    size_t arg_i = 0;
+    AssignArgs(lower, lower->function_name->left, values.items, &arg_i);
+
+    if (arg_i != values.size)
+    {
+        NameInfo name = GetInternedName(lower->function->name);
+        EXIT(EXIT_FAILURE, "function '%.*s' takes %lu arguments, but %lu given", (int) name.len, name.name, arg_i, values.size);
+    }
+
+    IrListDtor(&values);
+
+    Jump(lower, lower->body);
+
+    lower->block = NewBlock(lower);
+    SealBlock(lower, lower->block);
+
+    PROFILE_COUNT("ir tail calls", 1);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void AssignArgs(IrLower* lower, const Node_t* node, const IrValue* values, size_t* arg_i)
+{
+    assert(lower);
+    assert(arg_i);
+
+    if (!node) return;
+
+    if (node->type == NodeArgType::connect)
+    {
+        AssignArgs(lower, node->left,  values, arg_i);
+        AssignArgs(lower, node->right, values, arg_i);
+        return;
+    }
+
+    WriteVariable(lower, GetVar(lower, node->left), lower->block, values[*arg_i]);
+
+    (*arg_i)++;
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static IrValue LowerExpression(IrLower* lower, const Node_t* node)
+{
+    assert(lower);
+
+    if (!node)
+        EXIT(EXIT_FAILURE, "here must be expression node");
+
+    switch (node->type)
+    {
+        case NodeArgType::operation: return LowerOperation(lower, node);
+        case NodeArgType::name:      return ReadVariable  (lower, GetVar(lower, node), lower->block);
+
+        case NodeArgType::number:    return LowerNumber   (lower, node);
+
+        case NodeArgType::initialisation:
+        {
+            if (node->data.init == Initialisation::call_function)
+                return LowerCall(lower, node);
+
+            if (node->data.init == Initialisation::assign_variable)
+            {
+                IrValue value = LowerExpression(lower, node->right);
+                WriteVariable(lower, GetVar(lower, node->left), lower->block, value);
+                return value;
+            }
+
+            EXIT(EXIT_FAILURE, "here must be expression node");
+        }
+
+        case NodeArgType::connect:
+        case NodeArgType::type:
+        case NodeArgType::condition:
+        case NodeArgType::cycle:
+        case NodeArgType::dfunction:
+        case NodeArgType::attribute:
+        case NodeArgType::undefined:
+        default: EXIT(EXIT_FAILURE, "here must be expression node");
+    }
+
+    return IrNoValue;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// SPU words are int: doubles are truncated
+static IrValue LowerNumber(IrLower* lower, const Node_t* node)
+{
+    assert(lower);
+    assert(node);
+
+    Number number = node->data.num;
+
+    switch (number.type)
+    {
+        case Type::int_type:    return NewNumber(lower,       number.value.int_val   );
+        case Type::char_type:   return NewNumber(lower,       number.value.char_val  );
+        case Type::double_type: return NewNumber(lower, (int) number.value.double_val);
+        case Type::void_type:
+        case Type::undefined_type:
+        default: EXIT(EXIT_FAILURE, "undef num type.");
+    }
+
+    return IrNoValue;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static IrValue LowerOperation(IrLower* lower, const Node_t* node)
+{
+    assert(lower);
+    assert(node);
+
+    Operation operation = node->data.oper;
+
+    if (operation == Operation::bool_and || operation == Operation::bool_or)
+        return LowerBoolValue(lower, node);
+
+    if (operation == Operation::bool_not)
+    {
+        IrValue value = LowerExpression(lower, node->left);
+        return NewBinary(lower, IrOp::eq, value, NewNumber(lower, 0));
+    }
+
+    // unary minus is 'minus' node without right child
+    if (operation == Operation::minus && !node->right)
+    {
+        IrValue zero  = NewNumber(lower, 0);
+        IrValue value = LowerExpression(lower, node->left);
+        return NewBinary(lower, IrOp::sub, zero, value);
+    }
+
+    IrOp    op    = GetIrOp(operation);
+    IrValue left  = LowerExpression(lower, node->left);
+    IrValue right = LowerExpression(lower, node->right);
+
+    return NewBinary(lower, op, left, right);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// 'and', 'or' value: branches to blocks with 1 and 0, phi of them
+static IrValue LowerBoolValue(IrLower* lower, const Node_t* node)
+{
+    assert(lower);
+    assert(node);
+
+    IrBlockId true_block  = NewBlock(lower);
+    IrBlockId false_block = NewBlock(lower);
+    IrBlockId join_block  = NewBlock(lower);
+
+    LowerBranch(lower, node, true_block, false_block);
+    SealBlock  (lower, true_block);
+    SealBlock  (lower, false_block);
+
+    lower->block = true_block;
+    IrValue one  = NewNumber(lower, 1);
+    Jump(lower, join_block);
+
+    lower->block = false_block;
+    IrValue zero = NewNumber(lower, 0);
+    Jump(lower, join_block);
+
+    SealBlock(lower, join_block);
+    lower->block = join_block;
+
+    IrFunction* function = lower->function;
+    IrValue     phi      = NewIrPhi(function, join_block, NameNoId);
+    size_t      operands = NewIrOperands(function, 2);
+
+    function->instrs[phi].operands       = operands;
+    function->instrs[phi].operands_quant = 2;
+    function->operands.items[operands]     = one;
+    function->operands.items[operands + 1] = zero;
+
+    return phi;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// 'and' / 'or' are lazy: the right operand is computed only when the left does not decide
+static void LowerBranch(IrLower* lower, const Node_t* node, IrBlockId true_block, IrBlockId false_block)
+{
+    assert(lower);
+    assert(node);
+
+    Operation operation = (node->type == NodeArgType::operation) ? node->data.oper : Operation::undefined_operation;
+
+    if (operation == Operation::bool_not)
+        return LowerBranch(lower, node->left, false_block, true_block);
+
+    if (operation == Operation::bool_and || operation == Operation::bool_or)
+    {
+        IrBlockId right_block = NewBlock(lower);
+
+        if (operation == Operation::bool_and)
+            LowerBranch(lower, node->left, right_block, false_block);
+        else
+            LowerBranch(lower, node->left, true_block, right_block);
+
+        SealBlock(lower, right_block);
+        lower->block = right_block;
+
+        return LowerBranch(lower, node->right, true_block, false_block);
+    }
+
+    IrValue     condition = LowerExpression(lower, node);
+    IrFunction* function  = lower->function;
+    IrValue     br        = NewIrInstr(function, lower->block, IrOp::br);
+
+    function->instrs[br].a      = condition;
+    function->instrs[br].target = true_block;
+    function->instrs[br].other  = false_block;
+
+    AddIrPred(function, true_block,  lower->block);
+    AddIrPred(function, false_block, lower->block);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static IrValue LowerCall(IrLower* lower, const Node_t* node)
+{
+    assert(lower);
+    assert(node);
+    assert(node->left);
+
+    IrList values = {};
+    LowerCallArgs(lower, node->left->left, &values);
+
+    IrFunction* function = lower->function;
+    IrValue     call     = NewIrInstr(function, lower->block, IrOp::call);
+    size_t      operands = NewIrOperands(function, values.size);
+
+    function->instrs[call].callee         = node->left->data.name.id;
+    function->instrs[call].operands       = operands;
+    function->instrs[call].operands_quant = values.size;
+
+    for (size_t i = 0; i < values.size; i++)
+        function->operands.items[operands + i] = values.items[i];
+
+    IrListDtor(&values);
+
+    return call;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void LowerCallArgs(IrLower* lower, const Node_t* node, IrList* values)
+{
+    assert(lower);
+    assert(values);
+
+    if (!node) return;
+
+    if (node->type == NodeArgType::connect)
+    {
+        LowerCallArgs(lower, node->left,  values);
+        LowerCallArgs(lower, node->right, values);
+        return;
+    }
+
+    IrListPush(values, LowerExpression(lower, node));
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static IrOp GetIrOp(Operation operation)
+{
+    switch (operation)
+    {
+        case Operation::plus:             return IrOp::add;
+        case Operation::minus:            return IrOp::sub;
+        case Operation::mul:              return IrOp::mul;
+        case Operation::dive:             return IrOp::div;
+        case Operation::power:            return IrOp::pow;
+        case Operation::less:             return IrOp::lt;
+        case Operation::less_or_equal:    return IrOp::le;
+        case Operation::greater:          return IrOp::gt;
+        case Operation::greater_or_equal: return IrOp::ge;
+        case Operation::equal:            return IrOp::eq;
+        case Operation::not_equal:        return IrOp::ne;
+
+        case Operation::assign:
+        case Operation::bool_and:
+        case Operation::bool_or:
+        case Operation::bool_not:
+        case Operation::plus_equal:
+        case Operation::minus_equal:
+        case Operation::mul_equal:
+        case Operation::div_equal:
+        case Operation::plus_plus:
+        case Operation::minus_minus:
+        case Operation::undefined_operation:
+        default: EXIT(EXIT_FAILURE, "operation '%d' has no ir", (int) operation);
+    }
+
+    return IrOp::nop;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static IrBlockId NewBlock(IrLower* lower)
+{
+    assert(lower);
+
+    IrBlockId block = NewIrBlock(lower->function);
+
+    if (block >= lower->blocks_capacity)
+    {
+        size_t capacity = lower->blocks_capacity ? lower->blocks_capacity * 2 : 16;
+
+        lower->blocks = (IrLowerBlock*) realloc(lower->blocks, capacity * sizeof(*lower->blocks));
+        if (!lower->blocks)
+            EXIT(EXIT_FAILURE, "failed realloc memory for ir lowering blocks.");
+
+        memset(lower->blocks + lower->blocks_capacity, 0, (capacity - lower->blocks_capacity) * sizeof(*lower->blocks));
+        lower->blocks_capacity = capacity;
+    }
+
+    lower->blocks[block].is_sealed       = false;
+    lower->blocks[block].incomplete.size = 0;
+
+    // every block has a row of vars_quant definitions, vars_quant is fixed for the function
+    size_t defs_size = (block + 1) * lower->vars_quant;
+
+    if (defs_size > lower->defs_capacity)
+    {
+        lower->defs_capacity = defs_size * 2;
+        lower->defs          = (IrValue*) realloc(lower->defs, lower->defs_capacity * sizeof(*lower->defs));
+        if (!lower->defs)
+            EXIT(EXIT_FAILURE, "failed realloc memory for ir lowering definitions.");
+    }
+
+    for (size_t i = block * lower->vars_quant; i < defs_size; i++)
+        lower->defs[i] = IrNoValue;
+
+    return block;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void SealBlock(IrLower* lower, IrBlockId block)
+{
+    assert(lower);
+    assert(!lower->blocks[block].is_sealed);
+
+    IrList* incomplete = &lower->blocks[block].incomplete;
+
+    lower->blocks[block].is_sealed = true;
+
+    for (size_t i = 0; i < incomplete->size; i++)
+    {
+        IrValue phi = incomplete->items[i];
+        AddPhiOperands(lower, lower->locals[lower->function->instrs[phi].name] - 1, phi);
+    }
+
+    incomplete->size = 0;
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// current block goes to target
+static void Jump(IrLower* lower, IrBlockId target)
+{
+    assert(lower);
+
+    IrValue jmp = NewIrInstr(lower->function, lower->block, IrOp::jmp);
+
+    lower->function->instrs[jmp].target = target;
+    AddIrPred(lower->function, target, lower->block);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static IrValue NewBinary(IrLower* lower, IrOp op, IrValue a, IrValue b)
+{
+    assert(lower);
+
+    IrValue value = NewIrInstr(lower->function, lower->block, op);
+
+    lower->function->instrs[value].a = a;
+    lower->function->instrs[value].b = b;
+
+    return value;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static IrValue NewNumber(IrLower* lower, int number)
+{
+    assert(lower);
+
+    IrValue value = NewIrInstr(lower->function, lower->block, IrOp::number);
+    lower->function->instrs[value].number = number;
+
+    return value;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static size_t GetVar(const IrLower* lower, const Node_t* name_node)
+{
+    assert(lower);
+
+    if (!name_node || name_node->type != NodeArgType::name)
+        EXIT(EXIT_FAILURE, "here must be node with type 'name'");
+
+    size_t local = lower->locals[name_node->data.name.id];
+    assert(local != 0);
+
+    return local - 1;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void WriteVariable(IrLower* lower, size_t var, IrBlockId block, IrValue value)
+{
+    assert(lower);
+    assert(var < lower->vars_quant);
+
+    lower->defs[block * lower->vars_quant + var] = value;
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static IrValue ReadVariable(IrLower* lower, size_t var, IrBlockId block)
+{
+    assert(lower);
+    assert(var < lower->vars_quant);
+
+    IrValue value = lower->defs[block * lower->vars_quant + var];
+
+    if (value != IrNoValue)
+        return value;
+
+    return ReadVariableInPreds(lower, var, block);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static IrValue ReadVariableInPreds(IrLower* lower, size_t var, IrBlockId block)
+{
+    assert(lower);
+
+    IrFunction*   function = lower->function;
+    const IrList* preds    = &function->blocks[block].preds;
+    NameId        name     = lower->vars[var];
+    IrValue       value    = IrNoValue;
+
+    if (!lower->blocks[block].is_sealed)
+    {
+        value = NewIrPhi(function, block, name);
+        IrListPush(&lower->blocks[block].incomplete, value);
+    }
+    else if (preds->size == 0)
+    {
+        value = NewIrInstr(function, IrNoBlock, IrOp::undef);
+
+        function->instrs[value].block = block;
+        function->instrs[value].name  = name;
+
+        IrListPush(&function->blocks[block].phis, value);
+    }
+    else if (preds->size == 1)
+    {
+        value = ReadVariable(lower, var, preds->items[0]);
+    }
+    else
+    {
+        // phi is written before its operands are read, so a cycle through this block ends on it
+        value = NewIrPhi(function, block, name);
+        WriteVariable (lower, var, block, value);
+        AddPhiOperands(lower, var, value);
+    }
+
+    WriteVariable(lower, var, block, value);
+
+    return value;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void AddPhiOperands(IrLower* lower, size_t var, IrValue phi)
+{
+    assert(lower);
+
+    IrFunction* function = lower->function;
+    IrBlockId   block    = function->instrs[phi].block;
+    size_t      quant    = function->blocks[block].preds.size;
+    size_t      operands = NewIrOperands(function, quant);
+
+    function->instrs[phi].operands       = operands;
+    function->instrs[phi].operands_quant = quant;
+
+    for (size_t i = 0; i < quant; i++)
+    {
+        IrValue value = ReadVariable(lower, var, function->blocks[block].preds.items[i]);
+        function->operands.items[operands + i] = value;
+    }
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,1296 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <assert.h>
+#include "ir/ir-opt/ir-opt.hpp"
+#include "lib/lib.hpp"
+#include "profile/profile.hpp"
+#include "name-table/hash.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+enum class IrLatticeType
+{
+    unknown ,   // no executable definition met yet
+    constant,
+    varying ,
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct IrLattice
+{
+    IrLatticeType type;
+    int           value;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct IrConstants
+{
+    IrFunction* function;
+    IrLattice*  lattice;            // by value
+    bool*       executable;         // by block
+    size_t*     edges;              // first edge of the block in executable_edges, edges go in order of preds
+    bool*       executable_edges;
+    bool        is_changed;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct IrValueKey
+{
+    uint64_t op;
+    uint64_t a;
+    uint64_t b;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// dominator tree and scoped table of available pure values
+struct IrNumbering
+{
+    IrFunction* function;
+    IrValue*    replace;
+    size_t*     postorder;          // by block, SIZE_MAX - not reachable
+    IrBlockId*  idom;
+    IrBlockId*  first_child;
+    IrBlockId*  next_sibling;
+
+    IrValue*    table;
+    size_t      table_capacity;     // power of 2
+    IrList      undo;               // filled slots of the table, in order of filling
+    size_t      numbered;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static size_t     RemoveTrivialPhis     (IrFunction* function);
+
+static void       PropagateConstants    (IrFunction* function, IrStats* stats);
+static void       EvaluateBlock         (IrConstants* constants, IrBlockId block);
+static IrLattice  EvaluateInstr         (const IrConstants* constants, const IrInstr* instr);
+static IrLattice  MeetPhi               (const IrConstants* constants, IrBlockId block, const IrInstr* phi);
+static void       SetLattice            (IrConstants* constants, IrValue value, IrLattice lattice);
+static void       MarkEdge              (IrConstants* constants, IrBlockId from, IrBlockId to);
+static void       RewriteConstants      (IrConstants* constants, IrStats* stats);
+static void       RemoveBlock           (IrFunction* function, IrBlockId block);
+static bool       FoldIrValue           (IrOp op, int64_t a, int64_t b, int64_t* value);
+
+static size_t     ThreadJumps           (IrFunction* function);
+
+static size_t     NumberValues          (IrFunction* function);
+static void       BuildDominators       (IrNumbering* numbering);
+static void       NumberPostorder       (IrNumbering* numbering, IrBlockId* rpo, size_t* rpo_size);
+static IrBlockId  IntersectDominators   (const IrNumbering* numbering, IrBlockId a, IrBlockId b);
+static void       NumberBlock           (IrNumbering* numbering, IrBlockId block);
+static bool       IsPure                (IrOp op);
+static IrValueKey GetValueKey           (const IrInstr* instr);
+static bool       IsSameKey             (const IrValueKey* a, const IrValueKey* b);
+
+static size_t     RemoveDeadCode        (IrFunction* function);
+static bool       HasSideEffect         (const IrFunction* function, const IrInstr* instr);
+static void       MarkLive              (bool* live, IrList* worklist, IrValue value);
+
+static void       SinkPhiOperands       (IrFunction* function);
+static bool       IsPhiReadBefore       (const IrFunction* function, IrBlockId target, size_t pred_i, const IrList* sunk, size_t i);
+
+static size_t     GetSuccs              (const IrFunction* function, IrBlockId block, IrBlockId* succs);
+static IrValue    ResolveValue          (IrValue* replace, IrValue value);
+static IrValue*   NewReplace            (const IrFunction* function);
+static void       ReplaceUses           (IrFunction* function, IrValue* replace);
+static void       CompactBlocks         (IrFunction* function);
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void OptimizeIr(IrModule* module, IrStats* stats)
+{
+    assert(module);
+    assert(stats);
+
+    PROFILE_SCOPE("OptimizeIr");
+
+    *stats = {};
+
+    for (size_t i = 0; i < module->functions_quant; i++)
+    {
+        IrFunction* function = &module->functions[i];
+
+        stats->copies   += RemoveTrivialPhis (function);
+        PropagateConstants(function, stats);
+        stats->blocks   += ThreadJumps       (function);
+        stats->copies   += RemoveTrivialPhis (function);
+        stats->numbered += NumberValues      (function);
+        stats->copies   += RemoveTrivialPhis (function);
+        stats->dead     += RemoveDeadCode    (function);
+        SinkPhiOperands(function);
+    }
+
+    PROFILE_COUNT("ir copies",    stats->copies);
+    PROFILE_COUNT("ir constants", stats->constants);
+    PROFILE_COUNT("ir numbered",  stats->numbered);
+    PROFILE_COUNT("ir dead",      stats->dead);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// phi of one value (and itself) is a copy of the value, removing it may make other phis trivial
+static size_t RemoveTrivialPhis(IrFunction* function)
+{
+    assert(function);
+
+    IrValue* replace = NewReplace(function);
+    size_t   removed = 0;
+    bool     is_changed = true;
+
+    while (is_changed)
+    {
+        is_changed = false;
+
+        for (IrBlockId block = 0; block < function->blocks_quant; block++)
+        {
+            const IrList* phis = &function->blocks[block].phis;
+
+            for (size_t i = 0; i < phis->size; i++)
+            {
+                IrValue  phi   = phis->items[i];
+                IrInstr* instr = &function->instrs[phi];
+
+                if (instr->op != IrOp::phi)
+                    continue;
+
+                const IrValue* operands   = GetIrOperands(function, instr);
+                IrValue        same       = IrNoValue;
+                bool           is_trivial = true;
+
+                for (size_t operand_i = 0; operand_i < instr->operands_quant && is_trivial; operand_i++)
+                {
+                    IrValue operand = ResolveValue(replace, operands[operand_i]);
+
+                    if (operand == phi || operand == same)
+                        continue;
+
+                    if (same != IrNoValue)
+                        is_trivial = false;
+
+                    same = operand;
+                }
+
+                if (!is_trivial)
+                    continue;
+
+                // phi only of itself: the variable is not assigned on any path
+                if (same == IrNoValue)
+                {
+                    instr->op             = IrOp::undef;
+                    instr->operands_quant = 0;
+                }
+                else
+                {
+                    instr->op     = IrOp::nop;
+                    replace[phi]  = same;
+                }
+
+                removed++;
+                is_changed = true;
+            }
+        }
+    }
+
+    ReplaceUses  (function, replace);
+    CompactBlocks(function);
+
+    FREE(replace);
+
+    return removed;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void PropagateConstants(IrFunction* function, IrStats* stats)
+{
+    assert(function);
+    assert(stats);
+
+    IrConstants constants = {};
+    constants.function    = function;
+    constants.lattice     = (IrLattice*) calloc(function->instrs_quant,     sizeof(*constants.lattice));
+    constants.executable  = (bool*)      calloc(function->blocks_quant,     sizeof(*constants.executable));
+    constants.edges       = (size_t*)    calloc(function->blocks_quant + 1, sizeof(*constants.edges));
+
+    if (!constants.lattice || !constants.executable || !constants.edges)
+        EXIT(EXIT_FAILURE, "failed calloc memory for constant propagation.");
+
+    for (IrBlockId block = 0; block < function->blocks_quant; block++)
+        constants.edges[block + 1] = constants.edges[block] + function->blocks[block].preds.size;
+
+    constants.executable_edges = (bool*) calloc(constants.edges[function->blocks_quant] + 1, sizeof(*constants.executable_edges));
+    if (!constants.executable_edges)
+        EXIT(EXIT_FAILURE, "failed calloc memory for constant propagation.");
+
+    constants.executable[0] = true;
+    constants.is_changed    = true;
+
+    // lattice values only go down, so the sweeps end
+    while (constants.is_changed)
+    {
+        constants.is_changed = false;
+
+        for (IrBlockId block = 0; block < function->blocks_quant; block++)
+        {
+            if (constants.executable[block])
+                EvaluateBlock(&constants, block);
+        }
+    }
+
+    RewriteConstants(&constants, stats);
+
+    FREE(constants.lattice);
+    FREE(constants.executable);
+    FREE(constants.edges);
+    FREE(constants.executable_edges);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void EvaluateBlock(IrConstants* constants, IrBlockId block)
+{
+    assert(constants);
+
+    IrFunction*    function = constants->function;
+    const IrBlock* ir_block = &function->blocks[block];
+
+    for (size_t i = 0; i < ir_block->phis.size; i++)
+    {
+        IrValue        value = ir_block->phis.items[i];
+        const IrInstr* instr = &function->instrs[value];
+
+        if (instr->op == IrOp::phi)
+            SetLattice(constants, value, MeetPhi(constants, block, instr));
+        else
+            SetLattice(constants, value, {IrLatticeType::varying, 0});
+    }
+
+    for (size_t i = 0; i < ir_block->instrs.size; i++)
+    {
+        IrValue        value = ir_block->instrs.items[i];
+        const IrInstr* instr = &function->instrs[value];
+
+        if (instr->op == IrOp::jmp)
+        {
+            MarkEdge(constants, block, instr->target);
+            continue;
+        }
+
+        if (instr->op == IrOp::br)
+        {
+            IrLattice condition = constants->lattice[instr->a];
+
+            if (condition.type == IrLatticeType::varying || (condition.type == IrLatticeType::constant && condition.value != 0))
+                MarkEdge(constants, block, instr->target);
+
+            if (condition.type == IrLatticeType::varying || (condition.type == IrLatticeType::constant && condition.value == 0))
+                MarkEdge(constants, block, instr->other);
+
+            continue;
+        }
+
+        SetLattice(constants, value, EvaluateInstr(constants, instr));
+    }
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static IrLattice EvaluateInstr(const IrConstants* constants, const IrInstr* instr)
+{
+    assert(constants);
+    assert(instr);
+
+    if (instr->op == IrOp::number)
+        return {IrLatticeType::constant, instr->number};
+
+    if (!IsIrBinary(instr->op))
+        return {IrLatticeType::varying, 0};
+
+    IrLattice a = constants->lattice[instr->a];
+    IrLattice b = constants->lattice[instr->b];
+
+    if (a.type == IrLatticeType::unknown || b.type == IrLatticeType::unknown)
+        return {IrLatticeType::unknown, 0};
+
+    if (a.type == IrLatticeType::varying || b.type == IrLatticeType::varying)
+        return {IrLatticeType::varying, 0};
+
+    int64_t value = 0;
+
+    if (!FoldIrValue(instr->op, a.value, b.value, &value))
+        return {IrLatticeType::varying, 0};
+
+    return {IrLatticeType::constant, (int) value};
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static IrLattice MeetPhi(const IrConstants* constants, IrBlockId block, const IrInstr* phi)
+{
+    assert(constants);
+    assert(phi);
+
+    const IrFunction* function = constants->function;
+    const IrValue*    operands = GetIrOperands(function, phi);
+    IrLattice         result   = {IrLatticeType::unknown, 0};
+
+    for (size_t i = 0; i < phi->operands_quant; i++)
+    {
+        if (!constants->executable_edges[constants->edges[block] + i])
+            continue;
+
+        IrLattice operand = constants->lattice[operands[i]];
+
+        if (operand.type == IrLatticeType::unknown)
+            continue;
+
+        if (operand.type == IrLatticeType::varying ||
+           (result.type == IrLatticeType::constant && result.value != operand.value))
+            return {IrLatticeType::varying, 0};
+
+        result = operand;
+    }
+
+    return result;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void SetLattice(IrConstants* constants, IrValue value, IrLattice lattice)
+{
+    assert(constants);
+
+    IrLattice* old = &constants->lattice[value];
+
+    if (old->type == lattice.type && old->value == lattice.value)
+        return;
+
+    *old = lattice;
+    constants->is_changed = true;
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void MarkEdge(IrConstants* constants, IrBlockId from, IrBlockId to)
+{
+    assert(constants);
+
+    size_t edge = constants->edges[to] + GetIrPredIndex(constants->function, to, from);
+
+    if (constants->executable_edges[edge])
+        return;
+
+    constants->executable_edges[edge] = true;
+    constants->executable[to]         = true;
+    constants->is_changed             = true;
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// constant values become numbers, decided branches - jumps, not executable blocks are removed
+static void RewriteConstants(IrConstants* constants, IrStats* stats)
+{
+    assert(constants);
+    assert(stats);
+
+    IrFunction* function = constants->function;
+
+    for (IrBlockId block = 0; block < function->blocks_quant; block++)
+    {
+        IrBlock* ir_block = &function->blocks[block];
+
+        if (ir_block->is_removed)
+            continue;
+
+        if (!constants->executable[block])
+        {
+            RemoveBlock(function, block);
+            stats->blocks++;
+            continue;
+        }
+
+        for (size_t list_i = 0; list_i < 2; list_i++)
+        {
+            const IrList* list = (list_i == 0) ? &ir_block->phis : &ir_block->instrs;
+
+            for (size_t i = 0; i < list->size; i++)
+            {
+                IrValue   value   = list->items[i];
+                IrInstr*  instr   = &function->instrs[value];
+                IrLattice lattice = constants->lattice[value];
+
+                if (lattice.type != IrLatticeType::constant || instr->op == IrOp::number)
+                    continue;
+
+                if (instr->op != IrOp::phi && !IsIrBinary(instr->op))
+                    continue;
+
+                instr->op             = IrOp::number;
+                instr->number         = lattice.value;
+                instr->a              = IrNoValue;
+                instr->b              = IrNoValue;
+                instr->operands_quant = 0;
+
+                stats->constants++;
+            }
+        }
+
+        IrInstr* terminator = GetIrTerminator(function, block);
+
+        if (!terminator || terminator->op != IrOp::br)
+            continue;
+
+        IrLattice condition = constants->lattice[terminator->a];
+
+        if (condition.type != IrLatticeType::constant)
+            continue;
+
+        IrBlockId taken     = (condition.value != 0) ? terminator->target : terminator->other;
+        IrBlockId not_taken = (condition.value != 0) ? terminator->other  : terminator->target;
+
+        terminator->op     = IrOp::jmp;
+        terminator->a      = IrNoValue;
+        terminator->target = taken;
+        terminator->other  = IrNoBlock;
+
+        if (!function->blocks[not_taken].is_removed)
+            RemoveIrPred(function, not_taken, block);
+
+        stats->branches++;
+    }
+
+    CompactBlocks(function);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void RemoveBlock(IrFunction* function, IrBlockId block)
+{
+    assert(function);
+
+    IrBlockId succs[2]    = {};
+    size_t    succs_quant = GetSuccs(function, block, succs);
+
+    // removed successor has no predecessors already
+    for (size_t i = 0; i < succs_quant; i++)
+    {
+        if (!function->blocks[succs[i]].is_removed)
+            RemoveIrPred(function, succs[i], block);
+    }
+
+    IrBlock* ir_block = &function->blocks[block];
+
+    for (size_t i = 0; i < ir_block->phis.size; i++)
+        function->instrs[ir_block->phis.items[i]].op = IrOp::nop;
+
+    for (size_t i = 0; i < ir_block->instrs.size; i++)
+        function->instrs[ir_block->instrs.items[i]].op = IrOp::nop;
+
+    ir_block->phis.size   = 0;
+    ir_block->instrs.size = 0;
+    ir_block->preds.size  = 0;
+    ir_block->is_removed  = true;
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// same results as SPU gives, int64_t has room for every result except '^', it is checked on every step
+static bool FoldIrValue(IrOp op, int64_t a, int64_t b, int64_t* value)
+{
+    assert(value);
+
+    switch (op)
+    {
+        case IrOp::add: *value = a + b;    break;
+        case IrOp::sub: *value = a - b;    break;
+        case IrOp::mul: *value = a * b;    break;
+        case IrOp::lt:  *value = (a <  b); break;
+        case IrOp::le:  *value = (a <= b); break;
+        case IrOp::gt:  *value = (a >  b); break;
+        case IrOp::ge:  *value = (a >= b); break;
+        case IrOp::eq:  *value = (a == b); break;
+        case IrOp::ne:  *value = (a != b); break;
+
+        case IrOp::div:
+        {
+            if (b == 0)
+                return false;
+
+            *value = a / b;
+            break;
+        }
+
+        // exponent <= 0 gives 1, as the power loop of codegen does
+        case IrOp::pow:
+        {
+            *value = 1;
+
+            for (int64_t i = 0; i < b; i++)
+            {
+                *value *= a;
+
+                if (*value < INT_MIN || *value > INT_MAX)
+                    return false;
+            }
+
+            break;
+        }
+
+        case IrOp::nop:
+        case IrOp::number:
+        case IrOp::arg:
+        case IrOp::undef:
+        case IrOp::phi:
+        case IrOp::call:
+        case IrOp::print:
+        case IrOp::ret:
+        case IrOp::jmp:
+        case IrOp::br:
+        default: return false;
+    }
+
+    return INT_MIN <= *value && *value <= INT_MAX;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// block of one 'jmp' is skipped: its predecessor jumps to the target straight,
+// phis of the target keep their operands, the predecessor takes place of the block in the target preds
+static size_t ThreadJumps(IrFunction* function)
+{
+    assert(function);
+
+    size_t removed = 0;
+
+    for (IrBlockId block = 1; block < function->blocks_quant; block++)
+    {
+        IrBlock* ir_block = &function->blocks[block];
+
+        if (ir_block->is_removed || ir_block->phis.size != 0 || ir_block->instrs.size != 1 || ir_block->preds.size != 1)
+            continue;
+
+        IrInstr*  jump   = GetIrTerminator(function, block);
+        IrBlockId pred   = ir_block->preds.items[0];
+        IrBlockId target = jump ? jump->target : IrNoBlock;
+
+        if (!jump || jump->op != IrOp::jmp || target == block || pred == block)
+            continue;
+
+        IrInstr* pred_jump = GetIrTerminator(function, pred);
+        IrList*  preds     = &function->blocks[target].preds;
+        bool     is_pred   = false;
+
+        for (size_t i = 0; i < preds->size; i++)
+            is_pred = is_pred || preds->items[i] == pred;
+
+        // predecessor with both edges to the target would need two operands in phis for one block
+        if (!pred_jump || is_pred)
+            continue;
+
+        if (pred_jump->target == block) pred_jump->target = target;
+        if (pred_jump->other  == block) pred_jump->other  = target;
+
+        preds->items[GetIrPredIndex(function, target, block)] = pred;
+
+        jump->op              = IrOp::nop;
+        ir_block->instrs.size = 0;
+        ir_block->preds.size  = 0;
+        ir_block->is_removed  = true;
+
+        removed++;
+    }
+
+    return removed;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static size_t NumberValues(IrFunction* function)
+{
+    assert(function);
+
+    IrNumbering numbering = {};
+    numbering.function    = function;
+    numbering.replace     = NewReplace(function);
+
+    numbering.table_capacity = 16;
+    while (numbering.table_capacity < 2 * function->instrs_quant)
+        numbering.table_capacity *= 2;
+
+    numbering.table = (IrValue*) calloc(numbering.table_capacity, sizeof(*numbering.table));
+    if (!numbering.table)
+        EXIT(EXIT_FAILURE, "failed calloc memory for value numbering.");
+
+    for (size_t i = 0; i < numbering.table_capacity; i++)
+        numbering.table[i] = IrNoValue;
+
+    BuildDominators(&numbering);
+    NumberBlock    (&numbering, 0);
+
+    ReplaceUses  (function, numbering.replace);
+    CompactBlocks(function);
+
+    FREE(numbering.replace);
+    FREE(numbering.postorder);
+    FREE(numbering.idom);
+    FREE(numbering.first_child);
+    FREE(numbering.next_sibling);
+    FREE(numbering.table);
+    IrListDtor(&numbering.undo);
+
+    return numbering.numbered;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// Cooper, Harvey, Kennedy: idom of a block is the meeting point of idoms of its processed predecessors
+static void BuildDominators(IrNumbering* numbering)
+{
+    assert(numbering);
+
+    const IrFunction* function     = numbering->function;
+    size_t            blocks_quant = function->blocks_quant;
+
+    numbering->postorder    = (size_t*)    calloc(blocks_quant, sizeof(*numbering->postorder));
+    numbering->idom         = (IrBlockId*) calloc(blocks_quant, sizeof(*numbering->idom));
+    numbering->first_child  = (IrBlockId*) calloc(blocks_quant, sizeof(*numbering->first_child));
+    numbering->next_sibling = (IrBlockId*) calloc(blocks_quant, sizeof(*numbering->next_sibling));
+    IrBlockId* rpo          = (IrBlockId*) calloc(blocks_quant, sizeof(*rpo));
+
+    if (!numbering->postorder || !numbering->idom || !numbering->first_child || !numbering->next_sibling || !rpo)
+        EXIT(EXIT_FAILURE, "failed calloc memory for dominators.");
+
+    for (IrBlockId block = 0; block < blocks_quant; block++)
+    {
+        numbering->idom[block]         = IrNoBlock;
+        numbering->first_child[block]  = IrNoBlock;
+        numbering->next_sibling[block] = IrNoBlock;
+    }
+
+    size_t rpo_size = 0;
+    NumberPostorder(numbering, rpo, &rpo_size);
+
+    numbering->idom[0] = 0;
+    bool is_changed    = true;
+
+    while (is_changed)
+    {
+        is_changed = false;
+
+        for (size_t i = 1; i < rpo_size; i++)
+        {
+            IrBlockId     block    = rpo[i];
+            const IrList* preds    = &function->blocks[block].preds;
+            IrBlockId     new_idom = IrNoBlock;
+
+            for (size_t pred_i = 0; pred_i < preds->size; pred_i++)
+            {
+                IrBlockId pred = preds->items[pred_i];
+
+                if (numbering->idom[pred] == IrNoBlock)
+                    continue;
+
+                new_idom = (new_idom == IrNoBlock) ? pred : IntersectDominators(numbering, pred, new_idom);
+            }
+
+            if (new_idom != numbering->idom[block])
+            {
+                numbering->idom[block] = new_idom;
+                is_changed = true;
+            }
+        }
+    }
+
+    // children are linked in reverse postorder, so dominators are numbered before what they dominate
+    for (size_t i = rpo_size; i-- > 1; )
+    {
+        IrBlockId block  = rpo[i];
+        IrBlockId parent = numbering->idom[block];
+
+        numbering->next_sibling[block] = numbering->first_child[parent];
+        numbering->first_child[parent] = block;
+    }
+
+    FREE(rpo);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// depth first search without recursion: a block is numbered when all its successors are
+static void NumberPostorder(IrNumbering* numbering, IrBlockId* rpo, size_t* rpo_size)
+{
+    assert(numbering);
+    assert(rpo);
+    assert(rpo_size);
+
+    const IrFunction* function     = numbering->function;
+    size_t            blocks_quant = function->blocks_quant;
+
+    IrBlockId* stack      = (IrBlockId*) calloc(blocks_quant, sizeof(*stack));
+    size_t*    next_succ  = (size_t*)    calloc(blocks_quant, sizeof(*next_succ));
+    bool*      is_visited = (bool*)      calloc(blocks_quant, sizeof(*is_visited));
+
+    if (!stack || !next_succ || !is_visited)
+        EXIT(EXIT_FAILURE, "failed calloc memory for dominators.");
+
+    for (IrBlockId block = 0; block < blocks_quant; block++)
+        numbering->postorder[block] = SIZE_MAX;
+
+    size_t stack_size = 0;
+    size_t postorder  = 0;
+
+    stack[stack_size++] = 0;
+    is_visited[0]       = true;
+
+    while (stack_size > 0)
+    {
+        IrBlockId block       = stack[stack_size - 1];
+        IrBlockId succs[2]    = {};
+        size_t    succs_quant = GetSuccs(function, block, succs);
+
+        if (next_succ[block] < succs_quant)
+        {
+            IrBlockId succ = succs[next_succ[block]];
+            next_succ[block]++;
+
+            if (!is_visited[succ])
+            {
+                is_visited[succ]    = true;
+                stack[stack_size++] = succ;
+            }
+
+            continue;
+        }
+
+        numbering->postorder[block] = postorder++;
+        stack_size--;
+    }
+
+    *rpo_size = postorder;
+
+    for (IrBlockId block = 0; block < blocks_quant; block++)
+    {
+        if (numbering->postorder[block] != SIZE_MAX)
+            rpo[postorder - 1 - numbering->postorder[block]] = block;
+    }
+
+    FREE(stack);
+    FREE(next_succ);
+    FREE(is_visited);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static IrBlockId IntersectDominators(const IrNumbering* numbering, IrBlockId a, IrBlockId b)
+{
+    assert(numbering);
+
+    while (a != b)
+    {
+        while (numbering->postorder[a] < numbering->postorder[b]) a = numbering->idom[a];
+        while (numbering->postorder[b] < numbering->postorder[a]) b = numbering->idom[b];
+    }
+
+    return a;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// values of the block are available in blocks it dominates, they leave the table after them
+static void NumberBlock(IrNumbering* numbering, IrBlockId block)
+{
+    assert(numbering);
+
+    IrFunction*   function   = numbering->function;
+    const IrList* instrs     = &function->blocks[block].instrs;
+    size_t        undo_begin = numbering->undo.size;
+    size_t        mask       = numbering->table_capacity - 1;
+
+    for (size_t i = 0; i < instrs->size; i++)
+    {
+        IrValue  value = instrs->items[i];
+        IrInstr* instr = &function->instrs[value];
+
+        if (!IsPure(instr->op))
+            continue;
+
+        if (instr->a != IrNoValue) instr->a = ResolveValue(numbering->replace, instr->a);
+        if (instr->b != IrNoValue) instr->b = ResolveValue(numbering->replace, instr->b);
+
+        IrValueKey key  = GetValueKey(instr);
+        size_t     slot = Hash(&key, 1, sizeof(key)) & mask;
+
+        while (numbering->table[slot] != IrNoValue)
+        {
+            IrValueKey other = GetValueKey(&function->instrs[numbering->table[slot]]);
+
+            if (IsSameKey(&key, &other))
+                break;
+
+            slot = (slot + 1) & mask;
+        }
+
+        if (numbering->table[slot] != IrNoValue)
+        {
+            numbering->replace[value] = numbering->table[slot];
+            instr->op = IrOp::nop;
+            numbering->numbered++;
+            continue;
+        }
+
+        numbering->table[slot] = value;
+        IrListPush(&numbering->undo, slot);
+    }
+
+    for (IrBlockId child = numbering->first_child[block]; child != IrNoBlock; child = numbering->next_sibling[child])
+        NumberBlock(numbering, child);
+
+    // slots are freed in reverse order of filling, so probe chains of the rest values stay whole
+    while (numbering->undo.size > undo_begin)
+    {
+        numbering->undo.size--;
+        numbering->table[numbering->undo.items[numbering->undo.size]] = IrNoValue;
+    }
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// '/' is pure too: the same division in the dominator traps first
+static bool IsPure(IrOp op)
+{
+    return op == IrOp::number || IsIrBinary(op);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// commutative operations get the same key for both orders of operands
+static IrValueKey GetValueKey(const IrInstr* instr)
+{
+    assert(instr);
+
+    IrValueKey key = {};
+    key.op         = (uint64_t) instr->op;
+
+    if (instr->op == IrOp::number)
+    {
+        key.a = (uint32_t) instr->number;
+        return key;
+    }
+
+    bool is_commutative = (instr->op == IrOp::add || instr->op == IrOp::mul || instr->op == IrOp::eq || instr->op == IrOp::ne);
+
+    key.a = (is_commutative && instr->b < instr->a) ? instr->b : instr->a;
+    key.b = (is_commutative && instr->b < instr->a) ? instr->a : instr->b;
+
+    return key;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static bool IsSameKey(const IrValueKey* a, const IrValueKey* b)
+{
+    assert(a);
+    assert(b);
+
+    return a->op == b->op && a->a == b->a && a->b == b->b;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static size_t RemoveDeadCode(IrFunction* function)
+{
+    assert(function);
+
+    bool*  live     = (bool*) calloc(function->instrs_quant, sizeof(*live));
+    IrList worklist = {};
+
+    if (!live)
+        EXIT(EXIT_FAILURE, "failed calloc memory for dead code elimination.");
+
+    for (IrBlockId block = 0; block < function->blocks_quant; block++)
+    {
+        const IrList* instrs = &function->blocks[block].instrs;
+
+        for (size_t i = 0; i < instrs->size; i++)
+        {
+            if (HasSideEffect(function, &function->instrs[instrs->items[i]]))
+                MarkLive(live, &worklist, instrs->items[i]);
+        }
+    }
+
+    while (worklist.size > 0)
+    {
+        worklist.size--;
+
+        const IrInstr* instr    = &function->instrs[worklist.items[worklist.size]];
+        const IrValue* operands = GetIrOperands(function, instr);
+
+        if (instr->a != IrNoValue) MarkLive(live, &worklist, instr->a);
+        if (instr->b != IrNoValue) MarkLive(live, &worklist, instr->b);
+
+        for (size_t i = 0; i < instr->operands_quant; i++)
+            MarkLive(live, &worklist, operands[i]);
+    }
+
+    size_t dead = 0;
+
+    for (IrBlockId block = 0; block < function->blocks_quant; block++)
+    {
+        for (size_t list_i = 0; list_i < 2; list_i++)
+        {
+            const IrList* list = (list_i == 0) ? &function->blocks[block].phis : &function->blocks[block].instrs;
+
+            for (size_t i = 0; i < list->size; i++)
+            {
+                IrInstr* instr = &function->instrs[list->items[i]];
+
+                if (live[list->items[i]] || instr->op == IrOp::nop)
+                    continue;
+
+                instr->op = IrOp::nop;
+                dead++;
+            }
+        }
+    }
+
+    CompactBlocks(function);
+
+    FREE(live);
+    IrListDtor(&worklist);
+
+    return dead;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static bool HasSideEffect(const IrFunction* function, const IrInstr* instr)
+{
+    assert(function);
+    assert(instr);
+
+    switch (instr->op)
+    {
+        case IrOp::call:
+        case IrOp::print:
+        case IrOp::ret:
+        case IrOp::jmp:
+        case IrOp::br:     return true;
+
+        // division by zero stops the programm
+        case IrOp::div:
+        {
+            const IrInstr* divisor = &function->instrs[instr->b];
+            return divisor->op != IrOp::number || divisor->number == 0;
+        }
+
+        case IrOp::nop:
+        case IrOp::number:
+        case IrOp::arg:
+        case IrOp::undef:
+        case IrOp::phi:
+        case IrOp::add:
+        case IrOp::sub:
+        case IrOp::mul:
+        case IrOp::pow:
+        case IrOp::lt:
+        case IrOp::le:
+        case IrOp::gt:
+        case IrOp::ge:
+        case IrOp::eq:
+        case IrOp::ne:
+        default:           return false;
+    }
+
+    return false;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void MarkLive(bool* live, IrList* worklist, IrValue value)
+{
+    assert(live);
+    assert(worklist);
+
+    if (live[value])
+        return;
+
+    live[value] = true;
+    IrListPush(worklist, value);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// value, used only by a phi of the next block, goes to the end of its block:
+// the phi operands are computed after the last read of the phis, so codegen puts them right into the phi slots.
+// Only arithmetic moves: it can not trap, so the order of output stays
+static void SinkPhiOperands(IrFunction* function)
+{
+    assert(function);
+
+    size_t* uses  = (size_t*) calloc(function->instrs_quant + 1, sizeof(*uses));
+    IrList  sunk  = {};
+
+    if (!uses)
+        EXIT(EXIT_FAILURE, "failed calloc memory for ir sinking.");
+
+    for (IrValue value = 0; value < function->instrs_quant; value++)
+    {
+        const IrInstr* instr    = &function->instrs[value];
+        const IrValue* operands = GetIrOperands(function, instr);
+
+        if (instr->op == IrOp::nop || instr->op == IrOp::phi)
+            continue;
+
+        if (instr->a != IrNoValue) uses[instr->a]++;
+        if (instr->b != IrNoValue) uses[instr->b]++;
+
+        for (size_t i = 0; i < instr->operands_quant; i++)
+            uses[operands[i]]++;
+    }
+
+    for (IrBlockId block = 0; block < function->blocks_quant; block++)
+    {
+        IrList*        instrs     = &function->blocks[block].instrs;
+        const IrInstr* terminator = GetIrTerminator(function, block);
+        size_t         size       = 0;
+
+        if (!terminator || terminator->op != IrOp::jmp)
+            continue;
+
+        sunk.size = 0;
+
+        // uses of phis are not counted: value without other uses is used only by phis
+        for (size_t i = 0; i + 1 < instrs->size; i++)
+        {
+            IrValue value = instrs->items[i];
+            IrOp    op    = function->instrs[value].op;
+
+            if (uses[value] == 0 && IsIrBinary(op) && op != IrOp::div)
+                IrListPush(&sunk, value);
+            else
+                instrs->items[size++] = value;
+        }
+
+        // value goes after the other values, which read the phi it is for, if it can
+        size_t pred_i = GetIrPredIndex(function, terminator->target, block);
+
+        while (sunk.size > 0)
+        {
+            size_t next = 0;
+
+            while (next < sunk.size && IsPhiReadBefore(function, terminator->target, pred_i, &sunk, next))
+                next++;
+
+            if (next == sunk.size)
+                next = 0;
+
+            instrs->items[size++] = sunk.items[next];
+
+            memmove(sunk.items + next, sunk.items + next + 1, (sunk.size - next - 1) * sizeof(*sunk.items));
+            sunk.size--;
+        }
+
+        instrs->items[size++] = instrs->items[instrs->size - 1];
+        assert(size == instrs->size);
+    }
+
+    FREE(uses);
+    IrListDtor(&sunk);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// sunk value number i is an operand of a phi, which other sunk values read
+static bool IsPhiReadBefore(const IrFunction* function, IrBlockId target, size_t pred_i, const IrList* sunk, size_t i)
+{
+    assert(function);
+    assert(sunk);
+
+    const IrList* phis = &function->blocks[target].phis;
+
+    for (size_t phi_i = 0; phi_i < phis->size; phi_i++)
+    {
+        IrValue        phi   = phis->items[phi_i];
+        const IrInstr* instr = &function->instrs[phi];
+
+        if (instr->op != IrOp::phi || GetIrOperands(function, instr)[pred_i] != sunk->items[i])
+            continue;
+
+        for (size_t j = 0; j < sunk->size; j++)
+        {
+            const IrInstr* reader = &function->instrs[sunk->items[j]];
+
+            if (j != i && (reader->a == phi || reader->b == phi))
+                return true;
+        }
+    }
+
+    return false;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static size_t GetSuccs(const IrFunction* function, IrBlockId block, IrBlockId* succs)
+{
+    assert(function);
+    assert(succs);
+
+    const IrInstr* terminator = GetIrTerminator(function, block);
+
+    if (!terminator || terminator->op == IrOp::ret)
+        return 0;
+
+    succs[0] = terminator->target;
+
+    if (terminator->op == IrOp::jmp)
+        return 1;
+
+    succs[1] = terminator->other;
+
+    return 2;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static IrValue ResolveValue(IrValue* replace, IrValue value)
+{
+    assert(replace);
+
+    IrValue root = value;
+
+    while (replace[root] != root)
+        root = replace[root];
+
+    while (replace[value] != root)
+    {
+        IrValue next   = replace[value];
+        replace[value] = root;
+        value          = next;
+    }
+
+    return root;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// replace[value] = value: every value stays itself
+static IrValue* NewReplace(const IrFunction* function)
+{
+    assert(function);
+
+    IrValue* replace = (IrValue*) calloc(function->instrs_quant + 1, sizeof(*replace));
+    if (!replace)
+        EXIT(EXIT_FAILURE, "failed calloc memory for ir values.");
+
+    for (IrValue value = 0; value < function->instrs_quant; value++)
+        replace[value] = value;
+
+    return replace;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void ReplaceUses(IrFunction* function, IrValue* replace)
+{
+    assert(function);
+    assert(replace);
+
+    for (IrValue value = 0; value < function->instrs_quant; value++)
+    {
+        IrInstr* instr = &function->instrs[value];
+
+        if (instr->op == IrOp::nop)
+            continue;
+
+        if (instr->a != IrNoValue) instr->a = ResolveValue(replace, instr->a);
+        if (instr->b != IrNoValue) instr->b = ResolveValue(replace, instr->b);
+
+        IrValue* operands = GetIrOperands(function, instr);
+
+        for (size_t i = 0; i < instr->operands_quant; i++)
+            operands[i] = ResolveValue(replace, operands[i]);
+    }
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// removed instructions leave the blocks, phis turned into numbers go to the front of the instructions
+static void CompactBlocks(IrFunction* function)
+{
+    assert(function);
+
+    IrList moved = {};
+
+    for (IrBlockId block = 0; block < function->blocks_quant; block++)
+    {
+        IrBlock* ir_block = &function->blocks[block];
+        size_t   size     = 0;
+
+        moved.size = 0;
+
+        for (size_t i = 0; i < ir_block->phis.size; i++)
+        {
+            IrValue value = ir_block->phis.items[i];
+            IrOp    op    = function->instrs[value].op;
+
+            if (op == IrOp::phi || op == IrOp::undef)
+                ir_block->phis.items[size++] = value;
+            else if (op != IrOp::nop)
+                IrListPush(&moved, value);
+        }
+
+        ir_block->phis.size = size;
+
+        for (size_t i = 0; i < ir_block->instrs.size; i++)
+        {
+            IrValue value = ir_block->instrs.items[i];
+
+            if (function->instrs[value].op != IrOp::nop)
+                IrListPush(&moved, value);
+        }
+
+        ir_block->instrs.size = 0;
+
+        for (size_t i = 0; i < moved.size; i++)
+            IrListPush(&ir_block->instrs, moved.items[i]);
+    }
+
+    IrListDtor(&moved);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,578 @@
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "ir/ir.hpp"
+#include "ir/ir-lower/ir-lower.hpp"
+#include "ir/ir-opt/ir-opt.hpp"
+#include "lib/lib.hpp"
+#include "name-table/interner/interner.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static const size_t IrDefaultCapacity = 16;
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void        IrFunctionDtor   (IrFunction* function);
+static void        PrintIrFunction  (const IrFunction* function, FILE* stream);
+static void        PrintIrInstr     (const IrFunction* function, IrValue value, FILE* stream);
+static void        PrintIrName      (NameId id, FILE* stream);
+static const char* GetIrOpName      (IrOp op);
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void IrModuleCtor(IrModule* module)
+{
+    assert(module);
+
+    *module = {};
+
+    module->functions_capacity = IrDefaultCapacity;
+    module->functions          = (IrFunction*) calloc(module->functions_capacity, sizeof(*module->functions));
+
+    if (!module->functions)
+        EXIT(EXIT_FAILURE, "failed calloc memory for ir module.");
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void IrModuleDtor(IrModule* module)
+{
+    assert(module);
+
+    for (size_t i = 0; i < module->functions_quant; i++)
+        IrFunctionDtor(&module->functions[i]);
+
+    FREE(module->functions);
+    *module = {};
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+IrFunction* NewIrFunction(IrModule* module, NameId name, size_t args_quant)
+{
+    assert(module);
+
+    if (module->functions_quant == module->functions_capacity)
+    {
+        module->functions_capacity *= 2;
+        module->functions           = (IrFunction*) realloc(module->functions, module->functions_capacity * sizeof(*module->functions));
+        if (!module->functions)
+            EXIT(EXIT_FAILURE, "failed realloc memory for ir functions.");
+    }
+
+    IrFunction* function = &module->functions[module->functions_quant];
+    module->functions_quant++;
+
+    *function            = {};
+    function->name       = name;
+    function->args_quant = args_quant;
+
+    function->instrs_capacity = IrDefaultCapacity;
+    function->instrs          = (IrInstr*) calloc(function->instrs_capacity, sizeof(*function->instrs));
+    function->blocks_capacity = IrDefaultCapacity;
+    function->blocks          = (IrBlock*) calloc(function->blocks_capacity, sizeof(*function->blocks));
+
+    if (!function->instrs || !function->blocks)
+        EXIT(EXIT_FAILURE, "failed calloc memory for ir function.");
+
+    return function;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void IrFunctionDtor(IrFunction* function)
+{
+    assert(function);
+
+    for (size_t i = 0; i < function->blocks_quant; i++)
+    {
+        IrListDtor(&function->blocks[i].phis);
+        IrListDtor(&function->blocks[i].instrs);
+        IrListDtor(&function->blocks[i].preds);
+    }
+
+    IrListDtor(&function->operands);
+
+    FREE(function->instrs);
+    FREE(function->blocks);
+    *function = {};
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+IrBlockId NewIrBlock(IrFunction* function)
+{
+    assert(function);
+
+    if (function->blocks_quant == function->blocks_capacity)
+    {
+        function->blocks_capacity *= 2;
+        function->blocks           = (IrBlock*) realloc(function->blocks, function->blocks_capacity * sizeof(*function->blocks));
+        if (!function->blocks)
+            EXIT(EXIT_FAILURE, "failed realloc memory for ir blocks.");
+    }
+
+    function->blocks[function->blocks_quant] = {};
+
+    return function->blocks_quant++;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// instruction is added to the end of the block, IrNoBlock - to no block
+IrValue NewIrInstr(IrFunction* function, IrBlockId block, IrOp op)
+{
+    assert(function);
+    assert(block == IrNoBlock || block < function->blocks_quant);
+
+    if (function->instrs_quant == function->instrs_capacity)
+    {
+        function->instrs_capacity *= 2;
+        function->instrs           = (IrInstr*) realloc(function->instrs, function->instrs_capacity * sizeof(*function->instrs));
+        if (!function->instrs)
+            EXIT(EXIT_FAILURE, "failed realloc memory for ir instructions.");
+    }
+
+    IrValue  value = function->instrs_quant;
+    IrInstr* instr = &function->instrs[value];
+    function->instrs_quant++;
+
+    *instr        = {};
+    instr->op     = op;
+    instr->a      = IrNoValue;
+    instr->b      = IrNoValue;
+    instr->block  = block;
+    instr->target = IrNoBlock;
+    instr->other  = IrNoBlock;
+
+    if (block != IrNoBlock)
+        IrListPush(&function->blocks[block].instrs, value);
+
+    return value;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// operands are added by the caller, one per predecessor
+IrValue NewIrPhi(IrFunction* function, IrBlockId block, NameId name)
+{
+    assert(function);
+    assert(block < function->blocks_quant);
+
+    IrValue phi = NewIrInstr(function, IrNoBlock, IrOp::phi);
+
+    function->instrs[phi].block = block;
+    function->instrs[phi].name  = name;
+
+    IrListPush(&function->blocks[block].phis, phi);
+
+    return phi;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void AddIrPred(IrFunction* function, IrBlockId block, IrBlockId pred)
+{
+    assert(function);
+    assert(block < function->blocks_quant);
+    assert(pred  < function->blocks_quant);
+
+    IrListPush(&function->blocks[block].preds, pred);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// phis lose their operand of the edge
+void RemoveIrPred(IrFunction* function, IrBlockId block, IrBlockId pred)
+{
+    assert(function);
+    assert(block < function->blocks_quant);
+
+    IrBlock* ir_block = &function->blocks[block];
+    size_t   index    = GetIrPredIndex(function, block, pred);
+
+    for (size_t i = 0; i < ir_block->phis.size; i++)
+    {
+        IrInstr* phi = &function->instrs[ir_block->phis.items[i]];
+
+        if (phi->op != IrOp::phi)
+            continue;
+
+        IrValue* operands = GetIrOperands(function, phi);
+
+        memmove(operands + index, operands + index + 1, (phi->operands_quant - index - 1) * sizeof(*operands));
+        phi->operands_quant--;
+    }
+
+    IrList* preds = &ir_block->preds;
+
+    memmove(preds->items + index, preds->items + index + 1, (preds->size - index - 1) * sizeof(*preds->items));
+    preds->size--;
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+size_t GetIrPredIndex(const IrFunction* function, IrBlockId block, IrBlockId pred)
+{
+    assert(function);
+    assert(block < function->blocks_quant);
+
+    const IrList* preds = &function->blocks[block].preds;
+
+    for (size_t i = 0; i < preds->size; i++)
+    {
+        if (preds->items[i] == pred)
+            return i;
+    }
+
+    EXIT(EXIT_FAILURE, "block %lu is not predecessor of block %lu", pred, block);
+
+    return 0;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// place for quant operands, they are filled by the caller
+size_t NewIrOperands(IrFunction* function, size_t quant)
+{
+    assert(function);
+
+    size_t first = function->operands.size;
+
+    for (size_t i = 0; i < quant; i++)
+        IrListPush(&function->operands, IrNoValue);
+
+    return first;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+IrValue* GetIrOperands(const IrFunction* function, const IrInstr* instr)
+{
+    assert(function);
+    assert(instr);
+
+    return function->operands.items + instr->operands;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// nullptr - block is not finished yet
+IrInstr* GetIrTerminator(const IrFunction* function, IrBlockId block)
+{
+    assert(function);
+    assert(block < function->blocks_quant);
+
+    const IrList* instrs = &function->blocks[block].instrs;
+
+    if (instrs->size == 0)
+        return nullptr;
+
+    IrInstr* last = &function->instrs[instrs->items[instrs->size - 1]];
+
+    if (last->op != IrOp::jmp && last->op != IrOp::br && last->op != IrOp::ret)
+        return nullptr;
+
+    return last;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void IrListPush(IrList* list, size_t item)
+{
+    assert(list);
+
+    if (list->size == list->capacity)
+    {
+        list->capacity = list->capacity ? list->capacity * 2 : IrDefaultCapacity / 4;
+        list->items    = (size_t*) realloc(list->items, list->capacity * sizeof(*list->items));
+        if (!list->items)
+            EXIT(EXIT_FAILURE, "failed realloc memory for ir list.");
+    }
+
+    list->items[list->size] = item;
+    list->size++;
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void IrListDtor(IrList* list)
+{
+    assert(list);
+
+    FREE(list->items);
+    *list = {};
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+bool IsIrBinary(IrOp op)
+{
+    switch (op)
+    {
+        case IrOp::add:
+        case IrOp::sub:
+        case IrOp::mul:
+        case IrOp::div:
+        case IrOp::pow:
+        case IrOp::lt:
+        case IrOp::le:
+        case IrOp::gt:
+        case IrOp::ge:
+        case IrOp::eq:
+        case IrOp::ne:     return true;
+
+        case IrOp::nop:
+        case IrOp::number:
+        case IrOp::arg:
+        case IrOp::undef:
+        case IrOp::phi:
+        case IrOp::call:
+        case IrOp::print:
+        case IrOp::ret:
+        case IrOp::jmp:
+        case IrOp::br:
+        default:           return false;
+    }
+
+    return false;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+bool IsIrComparison(IrOp op)
+{
+    return op == IrOp::lt || op == IrOp::le || op == IrOp::gt ||
+           op == IrOp::ge || op == IrOp::eq || op == IrOp::ne;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void PrintIr(const IrModule* module, FILE* stream)
+{
+    assert(module);
+    assert(stream);
+
+    for (size_t i = 0; i < module->functions_quant; i++)
+        PrintIrFunction(&module->functions[i], stream);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// function fact(1)
+// b1: ; preds b0, b3
+//     %2 = phi [%0, b0], [%9, b3]    ; n
+// the optimized IR of the tree, as the back-end gets it with '-ir'
+void DumpIr(const Tree_t* tree, const char* path, FILE* report)
+{
+    assert(tree);
+    assert(path);
+
+    IrModule module = {};
+    IrStats  stats  = {};
+
+    IrModuleCtor(&module);
+    LowerTree   (tree, &module);
+    OptimizeIr  (&module, &stats);
+
+    FILE* stream = fopen(path, "w");
+    if (!stream)
+        EXIT(EXIT_FAILURE, "failed open '%s'", path);
+
+    PrintIr(&module, stream);
+    fclose(stream);
+
+    if (report)
+        fprintf(report, "ir: %lu copies, %lu constants, %lu branches, %lu blocks removed, %lu values numbered, %lu dead\n",
+                        stats.copies, stats.constants, stats.branches, stats.blocks, stats.numbered, stats.dead);
+
+    IrModuleDtor(&module);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void PrintIrFunction(const IrFunction* function, FILE* stream)
+{
+    assert(function);
+    assert(stream);
+
+    fprintf(stream, "function ");
+    PrintIrName(function->name, stream);
+    fprintf(stream, "(%lu)\n", function->args_quant);
+
+    for (IrBlockId block = 0; block < function->blocks_quant; block++)
+    {
+        const IrBlock* ir_block = &function->blocks[block];
+
+        if (ir_block->is_removed)
+            continue;
+
+        fprintf(stream, "b%lu:", block);
+
+        for (size_t i = 0; i < ir_block->preds.size; i++)
+            fprintf(stream, "%s b%lu", (i == 0) ? " ; preds" : ",", ir_block->preds.items[i]);
+
+        fprintf(stream, "\n");
+
+        for (size_t i = 0; i < ir_block->phis.size; i++)
+            PrintIrInstr(function, ir_block->phis.items[i], stream);
+
+        for (size_t i = 0; i < ir_block->instrs.size; i++)
+            PrintIrInstr(function, ir_block->instrs.items[i], stream);
+    }
+
+    fprintf(stream, "\n");
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void PrintIrInstr(const IrFunction* function, IrValue value, FILE* stream)
+{
+    assert(function);
+    assert(stream);
+
+    const IrInstr* instr = &function->instrs[value];
+    IrOp           op    = instr->op;
+
+    if (op == IrOp::nop)
+        return;
+
+    fprintf(stream, "    ");
+
+    if (op != IrOp::print && op != IrOp::ret && op != IrOp::jmp && op != IrOp::br)
+        fprintf(stream, "%%%lu = ", value);
+
+    fprintf(stream, "%s", GetIrOpName(op));
+
+    switch (op)
+    {
+        case IrOp::number:
+        case IrOp::arg:    fprintf(stream, " %d", instr->number); break;
+
+        case IrOp::phi:
+        {
+            const IrValue* operands = GetIrOperands(function, instr);
+            const IrList*  preds    = &function->blocks[instr->block].preds;
+
+            for (size_t i = 0; i < instr->operands_quant; i++)
+                fprintf(stream, "%s [%%%lu, b%lu]", (i == 0) ? "" : ",", operands[i], preds->items[i]);
+
+            break;
+        }
+
+        case IrOp::call:
+        {
+            const IrValue* operands = GetIrOperands(function, instr);
+
+            fprintf(stream, " ");
+            PrintIrName(instr->callee, stream);
+            fprintf(stream, "(");
+
+            for (size_t i = 0; i < instr->operands_quant; i++)
+                fprintf(stream, "%s%%%lu", (i == 0) ? "" : ", ", operands[i]);
+
+            fprintf(stream, ")");
+            break;
+        }
+
+        case IrOp::print:
+        case IrOp::ret:    fprintf(stream, " %%%lu", instr->a);                                      break;
+        case IrOp::jmp:    fprintf(stream, " b%lu", instr->target);                                  break;
+        case IrOp::br:     fprintf(stream, " %%%lu, b%lu, b%lu", instr->a, instr->target, instr->other); break;
+
+        case IrOp::add:
+        case IrOp::sub:
+        case IrOp::mul:
+        case IrOp::div:
+        case IrOp::pow:
+        case IrOp::lt:
+        case IrOp::le:
+        case IrOp::gt:
+        case IrOp::ge:
+        case IrOp::eq:
+        case IrOp::ne:     fprintf(stream, " %%%lu, %%%lu", instr->a, instr->b);                     break;
+
+        case IrOp::nop:
+        case IrOp::undef:
+        default:           break;
+    }
+
+    if (instr->name != NameNoId)
+    {
+        fprintf(stream, "    ; ");
+        PrintIrName(instr->name, stream);
+    }
+
+    fprintf(stream, "\n");
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void PrintIrName(NameId id, FILE* stream)
+{
+    assert(stream);
+
+    NameInfo name = GetInternedName(id);
+
+    fprintf(stream, "%.*s", (int) name.len, name.name);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static const char* GetIrOpName(IrOp op)
+{
+    switch (op)
+    {
+        case IrOp::nop:    return "nop";
+        case IrOp::number: return "number";
+        case IrOp::arg:    return "arg";
+        case IrOp::undef:  return "undef";
+        case IrOp::phi:    return "phi";
+        case IrOp::add:    return "add";
+        case IrOp::sub:    return "sub";
+        case IrOp::mul:    return "mul";
+        case IrOp::div:    return "div";
+        case IrOp::pow:    return "pow";
+        case IrOp::lt:     return "lt";
+        case IrOp::le:     return "le";
+        case IrOp::gt:     return "gt";
+        case IrOp::ge:     return "ge";
+        case IrOp::eq:     return "eq";
+        case IrOp::ne:     return "ne";
+        case IrOp::call:   return "call";
+        case IrOp::print:  return "print";
+        case IrOp::ret:    return "ret";
+        case IrOp::jmp:    return "jmp";
+        case IrOp::br:     return "br";
+        default:           EXIT(EXIT_FAILURE, "undefined ir operation '%d'", (int) op);
+    }
+
+    return nullptr;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
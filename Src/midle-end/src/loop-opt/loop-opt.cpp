@@ -0,0 +1,966 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <assert.h>
+#include "loop-opt/loop-opt.hpp"
+#include "fresh-name/fresh-name.hpp"
+#include "lib/lib.hpp"
+#include "profile/profile.hpp"
+#include "name-table/interner/interner.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// i * k in the cycle, k - number or invariant variable
+struct LoopProduct
+{
+    Node_t*       node;
+    const Node_t* factor;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct LoopOpt
+{
+    NameId           function;
+    NodeArena*       arena;         // arena of the tree, new nodes go to it
+
+    size_t*          stamps;        // stamp of the last cycle, where the name is assigned
+    size_t*          assigns;       // assignments of the name in that cycle
+    size_t           names_capacity;
+    size_t           stamp;
+
+    LoopProduct*     products;
+    size_t           products_quant;
+    size_t           products_capacity;
+
+    LoopStats*       stats;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static const size_t LoopDefaultCapacity = 64;
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void    LoopOptCtor           (LoopOpt* lo, LoopStats* stats, NodeArena* arena);
+static void    LoopOptDtor           (LoopOpt* lo);
+
+static void    ReducePowers          (Node_t* node, NodeArena* arena, LoopStats* stats);
+static void    ReducePower           (Node_t* node, NodeArena* arena);
+
+static void    OptimizeFunctions     (LoopOpt* lo, Node_t* node);
+static void    OptimizeStatements    (LoopOpt* lo, Node_t** slot);
+static void    OptimizeLoop          (LoopOpt* lo, Node_t** slot);
+static bool    MarkAssigns           (LoopOpt* lo, const Node_t* node);
+static void    MarkAssign            (LoopOpt* lo, NameId id);
+static size_t  GetAssigns            (const LoopOpt* lo, NameId id);
+
+static void    HoistInvariants       (LoopOpt* lo, Node_t* node, Node_t** before);
+static bool    IsInvariant           (const LoopOpt* lo, const Node_t* node);
+static bool    IsHoistable           (const Node_t* node);
+
+static void    ReduceWhileInductions (LoopOpt* lo, Node_t* loop, Node_t** slot, Node_t** before);
+static void    ReduceInduction       (LoopOpt* lo, Node_t* loop, NameId id, int step, Node_t** update_slot, Node_t** before);
+static bool    IsInductionStep       (const LoopOpt* lo, const Node_t* node, size_t assigns, NameId* id, int* step);
+static void    CollectProducts       (LoopOpt* lo, Node_t* node, NameId id);
+static void    AddProduct            (LoopOpt* lo, Node_t* node, const Node_t* factor);
+static bool    IsFactor              (const LoopOpt* lo, const Node_t* node);
+static bool    IsSameFactor          (const Node_t* first, const Node_t* second);
+static size_t  CountProducts         (const LoopOpt* lo, size_t first, const Node_t* factor);
+static Node_t* NewInductionStart     (NodeArena* arena, const Node_t* init, NameId id, const Node_t* factor);
+static Node_t* NewInductionUpdate    (NodeArena* arena, NameId reduced, int step, const Node_t* factor);
+static NameId  GetAssignedName       (const Node_t* node);
+
+static bool    IsSideOperation       (Operation operation);
+static bool    HasCallOrAssign       (const Node_t* node);
+static bool    IsIntNumber           (const Node_t* node);
+static bool    IsNonzeroNumber       (const Node_t* node);
+static bool    IsName                (const Node_t* node, NameId id);
+static void    AddStatement          (NodeArena* arena, Node_t** body, Node_t* statement);
+static Node_t* NewIntDefinition      (NodeArena* arena, NameId id, Node_t* value);
+static Node_t* NewNameNode           (NodeArena* arena, NameId id);
+static Node_t* NewIntNumber          (NodeArena* arena, int value);
+static Node_t* CopyNode              (NodeArena* arena, const Node_t* node);
+static void    SetNameNode           (Node_t* node, NameId id);
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void OptimizeLoops(Tree_t* tree, LoopStats* stats)
+{
+    assert(tree);
+    assert(stats);
+
+    PROFILE_SCOPE("OptimizeLoops");
+
+    *stats = {};
+
+    ReducePowers(tree->root, tree->arena, stats);
+
+    LoopOpt lo = {};
+    LoopOptCtor(&lo, stats, tree->arena);
+
+    OptimizeFunctions(&lo, tree->root);
+
+    LoopOptDtor(&lo);
+
+    PROFILE_COUNT("hoisted invariants", stats->hoisted);
+    PROFILE_COUNT("reduced powers",     stats->powers);
+    PROFILE_COUNT("reduced inductions", stats->reduced);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void LoopOptCtor(LoopOpt* lo, LoopStats* stats, NodeArena* arena)
+{
+    assert(lo);
+    assert(stats);
+
+    lo->stats             = stats;
+    lo->arena             = arena;
+    lo->names_capacity    = GetInternedNamesQuant() + 1;
+    lo->products_capacity = LoopDefaultCapacity;
+
+    lo->stamps   = (size_t*)      calloc(lo->names_capacity,    sizeof(size_t));
+    lo->assigns  = (size_t*)      calloc(lo->names_capacity,    sizeof(size_t));
+    lo->products = (LoopProduct*) calloc(lo->products_capacity, sizeof(LoopProduct));
+
+    if (!lo->stamps || !lo->assigns || !lo->products)
+        EXIT(EXIT_FAILURE, "failed calloc memory for loop optimizer.");
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void LoopOptDtor(LoopOpt* lo)
+{
+    assert(lo);
+
+    FREE(lo->stamps);
+    FREE(lo->assigns);
+    FREE(lo->products);
+
+    *lo = {};
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void ReducePowers(Node_t* node, NodeArena* arena, LoopStats* stats)
+{
+    assert(stats);
+
+    if (!node) return;
+
+    ReducePowers(node->left,  arena, stats);
+    ReducePowers(node->right, arena, stats);
+
+    if (node->type != NodeArgType::operation || node->data.oper != Operation::power)
+        return;
+
+    if (!IsIntNumber(node->right) || node->right->data.num.value.int_val > LoopPowerMaxChain)
+        return;
+
+    if (!node->left || node->left->type != NodeArgType::name)
+        return;
+
+    ReducePower(node, arena);
+    stats->powers++;
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// x ^ k: SPU power gives 1 for k <= 0, else x * x * .. * x, the last x is the old base node
+static void ReducePower(Node_t* node, NodeArena* arena)
+{
+    assert(node);
+
+    Node_t* base     = node->left;
+    int     exponent = node->right->data.num.value.int_val;
+
+    TREE_ASSERT(NodeAndUnderTreeDtor(node->right, arena));
+
+    if (exponent <= 0)
+    {
+        TREE_ASSERT(NodeAndUnderTreeDtor(base, arena));
+
+        Number number        = {};
+        number.type          = Type::int_type;
+        number.value.int_val = 1;
+
+        _SET_NUM(node, number);
+        return;
+    }
+
+    if (exponent == 1)
+    {
+        TREE_ASSERT(SetNode(node, base->type, base->data, nullptr, nullptr));
+        TREE_ASSERT(NodeDtor(base, arena));
+        return;
+    }
+
+    Node_t* chain = CopyNode(arena, base);
+
+    for (int i = 2; i < exponent; i++)
+        _MUL(&chain, arena, chain, CopyNode(arena, base));
+
+    _SET_MUL(node, chain, base);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void OptimizeFunctions(LoopOpt* lo, Node_t* node)
+{
+    assert(lo);
+
+    if (!node) return;
+
+    if (node->type == NodeArgType::connect)
+    {
+        OptimizeFunctions(lo, node->left);
+        OptimizeFunctions(lo, node->right);
+        return;
+    }
+
+    if (node->type != NodeArgType::initialisation || node->data.init != Initialisation::def_function)
+        EXIT(EXIT_FAILURE, "here must be def func node");
+
+    Node_t* name_node = node->left->left;
+
+    lo->function = name_node->data.name.id;
+
+    OptimizeStatements(lo, &name_node->right);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// outer cycles first: expression invariant in several nested cycles goes before the outermost of them
+static void OptimizeStatements(LoopOpt* lo, Node_t** slot)
+{
+    assert(lo);
+    assert(slot);
+
+    Node_t* node = *slot;
+
+    if (!node) return;
+
+    if (node->type == NodeArgType::connect)
+    {
+        OptimizeStatements(lo, &node->left);
+        OptimizeStatements(lo, &node->right);
+        return;
+    }
+
+    if (node->type == NodeArgType::condition)
+        return OptimizeStatements(lo, &node->right);
+
+    if (node->type != NodeArgType::cycle)
+        return;
+
+    OptimizeLoop      (lo, slot);
+    OptimizeStatements(lo, &node->right);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// for node: left = connect(connect(init, condition), step), right = body
+static void OptimizeLoop(LoopOpt* lo, Node_t** slot)
+{
+    assert(lo);
+    assert(slot);
+
+    Node_t* loop   = *slot;
+    Node_t* before = nullptr;
+    bool    is_for = (loop->data.cycle == Cycle::for_t);
+
+    lo->stamp++;
+
+    if (!MarkAssigns(lo, loop))
+        return;
+
+    if (is_for)
+    {
+        HoistInvariants(lo, loop->left->left->right, &before);
+        HoistInvariants(lo, loop->left->right,       &before);
+    }
+    else
+        HoistInvariants(lo, loop->left, &before);
+
+    HoistInvariants(lo, loop->right, &before);
+
+    if (is_for)
+    {
+        NameId id   = NameNoId;
+        int    step = 0;
+
+        // 'for' init assigns the induction variable once more
+        size_t assigns = (GetAssignedName(loop->left->left->left) == GetAssignedName(loop->left->right)) ? 2 : 1;
+
+        if (IsInductionStep(lo, loop->left->right, assigns, &id, &step))
+            ReduceInduction(lo, loop, id, step, nullptr, &before);
+    }
+    else
+        ReduceWhileInductions(lo, loop, &loop->right, &before);
+
+    if (!before) return;
+
+    AddStatement(lo->arena, &before, loop);
+    *slot = before;
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// false - cycle has '++', '+=' ..., its variables are not followed
+static bool MarkAssigns(LoopOpt* lo, const Node_t* node)
+{
+    assert(lo);
+
+    if (!node) return true;
+
+    if (node->type == NodeArgType::operation && IsSideOperation(node->data.oper))
+        return false;
+
+    NameId id = GetAssignedName(node);
+
+    if (id != NameNoId)
+        MarkAssign(lo, id);
+
+    return MarkAssigns(lo, node->left) && MarkAssigns(lo, node->right);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void MarkAssign(LoopOpt* lo, NameId id)
+{
+    assert(lo);
+
+    if ((size_t) id >= lo->names_capacity)
+    {
+        size_t old_capacity = lo->names_capacity;
+
+        lo->names_capacity = 2 * (size_t) id + 1;
+        lo->stamps  = (size_t*) realloc(lo->stamps,  lo->names_capacity * sizeof(size_t));
+        lo->assigns = (size_t*) realloc(lo->assigns, lo->names_capacity * sizeof(size_t));
+
+        if (!lo->stamps || !lo->assigns)
+            EXIT(EXIT_FAILURE, "failed realloc memory for loop optimizer names.");
+
+        memset(lo->stamps  + old_capacity, 0, (lo->names_capacity - old_capacity) * sizeof(size_t));
+        memset(lo->assigns + old_capacity, 0, (lo->names_capacity - old_capacity) * sizeof(size_t));
+    }
+
+    if (lo->stamps[id] != lo->stamp)
+    {
+        lo->stamps [id] = lo->stamp;
+        lo->assigns[id] = 0;
+    }
+
+    lo->assigns[id]++;
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static size_t GetAssigns(const LoopOpt* lo, NameId id)
+{
+    assert(lo);
+
+    if ((size_t) id >= lo->names_capacity || lo->stamps[id] != lo->stamp)
+        return 0;
+
+    return lo->assigns[id];
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// the biggest invariant expressions are taken, the node becomes the temp name
+static void HoistInvariants(LoopOpt* lo, Node_t* node, Node_t** before)
+{
+    assert(lo);
+    assert(before);
+
+    if (!node) return;
+
+    if (!IsHoistable(node) || !IsInvariant(lo, node))
+    {
+        HoistInvariants(lo, node->left,  before);
+        HoistInvariants(lo, node->right, before);
+        return;
+    }
+
+    NameId temp = NewFreshName(lo->function, "licm");
+
+    Node_t* moved = nullptr;
+    TREE_ASSERT(NodeCtor(&moved, lo->arena, node->type, node->data, node->left, node->right));
+
+    AddStatement(lo->arena, before, NewIntDefinition(lo->arena, temp, moved));
+    SetNameNode (node, temp);
+
+    lo->stats->hoisted++;
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// value is the same on every iteration and evaluating it before the cycle can not fail or hang
+static bool IsInvariant(const LoopOpt* lo, const Node_t* node)
+{
+    assert(lo);
+
+    if (!node) return true;
+
+    switch (node->type)
+    {
+        case NodeArgType::number:    return true;
+        case NodeArgType::name:      return GetAssigns(lo, node->data.name.id) == 0;
+        case NodeArgType::operation:
+        {
+            Operation operation = node->data.oper;
+
+            if (IsSideOperation(operation))
+                return false;
+
+            if (operation == Operation::dive  && !IsNonzeroNumber(node->right))
+                return false;
+
+            if (operation == Operation::power && !IsIntNumber(node->right))
+                return false;
+
+            return IsInvariant(lo, node->left) && IsInvariant(lo, node->right);
+        }
+
+        case NodeArgType::connect:
+        case NodeArgType::type:
+        case NodeArgType::condition:
+        case NodeArgType::cycle:
+        case NodeArgType::dfunction:
+        case NodeArgType::attribute:
+        case NodeArgType::initialisation:
+        case NodeArgType::undefined:
+        default: return false;
+    }
+
+    return false;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// comparisons and 'and', 'or', 'not' stay in place: their operands are taken, branches keep their jumps
+static bool IsHoistable(const Node_t* node)
+{
+    assert(node);
+
+    if (node->type != NodeArgType::operation || !node->left || !node->right)
+        return false;
+
+    switch (node->data.oper)
+    {
+        case Operation::plus:
+        case Operation::minus:
+        case Operation::mul:
+        case Operation::dive:
+        case Operation::power:               return true;
+
+        case Operation::assign:
+        case Operation::greater:
+        case Operation::greater_or_equal:
+        case Operation::less:
+        case Operation::less_or_equal:
+        case Operation::equal:
+        case Operation::not_equal:
+        case Operation::bool_and:
+        case Operation::bool_or:
+        case Operation::bool_not:
+        case Operation::plus_equal:
+        case Operation::minus_equal:
+        case Operation::mul_equal:
+        case Operation::div_equal:
+        case Operation::plus_plus:
+        case Operation::minus_minus:
+        case Operation::undefined_operation:
+        default: return false;
+    }
+
+    return false;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// 'while' induction step is a statement of the body itself, not of its conditions and cycles
+static void ReduceWhileInductions(LoopOpt* lo, Node_t* loop, Node_t** slot, Node_t** before)
+{
+    assert(lo);
+    assert(loop);
+    assert(slot);
+    assert(before);
+
+    Node_t* node = *slot;
+
+    if (!node) return;
+
+    if (node->type == NodeArgType::connect)
+    {
+        ReduceWhileInductions(lo, loop, &node->left,  before);
+        ReduceWhileInductions(lo, loop, &node->right, before);
+        return;
+    }
+
+    NameId id   = NameNoId;
+    int    step = 0;
+
+    if (IsInductionStep(lo, node, 1, &id, &step))
+        ReduceInduction(lo, loop, id, step, slot, before);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// update_slot - 'while' step statement, the update goes after it; nullptr - 'for', the update ends the body
+static void ReduceInduction(LoopOpt* lo, Node_t* loop, NameId id, int step, Node_t** update_slot, Node_t** before)
+{
+    assert(lo);
+    assert(loop);
+    assert(before);
+
+    bool    is_for = (loop->data.cycle == Cycle::for_t);
+    Node_t* init   = is_for ? loop->left->left->left : nullptr;
+
+    lo->products_quant = 0;
+
+    CollectProducts(lo, is_for ? loop->left->left->right : loop->left, id);
+    CollectProducts(lo, loop->right, id);
+
+    for (size_t i = 0; i < lo->products_quant; i++)
+    {
+        const LoopProduct* product = &lo->products[i];
+
+        // product is already reduced with an equal factor
+        if (product->node->type != NodeArgType::operation)
+            continue;
+
+        if (CountProducts(lo, i, product->factor) < LoopReduceMinUses)
+            continue;
+
+        NameId  reduced = NewFreshName(lo->function, "sr");
+        Node_t* update  = NewInductionUpdate(lo->arena, reduced, step, product->factor);
+        Node_t* start   = update ? NewInductionStart(lo->arena, init, id, product->factor) : nullptr;
+
+        if (!start)
+        {
+            if (update)
+                TREE_ASSERT(NodeAndUnderTreeDtor(update, lo->arena));
+
+            continue;
+        }
+
+        AddStatement(lo->arena, before, NewIntDefinition(lo->arena, reduced, start));
+
+        if (update_slot) _CONNECT(update_slot, lo->arena, *update_slot, update);
+        else             AddStatement(lo->arena, &loop->right, update);
+
+        // the factor of the first product is freed with it, its copy in the start value is compared
+        const Node_t* factor = start->right;
+
+        for (size_t j = i; j < lo->products_quant; j++)
+        {
+            Node_t* node = lo->products[j].node;
+
+            if (node->type != NodeArgType::operation || !IsSameFactor(lo->products[j].factor, factor))
+                continue;
+
+            TREE_ASSERT(NodeAndUnderTreeDtor(node->left,  lo->arena));
+            TREE_ASSERT(NodeAndUnderTreeDtor(node->right, lo->arena));
+            SetNameNode(node, reduced);
+        }
+
+        lo->stats->reduced++;
+    }
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// i = i + c, i = c + i, i = i - c; assigns - quantity of all assignments of i in the cycle
+static bool IsInductionStep(const LoopOpt* lo, const Node_t* node, size_t assigns, NameId* id, int* step)
+{
+    assert(lo);
+    assert(id);
+    assert(step);
+
+    if (!node || node->type != NodeArgType::initialisation || node->data.init != Initialisation::assign_variable)
+        return false;
+
+    NameId        name  = node->left->data.name.id;
+    const Node_t* value = node->right;
+
+    if (GetAssigns(lo, name) != assigns)
+        return false;
+
+    if (!value || value->type != NodeArgType::operation || !value->left || !value->right)
+        return false;
+
+    Operation operation = value->data.oper;
+
+    if (operation == Operation::plus && IsName(value->right, name) && IsIntNumber(value->left))
+    {
+        *id   = name;
+        *step = value->left->data.num.value.int_val;
+        return true;
+    }
+
+    if ((operation == Operation::plus || operation == Operation::minus) && IsName(value->left, name) && IsIntNumber(value->right))
+    {
+        int constant = value->right->data.num.value.int_val;
+
+        if (operation == Operation::minus && constant == INT_MIN)
+            return false;
+
+        *id   = name;
+        *step = (operation == Operation::plus) ? constant : -constant;
+        return true;
+    }
+
+    return false;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void CollectProducts(LoopOpt* lo, Node_t* node, NameId id)
+{
+    assert(lo);
+
+    if (!node) return;
+
+    if (node->type == NodeArgType::operation && node->data.oper == Operation::mul && node->left && node->right)
+    {
+        if (IsName(node->left,  id) && IsFactor(lo, node->right)) return AddProduct(lo, node, node->right);
+        if (IsName(node->right, id) && IsFactor(lo, node->left )) return AddProduct(lo, node, node->left );
+    }
+
+    CollectProducts(lo, node->left,  id);
+    CollectProducts(lo, node->right, id);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void AddProduct(LoopOpt* lo, Node_t* node, const Node_t* factor)
+{
+    assert(lo);
+    assert(node);
+    assert(factor);
+
+    if (lo->products_quant == lo->products_capacity)
+    {
+        lo->products_capacity *= 2;
+        lo->products = (LoopProduct*) realloc(lo->products, lo->products_capacity * sizeof(LoopProduct));
+
+        if (!lo->products)
+            EXIT(EXIT_FAILURE, "failed realloc memory for loop products.");
+    }
+
+    lo->products[lo->products_quant++] = {node, factor};
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static bool IsFactor(const LoopOpt* lo, const Node_t* node)
+{
+    assert(lo);
+    assert(node);
+
+    return IsIntNumber(node) || (node->type == NodeArgType::name && GetAssigns(lo, node->data.name.id) == 0);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static bool IsSameFactor(const Node_t* first, const Node_t* second)
+{
+    assert(first);
+    assert(second);
+
+    if (IsIntNumber(first) && IsIntNumber(second))
+        return first->data.num.value.int_val == second->data.num.value.int_val;
+
+    return first->type == NodeArgType::name && IsName(second, first->data.name.id);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static size_t CountProducts(const LoopOpt* lo, size_t first, const Node_t* factor)
+{
+    assert(lo);
+    assert(factor);
+
+    size_t quant = 0;
+
+    for (size_t i = first; i < lo->products_quant; i++)
+    {
+        if (lo->products[i].node->type == NodeArgType::operation && IsSameFactor(lo->products[i].factor, factor))
+            quant++;
+    }
+
+    return quant;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// i * k before the cycle; 'for' init, that assigns i, is not run yet, so its value is taken instead of i,
+// nullptr - init value has calls or assignments and can not be evaluated twice
+static Node_t* NewInductionStart(NodeArena* arena, const Node_t* init, NameId id, const Node_t* factor)
+{
+    assert(factor);
+
+    Node_t* value = nullptr;
+
+    if (init && GetAssignedName(init) == id)
+    {
+        if (!init->right || HasCallOrAssign(init->right))
+            return nullptr;
+
+        value = CopyNode(arena, init->right);
+    }
+    else
+        value = NewNameNode(arena, id);
+
+    Node_t* start = nullptr;
+    _MUL(&start, arena, value, CopyNode(arena, factor));
+
+    return start;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// reduced = reduced + c * k; nullptr - c * k is out of int or is not a number and not +-k
+static Node_t* NewInductionUpdate(NodeArena* arena, NameId reduced, int step, const Node_t* factor)
+{
+    assert(factor);
+
+    Operation operation = (step < 0) ? Operation::minus : Operation::plus;
+    Node_t*   increment = nullptr;
+
+    if (IsIntNumber(factor))
+    {
+        int64_t value = (int64_t) step * factor->data.num.value.int_val;
+
+        if (value < 0) value = -value;
+
+        if (value > INT_MAX)
+            return nullptr;
+
+        increment = NewIntNumber(arena, (int) value);
+    }
+    else if (step == 1 || step == -1)
+        increment = CopyNode(arena, factor);
+    else
+        return nullptr;
+
+    Node_t* sum = nullptr;
+    _OPER(&sum, arena, operation, NewNameNode(arena, reduced), increment);
+
+    Node_t* update = nullptr;
+    _ASG_VAR(&update, arena, NewNameNode(arena, reduced), sum);
+
+    return update;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// variable of 'int x = ..' and 'x = ..', NameNoId - other node
+static NameId GetAssignedName(const Node_t* node)
+{
+    if (!node || node->type != NodeArgType::initialisation)
+        return NameNoId;
+
+    if (node->data.init == Initialisation::def_variable)
+        return node->left->left->data.name.id;
+
+    if (node->data.init == Initialisation::assign_variable)
+        return node->left->data.name.id;
+
+    return NameNoId;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static bool IsSideOperation(Operation operation)
+{
+    switch (operation)
+    {
+        case Operation::assign:
+        case Operation::plus_equal:
+        case Operation::minus_equal:
+        case Operation::mul_equal:
+        case Operation::div_equal:
+        case Operation::plus_plus:
+        case Operation::minus_minus:         return true;
+
+        case Operation::plus:
+        case Operation::minus:
+        case Operation::mul:
+        case Operation::dive:
+        case Operation::power:
+        case Operation::greater:
+        case Operation::greater_or_equal:
+        case Operation::less:
+        case Operation::less_or_equal:
+        case Operation::equal:
+        case Operation::not_equal:
+        case Operation::bool_and:
+        case Operation::bool_or:
+        case Operation::bool_not:
+        case Operation::undefined_operation:
+        default: return false;
+    }
+
+    return false;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static bool HasCallOrAssign(const Node_t* node)
+{
+    if (!node) return false;
+
+    if (node->type == NodeArgType::initialisation && (node->data.init == Initialisation::call_function || node->data.init == Initialisation::assign_variable))
+        return true;
+
+    if (node->type == NodeArgType::operation && IsSideOperation(node->data.oper))
+        return true;
+
+    return HasCallOrAssign(node->left) || HasCallOrAssign(node->right);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static bool IsIntNumber(const Node_t* node)
+{
+    return node && node->type == NodeArgType::number && node->data.num.type == Type::int_type;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static bool IsNonzeroNumber(const Node_t* node)
+{
+    return IsIntNumber(node) && node->data.num.value.int_val != 0;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static bool IsName(const Node_t* node, NameId id)
+{
+    return node && node->type == NodeArgType::name && node->data.name.id == id;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void AddStatement(NodeArena* arena, Node_t** body, Node_t* statement)
+{
+    assert(body);
+    assert(statement);
+
+    if (!*body)
+    {
+        *body = statement;
+        return;
+    }
+
+    Node_t* connect = nullptr;
+    _CONNECT(&connect, arena, *body, statement);
+    *body = connect;
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static Node_t* NewIntDefinition(NodeArena* arena, NameId id, Node_t* value)
+{
+    assert(value);
+
+    Node_t* type_node = nullptr;
+    _TYPE(&type_node, arena, Type::int_type, NewNameNode(arena, id));
+
+    Node_t* def_node = nullptr;
+    _DEF_VAR(&def_node, arena, type_node, value);
+
+    return def_node;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static Node_t* NewNameNode(NodeArena* arena, NameId id)
+{
+    Name name = {};
+    name.id   = id;
+    name.name = GetInternedName(id);
+
+    Node_t* node = nullptr;
+    _NAME(&node, arena, name);
+
+    return node;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static Node_t* NewIntNumber(NodeArena* arena, int value)
+{
+    Number number        = {};
+    number.type          = Type::int_type;
+    number.value.int_val = value;
+
+    Node_t* node = nullptr;
+    _NUM(&node, arena, number);
+
+    return node;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static Node_t* CopyNode(NodeArena* arena, const Node_t* node)
+{
+    assert(node);
+
+    Node_t* copy = nullptr;
+    TREE_ASSERT(NodeCopy(&copy, arena, node));
+
+    return copy;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void SetNameNode(Node_t* node, NameId id)
+{
+    assert(node);
+
+    Name name = {};
+    name.id   = id;
+    name.name = GetInternedName(id);
+
+    _SET_NAME(node, name);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
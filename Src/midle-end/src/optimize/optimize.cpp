@@ -0,0 +1,66 @@
+#include <assert.h>
+#include "optimize/optimize.hpp"
+#include "tail-recursion/tail-recursion.hpp"
+#include "pure-eval/pure-eval.hpp"
+#include "call-graph/call-graph.hpp"
+#include "inliner/inliner.hpp"
+#include "const-fold/const-fold.hpp"
+#include "loop-opt/loop-opt.hpp"
+#include "unroll/unroll.hpp"
+#include "cse/cse.hpp"
+#include "profile/profile.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void OptimizeTree(Tree_t* tree, const OptimizeOptions* options)
+{
+    assert(tree);
+    assert(options);
+
+    PROFILE_SCOPE("OptimizeTree");
+
+    size_t accumulated = AccumulateTailRecursion(tree);
+
+    EvalStats eval_stats = {};
+    EvaluatePureCalls(tree, options->eval_budget, &eval_stats);
+
+    CallGraph graph = {};
+    CallGraphCtor(&graph, tree);
+
+    InlineReport inline_report = {};
+    InlineFunctions(&graph, tree->arena, &inline_report);
+
+    CallGraphDtor(&graph);
+
+    LoopStats loop_stats = {};
+    OptimizeLoops(tree, &loop_stats);
+
+    UnrollStats unroll_stats = {};
+    UnrollLoops(tree, &options->unroll, &unroll_stats);
+
+    size_t folded = FoldConstants(tree->root, tree->arena);
+
+    CseStats cse_stats = {};
+    EliminateCommonSubexpressions(tree, &cse_stats);
+
+    FILE* report = options->report;
+
+    if (report)
+    {
+        fprintf(report, "tail recursion: %lu functions get accumulator\n", accumulated);
+        fprintf(report, "pure calls: %lu pure functions, %lu calls evaluated, %lu given up\n",
+                        eval_stats.pure, eval_stats.evaluated, eval_stats.gave_up);
+        PrintInlineReport(&inline_report, report);
+        fprintf(report, "loops: %lu invariants hoisted, %lu powers unrolled, %lu inductions reduced\n",
+                        loop_stats.hoisted, loop_stats.powers, loop_stats.reduced);
+        fprintf(report, "unroll: %lu cycles fully unrolled, %lu partially unrolled\n", unroll_stats.full, unroll_stats.partial);
+        fprintf(report, "const fold: %lu nodes folded\n", folded);
+        fprintf(report, "cse: %lu temps, %lu nodes removed\n", cse_stats.temps, cse_stats.removed_nodes);
+    }
+
+    InlineReportDtor(&inline_report);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,959 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <assert.h>
+#include "pure-eval/pure-eval.hpp"
+#include "call-graph/call-graph.hpp"
+#include "const-fold/const-fold.hpp"
+#include "lib/lib.hpp"
+#include "profile/profile.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static const size_t EvalMaxDepth = 256;
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct EvalFunction
+{
+    NameId* vars;           // arguments first, then other variables of the body
+    size_t  vars_quant;
+    size_t  args_quant;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct EvalSlot
+{
+    int  value;
+    bool is_set;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+enum class EvalStatus
+{
+    next ,      // go to the next statement
+    ret  ,      // 'return', value is in Evaluator::ret_value
+    tail ,      // 'return' of self call: arguments are set, body starts again
+    fail ,      // value is not known at compile time
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// 'if' and its 'else if', 'else' are neighbours in the body connect list, not children of one node
+struct EvalIfChain
+{
+    bool is_open;
+    bool is_taken;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct Evaluator
+{
+    const CallGraph* graph;
+    const NodeArena* arena;             // arena of the tree, for NodeDtor()
+    bool*            is_pure;
+    EvalFunction*    functions;
+
+    size_t*          locals;            // locals[NameId] = index + 1 of the variable in the current function, 0 - not its variable
+    EvalSlot*        slots;             // variables of all active calls
+    size_t           slots_quant;
+    size_t           slots_capacity;
+    size_t           base;              // first slot of the current call
+    size_t           function;          // current function index, CallGraphNoFunction - call site
+
+    int              ret_value;
+    size_t           steps;             // nodes left for the current call site
+    size_t           depth;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void       EvaluatorCtor      (Evaluator* ev, const CallGraph* graph, const NodeArena* arena);
+static void       EvaluatorDtor      (Evaluator* ev);
+static void       CollectVars        (Evaluator* ev, EvalFunction* function, const Node_t* node);
+static size_t     CountArgs          (const Node_t* node);
+static void       FindPureFunctions  (Evaluator* ev, EvalStats* stats);
+static bool       HasPrint           (const Node_t* node);
+
+static void       FoldCalls          (Evaluator* ev, Node_t* node, size_t budget, EvalStats* stats);
+static void       FoldCall           (Evaluator* ev, Node_t* node, size_t budget, EvalStats* stats);
+static bool       IsConstant         (const Node_t* node);
+static void       SetIntNumber       (Node_t* node, int value, const NodeArena* arena);
+
+static bool       EvalCall           (Evaluator* ev, const Node_t* node, int* value);
+static bool       EvalArgs           (Evaluator* ev, const Node_t* node, size_t frame, size_t args_quant, size_t* arg_i);
+static void       SetLocals          (Evaluator* ev, size_t function, bool is_entered);
+static size_t     PushSlots          (Evaluator* ev, size_t quant);
+
+static EvalStatus EvalBody           (Evaluator* ev, const Node_t* node);
+static EvalStatus EvalStatements     (Evaluator* ev, const Node_t* node, EvalIfChain* chain);
+static EvalStatus EvalCondition      (Evaluator* ev, const Node_t* node, EvalIfChain* chain);
+static EvalStatus EvalStatement      (Evaluator* ev, const Node_t* node);
+static EvalStatus EvalWhile          (Evaluator* ev, const Node_t* node);
+static EvalStatus EvalFor            (Evaluator* ev, const Node_t* node);
+static EvalStatus EvalReturn         (Evaluator* ev, const Node_t* node);
+static EvalStatus EvalTailCall       (Evaluator* ev, const Node_t* node);
+
+static bool       EvalExpression     (Evaluator* ev, const Node_t* node, int* value);
+static bool       EvalNumber         (const Node_t* node, int* value);
+static bool       EvalOperation      (Evaluator* ev, const Node_t* node, int* value);
+static bool       EvalAssign         (Evaluator* ev, const Node_t* name_node, const Node_t* node, int* value);
+static bool       ReadVariable       (const Evaluator* ev, const Node_t* name_node, int* value);
+static bool       Step               (Evaluator* ev);
+static bool       IsSelfCall         (const Evaluator* ev, const Node_t* node);
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void EvaluatePureCalls(Tree_t* tree, size_t budget, EvalStats* stats)
+{
+    assert(tree);
+    assert(stats);
+
+    PROFILE_SCOPE("EvaluatePureCalls");
+
+    if (budget == 0) return;
+
+    CallGraph graph = {};
+    CallGraphCtor(&graph, tree);
+
+    Evaluator ev = {};
+    EvaluatorCtor(&ev, &graph, tree->arena);
+
+    FindPureFunctions(&ev, stats);
+
+    if (stats->pure != 0)
+        FoldCalls(&ev, tree->root, budget, stats);
+
+    EvaluatorDtor(&ev);
+    CallGraphDtor(&graph);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void EvaluatorCtor(Evaluator* ev, const CallGraph* graph, const NodeArena* arena)
+{
+    assert(ev);
+    assert(graph);
+
+    ev->graph     = graph;
+    ev->arena     = arena;
+    ev->function  = CallGraphNoFunction;
+    ev->is_pure   = (bool*)         calloc(graph->functions_quant + 1, sizeof(*ev->is_pure));
+    ev->functions = (EvalFunction*) calloc(graph->functions_quant + 1, sizeof(*ev->functions));
+    ev->locals    = (size_t*)       calloc(graph->names_quant     + 1, sizeof(*ev->locals));
+
+    if (!ev->is_pure || !ev->functions || !ev->locals)
+        EXIT(EXIT_FAILURE, "failed calloc memory for pure calls evaluation.");
+
+    // variables are collected to one buffer, every function gets a copy of its own
+    NameId* vars = (NameId*) calloc(graph->names_quant + 1, sizeof(*vars));
+    if (!vars)
+        EXIT(EXIT_FAILURE, "failed calloc memory for pure calls evaluation.");
+
+    for (size_t i = 0; i < graph->functions_quant; i++)
+    {
+        const Node_t* name_node = graph->functions[i].name;
+        EvalFunction* function  = &ev->functions[i];
+
+        function->vars       = vars;
+        function->args_quant = CountArgs(name_node->left);
+
+        CollectVars(ev, function, name_node->left);
+        CollectVars(ev, function, name_node->right);
+
+        function->vars = (NameId*) calloc(function->vars_quant + 1, sizeof(*function->vars));
+        if (!function->vars)
+            EXIT(EXIT_FAILURE, "failed calloc memory for pure calls evaluation.");
+
+        memcpy(function->vars, vars, function->vars_quant * sizeof(*vars));
+
+        for (size_t var = 0; var < function->vars_quant; var++)
+            ev->locals[vars[var]] = 0;
+    }
+
+    FREE(vars);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void EvaluatorDtor(Evaluator* ev)
+{
+    assert(ev);
+
+    for (size_t i = 0; i < ev->graph->functions_quant; i++)
+    {
+        FREE(ev->functions[i].vars);
+    }
+
+    FREE(ev->is_pure);
+    FREE(ev->functions);
+    FREE(ev->locals);
+    FREE(ev->slots);
+
+    *ev = {};
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// every name, except names of called functions, is a variable; ev->locals marks the met ones
+static void CollectVars(Evaluator* ev, EvalFunction* function, const Node_t* node)
+{
+    assert(ev);
+    assert(function);
+
+    if (!node) return;
+
+    if (node->type == NodeArgType::initialisation && node->data.init == Initialisation::call_function)
+        return CollectVars(ev, function, node->left->left);
+
+    if (node->type == NodeArgType::name)
+    {
+        NameId id = node->data.name.id;
+
+        assert(id != NameNoId);
+        assert(id <= ev->graph->names_quant);
+
+        if (ev->locals[id] == 0)
+        {
+            function->vars[function->vars_quant] = id;
+            function->vars_quant++;
+            ev->locals[id] = function->vars_quant;
+        }
+    }
+
+    CollectVars(ev, function, node->left);
+    CollectVars(ev, function, node->right);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static size_t CountArgs(const Node_t* node)
+{
+    if (!node) return 0;
+
+    if (node->type == NodeArgType::connect)
+        return CountArgs(node->left) + CountArgs(node->right);
+
+    return 1;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// greatest fixpoint: every function without 'print' is pure, then callers of not pure functions are not pure
+static void FindPureFunctions(Evaluator* ev, EvalStats* stats)
+{
+    assert(ev);
+    assert(stats);
+
+    const CallGraph* graph = ev->graph;
+
+    for (size_t i = 0; i < graph->functions_quant; i++)
+        ev->is_pure[i] = !HasPrint(graph->functions[i].name->right);
+
+    bool is_changed = true;
+
+    while (is_changed)
+    {
+        is_changed = false;
+
+        for (size_t i = 0; i < graph->functions_quant; i++)
+        {
+            const CallGraphFunction* function = &graph->functions[i];
+
+            if (!ev->is_pure[i]) continue;
+
+            for (size_t callee = 0; callee < function->callees_quant; callee++)
+            {
+                if (ev->is_pure[function->callees[callee]]) continue;
+
+                ev->is_pure[i] = false;
+                is_changed     = true;
+                break;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < graph->functions_quant; i++)
+        if (ev->is_pure[i]) stats->pure++;
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static bool HasPrint(const Node_t* node)
+{
+    if (!node) return false;
+
+    if (node->type == NodeArgType::dfunction)
+        return true;
+
+    return HasPrint(node->left) || HasPrint(node->right);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void FoldCalls(Evaluator* ev, Node_t* node, size_t budget, EvalStats* stats)
+{
+    assert(ev);
+    assert(stats);
+
+    if (!node) return;
+
+    if (node->type == NodeArgType::initialisation && node->data.init == Initialisation::call_function)
+        return FoldCall(ev, node, budget, stats);
+
+    FoldCalls(ev, node->left,  budget, stats);
+    FoldCalls(ev, node->right, budget, stats);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void FoldCall(Evaluator* ev, Node_t* node, size_t budget, EvalStats* stats)
+{
+    assert(ev);
+    assert(node);
+    assert(node->left);
+    assert(stats);
+
+    FoldCalls(ev, node->left->left, budget, stats);
+
+    size_t function = GetCallGraphFunction(ev->graph, node->left->data.name.id);
+
+    if (function == CallGraphNoFunction || !ev->is_pure[function] || !IsConstant(node->left->left))
+        return;
+
+    ev->steps = budget;
+    ev->depth = 0;
+
+    int value = 0;
+
+    if (!EvalCall(ev, node, &value))
+    {
+        PROFILE_COUNT("pure calls given up", 1);
+        stats->gave_up++;
+        return;
+    }
+
+    assert(ev->slots_quant == 0);
+
+    SetIntNumber(node, value, ev->arena);
+
+    PROFILE_COUNT("pure calls evaluated", 1);
+    stats->evaluated++;
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static bool IsConstant(const Node_t* node)
+{
+    if (!node) return true;
+
+    if (node->type != NodeArgType::connect && node->type != NodeArgType::operation && node->type != NodeArgType::number)
+        return false;
+
+    return IsConstant(node->left) && IsConstant(node->right);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void SetIntNumber(Node_t* node, int value, const NodeArena* arena)
+{
+    assert(node);
+
+    TREE_ASSERT(NodeAndUnderTreeDtor(node->left,  arena));
+    TREE_ASSERT(NodeAndUnderTreeDtor(node->right, arena));
+
+    Number number        = {};
+    number.type          = Type::int_type;
+    number.value.int_val = value;
+
+    _SET_NUM(node, number);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// arguments are computed in the caller, then its variables are hidden until the callee returns
+static bool EvalCall(Evaluator* ev, const Node_t* node, int* value)
+{
+    assert(ev);
+    assert(node);
+    assert(node->left);
+    assert(value);
+
+    size_t index = GetCallGraphFunction(ev->graph, node->left->data.name.id);
+
+    if (index == CallGraphNoFunction || !ev->is_pure[index] || ev->depth >= EvalMaxDepth)
+        return false;
+
+    const EvalFunction* function = &ev->functions[index];
+    const Node_t*       body     = ev->graph->functions[index].name->right;
+
+    size_t frame = PushSlots(ev, function->vars_quant);
+    size_t arg_i = 0;
+
+    if (!EvalArgs(ev, node->left->left, frame, function->args_quant, &arg_i) || arg_i != function->args_quant)
+    {
+        ev->slots_quant = frame;
+        return false;
+    }
+
+    size_t caller_base     = ev->base;
+    size_t caller_function = ev->function;
+
+    SetLocals(ev, caller_function, false);
+    SetLocals(ev, index,           true);
+
+    ev->base     = frame;
+    ev->function = index;
+    ev->depth++;
+
+    EvalStatus status = EvalStatus::tail;
+
+    while (status == EvalStatus::tail)
+        status = EvalBody(ev, body);
+
+    ev->depth--;
+    ev->base     = caller_base;
+    ev->function = caller_function;
+
+    SetLocals(ev, index,           false);
+    SetLocals(ev, caller_function, true);
+
+    ev->slots_quant = frame;
+
+    // function without 'return' at the end returns 0
+    switch (status)
+    {
+        case EvalStatus::next: *value = 0;             return true;
+        case EvalStatus::ret:  *value = ev->ret_value; return true;
+        case EvalStatus::tail:
+        case EvalStatus::fail:
+        default:                                       return false;
+    }
+
+    return false;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static bool EvalArgs(Evaluator* ev, const Node_t* node, size_t frame, size_t args_quant, size_t* arg_i)
+{
+    assert(ev);
+    assert(arg_i);
+
+    if (!node) return true;
+
+    if (node->type == NodeArgType::connect)
+        return EvalArgs(ev, node->left,  frame, args_quant, arg_i) &&
+               EvalArgs(ev, node->right, frame, args_quant, arg_i);
+
+    if (*arg_i >= args_quant)
+        return false;
+
+    int value = 0;
+
+    if (!EvalExpression(ev, node, &value))
+        return false;
+
+    ev->slots[frame + *arg_i] = {value, true};
+    (*arg_i)++;
+
+    return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void SetLocals(Evaluator* ev, size_t function, bool is_entered)
+{
+    assert(ev);
+
+    if (function == CallGraphNoFunction) return;
+
+    const EvalFunction* eval_function = &ev->functions[function];
+
+    for (size_t var = 0; var < eval_function->vars_quant; var++)
+        ev->locals[eval_function->vars[var]] = is_entered ? var + 1 : 0;
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// new slots are not set, returns the first of them
+static size_t PushSlots(Evaluator* ev, size_t quant)
+{
+    assert(ev);
+
+    size_t first = ev->slots_quant;
+
+    if (first + quant > ev->slots_capacity)
+    {
+        size_t capacity = ev->slots_capacity ? ev->slots_capacity * 2 : 64;
+
+        while (capacity < first + quant)
+            capacity *= 2;
+
+        ev->slots = (EvalSlot*) realloc(ev->slots, capacity * sizeof(*ev->slots));
+        if (!ev->slots)
+            EXIT(EXIT_FAILURE, "failed realloc memory for pure calls evaluation.");
+
+        ev->slots_capacity = capacity;
+    }
+
+    for (size_t i = first; i < first + quant; i++)
+        ev->slots[i] = {};
+
+    ev->slots_quant = first + quant;
+
+    return first;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static EvalStatus EvalBody(Evaluator* ev, const Node_t* node)
+{
+    assert(ev);
+
+    EvalIfChain chain = {};
+
+    return EvalStatements(ev, node, &chain);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static EvalStatus EvalStatements(Evaluator* ev, const Node_t* node, EvalIfChain* chain)
+{
+    assert(ev);
+    assert(chain);
+
+    if (!node) return EvalStatus::next;
+
+    if (node->type == NodeArgType::connect)
+    {
+        EvalStatus status = EvalStatements(ev, node->left, chain);
+
+        if (status != EvalStatus::next)
+            return status;
+
+        return EvalStatements(ev, node->right, chain);
+    }
+
+    if (node->type == NodeArgType::condition)
+        return EvalCondition(ev, node, chain);
+
+    *chain = {};
+
+    return EvalStatement(ev, node);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static EvalStatus EvalCondition(Evaluator* ev, const Node_t* node, EvalIfChain* chain)
+{
+    assert(ev);
+    assert(node);
+    assert(chain);
+
+    switch (node->data.condition)
+    {
+        case Condition::if_t:
+        {
+            chain->is_open  = true;
+            chain->is_taken = false;
+            break;
+        }
+
+        case Condition::else_if_t:
+        {
+            if (!chain->is_open)
+                return EvalStatus::fail;
+
+            break;
+        }
+
+        case Condition::else_t:
+        {
+            if (!chain->is_open)
+                return EvalStatus::fail;
+
+            bool is_taken = chain->is_taken;
+            *chain = {};
+
+            return is_taken ? EvalStatus::next : EvalBody(ev, node->right);
+        }
+
+        case Condition::undefined_condition:
+        default: return EvalStatus::fail;
+    }
+
+    if (chain->is_taken)
+        return EvalStatus::next;
+
+    int condition = 0;
+
+    if (!EvalExpression(ev, node->left, &condition))
+        return EvalStatus::fail;
+
+    if (condition == 0)
+        return EvalStatus::next;
+
+    chain->is_taken = true;
+
+    return EvalBody(ev, node->right);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static EvalStatus EvalStatement(Evaluator* ev, const Node_t* node)
+{
+    assert(ev);
+    assert(node);
+
+    if (!Step(ev))
+        return EvalStatus::fail;
+
+    NodeArgType type  = node->type;
+    int         value = 0;
+
+    if (type == NodeArgType::cycle && node->data.cycle == Cycle::while_t)
+        return EvalWhile(ev, node);
+
+    if (type == NodeArgType::cycle && node->data.cycle == Cycle::for_t)
+        return EvalFor(ev, node);
+
+    if (type == NodeArgType::attribute && node->data.attribute == FunctionAttribute::ret)
+        return EvalReturn(ev, node);
+
+    if (type == NodeArgType::initialisation && node->data.init == Initialisation::def_variable)
+        return EvalAssign(ev, node->left->left, node->right, &value) ? EvalStatus::next : EvalStatus::fail;
+
+    if (type == NodeArgType::initialisation && node->data.init == Initialisation::assign_variable)
+        return EvalAssign(ev, node->left, node->right, &value) ? EvalStatus::next : EvalStatus::fail;
+
+    // expression as statement (function call): its value is not used
+    return EvalExpression(ev, node, &value) ? EvalStatus::next : EvalStatus::fail;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static EvalStatus EvalWhile(Evaluator* ev, const Node_t* node)
+{
+    assert(ev);
+    assert(node);
+
+    while (true)
+    {
+        int condition = 0;
+
+        if (!EvalExpression(ev, node->left, &condition))
+            return EvalStatus::fail;
+
+        if (condition == 0)
+            return EvalStatus::next;
+
+        EvalStatus status = EvalBody(ev, node->right);
+
+        if (status != EvalStatus::next)
+            return status;
+    }
+
+    return EvalStatus::fail;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// for node: left = connect(connect(init, condition), step), right = body
+static EvalStatus EvalFor(Evaluator* ev, const Node_t* node)
+{
+    assert(ev);
+    assert(node);
+    assert(node->left);
+    assert(node->left->left);
+
+    const Node_t* init_node      = node->left->left->left;
+    const Node_t* condition_node = node->left->left->right;
+    const Node_t* step_node      = node->left->right;
+
+    EvalStatus status = EvalBody(ev, init_node);
+
+    if (status != EvalStatus::next)
+        return status;
+
+    while (true)
+    {
+        int condition = 1;
+
+        if (condition_node && !EvalExpression(ev, condition_node, &condition))
+            return EvalStatus::fail;
+
+        if (condition == 0)
+            return EvalStatus::next;
+
+        status = EvalBody(ev, node->right);
+
+        if (status != EvalStatus::next)
+            return status;
+
+        status = EvalBody(ev, step_node);
+
+        if (status != EvalStatus::next)
+            return status;
+
+        // cycle without condition and statements still spends the budget
+        if (!Step(ev))
+            return EvalStatus::fail;
+    }
+
+    return EvalStatus::fail;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static EvalStatus EvalReturn(Evaluator* ev, const Node_t* node)
+{
+    assert(ev);
+    assert(node);
+
+    if (!node->left)
+    {
+        ev->ret_value = 0;
+        return EvalStatus::ret;
+    }
+
+    if (IsSelfCall(ev, node->left))
+        return EvalTailCall(ev, node->left);
+
+    if (!EvalExpression(ev, node->left, &ev->ret_value))
+        return EvalStatus::fail;
+
+    return EvalStatus::ret;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// arguments are computed before any parameter is changed, other variables are not set again, as in a new call
+static EvalStatus EvalTailCall(Evaluator* ev, const Node_t* node)
+{
+    assert(ev);
+    assert(node);
+
+    const EvalFunction* function = &ev->functions[ev->function];
+
+    size_t values = PushSlots(ev, function->args_quant);
+    size_t arg_i  = 0;
+
+    if (!EvalArgs(ev, node->left->left, values, function->args_quant, &arg_i) || arg_i != function->args_quant)
+        return EvalStatus::fail;
+
+    for (size_t var = 0; var < function->vars_quant; var++)
+        ev->slots[ev->base + var] = (var < function->args_quant) ? ev->slots[values + var] : EvalSlot{};
+
+    ev->slots_quant = values;
+
+    return EvalStatus::tail;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static bool EvalExpression(Evaluator* ev, const Node_t* node, int* value)
+{
+    assert(ev);
+    assert(value);
+
+    if (!node || !Step(ev))
+        return false;
+
+    switch (node->type)
+    {
+        case NodeArgType::number:    return EvalNumber   (node, value);
+        case NodeArgType::name:      return ReadVariable (ev, node, value);
+        case NodeArgType::operation: return EvalOperation(ev, node, value);
+
+        case NodeArgType::initialisation:
+        {
+            if (node->data.init == Initialisation::call_function)
+                return EvalCall(ev, node, value);
+
+            if (node->data.init == Initialisation::assign_variable)
+                return EvalAssign(ev, node->left, node->right, value);
+
+            return false;
+        }
+
+        case NodeArgType::connect:
+        case NodeArgType::type:
+        case NodeArgType::condition:
+        case NodeArgType::cycle:
+        case NodeArgType::dfunction:
+        case NodeArgType::attribute:
+        case NodeArgType::undefined:
+        default: return false;
+    }
+
+    return false;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// doubles are truncated by the back-end, so they are left for it
+static bool EvalNumber(const Node_t* node, int* value)
+{
+    assert(node);
+    assert(value);
+
+    Number number = node->data.num;
+
+    switch (number.type)
+    {
+        case Type::int_type:  *value = number.value.int_val;  return true;
+        case Type::char_type: *value = number.value.char_val; return true;
+
+        case Type::double_type:
+        case Type::void_type:
+        case Type::undefined_type:
+        default: return false;
+    }
+
+    return false;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// 'and' / 'or' are lazy: the right operand is computed only when the left does not decide
+static bool EvalOperation(Evaluator* ev, const Node_t* node, int* value)
+{
+    assert(ev);
+    assert(node);
+    assert(value);
+
+    Operation operation = node->data.oper;
+    int       left      = 0;
+    int       right     = 0;
+
+    if (!EvalExpression(ev, node->left, &left))
+        return false;
+
+    if (operation == Operation::bool_and && left == 0)
+    {
+        *value = 0;
+        return true;
+    }
+
+    if (operation == Operation::bool_or && left != 0)
+    {
+        *value = 1;
+        return true;
+    }
+
+    // unary minus is 'minus' node without right child
+    bool is_unary = (operation == Operation::bool_not) || (operation == Operation::minus && !node->right);
+
+    if (!is_unary && !EvalExpression(ev, node->right, &right))
+        return false;
+
+    int64_t result = 0;
+
+    if (!GetFoldedValue(operation, left, right, is_unary, &result))
+        return false;
+
+    if (result < INT_MIN || result > INT_MAX)
+        return false;
+
+    *value = (int) result;
+
+    return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static bool EvalAssign(Evaluator* ev, const Node_t* name_node, const Node_t* node, int* value)
+{
+    assert(ev);
+    assert(name_node);
+    assert(value);
+
+    if (!EvalExpression(ev, node, value))
+        return false;
+
+    size_t local = ev->locals[name_node->data.name.id];
+
+    if (local == 0)
+        return false;
+
+    ev->slots[ev->base + local - 1] = {*value, true};
+
+    return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static bool ReadVariable(const Evaluator* ev, const Node_t* name_node, int* value)
+{
+    assert(ev);
+    assert(name_node);
+    assert(value);
+
+    size_t local = ev->locals[name_node->data.name.id];
+
+    if (local == 0)
+        return false;
+
+    EvalSlot slot = ev->slots[ev->base + local - 1];
+
+    if (!slot.is_set)
+        return false;
+
+    *value = slot.value;
+
+    return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static bool Step(Evaluator* ev)
+{
+    assert(ev);
+
+    if (ev->steps == 0)
+        return false;
+
+    ev->steps--;
+
+    return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static bool IsSelfCall(const Evaluator* ev, const Node_t* node)
+{
+    assert(ev);
+    assert(node);
+
+    return node->type      == NodeArgType::initialisation       &&
+           node->data.init == Initialisation::call_function     &&
+           ev->function    != CallGraphNoFunction               &&
+           node->left->data.name.id == ev->graph->functions[ev->function].name->data.name.id;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,501 @@
+#include <assert.h>
+#include "tail-recursion/tail-recursion.hpp"
+#include "fresh-name/fresh-name.hpp"
+#include "lib/lib.hpp"
+#include "profile/profile.hpp"
+#include "name-table/interner/interner.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct TailFunction
+{
+    NameId           function;
+    Operation        operation;        // '+' or '*' of all accumulating returns, undefined - none met yet
+    size_t           accumulating;     // 'return A op f(..)' quantity
+    bool             is_possible;
+    NodeArena*       arena;            // arena of the tree, new nodes go to it
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void    AccumulateFunctions    (Node_t** slot, NodeArena* arena, size_t* rewritten);
+static bool    AccumulateFunction     (Node_t** slot, NodeArena* arena);
+
+static void    CheckNode              (TailFunction* tail, const Node_t* node);
+static void    CheckReturn            (TailFunction* tail, const Node_t* ret);
+static bool    IsSelfCall             (const Node_t* node, NameId function);
+static bool    HasSelfCall            (const Node_t* node, NameId function);
+static bool    HasCallOrAssign        (const Node_t* node);
+static bool    IsAccumulating         (const Node_t* node, NameId function);
+
+static void    RewriteReturns         (const TailFunction* tail, Node_t* node, NameId acc_function, NameId acc);
+static void    RewriteReturn          (const TailFunction* tail, Node_t* ret,  NameId acc_function, NameId acc);
+static void    RedirectCall           (NodeArena* arena, Node_t* call, NameId acc_function, Node_t* acc_value);
+static Node_t* NewAccOperation        (NodeArena* arena, Operation operation, NameId acc, Node_t* value);
+static Node_t* NewNameNode            (NodeArena* arena, NameId id);
+static Node_t* NewIntNumber           (NodeArena* arena, int value);
+static Node_t* NewParamsCall          (NodeArena* arena, NameId function, const Node_t* params, Node_t* last_arg);
+static void    AddStatement           (NodeArena* arena, Node_t** body, Node_t* statement);
+static void    AddArg                 (NodeArena* arena, Node_t** args, Node_t* arg);
+static void    AddParam               (NodeArena* arena, Node_t** params, Node_t* param);
+static void    AddParamsArgs          (NodeArena* arena, Node_t** args, const Node_t* params);
+static bool    IsReturn               (const Node_t* node);
+static const Node_t* GetLastStatement (const Node_t* node);
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+size_t AccumulateTailRecursion(Tree_t* tree)
+{
+    assert(tree);
+
+    PROFILE_SCOPE("AccumulateTailRecursion");
+
+    size_t rewritten = 0;
+
+    AccumulateFunctions(&tree->root, tree->arena, &rewritten);
+
+    PROFILE_COUNT("accumulated recursions", rewritten);
+
+    return rewritten;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void AccumulateFunctions(Node_t** slot, NodeArena* arena, size_t* rewritten)
+{
+    assert(slot);
+    assert(rewritten);
+
+    Node_t* node = *slot;
+
+    if (!node) return;
+
+    if (node->type == NodeArgType::connect)
+    {
+        AccumulateFunctions(&node->left,  arena, rewritten);
+        AccumulateFunctions(&node->right, arena, rewritten);
+        return;
+    }
+
+    if (node->type != NodeArgType::initialisation || node->data.init != Initialisation::def_function)
+        EXIT(EXIT_FAILURE, "here must be def func node");
+
+    if (AccumulateFunction(slot, arena))
+        (*rewritten)++;
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// slot - place of the def_function node in the functions list, 'f.acc' goes next to it
+static bool AccumulateFunction(Node_t** slot, NodeArena* arena)
+{
+    assert(slot);
+
+    Node_t* def_node  = *slot;
+    Node_t* type_node = def_node->left;
+    Node_t* name_node = type_node->left;
+
+    if (type_node->data.type != Type::int_type)
+        return false;
+
+    TailFunction tail = {};
+    tail.function     = name_node->data.name.id;
+    tail.operation    = Operation::undefined_operation;
+    tail.is_possible  = true;
+    tail.arena        = arena;
+
+    CheckNode(&tail, name_node->right);
+
+    if (!tail.is_possible || tail.accumulating == 0)
+        return false;
+
+    NameId acc_function = NewFreshName(tail.function, "acc");
+    NameId acc          = NewFreshName(acc_function,  "value");
+    int    neutral      = (tail.operation == Operation::plus) ? 0 : 1;
+
+    Node_t* body = name_node->right;
+
+    RewriteReturns(&tail, body, acc_function, acc);
+
+    // function without 'return' at the end returns 0, with the accumulator it is 'acc op 0'
+    if (!IsReturn(GetLastStatement(body)))
+    {
+        Node_t* ret_node = nullptr;
+        _RET(&ret_node, arena, NewAccOperation(arena, tail.operation, acc, NewIntNumber(arena, 0)));
+        AddStatement(arena, &body, ret_node);
+    }
+
+    // f.acc(params, acc)
+    Node_t* params = nullptr;
+    if (name_node->left)
+        TREE_ASSERT(NodeCopy(&params, arena, name_node->left));
+
+    Node_t* acc_param = nullptr;
+    _TYPE(&acc_param, arena, Type::int_type, NewNameNode(arena, acc));
+
+    AddParam(arena, &params, acc_param);
+
+    Node_t* acc_name_node = NewNameNode(arena, acc_function);
+    acc_name_node->left   = params;
+    acc_name_node->right  = body;
+
+    Node_t* acc_type_node = nullptr;
+    _TYPE(&acc_type_node, arena, Type::int_type, acc_name_node);
+
+    Node_t* acc_def_node = nullptr;
+    _DEF_FUNC(&acc_def_node, arena, acc_type_node);
+
+    // f: return f.acc(params, neutral)
+    Node_t* ret_node = nullptr;
+    _RET(&ret_node, arena, NewParamsCall(arena, acc_function, name_node->left, NewIntNumber(arena, neutral)));
+
+    Node_t* new_body = nullptr;
+    _CONNECT(&new_body, arena, ret_node, nullptr);
+    name_node->right = new_body;
+
+    Node_t* functions = nullptr;
+    _CONNECT(&functions, arena, def_node, acc_def_node);
+    *slot = functions;
+
+    return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// calls of f are allowed only as the tail of 'return'
+static void CheckNode(TailFunction* tail, const Node_t* node)
+{
+    assert(tail);
+
+    if (!node || !tail->is_possible) return;
+
+    if (IsReturn(node))
+        return CheckReturn(tail, node);
+
+    if (IsSelfCall(node, tail->function))
+    {
+        tail->is_possible = false;
+        return;
+    }
+
+    CheckNode(tail, node->left);
+    CheckNode(tail, node->right);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void CheckReturn(TailFunction* tail, const Node_t* ret)
+{
+    assert(tail);
+    assert(ret);
+
+    const Node_t* value = ret->left;
+
+    if (IsSelfCall(value, tail->function))
+    {
+        tail->is_possible = !HasSelfCall(value->left->left, tail->function);
+        return;
+    }
+
+    if (!IsAccumulating(value, tail->function))
+    {
+        tail->is_possible = !HasSelfCall(value, tail->function);
+        return;
+    }
+
+    const Node_t* call  = IsSelfCall(value->left, tail->function) ? value->left  : value->right;
+    const Node_t* other = IsSelfCall(value->left, tail->function) ? value->right : value->left;
+
+    if (HasCallOrAssign(other) || HasSelfCall(call->left->left, tail->function))
+    {
+        tail->is_possible = false;
+        return;
+    }
+
+    if (tail->operation != Operation::undefined_operation && tail->operation != value->data.oper)
+    {
+        tail->is_possible = false;
+        return;
+    }
+
+    tail->operation = value->data.oper;
+    tail->accumulating++;
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static bool IsSelfCall(const Node_t* node, NameId function)
+{
+    return node && node->type == NodeArgType::initialisation && node->data.init == Initialisation::call_function &&
+           node->left->data.name.id == function;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static bool HasSelfCall(const Node_t* node, NameId function)
+{
+    if (!node) return false;
+
+    if (IsSelfCall(node, function))
+        return true;
+
+    return HasSelfCall(node->left, function) || HasSelfCall(node->right, function);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static bool HasCallOrAssign(const Node_t* node)
+{
+    if (!node) return false;
+
+    if (node->type == NodeArgType::initialisation && (node->data.init == Initialisation::call_function || node->data.init == Initialisation::assign_variable))
+        return true;
+
+    return HasCallOrAssign(node->left) || HasCallOrAssign(node->right);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// A + f(..), f(..) + A, A * f(..), f(..) * A
+static bool IsAccumulating(const Node_t* node, NameId function)
+{
+    if (!node || node->type != NodeArgType::operation)
+        return false;
+
+    if (node->data.oper != Operation::plus && node->data.oper != Operation::mul)
+        return false;
+
+    if (!node->left || !node->right)
+        return false;
+
+    return IsSelfCall(node->left, function) != IsSelfCall(node->right, function);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void RewriteReturns(const TailFunction* tail, Node_t* node, NameId acc_function, NameId acc)
+{
+    assert(tail);
+
+    if (!node) return;
+
+    if (IsReturn(node))
+        return RewriteReturn(tail, node, acc_function, acc);
+
+    RewriteReturns(tail, node->left,  acc_function, acc);
+    RewriteReturns(tail, node->right, acc_function, acc);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void RewriteReturn(const TailFunction* tail, Node_t* ret, NameId acc_function, NameId acc)
+{
+    assert(tail);
+    assert(ret);
+
+    Node_t* value = ret->left;
+
+    if (IsSelfCall(value, tail->function))
+        return RedirectCall(tail->arena, value, acc_function, NewNameNode(tail->arena, acc));
+
+    if (IsAccumulating(value, tail->function))
+    {
+        bool    is_call_left = IsSelfCall(value->left, tail->function);
+        Node_t* call         = is_call_left ? value->left  : value->right;
+        Node_t* other        = is_call_left ? value->right : value->left;
+
+        RedirectCall(tail->arena, call, acc_function, NewAccOperation(tail->arena, tail->operation, acc, other));
+
+        ret->left = call;
+        TREE_ASSERT(NodeDtor(value, tail->arena));
+        return;
+    }
+
+    // 'return' without value returns 0
+    ret->left = NewAccOperation(tail->arena, tail->operation, acc, value ? value : NewIntNumber(tail->arena, 0));
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void RedirectCall(NodeArena* arena, Node_t* call, NameId acc_function, Node_t* acc_value)
+{
+    assert(call);
+    assert(acc_value);
+
+    Node_t* name_node = call->left;
+
+    name_node->data.name.id   = acc_function;
+    name_node->data.name.name = GetInternedName(acc_function);
+
+    AddArg(arena, &name_node->left, acc_value);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static Node_t* NewAccOperation(NodeArena* arena, Operation operation, NameId acc, Node_t* value)
+{
+    assert(value);
+
+    Node_t* node = nullptr;
+    _OPER(&node, arena, operation, NewNameNode(arena, acc), value);
+
+    return node;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static Node_t* NewNameNode(NodeArena* arena, NameId id)
+{
+    Name name = {};
+    name.id   = id;
+    name.name = GetInternedName(id);
+
+    Node_t* node = nullptr;
+    _NAME(&node, arena, name);
+
+    return node;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static Node_t* NewIntNumber(NodeArena* arena, int value)
+{
+    Number number        = {};
+    number.type          = Type::int_type;
+    number.value.int_val = value;
+
+    Node_t* node = nullptr;
+    _NUM(&node, arena, number);
+
+    return node;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// call of 'function' with parameters of the current function as arguments and one more last argument
+static Node_t* NewParamsCall(NodeArena* arena, NameId function, const Node_t* params, Node_t* last_arg)
+{
+    assert(last_arg);
+
+    Node_t* args = nullptr;
+
+    AddParamsArgs(arena, &args, params);
+    AddArg       (arena, &args, last_arg);
+
+    Node_t* name_node = NewNameNode(arena, function);
+    name_node->left   = args;
+
+    Node_t* call_node = nullptr;
+    _CALL_FUNC(&call_node, arena, name_node);
+
+    return call_node;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void AddStatement(NodeArena* arena, Node_t** body, Node_t* statement)
+{
+    assert(body);
+    assert(statement);
+
+    Node_t* connect = nullptr;
+    _CONNECT(&connect, arena, *body, statement);
+    *body = connect;
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// arguments list as front-end makes it: connect(arg_1, connect(arg_2, arg_3))
+static void AddArg(NodeArena* arena, Node_t** args, Node_t* arg)
+{
+    assert(args);
+    assert(arg);
+
+    while (*args && (*args)->type == NodeArgType::connect)
+        args = &(*args)->right;
+
+    if (!*args)
+    {
+        *args = arg;
+        return;
+    }
+
+    Node_t* connect = nullptr;
+    _CONNECT(&connect, arena, *args, arg);
+    *args = connect;
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// parameters list: connect(type_1, connect(type_2, nullptr)), names are in left of types
+static void AddParam(NodeArena* arena, Node_t** params, Node_t* param)
+{
+    assert(params);
+    assert(param);
+
+    while (*params)
+        params = &(*params)->right;
+
+    _CONNECT(params, arena, param, nullptr);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void AddParamsArgs(NodeArena* arena, Node_t** args, const Node_t* params)
+{
+    assert(args);
+
+    if (!params) return;
+
+    if (params->type == NodeArgType::connect)
+    {
+        AddParamsArgs(arena, args, params->left);
+        AddParamsArgs(arena, args, params->right);
+        return;
+    }
+
+    AddArg(arena, args, NewNameNode(arena, params->left->data.name.id));
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static bool IsReturn(const Node_t* node)
+{
+    return node && node->type == NodeArgType::attribute && node->data.attribute == FunctionAttribute::ret;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static const Node_t* GetLastStatement(const Node_t* node)
+{
+    if (!node) return nullptr;
+
+    if (node->type != NodeArgType::connect)
+        return node;
+
+    const Node_t* last = GetLastStatement(node->right);
+
+    return last ? last : GetLastStatement(node->left);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
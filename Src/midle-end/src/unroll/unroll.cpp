@@ -0,0 +1,598 @@
+#include <stdint.h>
+#include <limits.h>
+#include <assert.h>
+#include "unroll/unroll.hpp"
+#include "lib/lib.hpp"
+#include "profile/profile.hpp"
+#include "name-table/interner/interner.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct UnrollCycle
+{
+    Node_t*   cycle;
+    Node_t*   init;             // 'for' init, nullptr - 'while'
+    Node_t**  condition;
+    Node_t*   step;             // 'for' step, nullptr - 'while', its step ends the body
+    NameId    counter;
+    Operation comparison;
+    int       step_value;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+struct Unroll
+{
+    const UnrollConfig* config;
+    UnrollStats*        stats;
+    NodeArena*          arena;      // arena of the tree, new nodes go to it
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void    UnrollFunctions    (Unroll* unroll, Node_t* node);
+static void    UnrollStatements   (Unroll* unroll, Node_t** slot);
+static bool    GetCycleShape      (Node_t* cycle, UnrollCycle* shape);
+static bool    UnrollFully        (Unroll* unroll, Node_t** slot, const UnrollCycle* shape);
+static bool    UnrollPartially    (Unroll* unroll, Node_t** slot, const UnrollCycle* shape);
+
+static bool    GetStepValue       (const Node_t* node, NameId counter, int* step_value);
+static bool    IsComparison       (Operation operation);
+static bool    Compare            (int64_t left, int64_t right, Operation comparison);
+static size_t  CountAssigns       (const Node_t* node, NameId id);
+static bool    IsSideOperation    (Operation operation);
+static bool    HasSideOperation   (const Node_t* node);
+static NameId  GetAssignedName    (const Node_t* node);
+static void    ReplaceName        (Node_t* node, NameId id, int value);
+static size_t  GetTreeSize        (const Node_t* node);
+static const Node_t* GetLastStatement (const Node_t* node);
+
+static bool    IsIntNumber        (const Node_t* node);
+static void    AddStatement       (NodeArena* arena, Node_t** body, Node_t* statement);
+static Node_t* NewNameNode        (NodeArena* arena, NameId id);
+static Node_t* NewIntNumber       (NodeArena* arena, int value);
+static Node_t* CopyNode           (NodeArena* arena, const Node_t* node);
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void UnrollLoops(Tree_t* tree, const UnrollConfig* config, UnrollStats* stats)
+{
+    assert(tree);
+    assert(config);
+    assert(stats);
+
+    PROFILE_SCOPE("UnrollLoops");
+
+    *stats = {};
+
+    if (config->factor < 2)
+        return;
+
+    Unroll unroll = {config, stats, tree->arena};
+
+    UnrollFunctions(&unroll, tree->root);
+
+    PROFILE_COUNT("fully unrolled cycles",     stats->full);
+    PROFILE_COUNT("partially unrolled cycles", stats->partial);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void UnrollFunctions(Unroll* unroll, Node_t* node)
+{
+    assert(unroll);
+
+    if (!node) return;
+
+    if (node->type == NodeArgType::connect)
+    {
+        UnrollFunctions(unroll, node->left);
+        UnrollFunctions(unroll, node->right);
+        return;
+    }
+
+    if (node->type != NodeArgType::initialisation || node->data.init != Initialisation::def_function)
+        EXIT(EXIT_FAILURE, "here must be def func node");
+
+    UnrollStatements(unroll, &node->left->left->right);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void UnrollStatements(Unroll* unroll, Node_t** slot)
+{
+    assert(unroll);
+    assert(slot);
+
+    Node_t* node = *slot;
+
+    if (!node) return;
+
+    if (node->type == NodeArgType::connect)
+    {
+        UnrollStatements(unroll, &node->left);
+        UnrollStatements(unroll, &node->right);
+        return;
+    }
+
+    if (node->type == NodeArgType::condition)
+        return UnrollStatements(unroll, &node->right);
+
+    if (node->type != NodeArgType::cycle)
+        return;
+
+    UnrollStatements(unroll, &node->right);
+
+    UnrollCycle shape = {};
+
+    if (!GetCycleShape(node, &shape))
+        return;
+
+    if (!UnrollFully(unroll, slot, &shape))
+        UnrollPartially(unroll, slot, &shape);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// for node: left = connect(connect(init, condition), step), right = body
+static bool GetCycleShape(Node_t* cycle, UnrollCycle* shape)
+{
+    assert(cycle);
+    assert(shape);
+
+    bool is_for = (cycle->data.cycle == Cycle::for_t);
+
+    shape->cycle     = cycle;
+    shape->init      = is_for ? cycle->left->left->left  : nullptr;
+    shape->condition = is_for ? &cycle->left->left->right : &cycle->left;
+    shape->step      = is_for ? cycle->left->right       : nullptr;
+
+    const Node_t* condition = *shape->condition;
+
+    if (!condition || condition->type != NodeArgType::operation || !IsComparison(condition->data.oper))
+        return false;
+
+    const Node_t* counter = condition->left;
+    const Node_t* bound   = condition->right;
+
+    if (!counter || counter->type != NodeArgType::name)
+        return false;
+
+    if (!bound || (!IsIntNumber(bound) && bound->type != NodeArgType::name))
+        return false;
+
+    shape->counter    = counter->data.name.id;
+    shape->comparison = condition->data.oper;
+
+    if (!GetStepValue(is_for ? shape->step : GetLastStatement(cycle->right), shape->counter, &shape->step_value))
+        return false;
+
+    bool is_up = (shape->comparison == Operation::less || shape->comparison == Operation::less_or_equal);
+
+    if (shape->step_value == 0 || (shape->step_value > 0) != is_up)
+        return false;
+
+    if (HasSideOperation(cycle))
+        return false;
+
+    size_t assigns = (GetAssignedName(shape->init) == shape->counter) ? 2 : 1;
+
+    if (CountAssigns(cycle, shape->counter) != assigns)
+        return false;
+
+    if (bound->type == NodeArgType::name && CountAssigns(cycle, bound->data.name.id) != 0)
+        return false;
+
+    return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// init; body with i = value_1; body with i = value_2; ...; i = value after the last step
+static bool UnrollFully(Unroll* unroll, Node_t** slot, const UnrollCycle* shape)
+{
+    assert(unroll);
+    assert(slot);
+    assert(shape);
+
+    Node_t* init  = shape->init;
+    Node_t* bound = (*shape->condition)->right;
+
+    if (!init || GetAssignedName(init) != shape->counter || !IsIntNumber(init->right) || !IsIntNumber(bound))
+        return false;
+
+    int64_t first = init->right->data.num.value.int_val;
+    int64_t last  = first;
+    size_t  trips = 0;
+
+    while (Compare(last, bound->data.num.value.int_val, shape->comparison))
+    {
+        if (++trips > unroll->config->full_trips)
+            return false;
+
+        last += shape->step_value;
+
+        if (last < INT_MIN || last > INT_MAX)
+            return false;
+    }
+
+    Node_t* cycle = shape->cycle;
+    Node_t* body  = cycle->right;
+
+    if (trips * GetTreeSize(body) > unroll->config->budget)
+        return false;
+
+    Node_t* statements = init;
+    cycle->left->left->left = nullptr;
+
+    for (size_t i = 0; i < trips && body; i++)
+    {
+        Node_t* copy = CopyNode(unroll->arena, body);
+        ReplaceName (copy, shape->counter, (int) (first + (int64_t) i * shape->step_value));
+        AddStatement(unroll->arena, &statements, copy);
+    }
+
+    Node_t* final_assign = nullptr;
+    _ASG_VAR(&final_assign, unroll->arena, NewNameNode(unroll->arena, shape->counter), NewIntNumber(unroll->arena, (int) last));
+
+    AddStatement(unroll->arena, &statements, final_assign);
+
+    TREE_ASSERT(NodeAndUnderTreeDtor(cycle, unroll->arena));
+    *slot = statements;
+
+    unroll->stats->full++;
+
+    return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// cycle (i + (factor - 1) * c cmp bound) { body; step; ...; body; step } while (i cmp bound) { body; step }
+static bool UnrollPartially(Unroll* unroll, Node_t** slot, const UnrollCycle* shape)
+{
+    assert(unroll);
+    assert(slot);
+    assert(shape);
+
+    Node_t* cycle     = shape->cycle;
+    Node_t* body      = cycle->right;
+    size_t  body_size = GetTreeSize(body) + GetTreeSize(shape->step);
+    size_t  factor    = unroll->config->factor;
+
+    // main cycle gets factor - 1 more bodies, remainder - one
+    while (factor >= 2 && body_size * factor > unroll->config->budget)
+        factor--;
+
+    if (factor < 2)
+        return false;
+
+    int64_t offset = (int64_t) (factor - 1) * shape->step_value;
+
+    if (offset < -INT_MAX || offset > INT_MAX)
+        return false;
+
+    Node_t* condition = *shape->condition;
+
+    Node_t* remainder_body = body ? CopyNode(unroll->arena, body) : nullptr;
+    if (shape->step)
+        AddStatement(unroll->arena, &remainder_body, CopyNode(unroll->arena, shape->step));
+
+    Node_t* remainder = nullptr;
+    _WHILE(&remainder, unroll->arena, condition, remainder_body);
+
+    Node_t* shifted = nullptr;
+    _OPER(&shifted, unroll->arena, (offset > 0) ? Operation::plus : Operation::minus, NewNameNode(unroll->arena, shape->counter), NewIntNumber(unroll->arena, (int) (offset > 0 ? offset : -offset)));
+
+    Node_t* guard = nullptr;
+    _OPER(&guard, unroll->arena, shape->comparison, shifted, CopyNode(unroll->arena, condition->right));
+
+    *shape->condition = guard;
+
+    Node_t* unrolled = nullptr;
+
+    for (size_t i = 0; i + 1 < factor; i++)
+    {
+        if (body)        AddStatement(unroll->arena, &unrolled, CopyNode(unroll->arena, body));
+        if (shape->step) AddStatement(unroll->arena, &unrolled, CopyNode(unroll->arena, shape->step));
+    }
+
+    if (body)
+        AddStatement(unroll->arena, &unrolled, body);
+
+    cycle->right = unrolled;
+
+    _CONNECT(slot, unroll->arena, cycle, remainder);
+
+    unroll->stats->partial++;
+
+    return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// i = i + c, i = c + i, i = i - c
+static bool GetStepValue(const Node_t* node, NameId counter, int* step_value)
+{
+    assert(step_value);
+
+    if (GetAssignedName(node) != counter || node->data.init != Initialisation::assign_variable)
+        return false;
+
+    const Node_t* value = node->right;
+
+    if (!value || value->type != NodeArgType::operation || !value->left || !value->right)
+        return false;
+
+    const Node_t* left  = value->left;
+    const Node_t* right = value->right;
+    bool is_left_counter  = (left->type  == NodeArgType::name && left->data.name.id  == counter);
+    bool is_right_counter = (right->type == NodeArgType::name && right->data.name.id == counter);
+
+    if (value->data.oper == Operation::plus && is_right_counter && IsIntNumber(left))
+    {
+        *step_value = left->data.num.value.int_val;
+        return true;
+    }
+
+    if (!is_left_counter || !IsIntNumber(right))
+        return false;
+
+    int constant = right->data.num.value.int_val;
+
+    if (value->data.oper == Operation::plus)
+    {
+        *step_value = constant;
+        return true;
+    }
+
+    if (value->data.oper == Operation::minus && constant != INT_MIN)
+    {
+        *step_value = -constant;
+        return true;
+    }
+
+    return false;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static bool IsComparison(Operation operation)
+{
+    return operation == Operation::less    || operation == Operation::less_or_equal ||
+           operation == Operation::greater || operation == Operation::greater_or_equal;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static bool Compare(int64_t left, int64_t right, Operation comparison)
+{
+    switch (comparison)
+    {
+        case Operation::less:             return left <  right;
+        case Operation::less_or_equal:    return left <= right;
+        case Operation::greater:          return left >  right;
+        case Operation::greater_or_equal: return left >= right;
+
+        case Operation::plus:
+        case Operation::minus:
+        case Operation::mul:
+        case Operation::dive:
+        case Operation::power:
+        case Operation::assign:
+        case Operation::equal:
+        case Operation::not_equal:
+        case Operation::bool_and:
+        case Operation::bool_or:
+        case Operation::bool_not:
+        case Operation::plus_equal:
+        case Operation::minus_equal:
+        case Operation::mul_equal:
+        case Operation::div_equal:
+        case Operation::plus_plus:
+        case Operation::minus_minus:
+        case Operation::undefined_operation:
+        default: EXIT(EXIT_FAILURE, "here must be comparison");
+    }
+
+    return false;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static size_t CountAssigns(const Node_t* node, NameId id)
+{
+    if (!node) return 0;
+
+    size_t assigns = (GetAssignedName(node) == id) ? 1 : 0;
+
+    return assigns + CountAssigns(node->left, id) + CountAssigns(node->right, id);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static bool IsSideOperation(Operation operation)
+{
+    switch (operation)
+    {
+        case Operation::assign:
+        case Operation::plus_equal:
+        case Operation::minus_equal:
+        case Operation::mul_equal:
+        case Operation::div_equal:
+        case Operation::plus_plus:
+        case Operation::minus_minus:         return true;
+
+        case Operation::plus:
+        case Operation::minus:
+        case Operation::mul:
+        case Operation::dive:
+        case Operation::power:
+        case Operation::greater:
+        case Operation::greater_or_equal:
+        case Operation::less:
+        case Operation::less_or_equal:
+        case Operation::equal:
+        case Operation::not_equal:
+        case Operation::bool_and:
+        case Operation::bool_or:
+        case Operation::bool_not:
+        case Operation::undefined_operation:
+        default: return false;
+    }
+
+    return false;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// '++', '+=' ... change variables without assignment nodes
+static bool HasSideOperation(const Node_t* node)
+{
+    if (!node) return false;
+
+    if (node->type == NodeArgType::operation && IsSideOperation(node->data.oper))
+        return true;
+
+    return HasSideOperation(node->left) || HasSideOperation(node->right);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// variable of 'int x = ..' and 'x = ..', NameNoId - other node
+static NameId GetAssignedName(const Node_t* node)
+{
+    if (!node || node->type != NodeArgType::initialisation)
+        return NameNoId;
+
+    if (node->data.init == Initialisation::def_variable)
+        return node->left->left->data.name.id;
+
+    if (node->data.init == Initialisation::assign_variable)
+        return node->left->data.name.id;
+
+    return NameNoId;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+// function names of calls are not variables, only their arguments are looked at
+static void ReplaceName(Node_t* node, NameId id, int value)
+{
+    if (!node) return;
+
+    if (node->type == NodeArgType::initialisation && node->data.init == Initialisation::call_function)
+        return ReplaceName(node->left->left, id, value);
+
+    if (node->type == NodeArgType::name && node->data.name.id == id)
+    {
+        Number number        = {};
+        number.type          = Type::int_type;
+        number.value.int_val = value;
+
+        _SET_NUM(node, number);
+        return;
+    }
+
+    ReplaceName(node->left,  id, value);
+    ReplaceName(node->right, id, value);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static size_t GetTreeSize(const Node_t* node)
+{
+    if (!node) return 0;
+
+    return 1 + GetTreeSize(node->left) + GetTreeSize(node->right);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static const Node_t* GetLastStatement(const Node_t* node)
+{
+    if (!node) return nullptr;
+
+    if (node->type != NodeArgType::connect)
+        return node;
+
+    const Node_t* last = GetLastStatement(node->right);
+
+    return last ? last : GetLastStatement(node->left);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static bool IsIntNumber(const Node_t* node)
+{
+    return node && node->type == NodeArgType::number && node->data.num.type == Type::int_type;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static void AddStatement(NodeArena* arena, Node_t** body, Node_t* statement)
+{
+    assert(body);
+    assert(statement);
+
+    if (!*body)
+    {
+        *body = statement;
+        return;
+    }
+
+    Node_t* connect = nullptr;
+    _CONNECT(&connect, arena, *body, statement);
+    *body = connect;
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static Node_t* NewNameNode(NodeArena* arena, NameId id)
+{
+    Name name = {};
+    name.id   = id;
+    name.name = GetInternedName(id);
+
+    Node_t* node = nullptr;
+    _NAME(&node, arena, name);
+
+    return node;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static Node_t* NewIntNumber(NodeArena* arena, int value)
+{
+    Number number        = {};
+    number.type          = Type::int_type;
+    number.value.int_val = value;
+
+    Node_t* node = nullptr;
+    _NUM(&node, arena, number);
+
+    return node;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+static Node_t* CopyNode(NodeArena* arena, const Node_t* node)
+{
+    assert(node);
+
+    Node_t* copy = nullptr;
+    TREE_ASSERT(NodeCopy(&copy, arena, node));
+
+    return copy;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,14 @@
+int foo(int a, int b, int c)
+{
+    return foo(a, b, c);
+}
+
+void main(int argc, char argv)
+{
+    int a = argc + 1;
+    a = a + 3;
+    if (a > 2) { a = a * 2 - 1; }
+    while (a < 100) { a = a * 2; }
+    for (int i = 0; i < 10; i = i + 1) { a = a + i; }
+    return a + argv;
+}
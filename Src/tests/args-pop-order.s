@@ -0,0 +1,12 @@
+int f1(int a, int b, int c)
+{
+    if (a > 0) { return c; }
+    return 6 * f1(a - 1, c - 4, c);
+}
+
+void main()
+{
+    int r = f1(2, 4, -1);
+    print(r);
+    return 0;
+}
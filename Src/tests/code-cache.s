@@ -0,0 +1,46 @@
+int leaf(int x)
+{
+    return x * 3 + 1;
+}
+
+int twice(int x)
+{
+    return leaf(leaf(x));
+}
+
+int loop_calls(int n)
+{
+    int s = 0;
+    for (int i = 0; i < n; i = i + 1)
+    {
+        s = s + twice(i) - leaf(i);
+    }
+    return s;
+}
+
+int rec(int n)
+{
+    if (n < 1) { return 0; }
+    return leaf(n) + rec(n - 1);
+}
+
+int args(int a, int b, int c, int d)
+{
+    return a * 1000 + b * 100 + c * 10 + d;
+}
+
+void main()
+{
+    int four = 4;
+
+    int r = twice(four);
+    print(r);
+    r = loop_calls(four * 2);
+    print(r);
+    r = rec(four + 1);
+    print(r);
+    r = args(four - 3, four - 2, four - 1, four);
+    print(r);
+    r = args(leaf(0), twice(0), rec(1), leaf(four) / 13);
+    print(r);
+}
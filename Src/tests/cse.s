@@ -0,0 +1,52 @@
+int noisy(int x)
+{
+    print(x);
+    return x;
+}
+
+int mix(int a, int b, int c)
+{
+    int x = a * b + c;
+    int y = a * b - c;
+    int z = (a * b + c) * (a * b - c);
+    return x + y + z;
+}
+
+int stale(int a, int b)
+{
+    int x = a * b;
+    a = a + 1;
+    int y = a * b;
+    return x * 100 + y;
+}
+
+int branches(int a, int b)
+{
+    int x = (a + b) * 2;
+    if (a > b) { x = x + (a + b) * 3; }
+    else { x = x - (a + b); }
+    int y = (a + b) * 2;
+    return x + y;
+}
+
+void main()
+{
+    int a = 7;
+    int b = 5;
+    int c = 3;
+
+    int r = mix(a, b, c);
+    print(r);
+    r = stale(a, b);
+    print(r);
+    r = branches(a, b);
+    print(r);
+    r = branches(b, a);
+    print(r);
+
+    int x = (a - c) * (b + c) + (a - c) * (b + c);
+    print(x);
+
+    int y = noisy(a) + noisy(a);
+    print(y);
+}
@@ -0,0 +1,64 @@
+int sq(int x)
+{
+    return x * x;
+}
+
+int add3(int a, int b, int c)
+{
+    return a + b + c;
+}
+
+int clamp(int x, int lo, int hi)
+{
+    int r = x;
+    if (x < lo) { r = lo; }
+    if (x > hi) { r = hi; }
+    return r;
+}
+
+int shout(int x)
+{
+    print(x);
+    return x + 1;
+}
+
+int is_even(int n)
+{
+    if (n == 0) { return 1; }
+    return is_odd(n - 1);
+}
+
+int is_odd(int n)
+{
+    if (n == 0) { return 0; }
+    return is_even(n - 1);
+}
+
+void main()
+{
+    int a = 3;
+    int b = sq(a) + sq(a + 1);
+    print(b);
+
+    int c = add3(sq(2), a, b);
+    print(c);
+
+    int r = clamp(c, 0, 10);
+    print(r);
+    r = clamp(0 - c, 0, 10);
+    print(r);
+    r = clamp(a + 4, 0, 10);
+    print(r);
+
+    int d = shout(a) * 2;
+    print(d);
+
+    shout(100);
+
+    int e = is_even(a);
+    print(e);
+    e = is_odd(a + c);
+    print(e);
+    e = is_even(b);
+    print(e);
+}
@@ -0,0 +1,84 @@
+int pick(int a, int b)
+{
+    int x = 0;
+    if (a > b) { x = a - b; }
+    else if (a < b) { x = b - a; }
+    else { x = 100; }
+    return x;
+}
+
+int swaps(int n)
+{
+    int a = 1;
+    int b = 2;
+    int i = 0;
+    while (i < n)
+    {
+        int t = a;
+        a = b;
+        b = t + b;
+        i = i + 1;
+    }
+    return a * 1000 + b;
+}
+
+int constant_branch(int n)
+{
+    int k = 5;
+    int s = 0;
+    if (k > 3) { s = n + k; }
+    else { s = n / 0; }
+    while (k < 3) { s = s + 1; }
+    return s;
+}
+
+int same_values(int a, int b)
+{
+    int x = a * b + 1;
+    int y = 0;
+    if (a > 0) { y = a * b + 1; }
+    else { y = a * b + 2; }
+    int unused = a / b;
+    return x + y;
+}
+
+int nested_loops(int n)
+{
+    int s = 0;
+    int i = 0;
+    while (i < n)
+    {
+        int j = i;
+        while (j > 0)
+        {
+            if (j / 2 * 2 == j) { s = s + j; }
+            else { s = s - 1; }
+            j = j - 1;
+        }
+        i = i + 1;
+    }
+    return s;
+}
+
+void main()
+{
+    int two   = 2;
+    int seven = 7;
+
+    int r = pick(seven, two);
+    print(r);
+    r = pick(two, seven);
+    print(r);
+    r = pick(two, two);
+    print(r);
+    r = swaps(seven);
+    print(r);
+    r = constant_branch(seven);
+    print(r);
+    r = same_values(seven, two);
+    print(r);
+    r = same_values(0 - seven, two);
+    print(r);
+    r = nested_loops(seven);
+    print(r);
+}
@@ -0,0 +1,84 @@
+int invariants(int a, int b, int n)
+{
+    int s = 0;
+    int i = 0;
+    while (i < n)
+    {
+        s = s + a * b + i;
+        i = i + 1;
+    }
+    return s;
+}
+
+int changed_invariant(int a, int n)
+{
+    int s = 0;
+    for (int i = 0; i < n; i = i + 1)
+    {
+        s = s + a * 3;
+        a = a + 1;
+    }
+    return s;
+}
+
+int inductions(int n, int k)
+{
+    int s = 0;
+    for (int i = 0; i < n; i = i + 1)
+    {
+        s = s + i * k + i * k * 2 + i * 5;
+    }
+    return s;
+}
+
+int changed_counter(int n)
+{
+    int s = 0;
+    int i = 0;
+    while (i < n)
+    {
+        s = s + i * 3 + i * 3;
+        if (i == 4) { i = i + 3; }
+        i = i + 1;
+    }
+    return s;
+}
+
+int skipped_counter(int n)
+{
+    int s = 0;
+    for (int i = 0; i < n; i = i + 2)
+    {
+        s = s + i * 7 + i * 7;
+        i = i - 1;
+    }
+    return s;
+}
+
+int powers(int x)
+{
+    int y = x ^ 3 + x ^ 2 + 2 ^ 10;
+    return y;
+}
+
+void main()
+{
+    int three = 3;
+    int four  = 4;
+    int ten   = 10;
+
+    int r = invariants(three, four, ten);
+    print(r);
+    r = changed_invariant(three + 2, four);
+    print(r);
+    r = inductions(three * 2, three);
+    print(r);
+    r = changed_counter(ten);
+    print(r);
+    r = skipped_counter(three * 2);
+    print(r);
+    r = powers(three + four);
+    print(r);
+    r = powers(0 - three);
+    print(r);
+}
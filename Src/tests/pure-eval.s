@@ -0,0 +1,66 @@
+int sq(int x)
+{
+    return x * x;
+}
+
+int fib(int n)
+{
+    if (n < 2) { return n; }
+    return fib(n - 1) + fib(n - 2);
+}
+
+int is_even(int n)
+{
+    if (n == 0) { return 1; }
+    return is_odd(n - 1);
+}
+
+int is_odd(int n)
+{
+    if (n == 0) { return 0; }
+    return is_even(n - 1);
+}
+
+int collatz(int n)
+{
+    int steps = 0;
+    while (n != 1)
+    {
+        if (n / 2 * 2 == n) { n = n / 2; }
+        else { n = 3 * n + 1; }
+        steps = steps + 1;
+    }
+    return steps;
+}
+
+int long_sum(int n)
+{
+    int s = 0;
+    for (int i = 0; i < n; i = i + 1)
+    {
+        s = s + i / 7;
+    }
+    return s;
+}
+
+int loud(int x)
+{
+    print(x);
+    return x * 2;
+}
+
+void main()
+{
+    int r = sq(fib(10));
+    print(r);
+    r = is_even(17) + is_odd(17) * 10;
+    print(r);
+    r = collatz(27);
+    print(r);
+    r = fib(23);
+    print(r);
+    r = long_sum(30000);
+    print(r);
+    r = loud(sq(3));
+    print(r);
+}
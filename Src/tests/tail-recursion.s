@@ -0,0 +1,62 @@
+int sum(int n)
+{
+    if (n == 0) { return 0; }
+    return n + sum(n - 1);
+}
+
+int fact(int n)
+{
+    if (n < 2) { return 1; }
+    return fact(n - 1) * n;
+}
+
+int pow2(int n)
+{
+    if (n == 0) { return 1; }
+    return 2 * pow2(n - 1);
+}
+
+int count_down(int n, int step)
+{
+    if (n < step) { return n; }
+    return count_down(n - step, step);
+}
+
+int fib(int n)
+{
+    if (n < 2) { return n; }
+    return fib(n - 1) + fib(n - 2);
+}
+
+int ping(int n)
+{
+    if (n == 0) { return 0; }
+    return 1 + pong(n - 1);
+}
+
+int pong(int n)
+{
+    if (n == 0) { return 0; }
+    return 2 + ping(n - 1);
+}
+
+void main()
+{
+    int n = 10;
+    int r = sum(n);
+    print(r);
+    r = sum(n - n);
+    print(r);
+    r = fact(n);
+    print(r);
+    r = pow2(n + 5);
+    print(r);
+    r = count_down(n * 10 + 3, 7);
+    print(r);
+    r = fib(n + 5);
+    print(r);
+    r = ping(n + 1);
+    print(r);
+    r = pong(n);
+    print(r);
+}
@@ -0,0 +1,93 @@
+int full(int a)
+{
+    int s = 0;
+    for (int i = 0; i < 5; i = i + 1)
+    {
+        s = s * 2 + a + i;
+    }
+    return s;
+}
+
+int partial(int n)
+{
+    int s = 0;
+    for (int i = 0; i < n; i = i + 1)
+    {
+        s = s + i * i;
+    }
+    return s;
+}
+
+int descending(int n)
+{
+    int s = 0;
+    int i = n;
+    while (i >= 0)
+    {
+        s = s * 3 + i;
+        s = s - s / 1000 * 1000;
+        i = i - 2;
+    }
+    return s;
+}
+
+int inclusive(int n)
+{
+    int s = 0;
+    for (int i = 1; i <= n; i = i + 3)
+    {
+        s = s + i;
+    }
+    return s;
+}
+
+int nested(int n)
+{
+    int s = 0;
+    for (int i = 0; i < n; i = i + 1)
+    {
+        for (int j = 0; j < 3; j = j + 1)
+        {
+            s = s + i * 10 + j;
+        }
+    }
+    return s;
+}
+
+int changed_counter(int n)
+{
+    int s = 0;
+    for (int i = 0; i < n; i = i + 1)
+    {
+        s = s + i;
+        if (i == 2) { i = i + 4; }
+    }
+    return s;
+}
+
+void main()
+{
+    int one  = 1;
+    int zero = one - one;
+
+    int r = full(one + 2);
+    print(r);
+
+    r = partial(zero);
+    print(r);
+    r = partial(one);
+    print(r);
+    r = partial(one * 7);
+    print(r);
+    r = partial(one * 9);
+    print(r);
+
+    r = descending(one * 13);
+    print(r);
+    r = inclusive(one * 14);
+    print(r);
+    r = nested(one * 5);
+    print(r);
+    r = changed_counter(one * 12);
+    print(r);
+}